@@ -36,6 +36,7 @@ import com.android.inputmethod.latin.utils.LanguageModelParam;
 import com.android.inputmethod.latin.utils.StringUtils;
 
 import java.io.File;
+import java.nio.ByteBuffer;
 import java.util.ArrayList;
 import java.util.Arrays;
 import java.util.HashMap;
@@ -61,6 +62,24 @@ public final class BinaryDictionary extends Dictionary {
     public static final String MAX_UNIGRAM_COUNT_QUERY = "MAX_UNIGRAM_COUNT";
     @UsedForTesting
     public static final String MAX_BIGRAM_COUNT_QUERY = "MAX_BIGRAM_COUNT";
+    // Bytes of the dictionary files that are resident in memory.
+    @UsedForTesting
+    public static final String RESIDENT_SIZE_QUERY = "RESIDENT_SIZE";
+    // Bytes of the dictionary files that in-place updates have copied into anonymous memory.
+    @UsedForTesting
+    public static final String ANONYMOUS_SIZE_QUERY = "ANONYMOUS_SIZE";
+    // Process-wide page fault counters, to measure the paging cost of opening a dictionary.
+    @UsedForTesting
+    public static final String MAJOR_PAGE_FAULT_COUNT_QUERY = "MAJOR_PAGE_FAULT_COUNT";
+    @UsedForTesting
+    public static final String MINOR_PAGE_FAULT_COUNT_QUERY = "MINOR_PAGE_FAULT_COUNT";
+    // Microseconds spent on each step of opening a version 4 dictionary, e.g. "body:12 trie:3".
+    @UsedForTesting
+    public static final String OPEN_TIMINGS_QUERY = "OPEN_TIMINGS";
+    // Heap allocations made by the last getSuggestions call. The native library counts them only
+    // when it is built with FLAG_COUNT_ALLOCATIONS, and reports -1 otherwise.
+    @UsedForTesting
+    public static final String SUGGESTION_ALLOCATION_COUNT_QUERY = "SUGGESTION_ALLOCATION_COUNT";
 
     public static final int NOT_A_VALID_TIMESTAMP = -1;
 
@@ -187,11 +206,15 @@ public final class BinaryDictionary extends Dictionary {
             boolean[] outIsBeginningOfSentence);
     private static native void getSuggestionsNative(long dict, long proximityInfo,
             long traverseSession, int[] xCoordinates, int[] yCoordinates, int[] times,
-            int[] pointerIds, int[] inputCodePoints, int inputSize, int[] suggestOptions,
-            int[][] prevWordCodePointArrays, boolean[] isBeginningOfSentenceArray,
-            int[] outputSuggestionCount, int[] outputCodePoints, int[] outputScores,
-            int[] outputIndices, int[] outputTypes, int[] outputAutoCommitFirstWordConfidence,
-            float[] inOutLanguageWeight);
+            int[] pointerIds, int[] inputCodePoints, int inputSize, int gesturePointsGeneration,
+            int[] suggestOptions, int[][] prevWordCodePointArrays,
+            boolean[] isBeginningOfSentenceArray, int[] outputSuggestionCount,
+            int[] outputCodePoints, int[] outputScores, int[] outputIndices, int[] outputTypes,
+            int[] outputAutoCommitFirstWordConfidence, float[] inOutLanguageWeight);
+    private static native void getSuggestionsWithBufferNative(long dict, long proximityInfo,
+            long traverseSession, ByteBuffer suggestionBuffer);
+    private static native void getSuggestionsForBatchNative(long dict, long proximityInfo,
+            long traverseSession, ByteBuffer suggestionBatchBuffer, int threadCount);
     private static native boolean addUnigramEntryNative(long dict, int[] word, int probability,
             int[] shortcutTarget, int shortcutProbability, boolean isBeginningOfSentence,
             boolean isNotAWord, boolean isBlacklisted, int timestamp);
@@ -270,14 +293,18 @@ public final class BinaryDictionary extends Dictionary {
         final InputPointers inputPointers = composer.getInputPointers();
         final boolean isGesture = composer.isBatchMode();
         final int inputSize;
+        final int gesturePointsGeneration;
         if (!isGesture) {
             inputSize = composer.copyCodePointsExceptTrailingSingleQuotesAndReturnCodePointCount(
                     session.mInputCodePoints);
             if (inputSize < 0) {
                 return null;
             }
+            session.resetGesturePoints();
+            gesturePointsGeneration = DicTraverseSession.NOT_A_GESTURE_POINTS_GENERATION;
         } else {
             inputSize = inputPointers.getPointerSize();
+            gesturePointsGeneration = session.streamGesturePoints(inputPointers);
         }
         session.mNativeSuggestOptions.setUseFullEditDistance(mUseFullEditDistance);
         session.mNativeSuggestOptions.setIsGesture(isGesture);
@@ -293,18 +320,135 @@ public final class BinaryDictionary extends Dictionary {
             session.mInputOutputLanguageWeight[0] = Dictionary.NOT_A_LANGUAGE_WEIGHT;
         }
         // TOOD: Pass multiple previous words information for n-gram.
-        getSuggestionsNative(mNativeDict, proximityInfo.getNativeProximityInfo(),
-                getTraverseSession(sessionId).getSession(), inputPointers.getXCoordinates(),
+        // The input and the output go through the direct buffer when the input fits in it. The
+        // points of a gesture are passed too, so that the native side can use them when the
+        // points streamed to the session are not the input.
+        final NativeSuggestionBuffer suggestionBuffer = session.mNativeSuggestionBuffer;
+        if (suggestionBuffer.setInput(inputSize, inputPointers.getXCoordinates(),
                 inputPointers.getYCoordinates(), inputPointers.getTimes(),
-                inputPointers.getPointerIds(), session.mInputCodePoints, inputSize,
+                inputPointers.getPointerIds(), inputSize /* pointCount */,
+                gesturePointsGeneration, session.mInputCodePoints, isGesture ? 0 : inputSize,
                 session.mNativeSuggestOptions.getOptions(), session.mPrevWordCodePointArrays,
-                session.mIsBeginningOfSentenceArray, session.mOutputSuggestionCount,
-                session.mOutputCodePoints, session.mOutputScores, session.mSpaceIndices,
-                session.mOutputTypes, session.mOutputAutoCommitFirstWordConfidence,
-                session.mInputOutputLanguageWeight);
+                session.mIsBeginningOfSentenceArray, session.mInputOutputLanguageWeight[0])) {
+            getSuggestionsWithBufferNative(mNativeDict, proximityInfo.getNativeProximityInfo(),
+                    session.getSession(), suggestionBuffer.getBuffer());
+            suggestionBuffer.getOutput(session.mOutputSuggestionCount,
+                    session.mOutputCodePoints, session.mOutputScores, session.mSpaceIndices,
+                    session.mOutputTypes, session.mOutputAutoCommitFirstWordConfidence,
+                    session.mInputOutputLanguageWeight);
+        } else {
+            getSuggestionsNative(mNativeDict, proximityInfo.getNativeProximityInfo(),
+                    session.getSession(), inputPointers.getXCoordinates(),
+                    inputPointers.getYCoordinates(), inputPointers.getTimes(),
+                    inputPointers.getPointerIds(), session.mInputCodePoints, inputSize,
+                    gesturePointsGeneration, session.mNativeSuggestOptions.getOptions(),
+                    session.mPrevWordCodePointArrays, session.mIsBeginningOfSentenceArray,
+                    session.mOutputSuggestionCount, session.mOutputCodePoints,
+                    session.mOutputScores, session.mSpaceIndices, session.mOutputTypes,
+                    session.mOutputAutoCommitFirstWordConfidence,
+                    session.mInputOutputLanguageWeight);
+        }
         if (inOutLanguageWeight != null) {
             inOutLanguageWeight[0] = session.mInputOutputLanguageWeight[0];
         }
+        return getOutputSuggestions(session);
+    }
+
+    @Override
+    public ArrayList<ArrayList<SuggestedWordInfo>> getSuggestionsForBatch(
+            final WordComposer[] composers, final PrevWordsInfo[] prevWordsInfos,
+            final ProximityInfo proximityInfo,
+            final SettingsValuesForSuggestion settingsValuesForSuggestion, final int sessionId,
+            final float[] inOutLanguageWeights) {
+        // The native side doesn't run more threads than its thread pool has.
+        return getSuggestionsForBatch(composers, prevWordsInfos, proximityInfo,
+                settingsValuesForSuggestion, sessionId, inOutLanguageWeights,
+                Runtime.getRuntime().availableProcessors());
+    }
+
+    /**
+     * Gets the suggestions for each of the typed words in one native call. The queries are
+     * independent, and each of them is the same as getSuggestions() with the arguments at the
+     * same index. The queries with the same previous words share the bigram lookups, and up to
+     * threadCount native threads run the queries. The queries that can't be batched, such as
+     * gestures and empty words, run one by one with getSuggestions().
+     */
+    public ArrayList<ArrayList<SuggestedWordInfo>> getSuggestionsForBatch(
+            final WordComposer[] composers, final PrevWordsInfo[] prevWordsInfos,
+            final ProximityInfo proximityInfo,
+            final SettingsValuesForSuggestion settingsValuesForSuggestion, final int sessionId,
+            final float[] inOutLanguageWeights, final int threadCount) {
+        if (!isValidDictionary()) {
+            return null;
+        }
+        final DicTraverseSession session = getTraverseSession(sessionId);
+        session.resetGesturePoints();
+        session.mNativeSuggestOptions.setUseFullEditDistance(mUseFullEditDistance);
+        session.mNativeSuggestOptions.setIsGesture(false);
+        session.mNativeSuggestOptions.setBlockOffensiveWords(
+                settingsValuesForSuggestion.mBlockPotentiallyOffensive);
+        session.mNativeSuggestOptions.setSpaceAwareGestureEnabled(
+                settingsValuesForSuggestion.mSpaceAwareGestureEnabled);
+        session.mNativeSuggestOptions.setAdditionalFeaturesOptions(
+                settingsValuesForSuggestion.mAdditionalFeaturesSettingValues);
+        final int[] options = session.mNativeSuggestOptions.getOptions();
+        // The index of the query in the batch for each composer, or -1 if it isn't batched. A
+        // query without input gets predictions instead of suggestions.
+        final int[] queryIndices = new int[composers.length];
+        final int[] inputSizes = new int[composers.length];
+        int queryCount = 0;
+        for (int i = 0; i < composers.length; ++i) {
+            inputSizes[i] = composers[i].isBatchMode() ? 0 : composers[i]
+                    .copyCodePointsExceptTrailingSingleQuotesAndReturnCodePointCount(
+                            session.mInputCodePoints);
+            queryIndices[i] = inputSizes[i] > 0 ? queryCount++ : -1;
+        }
+        final NativeSuggestionBatchBuffer batchBuffer = session.getNativeSuggestionBatchBuffer();
+        batchBuffer.startBatch(queryCount);
+        for (int i = 0; i < composers.length; ++i) {
+            if (queryIndices[i] < 0) {
+                continue;
+            }
+            Arrays.fill(session.mInputCodePoints, Constants.NOT_A_CODE);
+            composers[i].copyCodePointsExceptTrailingSingleQuotesAndReturnCodePointCount(
+                    session.mInputCodePoints);
+            prevWordsInfos[i].outputToArray(session.mPrevWordCodePointArrays,
+                    session.mIsBeginningOfSentenceArray);
+            final InputPointers inputPointers = composers[i].getInputPointers();
+            final int inputSize = inputSizes[i];
+            batchBuffer.addQuery(inputSize, inputPointers.getXCoordinates(),
+                    inputPointers.getYCoordinates(), inputPointers.getTimes(),
+                    inputPointers.getPointerIds(), session.mInputCodePoints, inputSize, options,
+                    session.mPrevWordCodePointArrays, session.mIsBeginningOfSentenceArray,
+                    inOutLanguageWeights[i]);
+        }
+        if (queryCount > 0) {
+            getSuggestionsForBatchNative(mNativeDict, proximityInfo.getNativeProximityInfo(),
+                    session.getSession(), batchBuffer.getBuffer(), threadCount);
+        }
+        final ArrayList<ArrayList<SuggestedWordInfo>> suggestionsForBatch = new ArrayList<>();
+        final float[] languageWeight = new float[1];
+        for (int i = 0; i < composers.length; ++i) {
+            if (queryIndices[i] < 0) {
+                // This doesn't use the batch buffer, so the outputs of the batch are kept.
+                languageWeight[0] = inOutLanguageWeights[i];
+                suggestionsForBatch.add(getSuggestions(composers[i], prevWordsInfos[i],
+                        proximityInfo, settingsValuesForSuggestion, sessionId, languageWeight));
+                inOutLanguageWeights[i] = languageWeight[0];
+                continue;
+            }
+            batchBuffer.getOutput(queryIndices[i], session.mOutputSuggestionCount,
+                    session.mOutputCodePoints, session.mOutputScores, session.mSpaceIndices,
+                    session.mOutputTypes, session.mOutputAutoCommitFirstWordConfidence,
+                    session.mInputOutputLanguageWeight);
+            inOutLanguageWeights[i] = session.mInputOutputLanguageWeight[0];
+            suggestionsForBatch.add(getOutputSuggestions(session));
+        }
+        return suggestionsForBatch;
+    }
+
+    // Makes the suggestions from the output arrays of the session.
+    private ArrayList<SuggestedWordInfo> getOutputSuggestions(final DicTraverseSession session) {
         final int count = session.mOutputSuggestionCount[0];
         final ArrayList<SuggestedWordInfo> suggestions = new ArrayList<>();
         for (int j = 0; j < count; ++j) {
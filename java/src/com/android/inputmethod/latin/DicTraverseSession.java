@@ -27,6 +27,8 @@ public final class DicTraverseSession {
     }
     // Must be equal to MAX_RESULTS in native/jni/src/defines.h
     private static final int MAX_RESULTS = 18;
+    // Must be equal to DicTraverseSession::NOT_A_GESTURE_POINTS_GENERATION in native code.
+    public static final int NOT_A_GESTURE_POINTS_GENERATION = 0;
     public final int[] mInputCodePoints = new int[Constants.DICTIONARY_MAX_WORD_LENGTH];
     public final int[][] mPrevWordCodePointArrays =
             new int[Constants.MAX_PREV_WORD_COUNT_FOR_N_GRAM][];
@@ -43,13 +45,27 @@ public final class DicTraverseSession {
     public final float[] mInputOutputLanguageWeight = new float[1];
 
     public final NativeSuggestOptions mNativeSuggestOptions = new NativeSuggestOptions();
+    public final NativeSuggestionBuffer mNativeSuggestionBuffer = new NativeSuggestionBuffer();
+    // Created when the session runs a batch for the first time.
+    private NativeSuggestionBatchBuffer mNativeSuggestionBatchBuffer;
 
     private static native long setDicTraverseSessionNative(String locale, long dictSize);
     private static native void initDicTraverseSessionNative(long nativeDicTraverseSession,
             long dictionary, int[] previousWord, int previousWordLength);
+    private static native void resetGesturePointsNative(long nativeDicTraverseSession);
+    private static native int appendGesturePointsNative(long nativeDicTraverseSession,
+            int[] xCoordinates, int[] yCoordinates, int[] times, int[] pointerIds, int offset,
+            int pointCount);
     private static native void releaseDicTraverseSessionNative(long nativeDicTraverseSession);
 
     private long mNativeDicTraverseSession;
+    // The gesture points that have been passed to the native session and the last one of them.
+    private int mStreamedGesturePointCount;
+    private int mLastStreamedGesturePointX;
+    private int mLastStreamedGesturePointY;
+    private int mLastStreamedGesturePointTime;
+    // The generation the native session returned for the streamed points.
+    private int mGesturePointsGeneration = NOT_A_GESTURE_POINTS_GENERATION;
 
     public DicTraverseSession(Locale locale, long dictionary, long dictSize) {
         mNativeDicTraverseSession = createNativeDicTraverseSession(
@@ -61,6 +77,13 @@ public final class DicTraverseSession {
         return mNativeDicTraverseSession;
     }
 
+    public NativeSuggestionBatchBuffer getNativeSuggestionBatchBuffer() {
+        if (mNativeSuggestionBatchBuffer == null) {
+            mNativeSuggestionBatchBuffer = new NativeSuggestionBatchBuffer();
+        }
+        return mNativeSuggestionBatchBuffer;
+    }
+
     public void initSession(long dictionary) {
         initSession(dictionary, null, 0);
     }
@@ -70,6 +93,52 @@ public final class DicTraverseSession {
                 mNativeDicTraverseSession, dictionary, previousWord, previousWordLength);
     }
 
+    /**
+     * Passes the points of the ongoing gesture that have been added since the last call to the
+     * native session, so that getting suggestions only processes the new points. Returns the
+     * generation of the streamed points, which is passed with the input to tell the native side
+     * that the points it holds are the input.
+     */
+    public int streamGesturePoints(final InputPointers inputPointers) {
+        final int pointerSize = inputPointers.getPointerSize();
+        final int[] xCoordinates = inputPointers.getXCoordinates();
+        final int[] yCoordinates = inputPointers.getYCoordinates();
+        final int[] times = inputPointers.getTimes();
+        if (pointerSize < mStreamedGesturePointCount || (mStreamedGesturePointCount > 0
+                && !isLastStreamedGesturePoint(xCoordinates, yCoordinates, times,
+                        mStreamedGesturePointCount - 1))) {
+            // A new gesture has started.
+            resetGesturePoints();
+        }
+        if (pointerSize == mStreamedGesturePointCount) {
+            return mGesturePointsGeneration;
+        }
+        mGesturePointsGeneration = appendGesturePointsNative(mNativeDicTraverseSession,
+                xCoordinates, yCoordinates, times, inputPointers.getPointerIds(),
+                mStreamedGesturePointCount, pointerSize - mStreamedGesturePointCount);
+        mStreamedGesturePointCount = pointerSize;
+        mLastStreamedGesturePointX = xCoordinates[pointerSize - 1];
+        mLastStreamedGesturePointY = yCoordinates[pointerSize - 1];
+        mLastStreamedGesturePointTime = times[pointerSize - 1];
+        return mGesturePointsGeneration;
+    }
+
+    public void resetGesturePoints() {
+        if (mStreamedGesturePointCount == 0) {
+            return;
+        }
+        resetGesturePointsNative(mNativeDicTraverseSession);
+        mStreamedGesturePointCount = 0;
+        mGesturePointsGeneration = NOT_A_GESTURE_POINTS_GENERATION;
+    }
+
+    private boolean isLastStreamedGesturePoint(final int[] xCoordinates,
+            final int[] yCoordinates, final int[] times, final int index) {
+        return xCoordinates[index] == mLastStreamedGesturePointX
+                && yCoordinates[index] == mLastStreamedGesturePointY
+                && times[index] == mLastStreamedGesturePointTime;
+    }
+
     private final long createNativeDicTraverseSession(String locale, long dictSize) {
         return setDicTraverseSessionNative(locale, dictSize);
     }
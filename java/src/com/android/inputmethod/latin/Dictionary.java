@@ -85,6 +85,30 @@ public abstract class Dictionary {
             final SettingsValuesForSuggestion settingsValuesForSuggestion,
             final int sessionId, final float[] inOutLanguageWeight);
 
+    /**
+     * Searches for suggestions for each of the given words. The searches are independent, and
+     * each of them is the same as getSuggestions() with the arguments at the same index.
+     * Dictionaries that can run the searches together override this.
+     * @param inOutLanguageWeights the language weight of each search, updated like
+     * inOutLanguageWeight of getSuggestions().
+     * @return the lists of suggestions for the words, each possibly null, or null if none
+     */
+    public ArrayList<ArrayList<SuggestedWordInfo>> getSuggestionsForBatch(
+            final WordComposer[] composers, final PrevWordsInfo[] prevWordsInfos,
+            final ProximityInfo proximityInfo,
+            final SettingsValuesForSuggestion settingsValuesForSuggestion, final int sessionId,
+            final float[] inOutLanguageWeights) {
+        final ArrayList<ArrayList<SuggestedWordInfo>> suggestionsForBatch = new ArrayList<>();
+        final float[] languageWeight = new float[1];
+        for (int i = 0; i < composers.length; ++i) {
+            languageWeight[0] = inOutLanguageWeights[i];
+            suggestionsForBatch.add(getSuggestions(composers[i], prevWordsInfos[i],
+                    proximityInfo, settingsValuesForSuggestion, sessionId, languageWeight));
+            inOutLanguageWeights[i] = languageWeight[0];
+        }
+        return suggestionsForBatch;
+    }
+
     /**
      * Checks if the given word has to be treated as a valid word. Please note that some
      * dictionaries have entries that should be treated as invalid words.
@@ -78,6 +78,31 @@ public final class DictionaryCollection extends Dictionary {
         return suggestions;
     }
 
+    @Override
+    public ArrayList<ArrayList<SuggestedWordInfo>> getSuggestionsForBatch(
+            final WordComposer[] composers, final PrevWordsInfo[] prevWordsInfos,
+            final ProximityInfo proximityInfo,
+            final SettingsValuesForSuggestion settingsValuesForSuggestion, final int sessionId,
+            final float[] inOutLanguageWeights) {
+        final CopyOnWriteArrayList<Dictionary> dictionaries = mDictionaries;
+        if (dictionaries.isEmpty()) return null;
+        final ArrayList<ArrayList<SuggestedWordInfo>> suggestionsForBatch = new ArrayList<>();
+        for (int i = 0; i < composers.length; ++i) {
+            suggestionsForBatch.add(new ArrayList<SuggestedWordInfo>());
+        }
+        for (final Dictionary dictionary : dictionaries) {
+            final ArrayList<ArrayList<SuggestedWordInfo>> dictionarySuggestionsForBatch =
+                    dictionary.getSuggestionsForBatch(composers, prevWordsInfos, proximityInfo,
+                            settingsValuesForSuggestion, sessionId, inOutLanguageWeights);
+            if (null == dictionarySuggestionsForBatch) continue;
+            for (int i = 0; i < composers.length; ++i) {
+                final ArrayList<SuggestedWordInfo> sugg = dictionarySuggestionsForBatch.get(i);
+                if (null != sugg) suggestionsForBatch.get(i).addAll(sugg);
+            }
+        }
+        return suggestionsForBatch;
+    }
+
     @Override
     public boolean isInDictionary(final String word) {
         for (int i = mDictionaries.size() - 1; i >= 0; --i)
@@ -510,6 +510,45 @@ public class DictionaryFacilitator {
         return suggestionResults;
     }
 
+    /**
+     * Gets the suggestion results for each of the words. Each result is the same as
+     * getSuggestionResults() returns for the word and the previous words at the same index, but
+     * the dictionaries search for all the words at once.
+     */
+    public SuggestionResults[] getSuggestionResultsForBatch(final WordComposer[] composers,
+            final PrevWordsInfo[] prevWordsInfos, final ProximityInfo proximityInfo,
+            final SettingsValuesForSuggestion settingsValuesForSuggestion, final int sessionId) {
+        final Dictionaries dictionaries = mDictionaries;
+        final SuggestionResults[] suggestionResultsForBatch =
+                new SuggestionResults[composers.length];
+        final float[] languageWeights = new float[composers.length];
+        for (int i = 0; i < composers.length; ++i) {
+            suggestionResultsForBatch[i] = new SuggestionResults(
+                    dictionaries.mLocale, SuggestedWords.MAX_SUGGESTIONS,
+                    prevWordsInfos[i].mPrevWordsInfo[0].mIsBeginningOfSentence);
+            languageWeights[i] = Dictionary.NOT_A_LANGUAGE_WEIGHT;
+        }
+        for (final String dictType : DICT_TYPES_ORDERED_TO_GET_SUGGESTIONS) {
+            final Dictionary dictionary = dictionaries.getDict(dictType);
+            if (null == dictionary) continue;
+            final ArrayList<ArrayList<SuggestedWordInfo>> dictionarySuggestionsForBatch =
+                    dictionary.getSuggestionsForBatch(composers, prevWordsInfos, proximityInfo,
+                            settingsValuesForSuggestion, sessionId, languageWeights);
+            if (null == dictionarySuggestionsForBatch) continue;
+            for (int i = 0; i < composers.length; ++i) {
+                final ArrayList<SuggestedWordInfo> dictionarySuggestions =
+                        dictionarySuggestionsForBatch.get(i);
+                if (null == dictionarySuggestions) continue;
+                final SuggestionResults suggestionResults = suggestionResultsForBatch[i];
+                suggestionResults.addAll(dictionarySuggestions);
+                if (null != suggestionResults.mRawSuggestions) {
+                    suggestionResults.mRawSuggestions.addAll(dictionarySuggestions);
+                }
+            }
+        }
+        return suggestionResultsForBatch;
+    }
+
     public boolean isValidWord(final String word, final boolean ignoreCase) {
         if (TextUtils.isEmpty(word)) {
             return false;
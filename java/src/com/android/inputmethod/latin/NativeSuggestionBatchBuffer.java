@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.android.inputmethod.latin;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.IntBuffer;
+
+/**
+ * A direct buffer that holds the queries of a batch and their results, so that the queries run
+ * in one native call. See suggestion_batch_buffer.h for the layout.
+ */
+public final class NativeSuggestionBatchBuffer {
+    // Need to update suggestion_batch_buffer.h when you change the layout.
+    private static final int QUERY_COUNT = 0;
+    private static final int HEADER_SIZE = 1;
+    // Enough for a few typed words. The buffer grows when a batch needs more.
+    private static final int INITIAL_BUFFER_SIZE =
+            HEADER_SIZE + 8 * (NativeSuggestionBuffer.OUTPUT_RECORD_SIZE + 64);
+
+    private ByteBuffer mByteBuffer;
+    private IntBuffer mIntBuffer;
+    private int mQueryCount;
+    private int mAddedQueryCount;
+
+    public NativeSuggestionBatchBuffer() {
+        allocate(INITIAL_BUFFER_SIZE);
+    }
+
+    private void allocate(final int size) {
+        final ByteBuffer byteBuffer = ByteBuffer.allocateDirect(size * Integer.SIZE / Byte.SIZE)
+                .order(ByteOrder.nativeOrder());
+        final IntBuffer intBuffer = byteBuffer.asIntBuffer();
+        if (mIntBuffer != null) {
+            final int writtenSize = mIntBuffer.position();
+            mIntBuffer.rewind();
+            mIntBuffer.limit(writtenSize);
+            intBuffer.put(mIntBuffer);
+        }
+        mByteBuffer = byteBuffer;
+        mIntBuffer = intBuffer;
+    }
+
+    private void ensureCapacity(final int size) {
+        if (size > mIntBuffer.capacity()) {
+            allocate(Math.max(size, mIntBuffer.capacity() * 2));
+        }
+    }
+
+    public ByteBuffer getBuffer() {
+        return mByteBuffer;
+    }
+
+    /**
+     * Starts a batch of queryCount queries. The queries are added with addQuery() in order.
+     */
+    public void startBatch(final int queryCount) {
+        mQueryCount = queryCount;
+        mAddedQueryCount = 0;
+        final int inputRecordsPos = HEADER_SIZE
+                + queryCount * NativeSuggestionBuffer.OUTPUT_RECORD_SIZE;
+        mIntBuffer.clear();
+        ensureCapacity(inputRecordsPos);
+        mIntBuffer.put(QUERY_COUNT, queryCount);
+        mIntBuffer.position(inputRecordsPos);
+    }
+
+    /**
+     * Adds the input record of the next query. The arguments are the same as
+     * NativeSuggestionBuffer.setInput() takes. The points are never streamed for a batch.
+     */
+    public void addQuery(final int inputSize, final int[] xCoordinates, final int[] yCoordinates,
+            final int[] times, final int[] pointerIds, final int[] inputCodePoints,
+            final int inputCodePointCount, final int[] options,
+            final int[][] prevWordCodePointArrays, final boolean[] isBeginningOfSentenceArray,
+            final float languageWeight) {
+        if (mAddedQueryCount >= mQueryCount) {
+            throw new IllegalStateException("Too many queries: " + mQueryCount);
+        }
+        final int recordSize = NativeSuggestionBuffer.getInputRecordSize(inputSize,
+                inputCodePointCount, options, prevWordCodePointArrays);
+        ensureCapacity(mIntBuffer.position() + 1 + recordSize);
+        mIntBuffer.put(recordSize);
+        NativeSuggestionBuffer.putInputRecord(mIntBuffer, inputSize, xCoordinates, yCoordinates,
+                times, pointerIds, inputSize /* pointCount */,
+                DicTraverseSession.NOT_A_GESTURE_POINTS_GENERATION, inputCodePoints,
+                inputCodePointCount, options, prevWordCodePointArrays,
+                isBeginningOfSentenceArray, languageWeight);
+        ++mAddedQueryCount;
+    }
+
+    /**
+     * Reads the output record of the queryIndex-th query into the same arrays as
+     * getSuggestionsNative() writes.
+     */
+    public void getOutput(final int queryIndex, final int[] outSuggestionCount,
+            final int[] outCodePoints, final int[] outScores, final int[] outSpaceIndices,
+            final int[] outTypes, final int[] outAutoCommitFirstWordConfidence,
+            final float[] outLanguageWeight) {
+        NativeSuggestionBuffer.getOutputRecord(mIntBuffer,
+                HEADER_SIZE + queryIndex * NativeSuggestionBuffer.OUTPUT_RECORD_SIZE,
+                outSuggestionCount, outCodePoints, outScores, outSpaceIndices, outTypes,
+                outAutoCommitFirstWordConfidence, outLanguageWeight);
+    }
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package com.android.inputmethod.latin;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.IntBuffer;
+
+/**
+ * A direct buffer that holds both the input and the output of one native getSuggestions() call,
+ * so that the call doesn't copy any arrays through JNI. See suggestion_buffer.h for the layout.
+ */
+public final class NativeSuggestionBuffer {
+    // Must be equal to MAX_RESULTS in native/jni/src/defines.h
+    private static final int MAX_RESULTS = 18;
+    // Need to update suggestion_buffer.h when you change the layout.
+    private static final int SUGGESTION_COUNT = 0;
+    private static final int AUTO_COMMIT_FIRST_WORD_CONFIDENCE = 1;
+    private static final int OUTPUT_LANGUAGE_WEIGHT = 2;
+    private static final int SCORES = 3;
+    private static final int SPACE_INDICES = SCORES + MAX_RESULTS;
+    private static final int TYPES = SPACE_INDICES + MAX_RESULTS;
+    private static final int CODE_POINTS = TYPES + MAX_RESULTS;
+    static final int OUTPUT_RECORD_SIZE =
+            CODE_POINTS + MAX_RESULTS * Constants.DICTIONARY_MAX_WORD_LENGTH;
+    private static final int INPUT_RECORD = OUTPUT_RECORD_SIZE;
+    private static final int INPUT_RECORD_HEADER_SIZE = 7;
+    // Typing input and short gestures fit in this. The other input is passed with arrays.
+    private static final int MAX_INPUT_RECORD_SIZE = 1024;
+    private static final int BUFFER_SIZE = INPUT_RECORD + MAX_INPUT_RECORD_SIZE;
+
+    private final ByteBuffer mByteBuffer;
+    private final IntBuffer mIntBuffer;
+
+    public NativeSuggestionBuffer() {
+        mByteBuffer = ByteBuffer.allocateDirect(BUFFER_SIZE * Integer.SIZE / Byte.SIZE)
+                .order(ByteOrder.nativeOrder());
+        mIntBuffer = mByteBuffer.asIntBuffer();
+    }
+
+    public ByteBuffer getBuffer() {
+        return mByteBuffer;
+    }
+
+    /**
+     * Writes the input record. pointCount is the number of the coordinates to pass, which must
+     * be at least inputSize. gesturePointsGeneration is the one
+     * DicTraverseSession.streamGesturePoints() returned. Returns false when the input doesn't fit
+     * in the buffer.
+     */
+    public boolean setInput(final int inputSize, final int[] xCoordinates,
+            final int[] yCoordinates, final int[] times, final int[] pointerIds,
+            final int pointCount, final int gesturePointsGeneration, final int[] inputCodePoints,
+            final int inputCodePointCount, final int[] options,
+            final int[][] prevWordCodePointArrays, final boolean[] isBeginningOfSentenceArray,
+            final float languageWeight) {
+        if (getInputRecordSize(pointCount, inputCodePointCount, options,
+                prevWordCodePointArrays) > MAX_INPUT_RECORD_SIZE) {
+            return false;
+        }
+        mIntBuffer.position(INPUT_RECORD);
+        putInputRecord(mIntBuffer, inputSize, xCoordinates, yCoordinates, times, pointerIds,
+                pointCount, gesturePointsGeneration, inputCodePoints, inputCodePointCount, options,
+                prevWordCodePointArrays, isBeginningOfSentenceArray, languageWeight);
+        return true;
+    }
+
+    /**
+     * Reads the output record into the same arrays as getSuggestionsNative() writes.
+     */
+    public void getOutput(final int[] outSuggestionCount, final int[] outCodePoints,
+            final int[] outScores, final int[] outSpaceIndices, final int[] outTypes,
+            final int[] outAutoCommitFirstWordConfidence, final float[] outLanguageWeight) {
+        getOutputRecord(mIntBuffer, 0 /* outputRecordPos */, outSuggestionCount, outCodePoints,
+                outScores, outSpaceIndices, outTypes, outAutoCommitFirstWordConfidence,
+                outLanguageWeight);
+    }
+
+    static int getInputRecordSize(final int pointCount, final int inputCodePointCount,
+            final int[] options, final int[][] prevWordCodePointArrays) {
+        int recordSize = INPUT_RECORD_HEADER_SIZE + options.length + inputCodePointCount
+                + pointCount * 4;
+        for (final int[] prevWord : prevWordCodePointArrays) {
+            recordSize += 2 + (prevWord != null ? prevWord.length : 0);
+        }
+        return recordSize;
+    }
+
+    // Writes the input record at the current position of intBuffer.
+    static void putInputRecord(final IntBuffer intBuffer, final int inputSize,
+            final int[] xCoordinates, final int[] yCoordinates, final int[] times,
+            final int[] pointerIds, final int pointCount, final int gesturePointsGeneration,
+            final int[] inputCodePoints, final int inputCodePointCount, final int[] options,
+            final int[][] prevWordCodePointArrays, final boolean[] isBeginningOfSentenceArray,
+            final float languageWeight) {
+        intBuffer.put(inputSize);
+        intBuffer.put(pointCount);
+        intBuffer.put(inputCodePointCount);
+        intBuffer.put(options.length);
+        intBuffer.put(prevWordCodePointArrays.length);
+        intBuffer.put(Float.floatToRawIntBits(languageWeight));
+        intBuffer.put(gesturePointsGeneration);
+        intBuffer.put(options);
+        for (int i = 0; i < prevWordCodePointArrays.length; ++i) {
+            final int[] prevWord = prevWordCodePointArrays[i];
+            if (prevWord == null) {
+                intBuffer.put(0 /* isBeginningOfSentence */);
+                intBuffer.put(0 /* codePointCount */);
+                continue;
+            }
+            intBuffer.put(isBeginningOfSentenceArray[i] ? 1 : 0);
+            intBuffer.put(prevWord.length);
+            intBuffer.put(prevWord);
+        }
+        intBuffer.put(inputCodePoints, 0, inputCodePointCount);
+        intBuffer.put(xCoordinates, 0, pointCount);
+        intBuffer.put(yCoordinates, 0, pointCount);
+        intBuffer.put(times, 0, pointCount);
+        intBuffer.put(pointerIds, 0, pointCount);
+    }
+
+    static void getOutputRecord(final IntBuffer intBuffer, final int outputRecordPos,
+            final int[] outSuggestionCount, final int[] outCodePoints, final int[] outScores,
+            final int[] outSpaceIndices, final int[] outTypes,
+            final int[] outAutoCommitFirstWordConfidence, final float[] outLanguageWeight) {
+        final int suggestionCount = intBuffer.get(outputRecordPos + SUGGESTION_COUNT);
+        outSuggestionCount[0] = suggestionCount;
+        outAutoCommitFirstWordConfidence[0] =
+                intBuffer.get(outputRecordPos + AUTO_COMMIT_FIRST_WORD_CONFIDENCE);
+        outLanguageWeight[0] =
+                Float.intBitsToFloat(intBuffer.get(outputRecordPos + OUTPUT_LANGUAGE_WEIGHT));
+        intBuffer.position(outputRecordPos + SCORES);
+        intBuffer.get(outScores, 0, suggestionCount);
+        intBuffer.position(outputRecordPos + SPACE_INDICES);
+        intBuffer.get(outSpaceIndices, 0, suggestionCount);
+        intBuffer.position(outputRecordPos + TYPES);
+        intBuffer.get(outTypes, 0, suggestionCount);
+        intBuffer.position(outputRecordPos + CODE_POINTS);
+        intBuffer.get(outCodePoints, 0, suggestionCount * Constants.DICTIONARY_MAX_WORD_LENGTH);
+    }
+}
@@ -65,6 +65,24 @@ public final class ReadOnlyBinaryDictionary extends Dictionary {
         return null;
     }
 
+    @Override
+    public ArrayList<ArrayList<SuggestedWordInfo>> getSuggestionsForBatch(
+            final WordComposer[] composers, final PrevWordsInfo[] prevWordsInfos,
+            final ProximityInfo proximityInfo,
+            final SettingsValuesForSuggestion settingsValuesForSuggestion, final int sessionId,
+            final float[] inOutLanguageWeights) {
+        if (mLock.readLock().tryLock()) {
+            try {
+                return mBinaryDictionary.getSuggestionsForBatch(composers, prevWordsInfos,
+                        proximityInfo, settingsValuesForSuggestion, sessionId,
+                        inOutLanguageWeights);
+            } finally {
+                mLock.readLock().unlock();
+            }
+        }
+        return null;
+    }
+
     @Override
     public boolean isInDictionary(final String word) {
         if (mLock.readLock().tryLock()) {
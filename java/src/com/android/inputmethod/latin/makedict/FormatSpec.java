@@ -190,6 +190,9 @@ public final class FormatSpec {
     // ExpandableDictionary.needsToMigrateDictionary() and
     // ExpandableDictionary.matchesExpectedBinaryDictFormatVersionForThisType().
     public static final int VERSION2 = 2;
+    // Read-only variant of version 2 with a LOUDS succinct trie. Only the native code reads and
+    // writes it.
+    public static final int VERSION2_LOUDS = 203;
     // Dictionary version used for testing.
     public static final int VERSION4_ONLY_FOR_TESTING = 399;
     public static final int VERSION401 = 401;
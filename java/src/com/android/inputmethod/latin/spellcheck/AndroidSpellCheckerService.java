@@ -247,6 +247,25 @@ public final class AndroidSpellCheckerService extends SpellCheckerService
         }
     }
 
+    public SuggestionResults[] getSuggestionResultsForBatch(final Locale locale,
+            final WordComposer[] composers, final PrevWordsInfo[] prevWordsInfos,
+            final ProximityInfo proximityInfo) {
+        Integer sessionId = null;
+        mSemaphore.acquireUninterruptibly();
+        try {
+            sessionId = mSessionIdPool.poll();
+            DictionaryFacilitator dictionaryFacilitatorForLocale =
+                    getDictionaryFacilitatorForLocaleLocked(locale);
+            return dictionaryFacilitatorForLocale.getSuggestionResultsForBatch(composers,
+                    prevWordsInfos, proximityInfo, mSettingsValuesForSuggestion, sessionId);
+        } finally {
+            if (sessionId != null) {
+                mSessionIdPool.add(sessionId);
+            }
+            mSemaphore.release();
+        }
+    }
+
     public boolean hasMainDictionaryForLocale(final Locale locale) {
         mSemaphore.acquireUninterruptibly();
         try {
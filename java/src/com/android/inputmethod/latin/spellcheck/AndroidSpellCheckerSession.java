@@ -27,6 +27,7 @@ import android.view.textservice.TextInfo;
 import com.android.inputmethod.compat.TextInfoCompatUtils;
 import com.android.inputmethod.latin.PrevWordsInfo;
 import com.android.inputmethod.latin.utils.StringUtils;
+import com.android.inputmethod.latin.utils.SuggestionResults;
 
 import java.util.ArrayList;
 import java.util.Locale;
@@ -196,6 +197,7 @@ public final class AndroidSpellCheckerSession extends AndroidWordLevelSpellCheck
         try {
             final int length = textInfos.length;
             final SuggestionsInfo[] retval = new SuggestionsInfo[length];
+            final PrevWordsInfo[] prevWordsInfos = new PrevWordsInfo[length];
             for (int i = 0; i < length; ++i) {
                 final CharSequence prevWord;
                 if (sequentialWords && i > 0) {
@@ -208,10 +210,17 @@ public final class AndroidSpellCheckerSession extends AndroidWordLevelSpellCheck
                 } else {
                     prevWord = null;
                 }
-                final PrevWordsInfo prevWordsInfo =
-                        new PrevWordsInfo(new PrevWordsInfo.WordInfo(prevWord));
+                prevWordsInfos[i] = new PrevWordsInfo(new PrevWordsInfo.WordInfo(prevWord));
+            }
+            // Each dictionary searches for all the words in one native call, which runs the
+            // searches on several threads.
+            final SuggestionResults[] suggestionResultsForBatch =
+                    getSuggestionResultsForBatch(textInfos, prevWordsInfos);
+            for (int i = 0; i < length; ++i) {
                 final TextInfo textInfo = textInfos[i];
-                retval[i] = onGetSuggestionsInternal(textInfo, prevWordsInfo, suggestionsLimit);
+                retval[i] = onGetSuggestionsInternal(textInfo, prevWordsInfos[i],
+                        suggestionsLimit, null == suggestionResultsForBatch ? null
+                                : suggestionResultsForBatch[i]);
                 retval[i].setCookieAndSequence(textInfo.getCookie(), textInfo.getSequence());
             }
             return retval;
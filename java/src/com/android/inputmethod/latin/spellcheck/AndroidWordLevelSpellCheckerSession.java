@@ -225,6 +225,74 @@ public abstract class AndroidWordLevelSpellCheckerSession extends Session {
     protected SuggestionsInfo onGetSuggestionsInternal(
             final TextInfo textInfo, final PrevWordsInfo prevWordsInfo,
             final int suggestionsLimit) {
+        return onGetSuggestionsInternal(textInfo, prevWordsInfo, suggestionsLimit,
+                null /* batchedSuggestionResults */);
+    }
+
+    /**
+     * Gets the suggestion results of the words that onGetSuggestionsInternal() would search
+     * the dictionaries for, with one search for all of them. The results of the other words are
+     * null. Returns null when there is no word to search for.
+     */
+    protected SuggestionResults[] getSuggestionResultsForBatch(final TextInfo[] textInfos,
+            final PrevWordsInfo[] prevWordsInfos) {
+        try {
+            if (!mService.hasMainDictionaryForLocale(mLocale)) {
+                return null;
+            }
+            final Keyboard keyboard = mService.getKeyboardForLocale(mLocale);
+            if (null == keyboard) {
+                return null;
+            }
+            final ArrayList<Integer> batchedIndices = new ArrayList<>();
+            final ArrayList<WordComposer> composers = new ArrayList<>();
+            final ArrayList<PrevWordsInfo> batchedPrevWordsInfos = new ArrayList<>();
+            for (int i = 0; i < textInfos.length; ++i) {
+                final String inText = textInfos[i].getText();
+                if (null != mSuggestionsCache.getSuggestionsFromCache(inText, prevWordsInfos[i])
+                        || CHECKABILITY_CHECKABLE != getCheckabilityInScript(inText, mScript)) {
+                    continue;
+                }
+                final String text = inText.replaceAll(AndroidSpellCheckerService.APOSTROPHE,
+                        AndroidSpellCheckerService.SINGLE_QUOTE);
+                batchedIndices.add(i);
+                composers.add(newComposer(text, keyboard));
+                batchedPrevWordsInfos.add(prevWordsInfos[i]);
+            }
+            if (batchedIndices.isEmpty()) {
+                return null;
+            }
+            final SuggestionResults[] batchedSuggestionResults =
+                    mService.getSuggestionResultsForBatch(mLocale,
+                            composers.toArray(new WordComposer[composers.size()]),
+                            batchedPrevWordsInfos.toArray(
+                                    new PrevWordsInfo[batchedPrevWordsInfos.size()]),
+                            keyboard.getProximityInfo());
+            final SuggestionResults[] suggestionResultsForBatch =
+                    new SuggestionResults[textInfos.length];
+            for (int i = 0; i < batchedIndices.size(); ++i) {
+                suggestionResultsForBatch[batchedIndices.get(i)] = batchedSuggestionResults[i];
+            }
+            return suggestionResultsForBatch;
+        } catch (RuntimeException e) {
+            // The words are checked one by one instead.
+            if (DBG) {
+                throw e;
+            } else {
+                Log.e(TAG, "Exception while spellcheking", e);
+                return null;
+            }
+        }
+    }
+
+    /**
+     * Same as onGetSuggestionsInternal(TextInfo, PrevWordsInfo, int), except that the
+     * dictionaries aren't searched when batchedSuggestionResults is not null, which has to be
+     * the result of getSuggestionResultsForBatch() for the text.
+     */
+    protected SuggestionsInfo onGetSuggestionsInternal(
+            final TextInfo textInfo, final PrevWordsInfo prevWordsInfo,
+            final int suggestionsLimit, final SuggestionResults batchedSuggestionResults) {
         try {
             final String inText = textInfo.getText();
             final SuggestionsParams cachedSuggestionsParams =
@@ -267,23 +335,18 @@ public abstract class AndroidWordLevelSpellCheckerSession extends Session {
                 return AndroidSpellCheckerService.getNotInDictEmptySuggestions(
                         false /* reportAsTypo */);
             }
-            final Keyboard keyboard = mService.getKeyboardForLocale(mLocale);
-            final WordComposer composer = new WordComposer();
-            final int[] codePoints = StringUtils.toCodePointArray(text);
-            final int[] coordinates;
-            final ProximityInfo proximityInfo;
-            if (null == keyboard) {
-                coordinates = CoordinateUtils.newCoordinateArray(codePoints.length,
-                        Constants.NOT_A_COORDINATE, Constants.NOT_A_COORDINATE);
-                proximityInfo = null;
+            final SuggestionResults suggestionResults;
+            if (null != batchedSuggestionResults) {
+                suggestionResults = batchedSuggestionResults;
             } else {
-                coordinates = keyboard.getCoordinates(codePoints);
-                proximityInfo = keyboard.getProximityInfo();
+                final Keyboard keyboard = mService.getKeyboardForLocale(mLocale);
+                final WordComposer composer = newComposer(text, keyboard);
+                final ProximityInfo proximityInfo =
+                        null == keyboard ? null : keyboard.getProximityInfo();
+                // TODO: Don't gather suggestions if the limit is <= 0 unless necessary
+                suggestionResults = mService.getSuggestionResults(
+                        mLocale, composer, prevWordsInfo, proximityInfo);
             }
-            composer.setComposingWord(codePoints, coordinates);
-            // TODO: Don't gather suggestions if the limit is <= 0 unless necessary
-            final SuggestionResults suggestionResults = mService.getSuggestionResults(
-                    mLocale, composer, prevWordsInfo, proximityInfo);
             final Result result = getResult(capitalizeType, mLocale, suggestionsLimit,
                     mService.getRecommendedThreshold(), text, suggestionResults);
             isInDict = isInDictForAnyCapitalization(text, capitalizeType);
@@ -323,6 +386,20 @@ public abstract class AndroidWordLevelSpellCheckerSession extends Session {
         }
     }
 
+    private static WordComposer newComposer(final String text, final Keyboard keyboard) {
+        final WordComposer composer = new WordComposer();
+        final int[] codePoints = StringUtils.toCodePointArray(text);
+        final int[] coordinates;
+        if (null == keyboard) {
+            coordinates = CoordinateUtils.newCoordinateArray(codePoints.length,
+                    Constants.NOT_A_COORDINATE, Constants.NOT_A_COORDINATE);
+        } else {
+            coordinates = keyboard.getCoordinates(codePoints);
+        }
+        composer.setComposingWord(codePoints, coordinates);
+        return composer;
+    }
+
     private static final class Result {
         public final String[] mSuggestions;
         public final boolean mHasRecommendedSuggestions;
@@ -42,6 +42,8 @@ public final class BinaryDictionaryUtils {
 
     private static native boolean createEmptyDictFileNative(String filePath, long dictVersion,
             String locale, String[] attributeKeyStringArray, String[] attributeValueStringArray);
+    private static native boolean convertDictFileNative(String ver2DictFilePath, String filePath,
+            long dictVersion);
     private static native float calcNormalizedScoreNative(int[] before, int[] after, int score);
     private static native int editDistanceNative(int[] before, int[] after);
     private static native int setCurrentTimeForTestNative(int currentTime);
@@ -106,6 +108,16 @@ public final class BinaryDictionaryUtils {
                 valueArray);
     }
 
+    /**
+     * Converts a version 2 dictionary file, which is what the dictionary compiler makes, to a
+     * read-only dictionary file of the given version (FormatSpec.VERSION2_LOUDS).
+     */
+    @UsedForTesting
+    public static boolean convertDictFile(final String ver2DictFilePath, final String filePath,
+            final long dictVersion) {
+        return convertDictFileNative(ver2DictFilePath, filePath, dictVersion);
+    }
+
     public static float calcNormalizedScore(final String before, final String after,
             final int score) {
         return calcNormalizedScoreNative(StringUtils.toCodePointArray(before),
@@ -19,6 +19,8 @@ LOCAL_PATH := $(call my-dir)
 # and the shared library that uses libjni_latinime_common_static.
 FLAG_DBG ?= false
 FLAG_DO_PROFILE ?= false
+# Replaces the global operator new to count allocations. See utils/scoped_allocation_counter.h.
+FLAG_COUNT_ALLOCATIONS ?= false
 
 ######################################
 include $(CLEAR_VARS)
@@ -60,6 +62,11 @@ endif # FLAG_FULL_DBG
 endif # FLAG_DBG
 endif # FLAG_DO_PROFILE
 
+ifeq ($(FLAG_COUNT_ALLOCATIONS), true)
+    $(warning Making allocation counting version of native library)
+    LOCAL_CFLAGS += -DFLAG_COUNT_ALLOCATIONS
+endif # FLAG_COUNT_ALLOCATIONS
+
 LOCAL_MODULE := libjni_latinime_common_static
 LOCAL_MODULE_TAGS := optional
 
@@ -30,10 +30,15 @@ LATIN_IME_CORE_SRC_FILES := \
         dictionary_utils.cpp \
         digraph_utils.cpp \
         error_type_utils.cpp \
+        exact_match_matcher.cpp \
         multi_bigram_map.cpp \
         property/word_property.cpp) \
     $(addprefix suggest/core/layout/, \
         additional_proximity_chars.cpp \
+        char_probability_matrix.cpp \
+        code_point_to_key_index_table.cpp \
+        key_distance_utils.cpp \
+        normal_distribution.cpp \
         proximity_info.cpp \
         proximity_info_params.cpp \
         proximity_info_state.cpp \
@@ -44,9 +49,13 @@ LATIN_IME_CORE_SRC_FILES := \
         suggestion_results.cpp \
         suggestions_output_utils.cpp) \
     $(addprefix suggest/policyimpl/dictionary/, \
+        header/header_attribute_view.cpp \
         header/header_policy.cpp \
         header/header_read_write_utils.cpp \
         structure/dictionary_structure_with_buffer_policy_factory.cpp) \
+    $(addprefix suggest/policyimpl/dictionary/structure/louds/, \
+        louds_dict_writer.cpp \
+        louds_trie_policy.cpp) \
     $(addprefix suggest/policyimpl/dictionary/structure/pt_common/, \
         bigram/bigram_list_read_write_utils.cpp \
         dynamic_pt_gc_event_listeners.cpp \
@@ -54,6 +63,7 @@ LATIN_IME_CORE_SRC_FILES := \
         dynamic_pt_reading_utils.cpp \
         dynamic_pt_updating_helper.cpp \
         dynamic_pt_writing_utils.cpp \
+        first_code_point_lookup_table.cpp \
         patricia_trie_reading_utils.cpp \
         shortcut/shortcut_list_reading_utils.cpp ) \
     $(addprefix suggest/policyimpl/dictionary/structure/v2/, \
@@ -79,12 +89,14 @@ LATIN_IME_CORE_SRC_FILES := \
     $(addprefix suggest/policyimpl/dictionary/utils/, \
         buffer_with_extendable_buffer.cpp \
         byte_array_utils.cpp \
+        checksum_utils.cpp \
         dict_file_writing_utils.cpp \
         file_utils.cpp \
         forgetting_curve_utils.cpp \
         format_utils.cpp \
         mmapped_buffer.cpp \
         sparse_table.cpp \
+        succinct_bit_vector.cpp \
         trie_map.cpp ) \
     suggest/policyimpl/gesture/gesture_suggest_policy_factory.cpp \
     $(addprefix suggest/policyimpl/typing/, \
@@ -93,11 +105,17 @@ LATIN_IME_CORE_SRC_FILES := \
         typing_suggest_policy.cpp \
         typing_traversal.cpp \
         typing_weighting.cpp) \
+    suggest/policyimpl/utils/edit_distance.cpp \
     $(addprefix utils/, \
         autocorrection_threshold_utils.cpp \
         char_utils.cpp \
         jni_data_utils.cpp \
         log_utils.cpp \
+        memory_usage_utils.cpp \
+        scoped_allocation_counter.cpp \
+        suggestion_batch_buffer.cpp \
+        suggestion_buffer.cpp \
+        thread_pool.cpp \
         time_keeper.cpp)
 
 LATIN_IME_CORE_SRC_FILES_BACKWARD_V402 := \
@@ -123,11 +141,33 @@ LATIN_IME_CORE_SRC_FILES += $(LATIN_IME_CORE_SRC_FILES_BACKWARD_V402)
 
 LATIN_IME_CORE_TEST_FILES := \
     defines_test.cpp \
+    suggest/core/layout/code_point_to_key_index_table_test.cpp \
+    suggest/core/layout/key_distance_utils_test.cpp \
     suggest/core/layout/normal_distribution_2d_test.cpp \
+    suggest/core/layout/proximity_info_state_test.cpp \
+    suggest/core/result/suggestion_results_test.cpp \
     suggest/core/dictionary/bloom_filter_test.cpp \
+    suggest/core/dictionary/exact_match_matcher_test.cpp \
+    suggest/policyimpl/dictionary/header/header_policy_test.cpp \
+    suggest/policyimpl/dictionary/structure/dictionary_structure_with_buffer_policy_factory_test.cpp \
+    suggest/policyimpl/dictionary/structure/louds/louds_bigram_list_policy_test.cpp \
+    suggest/policyimpl/dictionary/structure/pt_common/first_code_point_lookup_table_test.cpp \
     suggest/policyimpl/dictionary/structure/v4/content/language_model_dict_content_test.cpp \
     suggest/policyimpl/dictionary/structure/v4/content/probability_entry_test.cpp \
+    suggest/policyimpl/dictionary/structure/v4/ver4_dict_buffers_test.cpp \
+    suggest/policyimpl/dictionary/structure/v4/ver4_patricia_trie_policy_test.cpp \
+    suggest/policyimpl/dictionary/structure/v4/ver4_patricia_trie_writing_helper_test.cpp \
     suggest/policyimpl/dictionary/utils/buffer_with_extendable_buffer_test.cpp \
+    suggest/policyimpl/dictionary/utils/checksum_utils_test.cpp \
+    suggest/policyimpl/dictionary/utils/dict_file_writing_utils_test.cpp \
+    suggest/policyimpl/dictionary/utils/mmapped_buffer_test.cpp \
+    suggest/policyimpl/dictionary/utils/sparse_table_test.cpp \
+    suggest/policyimpl/dictionary/utils/succinct_bit_vector_test.cpp \
     suggest/policyimpl/dictionary/utils/trie_map_test.cpp \
+    suggest/policyimpl/utils/edit_distance_test.cpp \
     utils/autocorrection_threshold_utils_test.cpp \
-    utils/int_array_view_test.cpp
+    utils/char_utils_test.cpp \
+    utils/int_array_view_test.cpp \
+    utils/suggestion_batch_buffer_test.cpp \
+    utils/suggestion_buffer_test.cpp \
+    utils/thread_pool_test.cpp
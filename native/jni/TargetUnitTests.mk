@@ -22,6 +22,7 @@ include $(LOCAL_PATH)/NativeFileList.mk
 #################### Target library for unit test
 LATIN_IME_SRC_DIR := src
 LOCAL_CFLAGS += -std=c++11 -Wno-unused-parameter -Wno-unused-function
+LOCAL_CFLAGS += -DFLAG_COUNT_ALLOCATIONS
 LOCAL_CLANG := true
 LOCAL_C_INCLUDES += $(LOCAL_PATH)/$(LATIN_IME_SRC_DIR)
 LOCAL_MODULE := liblatinime_target_static_for_unittests
@@ -37,8 +38,10 @@ include $(BUILD_STATIC_LIBRARY)
 include $(CLEAR_VARS)
 LATIN_IME_TEST_SRC_DIR := tests
 LOCAL_CFLAGS += -std=c++11 -Wno-unused-parameter -Wno-unused-function
+LOCAL_CFLAGS += -DFLAG_COUNT_ALLOCATIONS
 LOCAL_CLANG := true
 LOCAL_C_INCLUDES += $(LOCAL_PATH)/$(LATIN_IME_SRC_DIR)
+LOCAL_C_INCLUDES += $(LOCAL_PATH)/$(LATIN_IME_TEST_SRC_DIR)
 LOCAL_MODULE := liblatinime_target_unittests
 LOCAL_MODULE_TAGS := tests
 LOCAL_SRC_FILES :=  \
@@ -18,7 +18,8 @@
 
 #include "com_android_inputmethod_latin_BinaryDictionary.h"
 
-#include <cstring> // for memset()
+#include <algorithm>
+#include <cstring> // for memcpy() and memset()
 #include <vector>
 
 #include "defines.h"
@@ -28,12 +29,15 @@
 #include "suggest/core/dictionary/property/unigram_property.h"
 #include "suggest/core/dictionary/property/word_property.h"
 #include "suggest/core/result/suggestion_results.h"
+#include "suggest/core/session/dic_traverse_session.h"
 #include "suggest/core/session/prev_words_info.h"
 #include "suggest/core/suggest_options.h"
 #include "suggest/policyimpl/dictionary/structure/dictionary_structure_with_buffer_policy_factory.h"
 #include "utils/char_utils.h"
 #include "utils/jni_data_utils.h"
 #include "utils/log_utils.h"
+#include "utils/suggestion_batch_buffer.h"
+#include "utils/suggestion_buffer.h"
 #include "utils/time_keeper.h"
 
 namespace latinime {
@@ -174,10 +178,46 @@ static int latinime_BinaryDictionary_getFormatVersion(JNIEnv *env, jclass clazz,
     return headerPolicy->getFormatVersionNumber();
 }
 
+// When the points of the gesture have been streamed to the session, they are used instead of
+// copying the whole trail again. gesturePointsGeneration is the generation the caller got when it
+// streamed the points, so points held from another stream are never used.
+static bool usesStreamedGesturePoints(const DicTraverseSession *const traverseSession,
+        const SuggestOptions *const suggestOptions, const int inputSize,
+        const int gesturePointsGeneration) {
+    return suggestOptions->isGesture() && inputSize > 0
+            && gesturePointsGeneration != DicTraverseSession::NOT_A_GESTURE_POINTS_GENERATION
+            && traverseSession->getGesturePointsGeneration() == gesturePointsGeneration
+            && traverseSession->getGesturePointCount() == inputSize;
+}
+
+static void getSuggestionsOrPredictions(const Dictionary *const dictionary,
+        ProximityInfo *const pInfo, DicTraverseSession *const traverseSession,
+        int *const xCoordinates, int *const yCoordinates, int *const times,
+        int *const pointerIds, int *const inputCodePoints, const int inputSize,
+        const int gesturePointsGeneration, const PrevWordsInfo *const prevWordsInfo,
+        const SuggestOptions *const suggestOptions, const float languageWeight,
+        SuggestionResults *const outSuggestionResults) {
+    if (usesStreamedGesturePoints(traverseSession, suggestOptions, inputSize,
+            gesturePointsGeneration)) {
+        dictionary->getSuggestions(pInfo, traverseSession, traverseSession->getGestureXs(),
+                traverseSession->getGestureYs(), traverseSession->getGestureTimes(),
+                traverseSession->getGesturePointerIds(), inputCodePoints, inputSize,
+                prevWordsInfo, suggestOptions, languageWeight, outSuggestionResults);
+    } else if (suggestOptions->isGesture() || inputSize > 0) {
+        // TODO: Use SuggestionResults to return suggestions.
+        dictionary->getSuggestions(pInfo, traverseSession, xCoordinates, yCoordinates,
+                times, pointerIds, inputCodePoints, inputSize, prevWordsInfo,
+                suggestOptions, languageWeight, outSuggestionResults);
+    } else {
+        dictionary->getPredictions(prevWordsInfo, outSuggestionResults);
+    }
+}
+
 static void latinime_BinaryDictionary_getSuggestions(JNIEnv *env, jclass clazz, jlong dict,
         jlong proximityInfo, jlong dicTraverseSession, jintArray xCoordinatesArray,
         jintArray yCoordinatesArray, jintArray timesArray, jintArray pointerIdsArray,
-        jintArray inputCodePointsArray, jint inputSize, jintArray suggestOptions,
+        jintArray inputCodePointsArray, jint inputSize, jint gesturePointsGeneration,
+        jintArray suggestOptions,
         jobjectArray prevWordCodePointArrays, jbooleanArray isBeginningOfSentenceArray,
         jintArray outSuggestionCount, jintArray outCodePointsArray, jintArray outScoresArray,
         jintArray outSpaceIndicesArray, jintArray outTypesArray,
@@ -194,24 +234,27 @@ static void latinime_BinaryDictionary_getSuggestions(JNIEnv *env, jclass clazz,
     if (!traverseSession) {
         return;
     }
-    // Input values
-    int xCoordinates[inputSize];
-    int yCoordinates[inputSize];
-    int times[inputSize];
-    int pointerIds[inputSize];
-    const jsize inputCodePointsLength = env->GetArrayLength(inputCodePointsArray);
-    int inputCodePoints[inputCodePointsLength];
-    env->GetIntArrayRegion(xCoordinatesArray, 0, inputSize, xCoordinates);
-    env->GetIntArrayRegion(yCoordinatesArray, 0, inputSize, yCoordinates);
-    env->GetIntArrayRegion(timesArray, 0, inputSize, times);
-    env->GetIntArrayRegion(pointerIdsArray, 0, inputSize, pointerIds);
-    env->GetIntArrayRegion(inputCodePointsArray, 0, inputCodePointsLength, inputCodePoints);
-
     const jsize numberOfOptions = env->GetArrayLength(suggestOptions);
     int options[numberOfOptions];
     env->GetIntArrayRegion(suggestOptions, 0, numberOfOptions, options);
     SuggestOptions givenSuggestOptions(options, numberOfOptions);
 
+    // Input values
+    const int inputCoordinatesSize =
+            usesStreamedGesturePoints(traverseSession, &givenSuggestOptions, inputSize,
+                    gesturePointsGeneration) ? 0 : inputSize;
+    int xCoordinates[inputCoordinatesSize];
+    int yCoordinates[inputCoordinatesSize];
+    int times[inputCoordinatesSize];
+    int pointerIds[inputCoordinatesSize];
+    const jsize inputCodePointsLength = env->GetArrayLength(inputCodePointsArray);
+    int inputCodePoints[inputCodePointsLength];
+    env->GetIntArrayRegion(xCoordinatesArray, 0, inputCoordinatesSize, xCoordinates);
+    env->GetIntArrayRegion(yCoordinatesArray, 0, inputCoordinatesSize, yCoordinates);
+    env->GetIntArrayRegion(timesArray, 0, inputCoordinatesSize, times);
+    env->GetIntArrayRegion(pointerIdsArray, 0, inputCoordinatesSize, pointerIds);
+    env->GetIntArrayRegion(inputCodePointsArray, 0, inputCodePointsLength, inputCodePoints);
+
     // Output values
     /* By the way, let's check the output array length here to make sure */
     const jsize outputCodePointsLength = env->GetArrayLength(outCodePointsArray);
@@ -241,19 +284,94 @@ static void latinime_BinaryDictionary_getSuggestions(JNIEnv *env, jclass clazz,
     SuggestionResults suggestionResults(MAX_RESULTS);
     const PrevWordsInfo prevWordsInfo = JniDataUtils::constructPrevWordsInfo(env,
             prevWordCodePointArrays, isBeginningOfSentenceArray);
-    if (givenSuggestOptions.isGesture() || inputSize > 0) {
-        // TODO: Use SuggestionResults to return suggestions.
-        dictionary->getSuggestions(pInfo, traverseSession, xCoordinates, yCoordinates,
-                times, pointerIds, inputCodePoints, inputSize, &prevWordsInfo,
-                &givenSuggestOptions, languageWeight, &suggestionResults);
-    } else {
-        dictionary->getPredictions(&prevWordsInfo, &suggestionResults);
-    }
+    getSuggestionsOrPredictions(dictionary, pInfo, traverseSession, xCoordinates, yCoordinates,
+            times, pointerIds, inputCodePoints, inputSize, gesturePointsGeneration,
+            &prevWordsInfo, &givenSuggestOptions, languageWeight, &suggestionResults);
     suggestionResults.outputSuggestions(env, outSuggestionCount, outCodePointsArray,
             outScoresArray, outSpaceIndicesArray, outTypesArray,
             outAutoCommitFirstWordConfidenceArray, inOutLanguageWeight);
 }
 
+// Same as above but both the input and the output are in the direct buffer laid out as
+// described in SuggestionBuffer, so that no arrays are copied.
+static void latinime_BinaryDictionary_getSuggestionsWithBuffer(JNIEnv *env, jclass clazz,
+        jlong dict, jlong proximityInfo, jlong dicTraverseSession, jobject buffer) {
+    int *const bufferAddress = static_cast<int *>(env->GetDirectBufferAddress(buffer));
+    const jlong bufferCapacity = env->GetDirectBufferCapacity(buffer);
+    if (!bufferAddress || bufferCapacity < static_cast<jlong>(
+            sizeof(int) * (SuggestionBuffer::INPUT_RECORD + 1))) {
+        AKLOGE("Invalid suggestion buffer. capacity: %lld",
+                static_cast<long long>(bufferCapacity));
+        return;
+    }
+    SuggestionBuffer suggestionBuffer(bufferAddress,
+            static_cast<int>(std::min(bufferCapacity / static_cast<jlong>(sizeof(int)),
+                    static_cast<jlong>(S_INT_MAX))));
+    // Assign 0 to the suggestion count here in case of returning earlier in this method.
+    suggestionBuffer.setSuggestionCount(0);
+    Dictionary *dictionary = reinterpret_cast<Dictionary *>(dict);
+    ProximityInfo *pInfo = reinterpret_cast<ProximityInfo *>(proximityInfo);
+    DicTraverseSession *traverseSession =
+            reinterpret_cast<DicTraverseSession *>(dicTraverseSession);
+    if (!dictionary || !traverseSession || !suggestionBuffer.isValid()) {
+        return;
+    }
+    const SuggestOptions givenSuggestOptions(suggestionBuffer.getOptions(),
+            suggestionBuffer.getOptionCount());
+    const int inputSize = suggestionBuffer.getInputSize();
+    // The points are always in the buffer, so that they are there when the streamed points are
+    // not the input.
+    if (suggestionBuffer.getPointCount() < inputSize) {
+        AKLOGE("Invalid point count: %d, inputSize: %d", suggestionBuffer.getPointCount(),
+                inputSize);
+        ASSERT(false);
+        return;
+    }
+    int inputCodePoints[MAX_WORD_LENGTH];
+    suggestionBuffer.getPaddedInputCodePoints(inputCodePoints);
+    SuggestionResults suggestionResults(MAX_RESULTS);
+    const PrevWordsInfo prevWordsInfo = suggestionBuffer.getPrevWordsInfo();
+    getSuggestionsOrPredictions(dictionary, pInfo, traverseSession,
+            suggestionBuffer.getXCoordinates(), suggestionBuffer.getYCoordinates(),
+            suggestionBuffer.getTimes(), suggestionBuffer.getPointerIds(), inputCodePoints,
+            inputSize, suggestionBuffer.getGesturePointsGeneration(), &prevWordsInfo,
+            &givenSuggestOptions, suggestionBuffer.getInputLanguageWeight(), &suggestionResults);
+    suggestionResults.outputSuggestions(&suggestionBuffer);
+}
+
+// Runs the queries of a batch held in the direct buffer laid out as described in
+// SuggestionBatchBuffer, so that checking many words makes only one JNI call.
+static void latinime_BinaryDictionary_getSuggestionsForBatch(JNIEnv *env, jclass clazz,
+        jlong dict, jlong proximityInfo, jlong dicTraverseSession, jobject buffer,
+        jint threadCount) {
+    int *const bufferAddress = static_cast<int *>(env->GetDirectBufferAddress(buffer));
+    const jlong bufferCapacity = env->GetDirectBufferCapacity(buffer);
+    if (!bufferAddress || bufferCapacity < static_cast<jlong>(
+            sizeof(int) * SuggestionBatchBuffer::HEADER_SIZE)) {
+        AKLOGE("Invalid suggestion batch buffer. capacity: %lld",
+                static_cast<long long>(bufferCapacity));
+        return;
+    }
+    SuggestionBatchBuffer batchBuffer(bufferAddress,
+            static_cast<int>(std::min(bufferCapacity / static_cast<jlong>(sizeof(int)),
+                    static_cast<jlong>(S_INT_MAX))));
+    Dictionary *dictionary = reinterpret_cast<Dictionary *>(dict);
+    ProximityInfo *pInfo = reinterpret_cast<ProximityInfo *>(proximityInfo);
+    DicTraverseSession *traverseSession =
+            reinterpret_cast<DicTraverseSession *>(dicTraverseSession);
+    if (!batchBuffer.isValid()) {
+        return;
+    }
+    if (!dictionary || !traverseSession) {
+        // Assign 0 to the suggestion counts so that no query has stale results.
+        for (int i = 0; i < batchBuffer.getQueryCount(); ++i) {
+            batchBuffer.getOutputRecord(i)[SuggestionBuffer::SUGGESTION_COUNT] = 0;
+        }
+        return;
+    }
+    dictionary->getSuggestionsForBatch(pInfo, traverseSession, &batchBuffer, threadCount);
+}
+
 static jint latinime_BinaryDictionary_getProbability(JNIEnv *env, jclass clazz, jlong dict,
         jintArray word) {
     Dictionary *dictionary = reinterpret_cast<Dictionary *>(dict);
@@ -659,9 +777,19 @@ static const JNINativeMethod sMethods[] = {
     },
     {
         const_cast<char *>("getSuggestionsNative"),
-        const_cast<char *>("(JJJ[I[I[I[I[II[I[[I[Z[I[I[I[I[I[I[F)V"),
+        const_cast<char *>("(JJJ[I[I[I[I[III[I[[I[Z[I[I[I[I[I[I[F)V"),
         reinterpret_cast<void *>(latinime_BinaryDictionary_getSuggestions)
     },
+    {
+        const_cast<char *>("getSuggestionsWithBufferNative"),
+        const_cast<char *>("(JJJLjava/nio/ByteBuffer;)V"),
+        reinterpret_cast<void *>(latinime_BinaryDictionary_getSuggestionsWithBuffer)
+    },
+    {
+        const_cast<char *>("getSuggestionsForBatchNative"),
+        const_cast<char *>("(JJJLjava/nio/ByteBuffer;I)V"),
+        reinterpret_cast<void *>(latinime_BinaryDictionary_getSuggestionsForBatch)
+    },
     {
         const_cast<char *>("getProbabilityNative"),
         const_cast<char *>("(J[I)I"),
@@ -56,6 +56,22 @@ static jboolean latinime_BinaryDictionaryUtils_createEmptyDictFile(JNIEnv *env,
             localeCodePoints, &attributeMap);
 }
 
+static jboolean latinime_BinaryDictionaryUtils_convertDictFile(JNIEnv *env, jclass clazz,
+        jstring ver2DictFilePath, jstring filePath, jlong dictVersion) {
+    const jsize ver2DictFilePathUtf8Length = env->GetStringUTFLength(ver2DictFilePath);
+    char ver2DictFilePathChars[ver2DictFilePathUtf8Length + 1];
+    env->GetStringUTFRegion(ver2DictFilePath, 0, env->GetStringLength(ver2DictFilePath),
+            ver2DictFilePathChars);
+    ver2DictFilePathChars[ver2DictFilePathUtf8Length] = '\0';
+
+    const jsize filePathUtf8Length = env->GetStringUTFLength(filePath);
+    char filePathChars[filePathUtf8Length + 1];
+    env->GetStringUTFRegion(filePath, 0, env->GetStringLength(filePath), filePathChars);
+    filePathChars[filePathUtf8Length] = '\0';
+    return DictFileWritingUtils::convertVer2DictFile(ver2DictFilePathChars, filePathChars,
+            static_cast<int>(dictVersion));
+}
+
 static jfloat latinime_BinaryDictionaryUtils_calcNormalizedScore(JNIEnv *env, jclass clazz,
         jintArray before, jintArray after, jint score) {
     jsize beforeLength = env->GetArrayLength(before);
@@ -98,6 +114,11 @@ static const JNINativeMethod sMethods[] = {
                 "(Ljava/lang/String;JLjava/lang/String;[Ljava/lang/String;[Ljava/lang/String;)Z"),
         reinterpret_cast<void *>(latinime_BinaryDictionaryUtils_createEmptyDictFile)
     },
+    {
+        const_cast<char *>("convertDictFileNative"),
+        const_cast<char *>("(Ljava/lang/String;Ljava/lang/String;J)Z"),
+        reinterpret_cast<void *>(latinime_BinaryDictionaryUtils_convertDictFile)
+    },
     {
         const_cast<char *>("calcNormalizedScoreNative"),
         const_cast<char *>("([I[II)F"),
@@ -50,6 +50,35 @@ static void latinime_initDicTraverseSession(JNIEnv *env, jclass clazz, jlong tra
     ts->init(dict, &prevWordsInfo, 0 /* suggestOptions */);
 }
 
+static void latinime_resetGesturePoints(JNIEnv *env, jclass clazz, jlong traverseSession) {
+    DicTraverseSession *ts = reinterpret_cast<DicTraverseSession *>(traverseSession);
+    if (!ts) {
+        return;
+    }
+    ts->resetGesturePoints();
+}
+
+static jint latinime_appendGesturePoints(JNIEnv *env, jclass clazz, jlong traverseSession,
+        jintArray xCoordinatesArray, jintArray yCoordinatesArray, jintArray timesArray,
+        jintArray pointerIdsArray, jint offset, jint pointCount) {
+    DicTraverseSession *ts = reinterpret_cast<DicTraverseSession *>(traverseSession);
+    if (!ts) {
+        return DicTraverseSession::NOT_A_GESTURE_POINTS_GENERATION;
+    }
+    if (pointCount <= 0) {
+        return ts->getGesturePointsGeneration();
+    }
+    int xCoordinates[pointCount];
+    int yCoordinates[pointCount];
+    int times[pointCount];
+    int pointerIds[pointCount];
+    env->GetIntArrayRegion(xCoordinatesArray, offset, pointCount, xCoordinates);
+    env->GetIntArrayRegion(yCoordinatesArray, offset, pointCount, yCoordinates);
+    env->GetIntArrayRegion(timesArray, offset, pointCount, times);
+    env->GetIntArrayRegion(pointerIdsArray, offset, pointCount, pointerIds);
+    return ts->appendGesturePoints(xCoordinates, yCoordinates, times, pointerIds, pointCount);
+}
+
 static void latinime_releaseDicTraverseSession(JNIEnv *env, jclass clazz, jlong traverseSession) {
     DicTraverseSession *ts = reinterpret_cast<DicTraverseSession *>(traverseSession);
     DicTraverseSession::releaseSessionInstance(ts);
@@ -66,6 +95,16 @@ static const JNINativeMethod sMethods[] = {
         const_cast<char *>("(JJ[II)V"),
         reinterpret_cast<void *>(latinime_initDicTraverseSession)
     },
+    {
+        const_cast<char *>("resetGesturePointsNative"),
+        const_cast<char *>("(J)V"),
+        reinterpret_cast<void *>(latinime_resetGesturePoints)
+    },
+    {
+        const_cast<char *>("appendGesturePointsNative"),
+        const_cast<char *>("(J[I[I[I[III)I"),
+        reinterpret_cast<void *>(latinime_appendGesturePoints)
+    },
     {
         const_cast<char *>("releaseDicTraverseSessionNative"),
         const_cast<char *>("(J)V"),
@@ -298,6 +298,8 @@ static inline void prof_out(void) {
 #define NOT_A_COORDINATE (-1)
 #define NOT_AN_INDEX (-1)
 #define NOT_A_PROBABILITY (-1)
+// The probability of a terminal PtNode that hasn't been read from the dictionary yet.
+#define NOT_YET_READ_PROBABILITY (-2)
 #define NOT_A_DICT_POS (S_INT_MIN)
 #define NOT_A_TIMESTAMP (-1)
 #define NOT_A_LANGUAGE_WEIGHT (-1.0f)
@@ -16,6 +16,8 @@
 
 #include "suggest/core/dicnode/dic_node.h"
 
+#include "suggest/core/policy/dictionary_structure_with_buffer_policy.h"
+
 namespace latinime {
 
 DicNode::DicNode(const DicNode &dicNode)
@@ -38,4 +40,13 @@ DicNode &DicNode::operator=(const DicNode &dicNode) {
     return *this;
 }
 
+int DicNode::getProbability(
+        const DictionaryStructureWithBufferPolicy *const dictionaryStructurePolicy) const {
+    const int probability = mDicNodeProperties.getProbability();
+    if (probability != NOT_YET_READ_PROBABILITY) {
+        return probability;
+    }
+    return dictionaryStructurePolicy->getUnigramProbabilityOfPtNode(getPtNodePos());
+}
+
 } // namespace latinime
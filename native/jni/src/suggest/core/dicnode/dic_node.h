@@ -56,6 +56,8 @@
 
 namespace latinime {
 
+class DictionaryStructureWithBufferPolicy;
+
 // This struct is purely a bucket to return values. No instances of this struct should be kept.
 struct DicNode_InputStateG {
     DicNode_InputStateG()
@@ -218,8 +220,17 @@ class DicNode {
         return mDicNodeProperties.getChildrenPtNodeArrayPos();
     }
 
-    int getProbability() const {
-        return mDicNodeProperties.getProbability();
+    // The unigram probability. The DicNodes created while searching don't have it until it's
+    // needed, so it's read from the dictionary when it hasn't been read yet.
+    int getProbability(
+            const DictionaryStructureWithBufferPolicy *const dictionaryStructurePolicy) const;
+
+    bool needsToReadProbability() const {
+        return mDicNodeProperties.getProbability() == NOT_YET_READ_PROBABILITY;
+    }
+
+    void setProbability(const int probability) {
+        mDicNodeProperties.setProbability(probability);
     }
 
     AK_FORCE_INLINE bool isTerminalDicNode() const {
@@ -61,9 +61,31 @@ namespace latinime {
     }
 }
 
+/* static */ void DicNodeUtils::getAllChildDicNodesWithoutProbabilities(const DicNode *dicNode,
+        const DictionaryStructureWithBufferPolicy *const dictionaryStructurePolicy,
+        DicNodeVector *const childDicNodes) {
+    if (dicNode->isTotalInputSizeExceedingLimit()) {
+        return;
+    }
+    if (!dicNode->isLeavingNode()) {
+        childDicNodes->pushPassingChild(dicNode);
+    } else {
+        dictionaryStructurePolicy->createAndGetAllChildDicNodesWithoutProbabilities(dicNode,
+                childDicNodes);
+    }
+}
+
 ///////////////////
 // Scoring utils //
 ///////////////////
+/* static */ void DicNodeUtils::readProbabilityIfNeeded(
+        const DictionaryStructureWithBufferPolicy *const dictionaryStructurePolicy,
+        DicNode *const dicNode) {
+    if (dicNode->needsToReadProbability()) {
+        dicNode->setProbability(dicNode->getProbability(dictionaryStructurePolicy));
+    }
+}
+
 /**
  * Computes the combined bigram / unigram cost for the given dicNode.
  */
@@ -84,7 +106,7 @@ namespace latinime {
 /* static */ int DicNodeUtils::getBigramNodeProbability(
         const DictionaryStructureWithBufferPolicy *const dictionaryStructurePolicy,
         const DicNode *const dicNode, MultiBigramMap *const multiBigramMap) {
-    const int unigramProbability = dicNode->getProbability();
+    const int unigramProbability = dicNode->getProbability(dictionaryStructurePolicy);
     if (multiBigramMap) {
         const int *const prevWordsPtNodePos = dicNode->getPrevWordsTerminalPtNodePos();
         return multiBigramMap->getBigramProbability(dictionaryStructurePolicy,
@@ -38,6 +38,14 @@ class DicNodeUtils {
     static void getAllChildDicNodes(const DicNode *dicNode,
             const DictionaryStructureWithBufferPolicy *const dictionaryStructurePolicy,
             DicNodeVector *childDicNodes);
+    // Same as getAllChildDicNodes() except that the probabilities of the children may not have
+    // been read yet. They are read with readProbabilityIfNeeded().
+    static void getAllChildDicNodesWithoutProbabilities(const DicNode *dicNode,
+            const DictionaryStructureWithBufferPolicy *const dictionaryStructurePolicy,
+            DicNodeVector *childDicNodes);
+    static void readProbabilityIfNeeded(
+            const DictionaryStructureWithBufferPolicy *const dictionaryStructurePolicy,
+            DicNode *const dicNode);
     static float getBigramNodeImprobability(
             const DictionaryStructureWithBufferPolicy *const dictionaryStructurePolicy,
             const DicNode *const dicNode, MultiBigramMap *const multiBigramMap);
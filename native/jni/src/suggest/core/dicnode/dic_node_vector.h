@@ -21,11 +21,34 @@
 
 #include "defines.h"
 #include "suggest/core/dicnode/dic_node.h"
+#include "suggest/core/dictionary/child_pt_node_listener.h"
 
 namespace latinime {
 
 class DicNodeVector {
  public:
+    // Pushes a leaving child of the parent DicNode for each visited PtNode.
+    class LeavingChildPusher : public ChildPtNodeListener {
+     public:
+        LeavingChildPusher(const DicNode *const parentDicNode, DicNodeVector *const childDicNodes)
+                : mParentDicNode(parentDicNode), mChildDicNodes(childDicNodes) {}
+
+        void onVisitChildPtNode(const int ptNodePos, const int childrenPtNodeArrayPos,
+                const int probability, const bool isTerminal, const bool hasChildren,
+                const bool isBlacklistedOrNotAWord, const int codePointCount,
+                const int *const codePoints) {
+            mChildDicNodes->pushLeavingChild(mParentDicNode, ptNodePos, childrenPtNodeArrayPos,
+                    probability, isTerminal, hasChildren, isBlacklistedOrNotAWord,
+                    static_cast<uint16_t>(codePointCount), codePoints);
+        }
+
+     private:
+        DISALLOW_IMPLICIT_CONSTRUCTORS(LeavingChildPusher);
+
+        const DicNode *const mParentDicNode;
+        DicNodeVector *const mChildDicNodes;
+    };
+
 #ifdef FLAG_DBG
     // 0 will introduce resizing the vector.
     static const int DEFAULT_NODES_SIZE_FOR_OPTIMIZATION = 0;
@@ -107,6 +107,10 @@ class DicNodeProperties {
         return mProbability;
     }
 
+    void setProbability(const int probability) {
+        mProbability = probability;
+    }
+
     int getDicNodeCodePoint() const {
         return mDicNodeCodePoint;
     }
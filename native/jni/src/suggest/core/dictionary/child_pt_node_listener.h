@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_CHILD_PT_NODE_LISTENER_H
+#define LATINIME_CHILD_PT_NODE_LISTENER_H
+
+#include "defines.h"
+
+namespace latinime {
+
+/**
+ * Interface to iterate the child PtNodes of a PtNode array without creating DicNodes.
+ */
+class ChildPtNodeListener {
+ public:
+    virtual void onVisitChildPtNode(const int ptNodePos, const int childrenPtNodeArrayPos,
+            const int probability, const bool isTerminal, const bool hasChildren,
+            const bool isBlacklistedOrNotAWord, const int codePointCount,
+            const int *const codePoints) = 0;
+    virtual ~ChildPtNodeListener() {};
+
+ protected:
+    ChildPtNodeListener() {}
+
+ private:
+    DISALLOW_COPY_AND_ASSIGN(ChildPtNodeListener);
+
+};
+} // namespace latinime
+#endif /* LATINIME_CHILD_PT_NODE_LISTENER_H */
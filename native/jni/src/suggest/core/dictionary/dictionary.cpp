@@ -18,6 +18,12 @@
 
 #include "suggest/core/dictionary/dictionary.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
 #include "defines.h"
 #include "suggest/core/dictionary/dictionary_utils.h"
 #include "suggest/core/policy/dictionary_header_structure_policy.h"
@@ -29,17 +35,23 @@
 #include "suggest/policyimpl/gesture/gesture_suggest_policy_factory.h"
 #include "suggest/policyimpl/typing/typing_suggest_policy_factory.h"
 #include "utils/log_utils.h"
+#include "utils/scoped_allocation_counter.h"
+#include "utils/suggestion_batch_buffer.h"
+#include "utils/suggestion_buffer.h"
+#include "utils/thread_pool.h"
 #include "utils/time_keeper.h"
 
 namespace latinime {
 
 const int Dictionary::HEADER_ATTRIBUTE_BUFFER_SIZE = 32;
+const char *const Dictionary::SUGGESTION_ALLOCATION_COUNT_QUERY = "SUGGESTION_ALLOCATION_COUNT";
 
 Dictionary::Dictionary(JNIEnv *env, DictionaryStructureWithBufferPolicy::StructurePolicyPtr
         dictionaryStructureWithBufferPolicy)
         : mDictionaryStructureWithBufferPolicy(std::move(dictionaryStructureWithBufferPolicy)),
           mGestureSuggest(new Suggest(GestureSuggestPolicyFactory::getGestureSuggestPolicy())),
-          mTypingSuggest(new Suggest(TypingSuggestPolicyFactory::getTypingSuggestPolicy())) {
+          mTypingSuggest(new Suggest(TypingSuggestPolicyFactory::getTypingSuggestPolicy())),
+          mSuggestionAllocationCount(ScopedAllocationCounter::NOT_AN_ALLOCATION_COUNT) {
     logDictionaryInfo(env);
 }
 
@@ -49,6 +61,18 @@ void Dictionary::getSuggestions(ProximityInfo *proximityInfo, DicTraverseSession
         const SuggestOptions *const suggestOptions, const float languageWeight,
         SuggestionResults *const outSuggestionResults) const {
     TimeKeeper::setCurrentTime();
+    const ScopedAllocationCounter allocationCounter;
+    getSuggestionsAtCurrentTime(proximityInfo, traverseSession, xcoordinates, ycoordinates, times,
+            pointerIds, inputCodePoints, inputSize, prevWordsInfo, suggestOptions, languageWeight,
+            outSuggestionResults);
+    mSuggestionAllocationCount = allocationCounter.getAllocationCount();
+}
+
+void Dictionary::getSuggestionsAtCurrentTime(ProximityInfo *proximityInfo,
+        DicTraverseSession *traverseSession, int *xcoordinates, int *ycoordinates, int *times,
+        int *pointerIds, int *inputCodePoints, int inputSize,
+        const PrevWordsInfo *const prevWordsInfo, const SuggestOptions *const suggestOptions,
+        const float languageWeight, SuggestionResults *const outSuggestionResults) const {
     traverseSession->init(this, prevWordsInfo, suggestOptions);
     const auto &suggest = suggestOptions->isGesture() ? mGestureSuggest : mTypingSuggest;
     suggest->getSuggestions(proximityInfo, traverseSession, xcoordinates,
@@ -59,6 +83,71 @@ void Dictionary::getSuggestions(ProximityInfo *proximityInfo, DicTraverseSession
     }
 }
 
+void Dictionary::getSuggestionsForBatch(ProximityInfo *proximityInfo,
+        DicTraverseSession *traverseSession, SuggestionBatchBuffer *const batchBuffer,
+        const int threadCount) const {
+    // The current time is shared by the queries so that the threads don't update it.
+    TimeKeeper::setCurrentTime();
+    const std::vector<std::vector<int>> queryGroups = batchBuffer->getQueryGroupsByContext();
+    const int queryGroupCount = static_cast<int>(queryGroups.size());
+    ThreadPool *const threadPool = ThreadPool::getInstance();
+    // More sessions than the pool can run at once would only take memory.
+    const int sessionCount = std::max(1, std::min(std::min(threadCount,
+            threadPool->getWorkerThreadCount() + 1), queryGroupCount));
+    // The pooled sessions are created lazily, so they are taken before running the tasks.
+    std::vector<DicTraverseSession *> sessions(1, traverseSession);
+    for (int i = 1; i < sessionCount; ++i) {
+        sessions.push_back(traverseSession->getPooledSession(i - 1));
+    }
+    std::atomic<int> nextQueryGroupIndex(0);
+    // Each task has its own session. The dictionary and the proximity info are only read during
+    // the search, so the tasks can share them.
+    threadPool->runTasks(sessionCount, [&](const int sessionIndex) {
+        DicTraverseSession *const session = sessions[sessionIndex];
+        session->setKeepsMultiBigramMap(true);
+        for (int groupIndex = nextQueryGroupIndex++; groupIndex < queryGroupCount;
+                groupIndex = nextQueryGroupIndex++) {
+            // The bigram maps cached for the previous group are of no use for this group.
+            session->getMultiBigramMap()->clear();
+            for (const int queryIndex : queryGroups[groupIndex]) {
+                getSuggestionsForQuery(proximityInfo, session, batchBuffer, queryIndex);
+            }
+        }
+        session->setKeepsMultiBigramMap(false);
+    });
+}
+
+void Dictionary::getSuggestionsForQuery(ProximityInfo *proximityInfo,
+        DicTraverseSession *traverseSession, SuggestionBatchBuffer *const batchBuffer,
+        const int queryIndex) const {
+    SuggestionBuffer query(batchBuffer->getOutputRecord(queryIndex),
+            batchBuffer->getInputRecord(queryIndex), batchBuffer->getInputRecordSize(queryIndex));
+    query.setSuggestionCount(0);
+    if (!query.isValid()) {
+        return;
+    }
+    const SuggestOptions suggestOptions(query.getOptions(), query.getOptionCount());
+    const int inputSize = query.getInputSize();
+    // The points are never streamed to the session for the queries of a batch.
+    if (query.getPointCount() < inputSize) {
+        AKLOGE("Invalid point count: %d, inputSize: %d", query.getPointCount(), inputSize);
+        return;
+    }
+    int inputCodePoints[MAX_WORD_LENGTH];
+    query.getPaddedInputCodePoints(inputCodePoints);
+    SuggestionResults suggestionResults(MAX_RESULTS);
+    const PrevWordsInfo prevWordsInfo = query.getPrevWordsInfo();
+    if (suggestOptions.isGesture() || inputSize > 0) {
+        getSuggestionsAtCurrentTime(proximityInfo, traverseSession, query.getXCoordinates(),
+                query.getYCoordinates(), query.getTimes(), query.getPointerIds(),
+                inputCodePoints, inputSize, &prevWordsInfo, &suggestOptions,
+                query.getInputLanguageWeight(), &suggestionResults);
+    } else {
+        getPredictionsAtCurrentTime(&prevWordsInfo, &suggestionResults);
+    }
+    suggestionResults.outputSuggestions(&query);
+}
+
 Dictionary::NgramListenerForPrediction::NgramListenerForPrediction(
         const PrevWordsInfo *const prevWordsInfo, SuggestionResults *const suggestionResults,
         const DictionaryStructureWithBufferPolicy *const dictStructurePolicy)
@@ -90,6 +179,11 @@ void Dictionary::NgramListenerForPrediction::onVisitEntry(const int ngramProbabi
 void Dictionary::getPredictions(const PrevWordsInfo *const prevWordsInfo,
         SuggestionResults *const outSuggestionResults) const {
     TimeKeeper::setCurrentTime();
+    getPredictionsAtCurrentTime(prevWordsInfo, outSuggestionResults);
+}
+
+void Dictionary::getPredictionsAtCurrentTime(const PrevWordsInfo *const prevWordsInfo,
+        SuggestionResults *const outSuggestionResults) const {
     NgramListenerForPrediction listener(prevWordsInfo, outSuggestionResults,
             mDictionaryStructureWithBufferPolicy.get());
     int prevWordsPtNodePos[MAX_PREV_WORD_COUNT_FOR_N_GRAM];
@@ -172,6 +266,11 @@ bool Dictionary::needsToRunGC(const bool mindsBlockByGC) {
 
 void Dictionary::getProperty(const char *const query, const int queryLength, char *const outResult,
         const int maxResultLength) {
+    if (strncmp(query, SUGGESTION_ALLOCATION_COUNT_QUERY, queryLength + 1 /* terminator */)
+            == 0) {
+        snprintf(outResult, maxResultLength, "%d", mSuggestionAllocationCount.load());
+        return;
+    }
     TimeKeeper::setCurrentTime();
     return mDictionaryStructureWithBufferPolicy->getProperty(query, queryLength, outResult,
             maxResultLength);
@@ -17,6 +17,7 @@
 #ifndef LATINIME_DICTIONARY_H
 #define LATINIME_DICTIONARY_H
 
+#include <atomic>
 #include <memory>
 
 #include "defines.h"
@@ -33,6 +34,7 @@ class DictionaryStructureWithBufferPolicy;
 class DicTraverseSession;
 class PrevWordsInfo;
 class ProximityInfo;
+class SuggestionBatchBuffer;
 class SuggestionResults;
 class SuggestOptions;
 
@@ -71,6 +73,14 @@ class Dictionary {
     void getPredictions(const PrevWordsInfo *const prevWordsInfo,
             SuggestionResults *const outSuggestionResults) const;
 
+    // Runs the independent queries of the batch and writes the results to their output records.
+    // The queries that have the same previous words run one after another in one session so that
+    // they share the cached bigram maps. Up to threadCount threads of the ThreadPool run the groups
+    // of queries, each in its own session taken from the pool of traverseSession.
+    void getSuggestionsForBatch(ProximityInfo *proximityInfo,
+            DicTraverseSession *traverseSession, SuggestionBatchBuffer *const batchBuffer,
+            const int threadCount) const;
+
     int getProbability(const int *word, int length) const;
 
     int getMaxProbabilityOfExactMatches(const int *word, int length) const;
@@ -131,13 +141,30 @@ class Dictionary {
     };
 
     static const int HEADER_ATTRIBUTE_BUFFER_SIZE;
+    static const char *const SUGGESTION_ALLOCATION_COUNT_QUERY;
 
     const DictionaryStructureWithBufferPolicy::StructurePolicyPtr
             mDictionaryStructureWithBufferPolicy;
     const SuggestInterfacePtr mGestureSuggest;
     const SuggestInterfacePtr mTypingSuggest;
+    // Heap allocations made by the last getSuggestions() call. They are counted only in builds
+    // with FLAG_COUNT_ALLOCATIONS.
+    mutable std::atomic<int> mSuggestionAllocationCount;
 
     void logDictionaryInfo(JNIEnv *const env) const;
+
+    // Same as getSuggestions() and getPredictions() but use the time set by the caller.
+    void getSuggestionsAtCurrentTime(ProximityInfo *proximityInfo,
+            DicTraverseSession *traverseSession, int *xcoordinates, int *ycoordinates,
+            int *times, int *pointerIds, int *inputCodePoints, int inputSize,
+            const PrevWordsInfo *const prevWordsInfo, const SuggestOptions *const suggestOptions,
+            const float languageWeight, SuggestionResults *const outSuggestionResults) const;
+    void getPredictionsAtCurrentTime(const PrevWordsInfo *const prevWordsInfo,
+            SuggestionResults *const outSuggestionResults) const;
+
+    void getSuggestionsForQuery(ProximityInfo *proximityInfo,
+            DicTraverseSession *traverseSession, SuggestionBatchBuffer *const batchBuffer,
+            const int queryIndex) const;
 };
 } // namespace latinime
 #endif // LATINIME_DICTIONARY_H
@@ -21,6 +21,7 @@
 #include "suggest/core/dicnode/dic_node_vector.h"
 #include "suggest/core/dictionary/dictionary.h"
 #include "suggest/core/dictionary/digraph_utils.h"
+#include "suggest/core/dictionary/exact_match_matcher.h"
 #include "suggest/core/session/prev_words_info.h"
 #include "suggest/core/policy/dictionary_structure_with_buffer_policy.h"
 
@@ -29,6 +30,20 @@ namespace latinime {
 /* static */ int DictionaryUtils::getMaxProbabilityOfExactMatches(
         const DictionaryStructureWithBufferPolicy *const dictionaryStructurePolicy,
         const int *const codePoints, const int codePointCount) {
+    ExactMatchMatcher exactMatchMatcher(dictionaryStructurePolicy);
+    int maxProbability = NOT_A_PROBABILITY;
+    if (exactMatchMatcher.getMaxProbabilityOfExactMatches(codePoints, codePointCount,
+            &maxProbability)) {
+        return maxProbability;
+    }
+    // Too many partial matches for the matcher.
+    return getMaxProbabilityOfExactMatchesWithDicNodes(dictionaryStructurePolicy, codePoints,
+            codePointCount);
+}
+
+/* static */ int DictionaryUtils::getMaxProbabilityOfExactMatchesWithDicNodes(
+        const DictionaryStructureWithBufferPolicy *const dictionaryStructurePolicy,
+        const int *const codePoints, const int codePointCount) {
     std::vector<DicNode> current;
     std::vector<DicNode> next;
 
@@ -60,7 +75,8 @@ namespace latinime {
             continue;
         }
         // dicNode can contain case errors, accent errors, intentional omissions or digraphs.
-        maxProbability = std::max(maxProbability, dicNode.getProbability());
+        maxProbability = std::max(maxProbability,
+                dicNode.getProbability(dictionaryStructurePolicy));
     }
     return maxProbability;
 }
@@ -35,6 +35,10 @@ class DictionaryUtils {
  private:
     DISALLOW_IMPLICIT_CONSTRUCTORS(DictionaryUtils);
 
+    static int getMaxProbabilityOfExactMatchesWithDicNodes(
+            const DictionaryStructureWithBufferPolicy *const dictionaryStructurePolicy,
+            const int *const codePoints, const int codePointCount);
+
     static void processChildDicNodes(
             const DictionaryStructureWithBufferPolicy *const dictionaryStructurePolicy,
             const int inputCodePoint, const DicNode *const parentDicNode,
@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/core/dictionary/exact_match_matcher.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "suggest/core/policy/dictionary_structure_with_buffer_policy.h"
+#include "utils/char_utils.h"
+
+namespace latinime {
+
+ExactMatchMatcher::ExactMatchMatcher(
+        const DictionaryStructureWithBufferPolicy *const dictionaryStructurePolicy)
+        : mDictionaryStructurePolicy(dictionaryStructurePolicy),
+          mHeaderPolicy(dictionaryStructurePolicy->getHeaderStructurePolicy()), mStateCounts(),
+          mNextStatesIndex(0), mCodePointPoolSize(0), mIsOverflowed(false),
+          mParentState(nullptr), mInputCodePoint(NOT_A_CODE_POINT) {}
+
+bool ExactMatchMatcher::getMaxProbabilityOfExactMatches(const int *const codePoints,
+        const int codePointCount, int *const outMaxProbability) {
+    mCodePointPoolSize = 0;
+    mIsOverflowed = false;
+    // The root has no code points and is a leaving state like the root DicNode.
+    State *const rootState = &mStates[0][0];
+    rootState->mChildrenPtNodeArrayPos = mDictionaryStructurePolicy->getRootPosition();
+    rootState->mProbability = NOT_A_PROBABILITY;
+    rootState->mIsTerminal = false;
+    rootState->mHasChildren = true;
+    rootState->mCodePointPoolPos = 0;
+    rootState->mCodePointCount = 0;
+    rootState->mCodePointIndex = -1;
+    rootState->mDepth = 0;
+    rootState->mDigraphIndex = DigraphUtils::NOT_A_DIGRAPH_INDEX;
+    mStateCounts[0] = 1;
+    int currentStatesIndex = 0;
+    for (int i = 0; i < codePointCount; ++i) {
+        mNextStatesIndex = 1 - currentStatesIndex;
+        mStateCounts[mNextStatesIndex] = 0;
+        // The base-lower input is used to ignore case errors and accent errors.
+        mInputCodePoint = CharUtils::toBaseLowerCase(codePoints[i]);
+        for (int j = 0; j < mStateCounts[currentStatesIndex]; ++j) {
+            const State *const state = &mStates[currentStatesIndex][j];
+            if (state->mDigraphIndex != DigraphUtils::NOT_A_DIGRAPH_INDEX
+                    && getNodeCodePoint(state) == mInputCodePoint) {
+                State nextState = *state;
+                nextState.mDigraphIndex = getNextDigraphIndex(nextState.mDigraphIndex);
+                pushNextState(&nextState);
+                continue;
+            }
+            processChildStates(state);
+        }
+        if (mIsOverflowed) {
+            return false;
+        }
+        currentStatesIndex = mNextStatesIndex;
+    }
+
+    int maxProbability = NOT_A_PROBABILITY;
+    for (int j = 0; j < mStateCounts[currentStatesIndex]; ++j) {
+        const State *const state = &mStates[currentStatesIndex][j];
+        if (state->mIsTerminal && state->mDepth > 0 && state->isLeaving()) {
+            maxProbability = std::max(maxProbability, state->mProbability);
+        }
+    }
+    *outMaxProbability = maxProbability;
+    return true;
+}
+
+void ExactMatchMatcher::onVisitChildPtNode(const int ptNodePos, const int childrenPtNodeArrayPos,
+        const int probability, const bool isTerminal, const bool hasChildren,
+        const bool isBlacklistedOrNotAWord, const int codePointCount,
+        const int *const codePoints) {
+    if (mIsOverflowed || codePointCount <= 0) {
+        return;
+    }
+    // Most children can't lead to a match. Skip them before copying their code points.
+    const int nodeCodePoint =
+            getCodePointForDigraphIndex(codePoints[0], mParentState->mDigraphIndex);
+    if (CharUtils::toBaseLowerCase(nodeCodePoint) != mInputCodePoint
+            && !CharUtils::isIntentionalOmissionCodePoint(nodeCodePoint)
+            && !DigraphUtils::hasDigraphForCodePoint(mHeaderPolicy, nodeCodePoint)) {
+        return;
+    }
+    if (mCodePointPoolSize + codePointCount > CODE_POINT_POOL_SIZE) {
+        mIsOverflowed = true;
+        return;
+    }
+    State childState;
+    childState.mChildrenPtNodeArrayPos = childrenPtNodeArrayPos;
+    childState.mProbability = probability;
+    childState.mIsTerminal = isTerminal;
+    childState.mHasChildren = hasChildren;
+    childState.mCodePointPoolPos = mCodePointPoolSize;
+    childState.mCodePointCount = codePointCount;
+    childState.mCodePointIndex = 0;
+    childState.mDepth = mParentState->mDepth + 1;
+    childState.mDigraphIndex = mParentState->mDigraphIndex;
+    memcpy(&mCodePointPool[mCodePointPoolSize], codePoints, sizeof(codePoints[0]) * codePointCount);
+    mCodePointPoolSize += codePointCount;
+    const int nextStateCount = mStateCounts[mNextStatesIndex];
+    processChildState(&childState);
+    if (mStateCounts[mNextStatesIndex] == nextStateCount) {
+        // No state refers to the code points copied for this child.
+        mCodePointPoolSize = childState.mCodePointPoolPos;
+    }
+}
+
+/* static */ DigraphUtils::DigraphCodePointIndex ExactMatchMatcher::getNextDigraphIndex(
+        const DigraphUtils::DigraphCodePointIndex digraphIndex) {
+    switch (digraphIndex) {
+        case DigraphUtils::NOT_A_DIGRAPH_INDEX:
+            return DigraphUtils::FIRST_DIGRAPH_CODEPOINT;
+        case DigraphUtils::FIRST_DIGRAPH_CODEPOINT:
+            return DigraphUtils::SECOND_DIGRAPH_CODEPOINT;
+        case DigraphUtils::SECOND_DIGRAPH_CODEPOINT:
+            return DigraphUtils::NOT_A_DIGRAPH_INDEX;
+    }
+    return DigraphUtils::NOT_A_DIGRAPH_INDEX;
+}
+
+void ExactMatchMatcher::pushNextState(const State *const state) {
+    if (mStateCounts[mNextStatesIndex] >= MAX_STATE_COUNT) {
+        mIsOverflowed = true;
+        return;
+    }
+    mStates[mNextStatesIndex][mStateCounts[mNextStatesIndex]++] = *state;
+}
+
+// Same as DictionaryUtils::processChildDicNodes() for the DicNode of parentState.
+void ExactMatchMatcher::processChildStates(const State *const parentState) {
+    // Same limit as DicNode::isTotalInputSizeExceedingLimit().
+    if (parentState->mDepth > MAX_WORD_LENGTH - 3) {
+        return;
+    }
+    if (!parentState->isLeaving()) {
+        // The passing child is the next code point in the same PtNode.
+        State childState = *parentState;
+        childState.mCodePointIndex += 1;
+        childState.mDepth += 1;
+        processChildState(&childState);
+        return;
+    }
+    if (!parentState->mHasChildren) {
+        return;
+    }
+    const State *const grandparentState = mParentState;
+    mParentState = parentState;
+    mDictionaryStructurePolicy->iterateChildPtNodes(parentState->mChildrenPtNodeArrayPos, this);
+    mParentState = grandparentState;
+}
+
+void ExactMatchMatcher::processChildState(State *const childState) {
+    const int nodeCodePoint = getNodeCodePoint(childState);
+    const int codePoint = CharUtils::toBaseLowerCase(nodeCodePoint);
+    if (mInputCodePoint == codePoint) {
+        pushNextState(childState);
+    }
+    if (CharUtils::isIntentionalOmissionCodePoint(nodeCodePoint)) {
+        processChildStates(childState);
+    }
+    if (DigraphUtils::hasDigraphForCodePoint(mHeaderPolicy, nodeCodePoint)) {
+        childState->mDigraphIndex = getNextDigraphIndex(childState->mDigraphIndex);
+        if (getNodeCodePoint(childState) == codePoint) {
+            childState->mDigraphIndex = getNextDigraphIndex(childState->mDigraphIndex);
+            pushNextState(childState);
+        }
+    }
+}
+
+} // namespace latinime
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_EXACT_MATCH_MATCHER_H
+#define LATINIME_EXACT_MATCH_MATCHER_H
+
+#include "defines.h"
+#include "suggest/core/dictionary/child_pt_node_listener.h"
+#include "suggest/core/dictionary/digraph_utils.h"
+
+namespace latinime {
+
+class DictionaryHeaderStructurePolicy;
+class DictionaryStructureWithBufferPolicy;
+
+/*
+ * Finds the words that match the input except for case errors, accent errors, intentional
+ * omissions and digraphs, and returns the max probability of them. This walks the trie in the same
+ * way as DictionaryUtils does with DicNodes, but each partial match is a small state kept in fixed
+ * size arrays, so no DicNode is created and no memory is allocated.
+ */
+class ExactMatchMatcher : public ChildPtNodeListener {
+ public:
+    ExactMatchMatcher(const DictionaryStructureWithBufferPolicy *const dictionaryStructurePolicy);
+
+    // Returns false when the partial matches don't fit in the matcher. outMaxProbability is not
+    // set in that case.
+    bool getMaxProbabilityOfExactMatches(const int *const codePoints, const int codePointCount,
+            int *const outMaxProbability);
+
+    void onVisitChildPtNode(const int ptNodePos, const int childrenPtNodeArrayPos,
+            const int probability, const bool isTerminal, const bool hasChildren,
+            const bool isBlacklistedOrNotAWord, const int codePointCount,
+            const int *const codePoints);
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(ExactMatchMatcher);
+
+    // A partial match. This has what the matching reads from the corresponding DicNode: the
+    // PtNode, the index of the current code point in the PtNode, the code point count of the word
+    // so far and the digraph index. The code points of the PtNode are in mCodePointPool.
+    class State {
+     public:
+        int mChildrenPtNodeArrayPos;
+        int mProbability;
+        bool mIsTerminal;
+        bool mHasChildren;
+        int mCodePointPoolPos;
+        int mCodePointCount;
+        int mCodePointIndex;
+        int mDepth;
+        DigraphUtils::DigraphCodePointIndex mDigraphIndex;
+
+        bool isLeaving() const {
+            return mCodePointIndex == mCodePointCount - 1;
+        }
+    };
+
+    static const int MAX_STATE_COUNT = 64;
+    static const int CODE_POINT_POOL_SIZE = MAX_WORD_LENGTH * 32;
+
+    const DictionaryStructureWithBufferPolicy *const mDictionaryStructurePolicy;
+    const DictionaryHeaderStructurePolicy *const mHeaderPolicy;
+    State mStates[2][MAX_STATE_COUNT];
+    int mStateCounts[2];
+    int mNextStatesIndex;
+    int mCodePointPool[CODE_POINT_POOL_SIZE];
+    int mCodePointPoolSize;
+    bool mIsOverflowed;
+    // The state whose children are being visited and the base lower case input code point to
+    // match them with.
+    const State *mParentState;
+    int mInputCodePoint;
+
+    static DigraphUtils::DigraphCodePointIndex getNextDigraphIndex(
+            const DigraphUtils::DigraphCodePointIndex digraphIndex);
+
+    static int getCodePointForDigraphIndex(const int codePoint,
+            const DigraphUtils::DigraphCodePointIndex digraphIndex) {
+        if (digraphIndex == DigraphUtils::NOT_A_DIGRAPH_INDEX) {
+            return codePoint;
+        }
+        return DigraphUtils::getDigraphCodePointForIndex(codePoint, digraphIndex);
+    }
+
+    int getNodeCodePoint(const State *const state) const {
+        return getCodePointForDigraphIndex(
+                mCodePointPool[state->mCodePointPoolPos + state->mCodePointIndex],
+                state->mDigraphIndex);
+    }
+
+    void pushNextState(const State *const state);
+    void processChildStates(const State *const parentState);
+    void processChildState(State *const childState);
+};
+} // namespace latinime
+#endif // LATINIME_EXACT_MATCH_MATCHER_H
@@ -45,10 +45,13 @@ class AdditionalProximityChars {
     }
 
  public:
-    static int getAdditionalCharsSize(const char *const localeStr, const int c) {
-        if (!isEnLocale(localeStr)) {
-            return 0;
-        }
+    // The locale is resolved once by this method, and the methods below are only called for
+    // locales that have additional proximity chars.
+    static bool hasAdditionalChars(const char *const localeStr) {
+        return isEnLocale(localeStr);
+    }
+
+    static int getAdditionalCharsSize(const int c) {
         switch (c) {
         case 'a':
             return EN_US_ADDITIONAL_A_SIZE;
@@ -65,10 +68,7 @@ class AdditionalProximityChars {
         }
     }
 
-    static const int *getAdditionalChars(const char *const localeStr, const int c) {
-        if (!isEnLocale(localeStr)) {
-            return 0;
-        }
+    static const int *getAdditionalChars(const int c) {
         switch (c) {
         case 'a':
             return EN_US_ADDITIONAL_A;
@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/core/layout/char_probability_matrix.h"
+
+#include <algorithm>
+
+namespace latinime {
+
+// Valid probabilities and their negative logs never go down to -1.
+const float CharProbabilityMatrix::NOT_A_CHAR_PROBABILITY = -1.0f;
+
+void CharProbabilityMatrix::resize(const int pointCount, const int keyCount) {
+    if (keyCount != mKeyCount) {
+        mProbabilities.clear();
+        mKeyCount = keyCount;
+    }
+    mPointCount = pointCount;
+    mProbabilities.resize(pointCount * getColumnCount(), NOT_A_CHAR_PROBABILITY);
+}
+
+void CharProbabilityMatrix::clearPoint(const int pointIndex) {
+    std::fill(mProbabilities.begin() + getPos(pointIndex, NOT_AN_INDEX),
+            mProbabilities.begin() + getPos(pointIndex + 1, NOT_AN_INDEX),
+            NOT_A_CHAR_PROBABILITY);
+}
+
+} // namespace latinime
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_CHAR_PROBABILITY_MATRIX_H
+#define LATINIME_CHAR_PROBABILITY_MATRIX_H
+
+#include <vector>
+
+#include "defines.h"
+
+namespace latinime {
+
+/*
+ * Probabilities of skipping each sampled input point or mapping it to each key, stored in one
+ * contiguous array of (keyCount + 1) columns per point. Column 0 is for skipping (NOT_AN_INDEX)
+ * and column k + 1 is for the key k. The array is kept across gestures, so it is only reallocated
+ * when a longer gesture comes.
+ */
+class CharProbabilityMatrix {
+ public:
+    CharProbabilityMatrix() : mPointCount(0), mKeyCount(0), mProbabilities() {}
+
+    // Keeps the probabilities of the existing points unless the key count changes. New points
+    // have no probabilities.
+    void resize(const int pointCount, const int keyCount);
+
+    void clear() {
+        mPointCount = 0;
+        mProbabilities.clear();
+    }
+
+    void clearPoint(const int pointIndex);
+
+    // keyIndex is NOT_AN_INDEX for the probability of skipping the point.
+    AK_FORCE_INLINE bool contains(const int pointIndex, const int keyIndex) const {
+        if (pointIndex < 0 || pointIndex >= mPointCount || keyIndex < NOT_AN_INDEX
+                || keyIndex >= mKeyCount) {
+            return false;
+        }
+        return mProbabilities[getPos(pointIndex, keyIndex)] != NOT_A_CHAR_PROBABILITY;
+    }
+
+    AK_FORCE_INLINE float get(const int pointIndex, const int keyIndex) const {
+        ASSERT(contains(pointIndex, keyIndex));
+        return mProbabilities[getPos(pointIndex, keyIndex)];
+    }
+
+    AK_FORCE_INLINE void set(const int pointIndex, const int keyIndex, const float probability) {
+        mProbabilities[getPos(pointIndex, keyIndex)] = probability;
+    }
+
+    AK_FORCE_INLINE void erase(const int pointIndex, const int keyIndex) {
+        mProbabilities[getPos(pointIndex, keyIndex)] = NOT_A_CHAR_PROBABILITY;
+    }
+
+    AK_FORCE_INLINE int getKeyCount() const {
+        return mKeyCount;
+    }
+
+ private:
+    DISALLOW_COPY_AND_ASSIGN(CharProbabilityMatrix);
+
+    static const float NOT_A_CHAR_PROBABILITY;
+
+    int mPointCount;
+    int mKeyCount;
+    std::vector<float> mProbabilities;
+
+    AK_FORCE_INLINE int getColumnCount() const {
+        return mKeyCount + 1 /* skip */;
+    }
+
+    AK_FORCE_INLINE int getPos(const int pointIndex, const int keyIndex) const {
+        return pointIndex * getColumnCount() + keyIndex + 1;
+    }
+};
+} // namespace latinime
+#endif // LATINIME_CHAR_PROBABILITY_MATRIX_H
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/core/layout/code_point_to_key_index_table.h"
+
+#include <algorithm>
+
+namespace latinime {
+
+void CodePointToKeyIndexTable::build(const int *const keyLowerCodePoints, const int keyCount) {
+    ASSERT(keyCount <= MAX_KEY_COUNT_IN_A_KEYBOARD);
+    mSortedLowerCodePointsAndKeyIndices.clear();
+    for (int i = 0; i < keyCount; ++i) {
+        mSortedLowerCodePointsAndKeyIndices.emplace_back(keyLowerCodePoints[i], i);
+    }
+    // Sorts by code point and then by key index, so that the last key wins when the keys are
+    // deduplicated below.
+    std::sort(mSortedLowerCodePointsAndKeyIndices.begin(),
+            mSortedLowerCodePointsAndKeyIndices.end());
+    std::vector<std::pair<int, int>>::iterator it = mSortedLowerCodePointsAndKeyIndices.begin();
+    while (it != mSortedLowerCodePointsAndKeyIndices.end()) {
+        std::vector<std::pair<int, int>>::iterator next = it + 1;
+        if (next != mSortedLowerCodePointsAndKeyIndices.end() && next->first == it->first) {
+            it = mSortedLowerCodePointsAndKeyIndices.erase(it);
+        } else {
+            it = next;
+        }
+    }
+    for (int codePoint = 0; codePoint < DIRECT_TABLE_SIZE; ++codePoint) {
+        mDirectTable[codePoint] = static_cast<int8_t>(
+                getKeyIndexOfLowerCodePoint(CharUtils::toLowerCase(codePoint)));
+    }
+}
+
+int CodePointToKeyIndexTable::getKeyIndexOfLowerCodePoint(const int lowerCodePoint) const {
+    const std::vector<std::pair<int, int>>::const_iterator it = std::lower_bound(
+            mSortedLowerCodePointsAndKeyIndices.begin(), mSortedLowerCodePointsAndKeyIndices.end(),
+            std::make_pair(lowerCodePoint, static_cast<int>(NOT_AN_INDEX)));
+    if (it == mSortedLowerCodePointsAndKeyIndices.end() || it->first != lowerCodePoint) {
+        return NOT_AN_INDEX;
+    }
+    return it->second;
+}
+
+} // namespace latinime
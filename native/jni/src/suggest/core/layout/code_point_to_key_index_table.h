@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_CODE_POINT_TO_KEY_INDEX_TABLE_H
+#define LATINIME_CODE_POINT_TO_KEY_INDEX_TABLE_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "defines.h"
+#include "utils/char_utils.h"
+
+namespace latinime {
+
+/*
+ * Maps code points to the indices of the keys that have their lower case code points. Code points
+ * below DIRECT_TABLE_SIZE, which cover Latin, Greek and Cyrillic letters, are mapped by a direct
+ * table that already takes lower casing into account. The other code points are lower cased and
+ * searched in a sorted array of the key code points.
+ */
+class CodePointToKeyIndexTable {
+ public:
+    CodePointToKeyIndexTable() : mDirectTable(), mSortedLowerCodePointsAndKeyIndices() {
+        for (int i = 0; i < DIRECT_TABLE_SIZE; ++i) {
+            mDirectTable[i] = NOT_AN_INDEX;
+        }
+    }
+
+    // keyLowerCodePoints[i] is the lower case code point of the key i. When some keys have the
+    // same code point, the last one is used.
+    void build(const int *const keyLowerCodePoints, const int keyCount);
+
+    AK_FORCE_INLINE int getKeyIndex(const int codePoint) const {
+        if (codePoint >= 0 && codePoint < DIRECT_TABLE_SIZE) {
+            return mDirectTable[codePoint];
+        }
+        if (codePoint == NOT_A_CODE_POINT) {
+            return NOT_AN_INDEX;
+        }
+        return getKeyIndexOfLowerCodePoint(CharUtils::toLowerCase(codePoint));
+    }
+
+ private:
+    DISALLOW_COPY_AND_ASSIGN(CodePointToKeyIndexTable);
+
+    // U+0000 - U+04FF
+    static const int DIRECT_TABLE_SIZE = 0x500;
+
+    // Key indices are less than MAX_KEY_COUNT_IN_A_KEYBOARD, so they fit in int8_t.
+    int8_t mDirectTable[DIRECT_TABLE_SIZE];
+    std::vector<std::pair<int, int>> mSortedLowerCodePointsAndKeyIndices;
+
+    int getKeyIndexOfLowerCodePoint(const int lowerCodePoint) const;
+};
+} // namespace latinime
+#endif // LATINIME_CODE_POINT_TO_KEY_INDEX_TABLE_H
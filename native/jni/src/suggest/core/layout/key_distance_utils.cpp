@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/core/layout/key_distance_utils.h"
+
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define LATINIME_KEY_DISTANCE_USE_SSE2
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+// 32-bit ARM NEON has no vector division, so only AArch64 is vectorized.
+#include <arm_neon.h>
+#define LATINIME_KEY_DISTANCE_USE_NEON
+#endif
+
+namespace latinime {
+
+/* static */ float KeyDistanceUtils::getNormalizedSquaredDistances(
+        const KeyCenters *const keyCenters, const int keyCount, const float x, const float y,
+        const float squaredMostCommonKeyWidth, float *const outDistances) {
+    float minDistance = static_cast<float>(MAX_VALUE_FOR_WEIGHTING);
+    int keyId = 0;
+#if defined(LATINIME_KEY_DISTANCE_USE_SSE2)
+    const __m128 xs = _mm_set1_ps(x);
+    const __m128 ys = _mm_set1_ps(y);
+    const __m128 divisors = _mm_set1_ps(squaredMostCommonKeyWidth);
+    __m128 minDistances = _mm_set1_ps(minDistance);
+    for (; keyId + 4 <= keyCount; keyId += 4) {
+        const __m128 centerXs = _mm_min_ps(
+                _mm_max_ps(xs, _mm_loadu_ps(keyCenters->centerXMins + keyId)),
+                _mm_loadu_ps(keyCenters->centerXMaxs + keyId));
+        const __m128 centerYs = _mm_max_ps(_mm_loadu_ps(keyCenters->centerYs + keyId),
+                _mm_min_ps(ys, _mm_loadu_ps(keyCenters->bottomYLimits + keyId)));
+        const __m128 deltaXs = _mm_sub_ps(centerXs, xs);
+        const __m128 deltaYs = _mm_sub_ps(centerYs, ys);
+        const __m128 distances = _mm_div_ps(
+                _mm_add_ps(_mm_mul_ps(deltaXs, deltaXs), _mm_mul_ps(deltaYs, deltaYs)),
+                divisors);
+        _mm_storeu_ps(outDistances + keyId, distances);
+        minDistances = _mm_min_ps(minDistances, distances);
+    }
+    float minDistanceLanes[4];
+    _mm_storeu_ps(minDistanceLanes, minDistances);
+    for (const float laneMinDistance : minDistanceLanes) {
+        minDistance = std::min(minDistance, laneMinDistance);
+    }
+#elif defined(LATINIME_KEY_DISTANCE_USE_NEON)
+    const float32x4_t xs = vdupq_n_f32(x);
+    const float32x4_t ys = vdupq_n_f32(y);
+    const float32x4_t divisors = vdupq_n_f32(squaredMostCommonKeyWidth);
+    float32x4_t minDistances = vdupq_n_f32(minDistance);
+    for (; keyId + 4 <= keyCount; keyId += 4) {
+        const float32x4_t centerXs = vminq_f32(
+                vmaxq_f32(xs, vld1q_f32(keyCenters->centerXMins + keyId)),
+                vld1q_f32(keyCenters->centerXMaxs + keyId));
+        const float32x4_t centerYs = vmaxq_f32(vld1q_f32(keyCenters->centerYs + keyId),
+                vminq_f32(ys, vld1q_f32(keyCenters->bottomYLimits + keyId)));
+        const float32x4_t deltaXs = vsubq_f32(centerXs, xs);
+        const float32x4_t deltaYs = vsubq_f32(centerYs, ys);
+        const float32x4_t distances = vdivq_f32(
+                vaddq_f32(vmulq_f32(deltaXs, deltaXs), vmulq_f32(deltaYs, deltaYs)), divisors);
+        vst1q_f32(outDistances + keyId, distances);
+        minDistances = vminq_f32(minDistances, distances);
+    }
+    minDistance = vminvq_f32(minDistances);
+#endif
+    for (; keyId < keyCount; ++keyId) {
+        const float distance = getNormalizedSquaredDistance(keyCenters, keyId, x, y,
+                squaredMostCommonKeyWidth);
+        outDistances[keyId] = distance;
+        minDistance = std::min(minDistance, distance);
+    }
+    return minDistance;
+}
+
+} // namespace latinime
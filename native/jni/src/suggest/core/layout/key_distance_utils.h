@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_KEY_DISTANCE_UTILS_H
+#define LATINIME_KEY_DISTANCE_UTILS_H
+
+#include <algorithm>
+
+#include "defines.h"
+
+namespace latinime {
+
+class KeyDistanceUtils {
+ public:
+    // Key centers in the structure-of-arrays layout used by getNormalizedSquaredDistances().
+    // The center of the key k for a point (x, y) is
+    //   (clamp(x, centerXMins[k], centerXMaxs[k]), max(centerYs[k], min(y, bottomYLimits[k]))).
+    // centerXMins and centerXMaxs differ only for keys wider than the most common key width, and
+    // bottomYLimits is +FLT_MAX for keys extended to the bottom edge of the keyboard and -FLT_MAX
+    // for the others. See ProximityInfo::getKeyCenter{X,Y}OfKeyIdG().
+    struct KeyCenters {
+        float centerXMins[MAX_KEY_COUNT_IN_A_KEYBOARD];
+        float centerXMaxs[MAX_KEY_COUNT_IN_A_KEYBOARD];
+        float centerYs[MAX_KEY_COUNT_IN_A_KEYBOARD];
+        float bottomYLimits[MAX_KEY_COUNT_IN_A_KEYBOARD];
+    };
+
+    // Writes the squared distances from (x, y) to the centers of all keys divided by
+    // squaredMostCommonKeyWidth to outDistances, and returns the minimum of them. The minimum is
+    // MAX_VALUE_FOR_WEIGHTING when keyCount is 0. The vectorized paths use the same operations in
+    // the same order as the scalar one.
+    static float getNormalizedSquaredDistances(const KeyCenters *const keyCenters,
+            const int keyCount, const float x, const float y,
+            const float squaredMostCommonKeyWidth, float *const outDistances);
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(KeyDistanceUtils);
+
+    static AK_FORCE_INLINE float getNormalizedSquaredDistance(
+            const KeyCenters *const keyCenters, const int keyId, const float x, const float y,
+            const float squaredMostCommonKeyWidth) {
+        const float centerX = std::min(std::max(x, keyCenters->centerXMins[keyId]),
+                keyCenters->centerXMaxs[keyId]);
+        const float centerY = std::max(keyCenters->centerYs[keyId],
+                std::min(y, keyCenters->bottomYLimits[keyId]));
+        const float deltaX = centerX - x;
+        const float deltaY = centerY - y;
+        return (deltaX * deltaX + deltaY * deltaY) / squaredMostCommonKeyWidth;
+    }
+};
+} // namespace latinime
+#endif // LATINIME_KEY_DISTANCE_UTILS_H
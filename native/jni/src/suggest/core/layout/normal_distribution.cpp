@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/core/layout/normal_distribution.h"
+
+namespace latinime {
+
+// The error of the linear interpolation of exp(-f) between two entries that are h apart is at most
+// h^2 / 8 * exp(-f) * exp(h). h = 1 / 64 gives 3.1e-5, and the rest is for rounding errors.
+const float NormalDistribution::MAX_RELATIVE_ERROR_OF_APPROXIMATION = 4.0e-5f;
+
+float NormalDistribution::sExpOfNegativeIntegerTable[
+        NormalDistribution::EXP_OF_NEGATIVE_INTEGER_TABLE_SIZE];
+float NormalDistribution::sExpOfNegativeFractionTable[
+        NormalDistribution::EXP_OF_NEGATIVE_FRACTION_TABLE_SIZE];
+const bool NormalDistribution::sAreExpOfNegativeTablesInitialized =
+        NormalDistribution::initializeExpOfNegativeTables();
+
+/* static */ bool NormalDistribution::initializeExpOfNegativeTables() {
+    for (int i = 0; i < EXP_OF_NEGATIVE_INTEGER_TABLE_SIZE; ++i) {
+        sExpOfNegativeIntegerTable[i] = static_cast<float>(exp(-static_cast<double>(i)));
+    }
+    for (int i = 0; i < EXP_OF_NEGATIVE_FRACTION_TABLE_SIZE; ++i) {
+        sExpOfNegativeFractionTable[i] = static_cast<float>(exp(-static_cast<double>(i)
+                / EXP_OF_NEGATIVE_FRACTION_TABLE_ENTRY_COUNT_PER_UNIT));
+    }
+    return true;
+}
+
+} // namespace latinime
@@ -20,6 +20,7 @@
 #include <cmath>
 
 #include "defines.h"
+#include "suggest/core/layout/geometry_utils.h"
 
 namespace latinime {
 
@@ -38,12 +39,61 @@ class NormalDistribution {
                 * expf(mPreComputedExponentPart * GeometryUtils::SQUARE_FLOAT(shiftedX));
     }
 
+    // Returns t such that getProbabilityDensity(x) = getMaxProbabilityDensity() * exp(-t).
+    AK_FORCE_INLINE float getNegativeExponent(const float x) const {
+        const float shiftedX = x - mU;
+        return -mPreComputedExponentPart * GeometryUtils::SQUARE_FLOAT(shiftedX);
+    }
+
+    AK_FORCE_INLINE float getMaxProbabilityDensity() const {
+        return mPreComputedNonExpPart;
+    }
+
+    // Returns exp(-t) for t >= 0 with the relative error of at most
+    // MAX_RELATIVE_ERROR_OF_APPROXIMATION, or 0.0f for t >= MAX_EXP_OF_NEGATIVE_INTEGER_PART + 1.
+    // exp(-t) = exp(-i) * exp(-f), where i and f are the integer part and the fractional part of t.
+    // exp(-i) is looked up in a table, and exp(-f) is linearly interpolated between the entries of
+    // another table.
+    static AK_FORCE_INLINE float getApproximateExpOfNegative(const float t) {
+        // Written so that NaN also returns 0.0f.
+        if (!(t < static_cast<float>(EXP_OF_NEGATIVE_INTEGER_TABLE_SIZE))) {
+            return 0.0f;
+        }
+        const int integerPart = static_cast<int>(t);
+        const float position = (t - static_cast<float>(integerPart))
+                * EXP_OF_NEGATIVE_FRACTION_TABLE_ENTRY_COUNT_PER_UNIT;
+        const int index = static_cast<int>(position);
+        const float fraction = position - static_cast<float>(index);
+        const float expOfNegativeFraction = sExpOfNegativeFractionTable[index]
+                + (sExpOfNegativeFractionTable[index + 1] - sExpOfNegativeFractionTable[index])
+                        * fraction;
+        return sExpOfNegativeIntegerTable[integerPart] * expOfNegativeFraction;
+    }
+
+    static const float MAX_RELATIVE_ERROR_OF_APPROXIMATION;
+
  private:
     DISALLOW_IMPLICIT_CONSTRUCTORS(NormalDistribution);
 
     const float mU; // mean value
     const float mPreComputedNonExpPart; // = 1 / sqrt(2 * PI * sigma^2)
     const float mPreComputedExponentPart; // = -1 / (2 * sigma^2)
+
+    // Densities less than exp(-64) times the density at the mean don't affect the key
+    // probabilities, and cutting them off keeps the products of densities away from denormalized
+    // floats, whose arithmetic is very slow on some CPUs.
+    static const int MAX_EXP_OF_NEGATIVE_INTEGER_PART = 63;
+    static const int EXP_OF_NEGATIVE_INTEGER_TABLE_SIZE = MAX_EXP_OF_NEGATIVE_INTEGER_PART + 1;
+    static const int EXP_OF_NEGATIVE_FRACTION_TABLE_ENTRY_COUNT_PER_UNIT = 64;
+    static const int EXP_OF_NEGATIVE_FRACTION_TABLE_SIZE =
+            EXP_OF_NEGATIVE_FRACTION_TABLE_ENTRY_COUNT_PER_UNIT + 1;
+    // sExpOfNegativeIntegerTable[i] = exp(-i)
+    static float sExpOfNegativeIntegerTable[EXP_OF_NEGATIVE_INTEGER_TABLE_SIZE];
+    // sExpOfNegativeFractionTable[i] = exp(-i / 64)
+    static float sExpOfNegativeFractionTable[EXP_OF_NEGATIVE_FRACTION_TABLE_SIZE];
+    static const bool sAreExpOfNegativeTablesInitialized;
+
+    static bool initializeExpOfNegativeTables();
 };
 } // namespace latinime
 #endif // LATINIME_NORMAL_DISTRIBUTION_H
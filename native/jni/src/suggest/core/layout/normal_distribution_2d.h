@@ -32,7 +32,9 @@ class NormalDistribution2D {
     NormalDistribution2D(const float uX, const float sigmaX, const float uY, const float sigmaY,
             const float theta)
             : mXDistribution(0.0f, sigmaX), mYDistribution(0.0f, sigmaY), mUX(uX), mUY(uY),
-              mSinTheta(sinf(theta)), mCosTheta(cosf(theta)) {}
+              mSinTheta(sinf(theta)), mCosTheta(cosf(theta)),
+              mMaxProbabilityDensity(mXDistribution.getMaxProbabilityDensity()
+                      * mYDistribution.getMaxProbabilityDensity()) {}
 
     float getProbabilityDensity(const float x, const float y) const {
         // Shift
@@ -45,6 +47,20 @@ class NormalDistribution2D {
                 * mYDistribution.getProbabilityDensity(rotatedShiftedY);
     }
 
+    // Same as getProbabilityDensity() but calls NormalDistribution::getApproximateExpOfNegative()
+    // once instead of calling expf() twice. The relative error is at most
+    // NormalDistribution::MAX_RELATIVE_ERROR_OF_APPROXIMATION except that densities less than
+    // exp(-64) times the density at the mean are 0.0f.
+    AK_FORCE_INLINE float getApproximateProbabilityDensity(const float x, const float y) const {
+        const float shiftedX = x - mUX;
+        const float shiftedY = y - mUY;
+        const float rotatedShiftedX = mCosTheta * shiftedX + mSinTheta * shiftedY;
+        const float rotatedShiftedY = -mSinTheta * shiftedX + mCosTheta * shiftedY;
+        return mMaxProbabilityDensity * NormalDistribution::getApproximateExpOfNegative(
+                mXDistribution.getNegativeExponent(rotatedShiftedX)
+                        + mYDistribution.getNegativeExponent(rotatedShiftedY));
+    }
+
  private:
     DISALLOW_IMPLICIT_CONSTRUCTORS(NormalDistribution2D);
 
@@ -54,6 +70,7 @@ class NormalDistribution2D {
     const float mUY;
     const float mSinTheta;
     const float mCosTheta;
+    const float mMaxProbabilityDensity;
 };
 } // namespace latinime
 #endif // LATINIME_NORMAL_DISTRIBUTION_2D_H
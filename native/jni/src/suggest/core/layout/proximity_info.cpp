@@ -19,6 +19,7 @@
 #include "suggest/core/layout/proximity_info.h"
 
 #include <algorithm>
+#include <cfloat>
 #include <cstring>
 #include <cmath>
 
@@ -31,6 +32,16 @@
 
 namespace latinime {
 
+template<typename T>
+static AK_FORCE_INLINE void safeCopyOrFillZeroArray(const T *const array, const int len,
+        T *const buffer) {
+    if (array && buffer) {
+        memmove(buffer, array, len * sizeof(buffer[0]));
+    } else if (buffer) {
+        memset(buffer, 0, len * sizeof(buffer[0]));
+    }
+}
+
 static AK_FORCE_INLINE void safeGetOrFillZeroIntArrayRegion(JNIEnv *env, jintArray jArray,
         jsize len, jint *buffer) {
     if (jArray && buffer) {
@@ -56,22 +67,10 @@ ProximityInfo::ProximityInfo(JNIEnv *env, const jstring localeJStr,
         const jintArray keyYCoordinates, const jintArray keyWidths, const jintArray keyHeights,
         const jintArray keyCharCodes, const jfloatArray sweetSpotCenterXs,
         const jfloatArray sweetSpotCenterYs, const jfloatArray sweetSpotRadii)
-        : GRID_WIDTH(gridWidth), GRID_HEIGHT(gridHeight), MOST_COMMON_KEY_WIDTH(mostCommonKeyWidth),
-          MOST_COMMON_KEY_WIDTH_SQUARE(mostCommonKeyWidth * mostCommonKeyWidth),
-          NORMALIZED_SQUARED_MOST_COMMON_KEY_HYPOTENUSE(1.0f +
-                  GeometryUtils::SQUARE_FLOAT(static_cast<float>(mostCommonKeyHeight) /
-                          static_cast<float>(mostCommonKeyWidth))),
-          CELL_WIDTH((keyboardWidth + gridWidth - 1) / gridWidth),
-          CELL_HEIGHT((keyboardHeight + gridHeight - 1) / gridHeight),
-          KEY_COUNT(std::min(keyCount, MAX_KEY_COUNT_IN_A_KEYBOARD)),
-          KEYBOARD_WIDTH(keyboardWidth), KEYBOARD_HEIGHT(keyboardHeight),
-          KEYBOARD_HYPOTENUSE(hypotf(KEYBOARD_WIDTH, KEYBOARD_HEIGHT)),
-          HAS_TOUCH_POSITION_CORRECTION_DATA(keyCount > 0 && keyXCoordinates && keyYCoordinates
-                  && keyWidths && keyHeights && keyCharCodes && sweetSpotCenterXs
-                  && sweetSpotCenterYs && sweetSpotRadii),
-          mProximityCharsArray(new int[GRID_WIDTH * GRID_HEIGHT * MAX_PROXIMITY_CHARS_SIZE
-                  /* proximityCharsLength */]),
-          mLowerCodePointToKeyMap() {
+        : ProximityInfo(keyboardWidth, keyboardHeight, gridWidth, gridHeight, mostCommonKeyWidth,
+                mostCommonKeyHeight, keyCount, keyCount > 0 && keyXCoordinates && keyYCoordinates
+                        && keyWidths && keyHeights && keyCharCodes && sweetSpotCenterXs
+                        && sweetSpotCenterYs && sweetSpotRadii) {
     /* Let's check the input array length here to make sure */
     const jsize proximityCharsLength = env->GetArrayLength(proximityChars);
     if (proximityCharsLength != GRID_WIDTH * GRID_HEIGHT * MAX_PROXIMITY_CHARS_SIZE) {
@@ -99,11 +98,60 @@ ProximityInfo::ProximityInfo(JNIEnv *env, const jstring localeJStr,
     safeGetOrFillZeroFloatArrayRegion(env, sweetSpotCenterXs, KEY_COUNT, mSweetSpotCenterXs);
     safeGetOrFillZeroFloatArrayRegion(env, sweetSpotCenterYs, KEY_COUNT, mSweetSpotCenterYs);
     safeGetOrFillZeroFloatArrayRegion(env, sweetSpotRadii, KEY_COUNT, mSweetSpotRadii);
-    initializeG();
+    initialize(proximityCharsLength);
 }
 
+ProximityInfo::ProximityInfo(const char *const localeStr, const int keyboardWidth,
+        const int keyboardHeight, const int gridWidth, const int gridHeight,
+        const int mostCommonKeyWidth, const int mostCommonKeyHeight,
+        const int *const proximityChars, const int keyCount, const int *const keyXCoordinates,
+        const int *const keyYCoordinates, const int *const keyWidths,
+        const int *const keyHeights, const int *const keyCharCodes,
+        const float *const sweetSpotCenterXs, const float *const sweetSpotCenterYs,
+        const float *const sweetSpotRadii)
+        : ProximityInfo(keyboardWidth, keyboardHeight, gridWidth, gridHeight, mostCommonKeyWidth,
+                mostCommonKeyHeight, keyCount, keyCount > 0 && keyXCoordinates && keyYCoordinates
+                        && keyWidths && keyHeights && keyCharCodes && sweetSpotCenterXs
+                        && sweetSpotCenterYs && sweetSpotRadii) {
+    const int proximityCharsLength = GRID_WIDTH * GRID_HEIGHT * MAX_PROXIMITY_CHARS_SIZE;
+    memset(mLocaleStr, 0, sizeof(mLocaleStr));
+    strncpy(mLocaleStr, localeStr, MAX_LOCALE_STRING_LENGTH - 1);
+    safeCopyOrFillZeroArray(proximityChars, proximityCharsLength, mProximityCharsArray);
+    safeCopyOrFillZeroArray(keyXCoordinates, KEY_COUNT, mKeyXCoordinates);
+    safeCopyOrFillZeroArray(keyYCoordinates, KEY_COUNT, mKeyYCoordinates);
+    safeCopyOrFillZeroArray(keyWidths, KEY_COUNT, mKeyWidths);
+    safeCopyOrFillZeroArray(keyHeights, KEY_COUNT, mKeyHeights);
+    safeCopyOrFillZeroArray(keyCharCodes, KEY_COUNT, mKeyCodePoints);
+    safeCopyOrFillZeroArray(sweetSpotCenterXs, KEY_COUNT, mSweetSpotCenterXs);
+    safeCopyOrFillZeroArray(sweetSpotCenterYs, KEY_COUNT, mSweetSpotCenterYs);
+    safeCopyOrFillZeroArray(sweetSpotRadii, KEY_COUNT, mSweetSpotRadii);
+    initialize(proximityCharsLength);
+}
+
+ProximityInfo::ProximityInfo(const int keyboardWidth, const int keyboardHeight,
+        const int gridWidth, const int gridHeight, const int mostCommonKeyWidth,
+        const int mostCommonKeyHeight, const int keyCount,
+        const bool hasTouchPositionCorrectionData)
+        : GRID_WIDTH(gridWidth), GRID_HEIGHT(gridHeight), MOST_COMMON_KEY_WIDTH(mostCommonKeyWidth),
+          MOST_COMMON_KEY_WIDTH_SQUARE(mostCommonKeyWidth * mostCommonKeyWidth),
+          NORMALIZED_SQUARED_MOST_COMMON_KEY_HYPOTENUSE(1.0f +
+                  GeometryUtils::SQUARE_FLOAT(static_cast<float>(mostCommonKeyHeight) /
+                          static_cast<float>(mostCommonKeyWidth))),
+          CELL_WIDTH((keyboardWidth + gridWidth - 1) / gridWidth),
+          CELL_HEIGHT((keyboardHeight + gridHeight - 1) / gridHeight),
+          KEY_COUNT(std::min(keyCount, MAX_KEY_COUNT_IN_A_KEYBOARD)),
+          KEYBOARD_WIDTH(keyboardWidth), KEYBOARD_HEIGHT(keyboardHeight),
+          KEYBOARD_HYPOTENUSE(hypotf(KEYBOARD_WIDTH, KEYBOARD_HEIGHT)),
+          HAS_TOUCH_POSITION_CORRECTION_DATA(hasTouchPositionCorrectionData),
+          mProximityCharsArray(new int[GRID_WIDTH * GRID_HEIGHT * MAX_PROXIMITY_CHARS_SIZE
+                  /* proximityCharsLength */]),
+          mProximityKeyIndicesArray(new int[GRID_WIDTH * GRID_HEIGHT * MAX_PROXIMITY_CHARS_SIZE]),
+          mHasAdditionalProximityChars(false), mCodePointToKeyIndexTable(), mKeyCentersG(),
+          mKeyCentersForTyping() {}
+
 ProximityInfo::~ProximityInfo() {
     delete[] mProximityCharsArray;
+    delete[] mProximityKeyIndicesArray;
 }
 
 bool ProximityInfo::hasSpaceProximity(const int x, const int y) const {
@@ -143,6 +191,25 @@ float ProximityInfo::getNormalizedSquaredDistanceFromCenterFloatG(
             / GeometryUtils::SQUARE_FLOAT(static_cast<float>(getMostCommonKeyWidth()));
 }
 
+float ProximityInfo::getNormalizedSquaredDistancesFromCentersFloatG(const int x, const int y,
+        const bool isGeometric, float *const outDistances) const {
+    if (x == NOT_A_COORDINATE || y == NOT_A_COORDINATE) {
+        // The key centers don't depend on the point in this case.
+        float minDistance = static_cast<float>(MAX_VALUE_FOR_WEIGHTING);
+        for (int keyId = 0; keyId < KEY_COUNT; ++keyId) {
+            outDistances[keyId] = getNormalizedSquaredDistanceFromCenterFloatG(keyId, x, y,
+                    isGeometric);
+            minDistance = std::min(minDistance, outDistances[keyId]);
+        }
+        return minDistance;
+    }
+    return KeyDistanceUtils::getNormalizedSquaredDistances(
+            isGeometric ? &mKeyCentersG : &mKeyCentersForTyping, KEY_COUNT,
+            static_cast<float>(x), static_cast<float>(y),
+            GeometryUtils::SQUARE_FLOAT(static_cast<float>(getMostCommonKeyWidth())),
+            outDistances);
+}
+
 int ProximityInfo::getCodePointOf(const int keyIndex) const {
     if (keyIndex < 0 || keyIndex >= KEY_COUNT) {
         return NOT_A_CODE_POINT;
@@ -157,6 +224,12 @@ int ProximityInfo::getOriginalCodePointOf(const int keyIndex) const {
     return mKeyIndexToOriginalCodePoint[keyIndex];
 }
 
+void ProximityInfo::initialize(const int proximityCharsLength) {
+    initializeG();
+    initializeProximityKeyIndices(proximityCharsLength);
+    mHasAdditionalProximityChars = AdditionalProximityChars::hasAdditionalChars(mLocaleStr);
+}
+
 void ProximityInfo::initializeG() {
     // TODO: Optimize
     for (int i = 0; i < KEY_COUNT; ++i) {
@@ -171,10 +244,12 @@ void ProximityInfo::initializeG() {
             const float gapY = sweetSpotCenterY - mCenterYsG[i];
             mSweetSpotCenterYsG[i] = static_cast<int>(mCenterYsG[i] + gapY * verticalScale);
         }
-        mLowerCodePointToKeyMap[lowerCode] = i;
         mKeyIndexToOriginalCodePoint[i] = code;
         mKeyIndexToLowerCodePointG[i] = lowerCode;
     }
+    mCodePointToKeyIndexTable.build(mKeyIndexToLowerCodePointG, KEY_COUNT);
+    initializeKeyCenters(true /* isGeometric */, &mKeyCentersG);
+    initializeKeyCenters(false /* isGeometric */, &mKeyCentersForTyping);
     for (int i = 0; i < KEY_COUNT; i++) {
         mKeyKeyDistancesG[i][i] = 0;
         for (int j = i + 1; j < KEY_COUNT; j++) {
@@ -195,6 +270,32 @@ void ProximityInfo::initializeG() {
     }
 }
 
+// Resolves the keys of the proximity chars of all grid cells, so that computing the proximities of
+// a tap doesn't have to look up the keys for each char.
+void ProximityInfo::initializeProximityKeyIndices(const int proximityCharsLength) {
+    for (int i = 0; i < proximityCharsLength; ++i) {
+        const int c = mProximityCharsArray[i];
+        mProximityKeyIndicesArray[i] = (c < KEYCODE_SPACE) ? NOT_AN_INDEX : getKeyIndexOf(c);
+    }
+}
+
+// Converts the key centers computed by getKeyCenter{X,Y}OfKeyIdG() to the form used by
+// KeyDistanceUtils.
+void ProximityInfo::initializeKeyCenters(const bool isGeometric,
+        KeyDistanceUtils::KeyCenters *const outKeyCenters) const {
+    for (int i = 0; i < KEY_COUNT; ++i) {
+        const int centerX = getKeyCenterXOfKeyIdG(i, NOT_A_COORDINATE, isGeometric);
+        const int keyWidthHalfDiff = (mKeyWidths[i] > getMostCommonKeyWidth())
+                ? (mKeyWidths[i] - getMostCommonKeyWidth()) / 2 : 0;
+        outKeyCenters->centerXMins[i] = static_cast<float>(centerX - keyWidthHalfDiff);
+        outKeyCenters->centerXMaxs[i] = static_cast<float>(centerX + keyWidthHalfDiff);
+        const int centerY = getKeyCenterYOfKeyIdG(i, NOT_A_COORDINATE, isGeometric);
+        outKeyCenters->centerYs[i] = static_cast<float>(centerY);
+        outKeyCenters->bottomYLimits[i] = (centerY + mKeyHeights[i] > KEYBOARD_HEIGHT)
+                ? FLT_MAX : -FLT_MAX;
+    }
+}
+
 // referencePointX is used only for keys wider than most common key width. When the referencePointX
 // is NOT_A_COORDINATE, this method calculates the return value without using the line segment.
 // isGeometric is currently not used because we don't have extra X coordinates sweet spots for
@@ -17,10 +17,10 @@
 #ifndef LATINIME_PROXIMITY_INFO_H
 #define LATINIME_PROXIMITY_INFO_H
 
-#include <unordered_map>
-
 #include "defines.h"
 #include "jni.h"
+#include "suggest/core/layout/code_point_to_key_index_table.h"
+#include "suggest/core/layout/key_distance_utils.h"
 #include "suggest/core/layout/proximity_info_utils.h"
 
 namespace latinime {
@@ -34,10 +34,23 @@ class ProximityInfo {
             const jintArray keyYCoordinates, const jintArray keyWidths, const jintArray keyHeights,
             const jintArray keyCharCodes, const jfloatArray sweetSpotCenterXs,
             const jfloatArray sweetSpotCenterYs, const jfloatArray sweetSpotRadii);
+    // Same as above but takes native arrays, which is for the native tests.
+    ProximityInfo(const char *const localeStr, const int keyboardWidth,
+            const int keyboardHeight, const int gridWidth, const int gridHeight,
+            const int mostCommonKeyWidth, const int mostCommonKeyHeight,
+            const int *const proximityChars, const int keyCount, const int *const keyXCoordinates,
+            const int *const keyYCoordinates, const int *const keyWidths,
+            const int *const keyHeights, const int *const keyCharCodes,
+            const float *const sweetSpotCenterXs, const float *const sweetSpotCenterYs,
+            const float *const sweetSpotRadii);
     ~ProximityInfo();
     bool hasSpaceProximity(const int x, const int y) const;
     float getNormalizedSquaredDistanceFromCenterFloatG(
             const int keyId, const int x, const int y, const bool isGeometric) const;
+    // Fills outDistances with getNormalizedSquaredDistanceFromCenterFloatG() for all keys and
+    // returns the minimum of them.
+    float getNormalizedSquaredDistancesFromCentersFloatG(const int x, const int y,
+            const bool isGeometric, float *const outDistances) const;
     int getCodePointOf(const int keyIndex) const;
     int getOriginalCodePointOf(const int keyIndex) const;
     bool hasSweetSpotData(const int keyIndex) const {
@@ -74,12 +87,12 @@ class ProximityInfo {
             const int inputSize, int *allInputCodes) const {
         ProximityInfoUtils::initializeProximities(inputCodes, inputXCoordinates, inputYCoordinates,
                 inputSize, mKeyXCoordinates, mKeyYCoordinates, mKeyWidths, mKeyHeights,
-                mProximityCharsArray, CELL_HEIGHT, CELL_WIDTH, GRID_WIDTH, MOST_COMMON_KEY_WIDTH,
-                KEY_COUNT, mLocaleStr, &mLowerCodePointToKeyMap, allInputCodes);
+                mProximityCharsArray, mProximityKeyIndicesArray, CELL_HEIGHT, CELL_WIDTH,
+                GRID_WIDTH, MOST_COMMON_KEY_WIDTH, mHasAdditionalProximityChars, allInputCodes);
     }
 
     AK_FORCE_INLINE int getKeyIndexOf(const int c) const {
-        return ProximityInfoUtils::getKeyIndexOf(KEY_COUNT, c, &mLowerCodePointToKeyMap);
+        return mCodePointToKeyIndexTable.getKeyIndex(c);
     }
 
     AK_FORCE_INLINE bool isCodePointOnKeyboard(const int codePoint) const {
@@ -89,7 +102,16 @@ class ProximityInfo {
  private:
     DISALLOW_IMPLICIT_CONSTRUCTORS(ProximityInfo);
 
+    // Initializes the dimensions. The constructors above fill the arrays and call initialize().
+    ProximityInfo(const int keyboardWidth, const int keyboardHeight, const int gridWidth,
+            const int gridHeight, const int mostCommonKeyWidth, const int mostCommonKeyHeight,
+            const int keyCount, const bool hasTouchPositionCorrectionData);
+
+    void initialize(const int proximityCharsLength);
     void initializeG();
+    void initializeProximityKeyIndices(const int proximityCharsLength);
+    void initializeKeyCenters(const bool isGeometric,
+            KeyDistanceUtils::KeyCenters *const outKeyCenters) const;
 
     const int GRID_WIDTH;
     const int GRID_HEIGHT;
@@ -107,6 +129,9 @@ class ProximityInfo {
     static const int MAX_LOCALE_STRING_LENGTH = 10;
     char mLocaleStr[MAX_LOCALE_STRING_LENGTH];
     int *mProximityCharsArray;
+    // The key indices of the chars in mProximityCharsArray.
+    int *mProximityKeyIndicesArray;
+    bool mHasAdditionalProximityChars;
     int mKeyXCoordinates[MAX_KEY_COUNT_IN_A_KEYBOARD];
     int mKeyYCoordinates[MAX_KEY_COUNT_IN_A_KEYBOARD];
     int mKeyWidths[MAX_KEY_COUNT_IN_A_KEYBOARD];
@@ -117,12 +142,14 @@ class ProximityInfo {
     // Sweet spots for geometric input. Note that we have extra sweet spots only for Y coordinates.
     float mSweetSpotCenterYsG[MAX_KEY_COUNT_IN_A_KEYBOARD];
     float mSweetSpotRadii[MAX_KEY_COUNT_IN_A_KEYBOARD];
-    std::unordered_map<int, int> mLowerCodePointToKeyMap;
+    CodePointToKeyIndexTable mCodePointToKeyIndexTable;
     int mKeyIndexToOriginalCodePoint[MAX_KEY_COUNT_IN_A_KEYBOARD];
     int mKeyIndexToLowerCodePointG[MAX_KEY_COUNT_IN_A_KEYBOARD];
     int mCenterXsG[MAX_KEY_COUNT_IN_A_KEYBOARD];
     int mCenterYsG[MAX_KEY_COUNT_IN_A_KEYBOARD];
     int mKeyKeyDistancesG[MAX_KEY_COUNT_IN_A_KEYBOARD][MAX_KEY_COUNT_IN_A_KEYBOARD];
+    KeyDistanceUtils::KeyCenters mKeyCentersG;
+    KeyDistanceUtils::KeyCenters mKeyCentersForTyping;
 };
 } // namespace latinime
 #endif // LATINIME_PROXIMITY_INFO_H
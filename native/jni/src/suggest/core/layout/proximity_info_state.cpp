@@ -21,7 +21,6 @@
 #include <algorithm>
 #include <cstring> // for memset() and memmove()
 #include <sstream> // for debug prints
-#include <unordered_map>
 #include <vector>
 
 #include "defines.h"
@@ -39,15 +38,24 @@ int ProximityInfoState::getPrimaryOriginalCodePointAt(const int index) const {
 }
 
 // TODO: Remove the dependency of "isGeometric"
+// isAppendedInput means the input is the previous input followed by new points, which the caller
+// guarantees when it streams the points of an ongoing gesture. The continuity check over all the
+// saved points is skipped in that case.
 void ProximityInfoState::initInputParams(const int pointerId, const float maxPointToKeyLength,
         const ProximityInfo *proximityInfo, const int *const inputCodes, const int inputSize,
         const int *const xCoordinates, const int *const yCoordinates, const int *const times,
-        const int *const pointerIds, const bool isGeometric) {
+        const int *const pointerIds, const bool isGeometric, const bool isAppendedInput) {
     ASSERT(isGeometric || (inputSize < MAX_WORD_LENGTH));
-    mIsContinuousSuggestionPossible = (mHasBeenUpdatedByGeometricInput != isGeometric) ?
-            false : ProximityInfoStateUtils::checkAndReturnIsContinuousSuggestionPossible(
-                    inputSize, xCoordinates, yCoordinates, times, mSampledInputSize,
-                    &mSampledInputXs, &mSampledInputYs, &mSampledTimes, &mSampledInputIndice);
+    if (mHasBeenUpdatedByGeometricInput != isGeometric) {
+        mIsContinuousSuggestionPossible = false;
+    } else if (isAppendedInput) {
+        mIsContinuousSuggestionPossible = true;
+    } else {
+        mIsContinuousSuggestionPossible =
+                ProximityInfoStateUtils::checkAndReturnIsContinuousSuggestionPossible(
+                        inputSize, xCoordinates, yCoordinates, times, mSampledInputSize,
+                        &mSampledInputXs, &mSampledInputYs, &mSampledTimes, &mSampledInputIndice);
+    }
     if (DEBUG_DICT) {
         AKLOGI("isContinuousSuggestionPossible = %s",
                 (mIsContinuousSuggestionPossible ? "true" : "false"));
@@ -92,10 +100,13 @@ void ProximityInfoState::initInputParams(const int pointerId, const float maxPoi
         mSampledInputIndice.clear();
         mSampledLengthCache.clear();
         mSampledNormalizedSquaredLengthCache.clear();
+        mSampledNearestKeySquaredLengthCache.clear();
         mSampledSearchKeySets.clear();
         mSpeedRates.clear();
         mBeelineSpeedPercentiles.clear();
         mCharProbabilities.clear();
+        mSampledMostProbableKeys.clear();
+        mSampledMostProbableKeyLogProbabilities.clear();
         mDirections.clear();
     }
 
@@ -126,20 +137,25 @@ void ProximityInfoState::initInputParams(const int pointerId, const float maxPoi
     if (mSampledInputSize > 0) {
         ProximityInfoStateUtils::initGeometricDistanceInfos(mProximityInfo, mSampledInputSize,
                 lastSavedInputSize, isGeometric, &mSampledInputXs, &mSampledInputYs,
-                &mSampledNormalizedSquaredLengthCache);
+                &mSampledNormalizedSquaredLengthCache, &mSampledNearestKeySquaredLengthCache);
         if (isGeometric) {
             // updates probabilities of skipping or mapping each key for all points.
             ProximityInfoStateUtils::updateAlignPointProbabilities(
                     mMaxPointToKeyLength, mProximityInfo->getMostCommonKeyWidth(),
                     mProximityInfo->getKeyCount(), lastSavedInputSize, mSampledInputSize,
                     &mSampledInputXs, &mSampledInputYs, &mSpeedRates, &mSampledLengthCache,
-                    &mSampledNormalizedSquaredLengthCache, mProximityInfo, &mCharProbabilities);
+                    &mSampledNormalizedSquaredLengthCache, &mSampledNearestKeySquaredLengthCache,
+                    mProximityInfo, &mCharProbabilities);
             ProximityInfoStateUtils::updateSampledSearchKeySets(mProximityInfo,
                     mSampledInputSize, lastSavedInputSize, &mSampledLengthCache,
                     &mCharProbabilities, &mSampledSearchKeySets,
                     &mSampledSearchKeyVectors);
+            ProximityInfoStateUtils::updateMostProbableKeys(lastSavedInputSize,
+                    mSampledInputSize, &mCharProbabilities, &mSampledMostProbableKeys,
+                    &mSampledMostProbableKeyLogProbabilities);
             mMostProbableStringProbability = ProximityInfoStateUtils::getMostProbableString(
-                    mProximityInfo, mSampledInputSize, &mCharProbabilities, mMostProbableString);
+                    mProximityInfo, mSampledInputSize, &mSampledMostProbableKeys,
+                    &mSampledMostProbableKeyLogProbabilities, mMostProbableString);
 
         }
     }
@@ -297,9 +313,8 @@ bool ProximityInfoState::hasSpaceProximity(const int index) const {
 // Returns a probability of mapping index to keyIndex.
 float ProximityInfoState::getProbability(const int index, const int keyIndex) const {
     ASSERT(0 <= index && index < mSampledInputSize);
-    std::unordered_map<int, float>::const_iterator it = mCharProbabilities[index].find(keyIndex);
-    if (it != mCharProbabilities[index].end()) {
-        return it->second;
+    if (mCharProbabilities.contains(index, keyIndex)) {
+        return mCharProbabilities.get(index, keyIndex);
     }
     return static_cast<float>(MAX_VALUE_FOR_WEIGHTING);
 }
@@ -18,10 +18,10 @@
 #define LATINIME_PROXIMITY_INFO_STATE_H
 
 #include <cstring> // for memset()
-#include <unordered_map>
 #include <vector>
 
 #include "defines.h"
+#include "suggest/core/layout/char_probability_matrix.h"
 #include "suggest/core/layout/proximity_info_params.h"
 #include "suggest/core/layout/proximity_info_state_utils.h"
 
@@ -37,7 +37,8 @@ class ProximityInfoState {
     void initInputParams(const int pointerId, const float maxPointToKeyLength,
             const ProximityInfo *proximityInfo, const int *const inputCodes,
             const int inputSize, const int *xCoordinates, const int *yCoordinates,
-            const int *const times, const int *const pointerIds, const bool isGeometric);
+            const int *const times, const int *const pointerIds, const bool isGeometric,
+            const bool isAppendedInput);
 
     /////////////////////////////////////////
     // Defined here                        //
@@ -49,8 +50,10 @@ class ProximityInfoState {
               mIsContinuousSuggestionPossible(false), mHasBeenUpdatedByGeometricInput(false),
               mSampledInputXs(), mSampledInputYs(), mSampledTimes(), mSampledInputIndice(),
               mSampledLengthCache(), mBeelineSpeedPercentiles(),
-              mSampledNormalizedSquaredLengthCache(), mSpeedRates(), mDirections(),
+              mSampledNormalizedSquaredLengthCache(), mSampledNearestKeySquaredLengthCache(),
+              mSpeedRates(), mDirections(),
               mCharProbabilities(), mSampledSearchKeySets(), mSampledSearchKeyVectors(),
+              mSampledMostProbableKeys(), mSampledMostProbableKeyLogProbabilities(),
               mTouchPositionCorrectionEnabled(false), mSampledInputSize(0),
               mMostProbableStringProbability(0.0f) {
         memset(mInputProximities, 0, sizeof(mInputProximities));
@@ -128,6 +131,10 @@ class ProximityInfoState {
         return mSampledInputYs[index];
     }
 
+    int getInputTime(const int index) const {
+        return mSampledTimes[index];
+    }
+
     int getInputIndexOfSampledPoint(const int sampledIndex) const {
         return mSampledInputIndice[sampledIndex];
     }
@@ -212,16 +219,22 @@ class ProximityInfoState {
     std::vector<int> mSampledLengthCache;
     std::vector<int> mBeelineSpeedPercentiles;
     std::vector<float> mSampledNormalizedSquaredLengthCache;
+    // The minimum of mSampledNormalizedSquaredLengthCache for each sampled point.
+    std::vector<float> mSampledNearestKeySquaredLengthCache;
     std::vector<float> mSpeedRates;
     std::vector<float> mDirections;
     // probabilities of skipping or mapping to a key for each point.
-    std::vector<std::unordered_map<int, float>> mCharProbabilities;
+    CharProbabilityMatrix mCharProbabilities;
     // The vector for the key code set which holds nearby keys of some trailing sampled input points
     // for each sampled input point. These nearby keys contain the next characters which can be in
     // the dictionary. Specifically, currently we are looking for keys nearby trailing sampled
     // inputs including the current input point.
     std::vector<ProximityInfoStateUtils::NearKeycodesSet> mSampledSearchKeySets;
     std::vector<std::vector<int>> mSampledSearchKeyVectors;
+    // The most probable key and its log probability for each point, which are used for
+    // mMostProbableString.
+    std::vector<int> mSampledMostProbableKeys;
+    std::vector<float> mSampledMostProbableKeyLogProbabilities;
     bool mTouchPositionCorrectionEnabled;
     int mInputProximities[MAX_PROXIMITY_CHARS_SIZE * MAX_WORD_LENGTH];
     int mSampledInputSize;
@@ -189,19 +189,18 @@ namespace latinime {
         const int lastSavedInputSize, const bool isGeometric,
         const std::vector<int> *const sampledInputXs,
         const std::vector<int> *const sampledInputYs,
-        std::vector<float> *sampledNormalizedSquaredLengthCache) {
+        std::vector<float> *sampledNormalizedSquaredLengthCache,
+        std::vector<float> *sampledNearestKeySquaredLengthCache) {
     const int keyCount = proximityInfo->getKeyCount();
     sampledNormalizedSquaredLengthCache->resize(sampledInputSize * keyCount);
+    sampledNearestKeySquaredLengthCache->resize(sampledInputSize);
     for (int i = lastSavedInputSize; i < sampledInputSize; ++i) {
-        for (int k = 0; k < keyCount; ++k) {
-            const int index = i * keyCount + k;
-            const int x = (*sampledInputXs)[i];
-            const int y = (*sampledInputYs)[i];
-            const float normalizedSquaredDistance =
-                    proximityInfo->getNormalizedSquaredDistanceFromCenterFloatG(
-                            k, x, y, isGeometric);
-            (*sampledNormalizedSquaredLengthCache)[index] = normalizedSquaredDistance;
-        }
+        // Computes the distances to all keys at once. The nearest one is kept for
+        // updateAlignPointProbabilities().
+        (*sampledNearestKeySquaredLengthCache)[i] =
+                proximityInfo->getNormalizedSquaredDistancesFromCentersFloatG(
+                        (*sampledInputXs)[i], (*sampledInputYs)[i], isGeometric,
+                        sampledNormalizedSquaredLengthCache->data() + i * keyCount);
     }
 }
 
@@ -620,13 +619,24 @@ namespace latinime {
         const std::vector<float> *const sampledSpeedRates,
         const std::vector<int> *const sampledLengthCache,
         const std::vector<float> *const sampledNormalizedSquaredLengthCache,
+        const std::vector<float> *const sampledNearestKeySquaredLengthCache,
         const ProximityInfo *const proximityInfo,
-        std::vector<std::unordered_map<int, float>> *charProbabilities) {
-    charProbabilities->resize(sampledInputSize);
+        CharProbabilityMatrix *const charProbabilities) {
+    charProbabilities->resize(sampledInputSize, keyCount);
+    // The key centers don't depend on the input points.
+    float keyCenterXs[MAX_KEY_COUNT_IN_A_KEYBOARD];
+    float keyCenterYs[MAX_KEY_COUNT_IN_A_KEYBOARD];
+    for (int j = 0; j < keyCount; ++j) {
+        keyCenterXs[j] = static_cast<float>(proximityInfo->getKeyCenterXOfKeyIdG(j,
+                NOT_A_COORDINATE /* referencePointX */, true /* isGeometric */));
+        keyCenterYs[j] = static_cast<float>(proximityInfo->getKeyCenterYOfKeyIdG(j,
+                NOT_A_COORDINATE /* referencePointY */, true /* isGeometric */));
+    }
+    float probabilityDensities[MAX_KEY_COUNT_IN_A_KEYBOARD];
     // Calculates probabilities of using a point as a correlated point with the character
     // for each point.
     for (int i = start; i < sampledInputSize; ++i) {
-        (*charProbabilities)[i].clear();
+        charProbabilities->clearPoint(i);
         // First, calculates skip probability. Starts from MAX_SKIP_PROBABILITY.
         // Note that all values that are multiplied to this probability should be in [0.0, 1.0];
         float skipProbability = ProximityInfoParams::MAX_SKIP_PROBABILITY;
@@ -634,14 +644,10 @@ namespace latinime {
         const float currentAngle = getPointAngle(sampledInputXs, sampledInputYs, i);
         const float speedRate = (*sampledSpeedRates)[i];
 
-        float nearestKeyDistance = static_cast<float>(MAX_VALUE_FOR_WEIGHTING);
-        for (int j = 0; j < keyCount; ++j) {
-            const float distance = getPointToKeyByIdLength(
-                    maxPointToKeyLength, sampledNormalizedSquaredLengthCache, keyCount, i, j);
-            if (distance < nearestKeyDistance) {
-                nearestKeyDistance = distance;
-            }
-        }
+        // Same as the minimum of getPointToKeyByIdLength() over all keys.
+        const float nearestKeyDistance = (keyCount > 0)
+                ? std::min((*sampledNearestKeySquaredLengthCache)[i], maxPointToKeyLength)
+                : static_cast<float>(MAX_VALUE_FOR_WEIGHTING);
 
         if (i == 0) {
             skipProbability *= std::min(1.0f,
@@ -695,7 +701,7 @@ namespace latinime {
         // probabilities must be in [0.0, ProximityInfoParams::MAX_SKIP_PROBABILITY];
         ASSERT(skipProbability >= 0.0f);
         ASSERT(skipProbability <= ProximityInfoParams::MAX_SKIP_PROBABILITY);
-        (*charProbabilities)[i][NOT_AN_INDEX] = skipProbability;
+        charProbabilities->set(i, NOT_AN_INDEX, skipProbability);
 
         // Second, calculates key probabilities by dividing the rest probability
         // (1.0f - skipProbability).
@@ -735,23 +741,25 @@ namespace latinime {
         // Summing up probability densities of all near keys.
         float sumOfProbabilityDensities = 0.0f;
         for (int j = 0; j < keyCount; ++j) {
-            sumOfProbabilityDensities += distribution.getProbabilityDensity(
-                    proximityInfo->getKeyCenterXOfKeyIdG(j,
-                            NOT_A_COORDINATE /* referencePointX */, true /* isGeometric */),
-                    proximityInfo->getKeyCenterYOfKeyIdG(j,
-                            NOT_A_COORDINATE /* referencePointY */, true /* isGeometric */));
+            probabilityDensities[j] = distribution.getApproximateProbabilityDensity(
+                    keyCenterXs[j], keyCenterYs[j]);
+            sumOfProbabilityDensities += probabilityDensities[j];
+        }
+        if (sumOfProbabilityDensities == 0.0f) {
+            // The approximation cuts off tiny densities. Falls back to the exact densities for
+            // points that are far from all keys.
+            for (int j = 0; j < keyCount; ++j) {
+                probabilityDensities[j] = distribution.getProbabilityDensity(
+                        keyCenterXs[j], keyCenterYs[j]);
+                sumOfProbabilityDensities += probabilityDensities[j];
+            }
         }
 
         // Split the probability of an input point to keys that are close to the input point.
         for (int j = 0; j < keyCount; ++j) {
-            const float probabilityDensity = distribution.getProbabilityDensity(
-                    proximityInfo->getKeyCenterXOfKeyIdG(j,
-                            NOT_A_COORDINATE /* referencePointX */, true /* isGeometric */),
-                    proximityInfo->getKeyCenterYOfKeyIdG(j,
-                            NOT_A_COORDINATE /* referencePointY */, true /* isGeometric */));
-            const float probability = inputCharProbability * probabilityDensity
+            const float probability = inputCharProbability * probabilityDensities[j]
                     / sumOfProbabilityDensities;
-            (*charProbabilities)[i][j] = probability;
+            charProbabilities->set(i, j, probability);
         }
     }
 
@@ -763,19 +771,21 @@ namespace latinime {
             sstream << "Speed: "<< (*sampledSpeedRates)[i] << ", ";
             sstream << "Angle: "<< getPointAngle(sampledInputXs, sampledInputYs, i) << ", \n";
 
-            for (std::unordered_map<int, float>::iterator it = (*charProbabilities)[i].begin();
-                    it != (*charProbabilities)[i].end(); ++it) {
-                if (it->first == NOT_AN_INDEX) {
-                    sstream << it->first
+            for (int j = NOT_AN_INDEX; j < keyCount; ++j) {
+                if (!charProbabilities->contains(i, j)) {
+                    continue;
+                }
+                if (j == NOT_AN_INDEX) {
+                    sstream << j
                             << "(skip):"
-                            << it->second
+                            << charProbabilities->get(i, j)
                             << "\n";
                 } else {
-                    sstream << it->first
+                    sstream << j
                             << "("
-                            //<< static_cast<char>(mProximityInfo->getCodePointOf(it->first))
+                            //<< static_cast<char>(mProximityInfo->getCodePointOf(j))
                             << "):"
-                            << it->second
+                            << charProbabilities->get(i, j)
                             << "\n";
                 }
             }
@@ -805,24 +815,24 @@ namespace latinime {
     // Converting from raw probabilities to log probabilities to calculate spatial distance.
     for (int i = start; i < sampledInputSize; ++i) {
         for (int j = 0; j < keyCount; ++j) {
-            std::unordered_map<int, float>::iterator it = (*charProbabilities)[i].find(j);
-            if (it == (*charProbabilities)[i].end()){
+            if (!charProbabilities->contains(i, j)) {
                 continue;
-            } else if(it->second < ProximityInfoParams::MIN_PROBABILITY) {
+            } else if (charProbabilities->get(i, j) < ProximityInfoParams::MIN_PROBABILITY) {
                 // Erases from near keys vector because it has very low probability.
-                (*charProbabilities)[i].erase(j);
+                charProbabilities->erase(i, j);
             } else {
-                it->second = -logf(it->second);
+                charProbabilities->set(i, j, -logf(charProbabilities->get(i, j)));
             }
         }
-        (*charProbabilities)[i][NOT_AN_INDEX] = -logf((*charProbabilities)[i][NOT_AN_INDEX]);
+        charProbabilities->set(i, NOT_AN_INDEX,
+                -logf(charProbabilities->get(i, NOT_AN_INDEX)));
     }
 }
 
 /* static */ void ProximityInfoStateUtils::updateSampledSearchKeySets(
         const ProximityInfo *const proximityInfo, const int sampledInputSize,
         const int lastSavedInputSize, const std::vector<int> *const sampledLengthCache,
-        const std::vector<std::unordered_map<int, float>> *const charProbabilities,
+        const CharProbabilityMatrix *const charProbabilities,
         std::vector<NearKeycodesSet> *sampledSearchKeySets,
         std::vector<std::vector<int>> *sampledSearchKeyVectors) {
     sampledSearchKeySets->resize(sampledInputSize);
@@ -830,7 +840,16 @@ namespace latinime {
     const int readForwordLength = static_cast<int>(
             hypotf(proximityInfo->getKeyboardWidth(), proximityInfo->getKeyboardHeight())
                     * ProximityInfoParams::SEARCH_KEY_RADIUS_RATIO);
-    for (int i = 0; i < sampledInputSize; ++i) {
+    const int keyCount = proximityInfo->getKeyCount();
+    // The key sets of the saved points can only change when a new point is within
+    // readForwordLength. The length cache is monotonically increasing, so they are contiguous.
+    int firstUpdatedIndex = std::min(lastSavedInputSize, sampledInputSize);
+    while (firstUpdatedIndex > 0 && firstUpdatedIndex < sampledInputSize
+            && (*sampledLengthCache)[lastSavedInputSize]
+                    - (*sampledLengthCache)[firstUpdatedIndex - 1] < readForwordLength) {
+        --firstUpdatedIndex;
+    }
+    for (int i = firstUpdatedIndex; i < sampledInputSize; ++i) {
         if (i >= lastSavedInputSize) {
             (*sampledSearchKeySets)[i].reset();
         }
@@ -839,16 +858,14 @@ namespace latinime {
             if ((*sampledLengthCache)[j] - (*sampledLengthCache)[i] >= readForwordLength) {
                 break;
             }
-            for(const auto& charProbability : charProbabilities->at(j)) {
-                if (charProbability.first == NOT_AN_INDEX) {
-                    continue;
+            for (int k = 0; k < keyCount; ++k) {
+                if (charProbabilities->contains(j, k)) {
+                    (*sampledSearchKeySets)[i].set(k);
                 }
-                (*sampledSearchKeySets)[i].set(charProbability.first);
             }
         }
     }
-    const int keyCount = proximityInfo->getKeyCount();
-    for (int i = 0; i < sampledInputSize; ++i) {
+    for (int i = firstUpdatedIndex; i < sampledInputSize; ++i) {
         std::vector<int> *searchKeyVector = &(*sampledSearchKeyVectors)[i];
         searchKeyVector->clear();
         for (int j = 0; j < keyCount; ++j) {
@@ -868,7 +885,7 @@ namespace latinime {
 /* static */ bool ProximityInfoStateUtils::suppressCharProbabilities(const int mostCommonKeyWidth,
         const int sampledInputSize, const std::vector<int> *const lengthCache,
         const int index0, const int index1,
-        std::vector<std::unordered_map<int, float>> *charProbabilities) {
+        CharProbabilityMatrix *const charProbabilities) {
     ASSERT(0 <= index0 && index0 < sampledInputSize);
     ASSERT(0 <= index1 && index1 < sampledInputSize);
     const float keyWidthFloat = static_cast<float>(mostCommonKeyWidth);
@@ -879,23 +896,30 @@ namespace latinime {
     const float suppressionRate = ProximityInfoParams::MIN_SUPPRESSION_RATE
             + diff / keyWidthFloat / ProximityInfoParams::SUPPRESSION_LENGTH_WEIGHT
                     * ProximityInfoParams::SUPPRESSION_WEIGHT;
-    for (std::unordered_map<int, float>::iterator it = (*charProbabilities)[index0].begin();
-            it != (*charProbabilities)[index0].end(); ++it) {
-        std::unordered_map<int, float>::iterator it2 = (*charProbabilities)[index1].find(it->first);
-        if (it2 != (*charProbabilities)[index1].end() && it->second < it2->second) {
-            const float newProbability = it->second * suppressionRate;
-            const float suppression = it->second - newProbability;
-            it->second = newProbability;
-            // mCharProbabilities[index0][NOT_AN_INDEX] is the probability of skipping this point.
-            (*charProbabilities)[index0][NOT_AN_INDEX] += suppression;
+    // Suppressing the skip probability itself doesn't change anything, so only keys are checked.
+    for (int keyIndex = 0; keyIndex < charProbabilities->getKeyCount(); ++keyIndex) {
+        if (!charProbabilities->contains(index0, keyIndex)
+                || !charProbabilities->contains(index1, keyIndex)) {
+            continue;
+        }
+        const float probability0 = charProbabilities->get(index0, keyIndex);
+        const float probability1 = charProbabilities->get(index1, keyIndex);
+        if (probability0 < probability1) {
+            const float newProbability = probability0 * suppressionRate;
+            const float suppression = probability0 - newProbability;
+            charProbabilities->set(index0, keyIndex, newProbability);
+            // The NOT_AN_INDEX column of index0 is the probability of skipping this point.
+            charProbabilities->set(index0, NOT_AN_INDEX,
+                    charProbabilities->get(index0, NOT_AN_INDEX) + suppression);
 
             // Add the probability of the same key nearby index1
+            const float skipProbability1 = charProbabilities->get(index1, NOT_AN_INDEX);
             const float probabilityGain = std::min(suppression
                     * ProximityInfoParams::SUPPRESSION_WEIGHT_FOR_PROBABILITY_GAIN,
-                    (*charProbabilities)[index1][NOT_AN_INDEX]
+                    skipProbability1
                             * ProximityInfoParams::SKIP_PROBABALITY_WEIGHT_FOR_PROBABILITY_GAIN);
-            it2->second += probabilityGain;
-            (*charProbabilities)[index1][NOT_AN_INDEX] -= probabilityGain;
+            charProbabilities->set(index1, keyIndex, probability1 + probabilityGain);
+            charProbabilities->set(index1, NOT_AN_INDEX, skipProbability1 - probabilityGain);
         }
     }
     return true;
@@ -929,11 +953,40 @@ namespace latinime {
     return true;
 }
 
+// Finds the most probable key (or NOT_AN_INDEX for skipping) of each point from start. The
+// probabilities of the points before start are not changed by updateAlignPointProbabilities().
+/* static */ void ProximityInfoStateUtils::updateMostProbableKeys(const int start,
+        const int sampledInputSize, const CharProbabilityMatrix *const charProbabilities,
+        std::vector<int> *const sampledMostProbableKeys,
+        std::vector<float> *const sampledMostProbableKeyLogProbabilities) {
+    sampledMostProbableKeys->resize(sampledInputSize);
+    sampledMostProbableKeyLogProbabilities->resize(sampledInputSize);
+    for (int i = start; i < sampledInputSize; ++i) {
+        float minLogProbability = static_cast<float>(MAX_VALUE_FOR_WEIGHTING);
+        int character = NOT_AN_INDEX;
+        for (int j = NOT_AN_INDEX; j < charProbabilities->getKeyCount(); ++j) {
+            if (!charProbabilities->contains(i, j)) {
+                continue;
+            }
+            const float logProbability = (j != NOT_AN_INDEX)
+                    ? charProbabilities->get(i, j) + ProximityInfoParams::DEMOTION_LOG_PROBABILITY
+                    : charProbabilities->get(i, j);
+            if (logProbability < minLogProbability) {
+                minLogProbability = logProbability;
+                character = j;
+            }
+        }
+        (*sampledMostProbableKeys)[i] = character;
+        (*sampledMostProbableKeyLogProbabilities)[i] = minLogProbability;
+    }
+}
+
 // Get a word that is detected by tracing the most probable string into codePointBuf and
 // returns probability of generating the word.
 /* static */ float ProximityInfoStateUtils::getMostProbableString(
         const ProximityInfo *const proximityInfo, const int sampledInputSize,
-        const std::vector<std::unordered_map<int, float>> *const charProbabilities,
+        const std::vector<int> *const sampledMostProbableKeys,
+        const std::vector<float> *const sampledMostProbableKeyLogProbabilities,
         int *const codePointBuf) {
     ASSERT(sampledInputSize >= 0);
     memset(codePointBuf, 0, sizeof(codePointBuf[0]) * MAX_WORD_LENGTH);
@@ -941,17 +994,8 @@ namespace latinime {
     float sumLogProbability = 0.0f;
     // TODO: Current implementation is greedy algorithm. DP would be efficient for many cases.
     for (int i = 0; i < sampledInputSize && index < MAX_WORD_LENGTH - 1; ++i) {
-        float minLogProbability = static_cast<float>(MAX_VALUE_FOR_WEIGHTING);
-        int character = NOT_AN_INDEX;
-        for (std::unordered_map<int, float>::const_iterator it = (*charProbabilities)[i].begin();
-                it != (*charProbabilities)[i].end(); ++it) {
-            const float logProbability = (it->first != NOT_AN_INDEX)
-                    ? it->second + ProximityInfoParams::DEMOTION_LOG_PROBABILITY : it->second;
-            if (logProbability < minLogProbability) {
-                minLogProbability = logProbability;
-                character = it->first;
-            }
-        }
+        const int character = (*sampledMostProbableKeys)[i];
+        const float minLogProbability = (*sampledMostProbableKeyLogProbabilities)[i];
         if (character != NOT_AN_INDEX) {
             const int codePoint = proximityInfo->getCodePointOf(character);
             if (codePoint == NOT_A_CODE_POINT) {
@@ -22,6 +22,7 @@
 #include <vector>
 
 #include "defines.h"
+#include "suggest/core/layout/char_probability_matrix.h"
 
 namespace latinime {
 class ProximityInfo;
@@ -71,12 +72,13 @@ class ProximityInfoStateUtils {
             const std::vector<float> *const sampledSpeedRates,
             const std::vector<int> *const sampledLengthCache,
             const std::vector<float> *const sampledNormalizedSquaredLengthCache,
+            const std::vector<float> *const sampledNearestKeySquaredLengthCache,
             const ProximityInfo *const proximityInfo,
-            std::vector<std::unordered_map<int, float>> *charProbabilities);
+            CharProbabilityMatrix *const charProbabilities);
     static void updateSampledSearchKeySets(const ProximityInfo *const proximityInfo,
             const int sampledInputSize, const int lastSavedInputSize,
             const std::vector<int> *const sampledLengthCache,
-            const std::vector<std::unordered_map<int, float>> *const charProbabilities,
+            const CharProbabilityMatrix *const charProbabilities,
             std::vector<NearKeycodesSet> *sampledSearchKeySets,
             std::vector<std::vector<int>> *sampledSearchKeyVectors);
     static float getPointToKeyByIdLength(const float maxPointToKeyLength,
@@ -86,7 +88,8 @@ class ProximityInfoStateUtils {
             const int sampledInputSize, const int lastSavedInputSize, const bool isGeometric,
             const std::vector<int> *const sampledInputXs,
             const std::vector<int> *const sampledInputYs,
-            std::vector<float> *sampledNormalizedSquaredLengthCache);
+            std::vector<float> *sampledNormalizedSquaredLengthCache,
+            std::vector<float> *sampledNearestKeySquaredLengthCache);
     static void initPrimaryInputWord(const int inputSize, const int *const inputProximities,
             int *primaryInputWord);
     static void dump(const bool isGeometric, const int inputSize,
@@ -103,9 +106,13 @@ class ProximityInfoStateUtils {
             const std::vector<int> *const sampledTimes,
             const std::vector<int> *const sampledInputIndices);
     // TODO: Move to most_probable_string_utils.h
+    static void updateMostProbableKeys(const int start, const int sampledInputSize,
+            const CharProbabilityMatrix *const charProbabilities,
+            std::vector<int> *const sampledMostProbableKeys,
+            std::vector<float> *const sampledMostProbableKeyLogProbabilities);
     static float getMostProbableString(const ProximityInfo *const proximityInfo,
-            const int sampledInputSize,
-            const std::vector<std::unordered_map<int, float>> *const charProbabilities,
+            const int sampledInputSize, const std::vector<int> *const sampledMostProbableKeys,
+            const std::vector<float> *const sampledMostProbableKeyLogProbabilities,
             int *const codePointBuf);
 
  private:
@@ -147,7 +154,7 @@ class ProximityInfoStateUtils {
             const int index2);
     static bool suppressCharProbabilities(const int mostCommonKeyWidth,
             const int sampledInputSize, const std::vector<int> *const lengthCache, const int index0,
-            const int index1, std::vector<std::unordered_map<int, float>> *charProbabilities);
+            const int index1, CharProbabilityMatrix *const charProbabilities);
     static float calculateSquaredDistanceFromSweetSpotCenter(
             const ProximityInfo *const proximityInfo, const std::vector<int> *const sampledInputXs,
             const std::vector<int> *const sampledInputYs, const int keyIndex,
@@ -18,41 +18,22 @@
 #define LATINIME_PROXIMITY_INFO_UTILS_H
 
 #include <cmath>
-#include <unordered_map>
 
 #include "defines.h"
 #include "suggest/core/layout/additional_proximity_chars.h"
 #include "suggest/core/layout/geometry_utils.h"
-#include "utils/char_utils.h"
 
 namespace latinime {
 class ProximityInfoUtils {
  public:
-    static AK_FORCE_INLINE int getKeyIndexOf(const int keyCount, const int c,
-            const std::unordered_map<int, int> *const codeToKeyMap) {
-        if (keyCount == 0) {
-            // We do not have the coordinate data
-            return NOT_AN_INDEX;
-        }
-        if (c == NOT_A_CODE_POINT) {
-            return NOT_AN_INDEX;
-        }
-        const int lowerCode = CharUtils::toLowerCase(c);
-        std::unordered_map<int, int>::const_iterator mapPos = codeToKeyMap->find(lowerCode);
-        if (mapPos != codeToKeyMap->end()) {
-            return mapPos->second;
-        }
-        return NOT_AN_INDEX;
-    }
-
     static AK_FORCE_INLINE void initializeProximities(const int *const inputCodes,
             const int *const inputXCoordinates, const int *const inputYCoordinates,
             const int inputSize, const int *const keyXCoordinates,
             const int *const keyYCoordinates, const int *const keyWidths, const int *keyHeights,
-            const int *const proximityCharsArray, const int cellHeight, const int cellWidth,
-            const int gridWidth, const int mostCommonKeyWidth, const int keyCount,
-            const char *const localeStr,
-            const std::unordered_map<int, int> *const codeToKeyMap, int *inputProximities) {
+            const int *const proximityCharsArray, const int *const proximityKeyIndicesArray,
+            const int cellHeight, const int cellWidth, const int gridWidth,
+            const int mostCommonKeyWidth, const bool hasAdditionalProximityChars,
+            int *inputProximities) {
         // Initialize
         // - mInputCodes
         // - mNormalizedSquaredDistances
@@ -63,8 +44,9 @@ class ProximityInfoUtils {
             const int y = inputYCoordinates[i];
             int *proximities = &inputProximities[i * MAX_PROXIMITY_CHARS_SIZE];
             calculateProximities(keyXCoordinates, keyYCoordinates, keyWidths, keyHeights,
-                    proximityCharsArray, cellHeight, cellWidth, gridWidth, mostCommonKeyWidth,
-                    keyCount, x, y, primaryKey, localeStr, codeToKeyMap, proximities);
+                    proximityCharsArray, proximityKeyIndicesArray, cellHeight, cellWidth,
+                    gridWidth, mostCommonKeyWidth, x, y, primaryKey, hasAdditionalProximityChars,
+                    proximities);
         }
 
         if (DEBUG_PROXIMITY_CHARS) {
@@ -141,10 +123,10 @@ class ProximityInfoUtils {
 
     static AK_FORCE_INLINE void calculateProximities(const int *const keyXCoordinates,
             const int *const keyYCoordinates, const int *const keyWidths, const int *keyHeights,
-            const int *const proximityCharsArray, const int cellHeight, const int cellWidth,
-            const int gridWidth, const int mostCommonKeyWidth, const int keyCount,
-            const int x, const int y, const int primaryKey, const char *const localeStr,
-            const std::unordered_map<int, int> *const codeToKeyMap, int *proximities) {
+            const int *const proximityCharsArray, const int *const proximityKeyIndicesArray,
+            const int cellHeight, const int cellWidth, const int gridWidth,
+            const int mostCommonKeyWidth, const int x, const int y, const int primaryKey,
+            const bool hasAdditionalProximityChars, int *proximities) {
         const int mostCommonKeyWidthSquare = mostCommonKeyWidth * mostCommonKeyWidth;
         int insertPos = 0;
         proximities[insertPos++] = primaryKey;
@@ -161,7 +143,8 @@ class ProximityInfoUtils {
                 if (c < KEYCODE_SPACE || c == primaryKey) {
                     continue;
                 }
-                const int keyIndex = getKeyIndexOf(keyCount, c, codeToKeyMap);
+                // The key index of each proximity char is resolved when the keyboard is created.
+                const int keyIndex = proximityKeyIndicesArray[startIndex + i];
                 const bool onKey = isOnKey(keyXCoordinates, keyYCoordinates, keyWidths, keyHeights,
                         keyIndex, x, y);
                 const int distance = squaredLengthToEdge(keyXCoordinates, keyYCoordinates,
@@ -176,8 +159,8 @@ class ProximityInfoUtils {
                     }
                 }
             }
-            const int additionalProximitySize =
-                    AdditionalProximityChars::getAdditionalCharsSize(localeStr, primaryKey);
+            const int additionalProximitySize = hasAdditionalProximityChars
+                    ? AdditionalProximityChars::getAdditionalCharsSize(primaryKey) : 0;
             if (additionalProximitySize > 0) {
                 proximities[insertPos++] = ADDITIONAL_PROXIMITY_CHAR_DELIMITER_CODE;
                 if (insertPos >= MAX_PROXIMITY_CHARS_SIZE) {
@@ -188,7 +171,7 @@ class ProximityInfoUtils {
                 }
 
                 const int *additionalProximityChars =
-                        AdditionalProximityChars::getAdditionalChars(localeStr, primaryKey);
+                        AdditionalProximityChars::getAdditionalChars(primaryKey);
                 for (int j = 0; j < additionalProximitySize; ++j) {
                     const int ac = additionalProximityChars[j];
                     int k = 0;
@@ -24,6 +24,7 @@
 
 namespace latinime {
 
+class ChildPtNodeListener;
 class DicNode;
 class DicNodeVector;
 class DictionaryHeaderStructurePolicy;
@@ -47,6 +48,17 @@ class DictionaryStructureWithBufferPolicy {
     virtual void createAndGetAllChildDicNodes(const DicNode *const dicNode,
             DicNodeVector *const childDicNodes) const = 0;
 
+    // Same as createAndGetAllChildDicNodes() except that the probabilities of the children may be
+    // NOT_YET_READ_PROBABILITY, which are read with getUnigramProbabilityOfPtNode() when they
+    // are needed.
+    virtual void createAndGetAllChildDicNodesWithoutProbabilities(const DicNode *const dicNode,
+            DicNodeVector *const childDicNodes) const = 0;
+
+    // Visits the PtNodes in the PtNode array that createAndGetAllChildDicNodes() creates DicNodes
+    // for, with the same values.
+    virtual void iterateChildPtNodes(const int ptNodeArrayPos,
+            ChildPtNodeListener *const listener) const = 0;
+
     virtual int getCodePointsAndProbabilityAndReturnCodePointCount(
             const int nodePos, const int maxCodePointCount, int *const outCodePoints,
             int *const outUnigramProbability) const = 0;
@@ -60,6 +72,10 @@ class DictionaryStructureWithBufferPolicy {
     virtual int getProbabilityOfPtNode(const int *const prevWordsPtNodePos,
             const int nodePos) const = 0;
 
+    // Returns the unigram probability that createAndGetAllChildDicNodes() gives to the DicNode
+    // of the PtNode.
+    virtual int getUnigramProbabilityOfPtNode(const int ptNodePos) const = 0;
+
     virtual void iterateNgramEntries(const int *const prevWordsPtNodePos,
             NgramListener *const listener) const = 0;
 
@@ -17,41 +17,51 @@
 #ifndef LATINIME_SUGGESTED_WORD_H
 #define LATINIME_SUGGESTED_WORD_H
 
-#include <vector>
+#include <cstring>
 
 #include "defines.h"
 #include "suggest/core/dictionary/dictionary.h"
 
 namespace latinime {
 
+// A suggestion held by SuggestionResults. The code points are stored inline so that holding a
+// suggestion never allocates.
 class SuggestedWord {
  public:
-    class Comparator {
-     public:
-        bool operator()(const SuggestedWord &left, const SuggestedWord &right) {
-            if (left.getScore() != right.getScore()) {
-                return left.getScore() > right.getScore();
-            }
-            return left.getCodePointCount() < right.getCodePointCount();
-        }
-
-     private:
-        DISALLOW_ASSIGNMENT_OPERATOR(Comparator);
-    };
+    // An empty slot of SuggestionResults.
+    SuggestedWord()
+            : mCodePointCount(0), mScore(0), mType(0), mIndexToPartialCommit(NOT_AN_INDEX),
+              mAutoCommitFirstWordConfidence(NOT_A_FIRST_WORD_CONFIDENCE) {}
 
     SuggestedWord(const int *const codePoints, const int codePointCount,
             const int score, const int type, const int indexToPartialCommit,
             const int autoCommitFirstWordConfidence)
-            : mCodePoints(codePoints, codePoints + codePointCount), mScore(score),
-              mType(type), mIndexToPartialCommit(indexToPartialCommit),
-              mAutoCommitFirstWordConfidence(autoCommitFirstWordConfidence) {}
+            : mCodePointCount(codePointCount), mScore(score), mType(type),
+              mIndexToPartialCommit(indexToPartialCommit),
+              mAutoCommitFirstWordConfidence(autoCommitFirstWordConfidence) {
+        ASSERT(0 <= codePointCount && codePointCount <= MAX_WORD_LENGTH);
+        memmove(mCodePoints, codePoints, sizeof(mCodePoints[0]) * codePointCount);
+    }
+
+    // Whether a suggestion of the given score and length ranks above this one. Among the
+    // suggestions of the same score, the shorter one ranks above.
+    bool ranksBelow(const int score, const int codePointCount) const {
+        if (score != mScore) {
+            return score > mScore;
+        }
+        return codePointCount < mCodePointCount;
+    }
+
+    bool ranksBelow(const SuggestedWord &suggestedWord) const {
+        return ranksBelow(suggestedWord.getScore(), suggestedWord.getCodePointCount());
+    }
 
     const int *getCodePoint() const {
-        return &mCodePoints.at(0);
+        return mCodePoints;
     }
 
     int getCodePointCount() const {
-        return mCodePoints.size();
+        return mCodePointCount;
     }
 
     int getScore() const {
@@ -71,9 +81,10 @@ class SuggestedWord {
     }
 
  private:
-    DISALLOW_DEFAULT_CONSTRUCTOR(SuggestedWord);
+    // Default copy constructor and assign operator are used for the slots of SuggestionResults.
 
-    std::vector<int> mCodePoints;
+    int mCodePoints[MAX_WORD_LENGTH];
+    int mCodePointCount;
     int mScore;
     int mType;
     int mIndexToPartialCommit;
@@ -17,6 +17,7 @@
 #include "suggest/core/result/suggestion_results.h"
 
 #include "utils/jni_data_utils.h"
+#include "utils/suggestion_buffer.h"
 
 namespace latinime {
 
@@ -24,10 +25,11 @@ void SuggestionResults::outputSuggestions(JNIEnv *env, jintArray outSuggestionCo
         jintArray outputCodePointsArray, jintArray outScoresArray, jintArray outSpaceIndicesArray,
         jintArray outTypesArray, jintArray outAutoCommitFirstWordConfidenceArray,
         jfloatArray outLanguageWeight) {
-    int outputIndex = 0;
-    while (!mSuggestedWords.empty()) {
-        const SuggestedWord &suggestedWord = mSuggestedWords.top();
-        suggestedWord.getCodePointCount();
+    int sortedIndices[MAX_RESULTS];
+    getSortedSuggestionIndices(sortedIndices);
+    for (int outputIndex = 0; outputIndex < mSuggestionCount; ++outputIndex) {
+        const SuggestedWord &suggestedWord =
+                mSuggestedWords[sortedIndices[mSuggestionCount - 1 - outputIndex]];
         const int start = outputIndex * MAX_WORD_LENGTH;
         JniDataUtils::outputCodePoints(env, outputCodePointsArray, start,
                 MAX_WORD_LENGTH /* maxLength */, suggestedWord.getCodePoint(),
@@ -36,15 +38,35 @@ void SuggestionResults::outputSuggestions(JNIEnv *env, jintArray outSuggestionCo
         JniDataUtils::putIntToArray(env, outSpaceIndicesArray, outputIndex,
                 suggestedWord.getIndexToPartialCommit());
         JniDataUtils::putIntToArray(env, outTypesArray, outputIndex, suggestedWord.getType());
-        if (mSuggestedWords.size() == 1) {
+        if (outputIndex == mSuggestionCount - 1) {
             JniDataUtils::putIntToArray(env, outAutoCommitFirstWordConfidenceArray, 0 /* index */,
                     suggestedWord.getAutoCommitFirstWordConfidence());
         }
-        ++outputIndex;
-        mSuggestedWords.pop();
     }
-    JniDataUtils::putIntToArray(env, outSuggestionCount, 0 /* index */, outputIndex);
+    JniDataUtils::putIntToArray(env, outSuggestionCount, 0 /* index */, mSuggestionCount);
     JniDataUtils::putFloatToArray(env, outLanguageWeight, 0 /* index */, mLanguageWeight);
+    mSuggestionCount = 0;
+}
+
+void SuggestionResults::outputSuggestions(SuggestionBuffer *const outBuffer) {
+    int sortedIndices[MAX_RESULTS];
+    getSortedSuggestionIndices(sortedIndices);
+    for (int outputIndex = 0; outputIndex < mSuggestionCount; ++outputIndex) {
+        const SuggestedWord &suggestedWord =
+                mSuggestedWords[sortedIndices[mSuggestionCount - 1 - outputIndex]];
+        JniDataUtils::outputCodePoints(outBuffer->getCodePointsOfSuggestion(outputIndex),
+                MAX_WORD_LENGTH /* maxLength */, suggestedWord.getCodePoint(),
+                suggestedWord.getCodePointCount(), true /* needsNullTermination */);
+        outBuffer->setSuggestion(outputIndex, suggestedWord.getScore(),
+                suggestedWord.getIndexToPartialCommit(), suggestedWord.getType());
+        if (outputIndex == mSuggestionCount - 1) {
+            outBuffer->setAutoCommitFirstWordConfidence(
+                    suggestedWord.getAutoCommitFirstWordConfidence());
+        }
+    }
+    outBuffer->setSuggestionCount(mSuggestionCount);
+    outBuffer->setLanguageWeight(mLanguageWeight);
+    mSuggestionCount = 0;
 }
 
 void SuggestionResults::addPrediction(const int *const codePoints, const int codePointCount,
@@ -66,40 +88,59 @@ void SuggestionResults::addSuggestion(const int *const codePoints, const int cod
                 codePointCount);
         return;
     }
-    if (getSuggestionCount() >= mMaxSuggestionCount) {
-        const SuggestedWord &mWorstSuggestion = mSuggestedWords.top();
-        if (score > mWorstSuggestion.getScore() || (score == mWorstSuggestion.getScore()
-                && codePointCount < mWorstSuggestion.getCodePointCount())) {
-            mSuggestedWords.pop();
-        } else {
-            return;
-        }
+    if (mSuggestionCount < mMaxSuggestionCount) {
+        mSuggestedWords[mSuggestionCount] = SuggestedWord(codePoints, codePointCount, score, type,
+                indexToPartialCommit, autocimmitFirstWordConfindence);
+        ++mSuggestionCount;
+        updateWorstSuggestionIndex();
+        return;
     }
-    mSuggestedWords.push(SuggestedWord(codePoints, codePointCount, score, type,
-            indexToPartialCommit, autocimmitFirstWordConfindence));
+    if (mSuggestionCount == 0
+            || !mSuggestedWords[mWorstSuggestionIndex].ranksBelow(score, codePointCount)) {
+        return;
+    }
+    mSuggestedWords[mWorstSuggestionIndex] = SuggestedWord(codePoints, codePointCount, score,
+            type, indexToPartialCommit, autocimmitFirstWordConfindence);
+    updateWorstSuggestionIndex();
 }
 
 void SuggestionResults::getSortedScores(int *const outScores) const {
-    auto copyOfSuggestedWords = mSuggestedWords;
-    while (!copyOfSuggestedWords.empty()) {
-        const SuggestedWord &suggestedWord = copyOfSuggestedWords.top();
-        outScores[copyOfSuggestedWords.size() - 1] = suggestedWord.getScore();
-        copyOfSuggestedWords.pop();
+    int sortedIndices[MAX_RESULTS];
+    getSortedSuggestionIndices(sortedIndices);
+    for (int i = 0; i < mSuggestionCount; ++i) {
+        outScores[i] = mSuggestedWords[sortedIndices[i]].getScore();
     }
 }
 
 void SuggestionResults::dumpSuggestions() const {
     AKLOGE("language weight: %f", mLanguageWeight);
-    std::vector<SuggestedWord> suggestedWords;
-    auto copyOfSuggestedWords = mSuggestedWords;
-    while (!copyOfSuggestedWords.empty()) {
-        suggestedWords.push_back(copyOfSuggestedWords.top());
-        copyOfSuggestedWords.pop();
+    int sortedIndices[MAX_RESULTS];
+    getSortedSuggestionIndices(sortedIndices);
+    for (int i = 0; i < mSuggestionCount; ++i) {
+        DUMP_SUGGESTION(mSuggestedWords[sortedIndices[i]].getCodePoint(),
+                mSuggestedWords[sortedIndices[i]].getCodePointCount(), i,
+                mSuggestedWords[sortedIndices[i]].getScore());
     }
-    int index = 0;
-    for (auto it = suggestedWords.rbegin(); it != suggestedWords.rend(); ++it) {
-        DUMP_SUGGESTION(it->getCodePoint(), it->getCodePointCount(), index, it->getScore());
-        index++;
+}
+
+void SuggestionResults::updateWorstSuggestionIndex() {
+    mWorstSuggestionIndex = 0;
+    for (int i = 1; i < mSuggestionCount; ++i) {
+        if (mSuggestedWords[i].ranksBelow(mSuggestedWords[mWorstSuggestionIndex])) {
+            mWorstSuggestionIndex = i;
+        }
+    }
+}
+
+// There are at most MAX_RESULTS suggestions, so they are sorted by insertion.
+void SuggestionResults::getSortedSuggestionIndices(int *const outIndices) const {
+    for (int i = 0; i < mSuggestionCount; ++i) {
+        int pos = i;
+        while (pos > 0 && mSuggestedWords[outIndices[pos - 1]].ranksBelow(mSuggestedWords[i])) {
+            outIndices[pos] = outIndices[pos - 1];
+            --pos;
+        }
+        outIndices[pos] = i;
     }
 }
 
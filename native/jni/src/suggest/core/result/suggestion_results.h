@@ -17,8 +17,7 @@
 #ifndef LATINIME_SUGGESTION_RESULTS_H
 #define LATINIME_SUGGESTION_RESULTS_H
 
-#include <queue>
-#include <vector>
+#include <algorithm>
 
 #include "defines.h"
 #include "jni.h"
@@ -26,16 +25,26 @@
 
 namespace latinime {
 
+class SuggestionBuffer;
+
+// Keeps the best suggestions up to a fixed count. The suggestions are held in fixed slots, so
+// adding suggestions never allocates, and a suggestion that doesn't rank above the worst one
+// is rejected before it is copied.
 class SuggestionResults {
  public:
     explicit SuggestionResults(const int maxSuggestionCount)
-            : mMaxSuggestionCount(maxSuggestionCount), mLanguageWeight(NOT_A_LANGUAGE_WEIGHT),
-              mSuggestedWords() {}
+            : mMaxSuggestionCount(std::min(maxSuggestionCount, MAX_RESULTS)),
+              mLanguageWeight(NOT_A_LANGUAGE_WEIGHT), mSuggestedWords(), mSuggestionCount(0),
+              mWorstSuggestionIndex(0) {
+        ASSERT(maxSuggestionCount <= MAX_RESULTS);
+    }
 
-    // Returns suggestion count.
+    // Outputs the suggestions from the worst to the best and clears them.
     void outputSuggestions(JNIEnv *env, jintArray outSuggestionCount, jintArray outCodePointsArray,
             jintArray outScoresArray, jintArray outSpaceIndicesArray, jintArray outTypesArray,
             jintArray outAutoCommitFirstWordConfidenceArray, jfloatArray outLanguageWeight);
+    // Same as above but writes to the output record of outBuffer.
+    void outputSuggestions(SuggestionBuffer *const outBuffer);
     void addPrediction(const int *const codePoints, const int codePointCount, const int score);
     void addSuggestion(const int *const codePoints, const int codePointCount,
             const int score, const int type, const int indexToPartialCommit,
@@ -48,7 +57,7 @@ class SuggestionResults {
     }
 
     int getSuggestionCount() const {
-        return mSuggestedWords.size();
+        return mSuggestionCount;
     }
 
  private:
@@ -56,8 +65,15 @@ class SuggestionResults {
 
     const int mMaxSuggestionCount;
     float mLanguageWeight;
-    std::priority_queue<
-            SuggestedWord, std::vector<SuggestedWord>, SuggestedWord::Comparator> mSuggestedWords;
+    // The suggestions in the order they are added, except that a suggestion that is added when
+    // the slots are full replaces the worst one.
+    SuggestedWord mSuggestedWords[MAX_RESULTS];
+    int mSuggestionCount;
+    int mWorstSuggestionIndex;
+
+    void updateWorstSuggestionIndex();
+    // Outputs the indices of the suggestions from the best to the worst.
+    void getSortedSuggestionIndices(int *const outIndices) const;
 };
 } // namespace latinime
 #endif // LATINIME_SUGGESTION_RESULTS_H
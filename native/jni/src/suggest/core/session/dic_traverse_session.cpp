@@ -28,6 +28,8 @@ namespace latinime {
 // (e.g. main dictionary) from small dictionaries (e.g. contacts...)
 const int DicTraverseSession::DICTIONARY_SIZE_THRESHOLD_TO_USE_LARGE_CACHE_FOR_SUGGESTION =
         256 * 1024;
+// Need to update com.android.inputmethod.latin.DicTraverseSession when you change this.
+const int DicTraverseSession::NOT_A_GESTURE_POINTS_GENERATION = 0;
 
 void DicTraverseSession::init(const Dictionary *const dictionary,
         const PrevWordsInfo *const prevWordsInfo, const SuggestOptions *const suggestOptions) {
@@ -45,8 +47,14 @@ void DicTraverseSession::setupForGetSuggestions(const ProximityInfo *pInfo,
         const float maxSpatialDistance, const int maxPointerCount) {
     mProximityInfo = pInfo;
     mMaxPointerCount = maxPointerCount;
+    // When the points held by this session are given, they are the previously processed points
+    // followed by the points appended after that.
+    const bool isStreamedGestureInput = inputSize > 0 && inputXs == mGestureXs.data();
+    const bool isAppendedInput = isStreamedGestureInput && mProcessedGesturePointCount > 0
+            && mProcessedGesturePointCount <= inputSize;
+    mProcessedGesturePointCount = isStreamedGestureInput ? inputSize : 0;
     initializeProximityInfoStates(inputCodePoints, inputXs, inputYs, times, pointerIds, inputSize,
-            maxSpatialDistance, maxPointerCount);
+            maxSpatialDistance, maxPointerCount, isAppendedInput);
 }
 
 const DictionaryStructureWithBufferPolicy *DicTraverseSession::getDictionaryStructurePolicy()
@@ -57,20 +65,61 @@ const DictionaryStructureWithBufferPolicy *DicTraverseSession::getDictionaryStru
 void DicTraverseSession::resetCache(const int thresholdForNextActiveDicNodes, const int maxWords) {
     mDicNodesCache.reset(thresholdForNextActiveDicNodes /* nextActiveSize */,
             maxWords /* terminalSize */);
-    mMultiBigramMap.clear();
+    if (!mKeepsMultiBigramMap) {
+        mMultiBigramMap.clear();
+    }
+}
+
+DicTraverseSession *DicTraverseSession::getPooledSession(const int index) {
+    while (static_cast<int>(mPooledSessions.size()) <= index) {
+        mPooledSessions.emplace_back(
+                new DicTraverseSession(nullptr /* env */, nullptr /* localeStr */,
+                        mUsesLargeCache));
+    }
+    return mPooledSessions[index].get();
+}
+
+void DicTraverseSession::resetGesturePoints() {
+    mGestureXs.clear();
+    mGestureYs.clear();
+    mGestureTimes.clear();
+    mGesturePointerIds.clear();
+    mProcessedGesturePointCount = 0;
+    updateGesturePointsGeneration();
+}
+
+int DicTraverseSession::appendGesturePoints(const int *const xs, const int *const ys,
+        const int *const times, const int *const pointerIds, const int pointCount) {
+    mGestureXs.insert(mGestureXs.end(), xs, xs + pointCount);
+    mGestureYs.insert(mGestureYs.end(), ys, ys + pointCount);
+    mGestureTimes.insert(mGestureTimes.end(), times, times + pointCount);
+    if (pointerIds) {
+        mGesturePointerIds.insert(mGesturePointerIds.end(), pointerIds, pointerIds + pointCount);
+    } else {
+        // Assuming pointerId == 0 if pointerIds is null.
+        mGesturePointerIds.resize(mGesturePointerIds.size() + pointCount, 0);
+    }
+    updateGesturePointsGeneration();
+    return mGesturePointsGeneration;
+}
+
+void DicTraverseSession::updateGesturePointsGeneration() {
+    // NOT_A_GESTURE_POINTS_GENERATION is skipped when the generation wraps around.
+    mGesturePointsGeneration = (mGesturePointsGeneration == S_INT_MAX)
+            ? NOT_A_GESTURE_POINTS_GENERATION + 1 : mGesturePointsGeneration + 1;
 }
 
 void DicTraverseSession::initializeProximityInfoStates(const int *const inputCodePoints,
         const int *const inputXs, const int *const inputYs, const int *const times,
         const int *const pointerIds, const int inputSize, const float maxSpatialDistance,
-        const int maxPointerCount) {
+        const int maxPointerCount, const bool isAppendedInput) {
     ASSERT(1 <= maxPointerCount && maxPointerCount <= MAX_POINTER_COUNT_G);
     mInputSize = 0;
     for (int i = 0; i < maxPointerCount; ++i) {
         mProximityInfoStates[i].initInputParams(i, maxSpatialDistance, getProximityInfo(),
                 inputCodePoints, inputSize, inputXs, inputYs, times, pointerIds,
                 maxPointerCount == MAX_POINTER_COUNT_G
-                /* TODO: this is a hack. fix proximity info state */);
+                /* TODO: this is a hack. fix proximity info state */, isAppendedInput);
         mInputSize += mProximityInfoStates[i].size();
     }
 }
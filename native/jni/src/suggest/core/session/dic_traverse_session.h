@@ -17,6 +17,7 @@
 #ifndef LATINIME_DIC_TRAVERSE_SESSION_H
 #define LATINIME_DIC_TRAVERSE_SESSION_H
 
+#include <memory>
 #include <vector>
 
 #include "defines.h"
@@ -52,6 +53,10 @@ class DicTraverseSession {
     AK_FORCE_INLINE DicTraverseSession(JNIEnv *env, jstring localeStr, bool usesLargeCache)
             : mProximityInfo(nullptr), mDictionary(nullptr), mSuggestOptions(nullptr),
               mDicNodesCache(usesLargeCache), mMultiBigramMap(), mInputSize(0), mMaxPointerCount(1),
+              mGestureXs(), mGestureYs(), mGestureTimes(), mGesturePointerIds(),
+              mGesturePointsGeneration(NOT_A_GESTURE_POINTS_GENERATION),
+              mProcessedGesturePointCount(0), mKeepsMultiBigramMap(false),
+              mUsesLargeCache(usesLargeCache), mPooledSessions(),
               mMultiWordCostMultiplier(1.0f) {
         // NOTE: mProximityInfoStates is an array of instances.
         // No need to initialize it explicitly here.
@@ -72,8 +77,35 @@ class DicTraverseSession {
             const int maxPointerCount);
     void resetCache(const int thresholdForNextActiveDicNodes, const int maxWords);
 
+    // Streaming gesture input. The points of the ongoing gesture are appended as they come, and
+    // getSuggestions() is called with the points held by the session (getGestureXs() etc.). Only
+    // the appended points are processed in that case. The generation changes whenever the points
+    // change, so that the caller can tell whether the points it streamed are still the held ones.
+    static const int NOT_A_GESTURE_POINTS_GENERATION;
+
+    void resetGesturePoints();
+    // Returns the new generation of the points.
+    int appendGesturePoints(const int *const xs, const int *const ys, const int *const times,
+            const int *const pointerIds, const int pointCount);
+    int getGesturePointsGeneration() const { return mGesturePointsGeneration; }
+    int getGesturePointCount() const { return static_cast<int>(mGestureXs.size()); }
+    int *getGestureXs() { return mGestureXs.data(); }
+    int *getGestureYs() { return mGestureYs.data(); }
+    int *getGestureTimes() { return mGestureTimes.data(); }
+    int *getGesturePointerIds() { return mGesturePointerIds.data(); }
+
     const DictionaryStructureWithBufferPolicy *getDictionaryStructurePolicy() const;
 
+    // While this is set, resetCache() keeps the cached bigram maps so that the following searches
+    // with the same previous words share them. They must be cleared when the dictionary changes.
+    void setKeepsMultiBigramMap(const bool keepsMultiBigramMap) {
+        mKeepsMultiBigramMap = keepsMultiBigramMap;
+    }
+
+    // The sessions that run the queries of a batch in parallel with this session. They are created
+    // when a batch uses them for the first time and are kept for the later batches.
+    DicTraverseSession *getPooledSession(const int index);
+
     //--------------------
     // getters and setters
     //--------------------
@@ -164,7 +196,9 @@ class DicTraverseSession {
     static const int DICTIONARY_SIZE_THRESHOLD_TO_USE_LARGE_CACHE_FOR_SUGGESTION;
     void initializeProximityInfoStates(const int *const inputCodePoints, const int *const inputXs,
             const int *const inputYs, const int *const times, const int *const pointerIds,
-            const int inputSize, const float maxSpatialDistance, const int maxPointerCount);
+            const int inputSize, const float maxSpatialDistance, const int maxPointerCount,
+            const bool isAppendedInput);
+    void updateGesturePointsGeneration();
 
     int mPrevWordsPtNodePos[MAX_PREV_WORD_COUNT_FOR_N_GRAM];
     const ProximityInfo *mProximityInfo;
@@ -174,11 +208,27 @@ class DicTraverseSession {
     DicNodesCache mDicNodesCache;
     // Temporary cache for bigram frequencies
     MultiBigramMap mMultiBigramMap;
+    // Only the gesture SuggestPolicy that GestureSuggestPolicyFactory provides reads more than one
+    // pointer. It is not a part of this library, so the pointer count stays fixed until it can
+    // consume more pointers.
     ProximityInfoState mProximityInfoStates[MAX_POINTER_COUNT_G];
 
     int mInputSize;
     int mMaxPointerCount;
 
+    // Points of the ongoing gesture appended by appendGesturePoints().
+    std::vector<int> mGestureXs;
+    std::vector<int> mGestureYs;
+    std::vector<int> mGestureTimes;
+    std::vector<int> mGesturePointerIds;
+    int mGesturePointsGeneration;
+    // The number of the gesture points processed by the last setupForGetSuggestions().
+    int mProcessedGesturePointCount;
+    bool mKeepsMultiBigramMap;
+
+    const bool mUsesLargeCache;
+    std::vector<std::unique_ptr<DicTraverseSession>> mPooledSessions;
+
     /////////////////////////////////
     // Configuration per dictionary
     float mMultiWordCostMultiplier;
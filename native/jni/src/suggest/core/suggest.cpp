@@ -18,6 +18,7 @@
 
 #include "suggest/core/dicnode/dic_node.h"
 #include "suggest/core/dicnode/dic_node_priority_queue.h"
+#include "suggest/core/dicnode/dic_node_utils.h"
 #include "suggest/core/dicnode/dic_node_vector.h"
 #include "suggest/core/dictionary/dictionary.h"
 #include "suggest/core/dictionary/digraph_utils.h"
@@ -162,7 +163,7 @@ void Suggest::expandCurrentDicNodes(DicTraverseSession *traverseSession) const {
                 createNextWordDicNode(traverseSession, &dicNode, true /* spaceSubstitution */);
             }
 
-            DicNodeUtils::getAllChildDicNodes(
+            DicNodeUtils::getAllChildDicNodesWithoutProbabilities(
                     &dicNode, traverseSession->getDictionaryStructurePolicy(), &childDicNodes);
 
             const int childDicNodesSize = childDicNodes.getSizeAndLock();
@@ -238,6 +239,7 @@ void Suggest::processTerminalDicNode(
     if (!dicNode->hasMatchedOrProximityCodePoints()) {
         return;
     }
+    DicNodeUtils::readProbabilityIfNeeded(traverseSession->getDictionaryStructurePolicy(), dicNode);
     // Create a non-cached node here.
     DicNode terminalDicNode(*dicNode);
     if (TRAVERSAL->needsToTraverseAllUserInput()
@@ -412,7 +414,8 @@ void Suggest::weightChildNode(DicTraverseSession *traverseSession, DicNode *dicN
  */
 void Suggest::createNextWordDicNode(DicTraverseSession *traverseSession, DicNode *dicNode,
         const bool spaceSubstitution) const {
-    if (!TRAVERSAL->isGoodToTraverseNextWord(dicNode)) {
+    DicNodeUtils::readProbabilityIfNeeded(traverseSession->getDictionaryStructurePolicy(), dicNode);
+    if (!TRAVERSAL->isGoodToTraverseNextWord(traverseSession, dicNode)) {
         return;
     }
 
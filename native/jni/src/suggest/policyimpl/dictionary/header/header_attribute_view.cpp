@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/policyimpl/dictionary/header/header_attribute_view.h"
+
+#include <cctype>
+
+#include "suggest/policyimpl/dictionary/header/header_read_write_utils.h"
+#include "suggest/policyimpl/dictionary/utils/byte_array_utils.h"
+
+namespace latinime {
+
+// These have to be the same as the limits used by HeaderReadWriteUtils.
+const int HeaderAttributeView::MAX_ATTRIBUTE_KEY_LENGTH = 256;
+const int HeaderAttributeView::MAX_ATTRIBUTE_VALUE_LENGTH = 256;
+
+HeaderAttributeView::HeaderAttributeView(const uint8_t *const dictBuf)
+        : mDictBuf(dictBuf), mHeaderSize(HeaderReadWriteUtils::getHeaderSize(dictBuf)),
+          mIndexedAttributeCount(0), mUnindexedAttributesPos(NOT_A_DICT_POS), mKeyPositions(),
+          mValuePositions() {
+    int pos = HeaderReadWriteUtils::getHeaderOptionsPosition();
+    while (pos < mHeaderSize) {
+        if (mIndexedAttributeCount >= MAX_INDEXED_ATTRIBUTE_COUNT) {
+            mUnindexedAttributesPos = pos;
+            break;
+        }
+        mKeyPositions[mIndexedAttributeCount] = pos;
+        ByteArrayUtils::advancePositionToBehindString(mDictBuf, MAX_ATTRIBUTE_KEY_LENGTH, &pos);
+        mValuePositions[mIndexedAttributeCount] = pos;
+        ByteArrayUtils::advancePositionToBehindString(mDictBuf, MAX_ATTRIBUTE_VALUE_LENGTH, &pos);
+        mIndexedAttributeCount++;
+    }
+}
+
+int HeaderAttributeView::readIntAttributeValue(const char *const key,
+        const int defaultValue) const {
+    int pos = getValuePos(key);
+    if (pos == NOT_A_DICT_POS) {
+        return defaultValue;
+    }
+    int value = 0;
+    bool isNegative = false;
+    for (int i = 0; i < MAX_ATTRIBUTE_VALUE_LENGTH; ++i) {
+        const int codePoint = ByteArrayUtils::readCodePointAndAdvancePosition(mDictBuf, &pos);
+        if (codePoint == NOT_A_CODE_POINT) {
+            break;
+        }
+        if (i == 0 && codePoint == '-') {
+            isNegative = true;
+        } else {
+            if (!isdigit(codePoint)) {
+                // If not a number.
+                return defaultValue;
+            }
+            value *= 10;
+            value += codePoint - '0';
+        }
+    }
+    return isNegative ? -value : value;
+}
+
+bool HeaderAttributeView::readBoolAttributeValue(const char *const key,
+        const bool defaultValue) const {
+    const int intDefaultValue = defaultValue ? 1 : 0;
+    const int intValue = readIntAttributeValue(key, intDefaultValue);
+    return intValue != 0;
+}
+
+const std::vector<int> HeaderAttributeView::readCodePointVectorAttributeValue(
+        const char *const key) const {
+    int codePoints[MAX_ATTRIBUTE_VALUE_LENGTH];
+    const int codePointCount = readCodePointsAttributeValue(key, MAX_ATTRIBUTE_VALUE_LENGTH,
+            codePoints);
+    if (codePointCount <= 0) {
+        return std::vector<int>();
+    }
+    return std::vector<int>(codePoints, codePoints + codePointCount);
+}
+
+int HeaderAttributeView::readCodePointsAttributeValue(const char *const key,
+        const int maxCodePointCount, int *const outCodePoints) const {
+    int pos = getValuePos(key);
+    if (pos == NOT_A_DICT_POS) {
+        return -1;
+    }
+    return ByteArrayUtils::readStringAndAdvancePosition(mDictBuf, maxCodePointCount,
+            outCodePoints, &pos);
+}
+
+void HeaderAttributeView::fetchAllAttributes(
+        DictionaryHeaderStructurePolicy::AttributeMap *const outAttributeMap) const {
+    if (!isValid()) {
+        return;
+    }
+    HeaderReadWriteUtils::fetchAllHeaderAttributes(mDictBuf, outAttributeMap);
+}
+
+// Returns the position of the value of the first occurrence of the key.
+int HeaderAttributeView::getValuePos(const char *const key) const {
+    if (!isValid()) {
+        return NOT_A_DICT_POS;
+    }
+    for (int i = 0; i < mIndexedAttributeCount; ++i) {
+        if (isKeyAtPos(key, mKeyPositions[i])) {
+            return mValuePositions[i];
+        }
+    }
+    if (mUnindexedAttributesPos == NOT_A_DICT_POS) {
+        return NOT_A_DICT_POS;
+    }
+    int pos = mUnindexedAttributesPos;
+    while (pos < mHeaderSize) {
+        const bool isTargetKey = isKeyAtPos(key, pos);
+        ByteArrayUtils::advancePositionToBehindString(mDictBuf, MAX_ATTRIBUTE_KEY_LENGTH, &pos);
+        if (isTargetKey) {
+            return pos;
+        }
+        ByteArrayUtils::advancePositionToBehindString(mDictBuf, MAX_ATTRIBUTE_VALUE_LENGTH, &pos);
+    }
+    return NOT_A_DICT_POS;
+}
+
+// Keys are ASCII strings, so they can be compared with the code points in the buffer one by one.
+bool HeaderAttributeView::isKeyAtPos(const char *const key, const int keyPos) const {
+    int pos = keyPos;
+    for (int i = 0; i < MAX_ATTRIBUTE_KEY_LENGTH; ++i) {
+        const int codePoint = ByteArrayUtils::readCodePointAndAdvancePosition(mDictBuf, &pos);
+        if (codePoint == NOT_A_CODE_POINT) {
+            return key[i] == '\0';
+        }
+        if (key[i] == '\0' || codePoint != key[i]) {
+            return false;
+        }
+    }
+    return false;
+}
+
+} // namespace latinime
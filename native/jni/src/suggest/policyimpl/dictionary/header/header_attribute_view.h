@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_HEADER_ATTRIBUTE_VIEW_H
+#define LATINIME_HEADER_ATTRIBUTE_VIEW_H
+
+#include <cstdint>
+#include <vector>
+
+#include "defines.h"
+#include "suggest/core/policy/dictionary_header_structure_policy.h"
+
+namespace latinime {
+
+/*
+ * Read-only view of the {key,value} attribute strings of a dictionary header. Only the positions
+ * of the attributes are indexed; values are decoded from the dictionary buffer when they are
+ * read. The dictionary buffer has to outlive the view.
+ *
+ * When a key appears more than once, the first occurrence is used. This is the same as the
+ * attribute map built by HeaderReadWriteUtils::fetchAllHeaderAttributes(), which doesn't
+ * overwrite the keys that have already been inserted.
+ */
+class HeaderAttributeView {
+ public:
+    explicit HeaderAttributeView(const uint8_t *const dictBuf);
+
+    // Empty view for headers that are not backed by a dictionary buffer.
+    HeaderAttributeView()
+            : mDictBuf(nullptr), mHeaderSize(0), mIndexedAttributeCount(0),
+              mUnindexedAttributesPos(NOT_A_DICT_POS), mKeyPositions(), mValuePositions() {}
+
+    AK_FORCE_INLINE bool isValid() const {
+        return mDictBuf != nullptr;
+    }
+
+    int readIntAttributeValue(const char *const key, const int defaultValue) const;
+
+    bool readBoolAttributeValue(const char *const key, const bool defaultValue) const;
+
+    const std::vector<int> readCodePointVectorAttributeValue(const char *const key) const;
+
+    // Returns the code point count of the value, or -1 when the key is not found.
+    int readCodePointsAttributeValue(const char *const key, const int maxCodePointCount,
+            int *const outCodePoints) const;
+
+    void fetchAllAttributes(DictionaryHeaderStructurePolicy::AttributeMap *const outAttributeMap)
+            const;
+
+ private:
+    DISALLOW_COPY_AND_ASSIGN(HeaderAttributeView);
+
+    // Headers written by the dictionary tools have less than 20 attributes. Attributes beyond
+    // this count are found by scanning the header.
+    static const int MAX_INDEXED_ATTRIBUTE_COUNT = 32;
+    static const int MAX_ATTRIBUTE_KEY_LENGTH;
+    static const int MAX_ATTRIBUTE_VALUE_LENGTH;
+
+    const uint8_t *const mDictBuf;
+    const int mHeaderSize;
+    int mIndexedAttributeCount;
+    int mUnindexedAttributesPos;
+    int mKeyPositions[MAX_INDEXED_ATTRIBUTE_COUNT];
+    int mValuePositions[MAX_INDEXED_ATTRIBUTE_COUNT];
+
+    int getValuePos(const char *const key) const;
+    bool isKeyAtPos(const char *const key, const int keyPos) const;
+};
+} // namespace latinime
+#endif /* LATINIME_HEADER_ATTRIBUTE_VIEW_H */
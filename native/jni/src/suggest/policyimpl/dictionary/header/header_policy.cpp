@@ -17,6 +17,8 @@
 #include "suggest/policyimpl/dictionary/header/header_policy.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <cstdio>
 
 namespace latinime {
 
@@ -44,6 +46,8 @@ const char *const HeaderPolicy::FORGETTING_CURVE_DURATION_TO_LEVEL_DOWN_IN_SECON
 
 const char *const HeaderPolicy::MAX_UNIGRAM_COUNT_KEY = "MAX_UNIGRAM_COUNT";
 const char *const HeaderPolicy::MAX_BIGRAM_COUNT_KEY = "MAX_BIGRAM_COUNT";
+// Adler-32 of the body file of a version 4 dictionary as an unsigned decimal number.
+const char *const HeaderPolicy::BODY_CHECKSUM_KEY = "BODY_CHECKSUM";
 
 const int HeaderPolicy::DEFAULT_MULTIPLE_WORDS_DEMOTION_RATE = 100;
 const float HeaderPolicy::MULTIPLE_WORD_COST_MULTIPLIER_SCALE = 100.0f;
@@ -64,6 +68,18 @@ void HeaderPolicy::readHeaderValueOrQuestionMark(const char *const key, int *out
         outValue[0] = '\0';
         return;
     }
+    if (mAttributeView.isValid()) {
+        const int valueLength = mAttributeView.readCodePointsAttributeValue(key,
+                outValueSize - 1, outValue);
+        if (valueLength < 0) {
+            // The key was not found.
+            outValue[0] = '?';
+            outValue[1] = '\0';
+        } else {
+            outValue[valueLength] = '\0';
+        }
+        return;
+    }
     std::vector<int> keyCodePointVector;
     HeaderReadWriteUtils::insertCharactersIntoVector(key, &keyCodePointVector);
     DictionaryHeaderStructurePolicy::AttributeMap::const_iterator it =
@@ -81,13 +97,47 @@ void HeaderPolicy::readHeaderValueOrQuestionMark(const char *const key, int *out
     outValue[terminalIndex] = '\0';
 }
 
+bool HeaderPolicy::readBodyChecksum(uint32_t *const outChecksum) const {
+    const std::vector<int> checksumString = mAttributeView.isValid() ?
+            mAttributeView.readCodePointVectorAttributeValue(BODY_CHECKSUM_KEY) :
+            HeaderReadWriteUtils::readCodePointVectorAttributeValue(&mAttributeMap,
+                    BODY_CHECKSUM_KEY);
+    if (checksumString.empty()) {
+        return false;
+    }
+    uint64_t checksum = 0;
+    for (const int codePoint : checksumString) {
+        if (codePoint < '0' || codePoint > '9') {
+            return false;
+        }
+        checksum = checksum * 10 + (codePoint - '0');
+        if (checksum > UINT32_MAX) {
+            return false;
+        }
+    }
+    *outChecksum = static_cast<uint32_t>(checksum);
+    return true;
+}
+
+const DictionaryHeaderStructurePolicy::AttributeMap *HeaderPolicy::getAttributeMap() const {
+    if (mAttributeView.isValid()) {
+        std::call_once(mAttributeMapMaterializationFlag, [this] {
+            mAttributeView.fetchAllAttributes(&mAttributeMap);
+        });
+    }
+    return &mAttributeMap;
+}
+
 const std::vector<int> HeaderPolicy::readLocale() const {
+    if (mAttributeView.isValid()) {
+        return mAttributeView.readCodePointVectorAttributeValue(LOCALE_KEY);
+    }
     return HeaderReadWriteUtils::readCodePointVectorAttributeValue(&mAttributeMap, LOCALE_KEY);
 }
 
 float HeaderPolicy::readMultipleWordCostMultiplier() const {
-    const int demotionRate = HeaderReadWriteUtils::readIntAttributeValue(&mAttributeMap,
-            MULTIPLE_WORDS_DEMOTION_RATE_KEY, DEFAULT_MULTIPLE_WORDS_DEMOTION_RATE);
+    const int demotionRate = readIntAttributeValue(MULTIPLE_WORDS_DEMOTION_RATE_KEY,
+            DEFAULT_MULTIPLE_WORDS_DEMOTION_RATE);
     if (demotionRate <= 0) {
         return static_cast<float>(MAX_VALUE_FOR_WEIGHTING);
     }
@@ -95,17 +145,52 @@ float HeaderPolicy::readMultipleWordCostMultiplier() const {
 }
 
 bool HeaderPolicy::readRequiresGermanUmlautProcessing() const {
-    return HeaderReadWriteUtils::readBoolAttributeValue(&mAttributeMap,
-            REQUIRES_GERMAN_UMLAUT_PROCESSING_KEY, false);
+    return readBoolAttributeValue(REQUIRES_GERMAN_UMLAUT_PROCESSING_KEY, false);
+}
+
+int HeaderPolicy::readIntAttributeValue(const char *const key, const int defaultValue) const {
+    if (mAttributeView.isValid()) {
+        return mAttributeView.readIntAttributeValue(key, defaultValue);
+    }
+    return HeaderReadWriteUtils::readIntAttributeValue(&mAttributeMap, key, defaultValue);
+}
+
+bool HeaderPolicy::readBoolAttributeValue(const char *const key, const bool defaultValue) const {
+    if (mAttributeView.isValid()) {
+        return mAttributeView.readBoolAttributeValue(key, defaultValue);
+    }
+    return HeaderReadWriteUtils::readBoolAttributeValue(&mAttributeMap, key, defaultValue);
 }
 
 bool HeaderPolicy::fillInAndWriteHeaderToBuffer(const bool updatesLastDecayedTime,
         const int unigramCount, const int bigramCount,
         const int extendedRegionSize, BufferWithExtendableBuffer *const outBuffer) const {
-    int writingPos = 0;
-    DictionaryHeaderStructurePolicy::AttributeMap attributeMapToWrite(mAttributeMap);
+    DictionaryHeaderStructurePolicy::AttributeMap attributeMapToWrite(createAttributeMap());
+    fillInHeader(updatesLastDecayedTime, unigramCount, bigramCount,
+            extendedRegionSize, &attributeMapToWrite);
+    return writeHeaderToBuffer(&attributeMapToWrite, outBuffer);
+}
+
+bool HeaderPolicy::fillInAndWriteHeaderToBuffer(const bool updatesLastDecayedTime,
+        const int unigramCount, const int bigramCount, const int extendedRegionSize,
+        const uint32_t bodyChecksum, BufferWithExtendableBuffer *const outBuffer) const {
+    DictionaryHeaderStructurePolicy::AttributeMap attributeMapToWrite(createAttributeMap());
     fillInHeader(updatesLastDecayedTime, unigramCount, bigramCount,
             extendedRegionSize, &attributeMapToWrite);
+    char bodyChecksumString[11];
+    snprintf(bodyChecksumString, NELEMS(bodyChecksumString), "%u", bodyChecksum);
+    std::vector<int> bodyChecksumCodePoints;
+    HeaderReadWriteUtils::insertCharactersIntoVector(bodyChecksumString,
+            &bodyChecksumCodePoints);
+    HeaderReadWriteUtils::setCodePointVectorAttribute(&attributeMapToWrite, BODY_CHECKSUM_KEY,
+            bodyChecksumCodePoints);
+    return writeHeaderToBuffer(&attributeMapToWrite, outBuffer);
+}
+
+bool HeaderPolicy::writeHeaderToBuffer(
+        const DictionaryHeaderStructurePolicy::AttributeMap *const attributeMap,
+        BufferWithExtendableBuffer *const outBuffer) const {
+    int writingPos = 0;
     if (!HeaderReadWriteUtils::writeDictionaryVersion(outBuffer, mDictFormatVersion,
             &writingPos)) {
         return false;
@@ -120,7 +205,7 @@ bool HeaderPolicy::fillInAndWriteHeaderToBuffer(const bool updatesLastDecayedTim
             &writingPos)) {
         return false;
     }
-    if (!HeaderReadWriteUtils::writeHeaderAttributes(outBuffer, &attributeMapToWrite,
+    if (!HeaderReadWriteUtils::writeHeaderAttributes(outBuffer, attributeMap,
             &writingPos)) {
         return false;
     }
@@ -143,6 +228,10 @@ void HeaderPolicy::fillInHeader(const bool updatesLastDecayedTime, const int uni
     HeaderReadWriteUtils::setIntAttribute(outAttributeMap, DATE_KEY,
             TimeKeeper::peekCurrentTime());
     HeaderReadWriteUtils::setCodePointVectorAttribute(outAttributeMap, LOCALE_KEY, mLocale);
+    // The checksum of the original body doesn't match the body that is written with this header.
+    DictionaryHeaderStructurePolicy::AttributeMap::key_type bodyChecksumKey;
+    HeaderReadWriteUtils::insertCharactersIntoVector(BODY_CHECKSUM_KEY, &bodyChecksumKey);
+    outAttributeMap->erase(bodyChecksumKey);
     if (updatesLastDecayedTime) {
         // Set current time as the last updated time.
         HeaderReadWriteUtils::setIntAttribute(outAttributeMap, LAST_DECAYED_TIME_KEY,
@@ -150,10 +239,13 @@ void HeaderPolicy::fillInHeader(const bool updatesLastDecayedTime, const int uni
     }
 }
 
-/* static */ DictionaryHeaderStructurePolicy::AttributeMap
-        HeaderPolicy::createAttributeMapAndReadAllAttributes(const uint8_t *const dictBuf) {
+// Returns a copy of the attributes without caching a materialized map in this policy.
+const DictionaryHeaderStructurePolicy::AttributeMap HeaderPolicy::createAttributeMap() const {
+    if (!mAttributeView.isValid()) {
+        return mAttributeMap;
+    }
     DictionaryHeaderStructurePolicy::AttributeMap attributeMap;
-    HeaderReadWriteUtils::fetchAllHeaderAttributes(dictBuf, &attributeMap);
+    mAttributeView.fetchAllAttributes(&attributeMap);
     return attributeMap;
 }
 
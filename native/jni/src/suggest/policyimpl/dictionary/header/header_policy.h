@@ -18,9 +18,11 @@
 #define LATINIME_HEADER_POLICY_H
 
 #include <cstdint>
+#include <mutex>
 
 #include "defines.h"
 #include "suggest/core/policy/dictionary_header_structure_policy.h"
+#include "suggest/policyimpl/dictionary/header/header_attribute_view.h"
 #include "suggest/policyimpl/dictionary/header/header_read_write_utils.h"
 #include "suggest/policyimpl/dictionary/utils/format_utils.h"
 #include "utils/char_utils.h"
@@ -30,42 +32,42 @@ namespace latinime {
 
 class HeaderPolicy : public DictionaryHeaderStructurePolicy {
  public:
-    // Reads information from existing dictionary buffer.
+    // Reads information from existing dictionary buffer. Attribute values are decoded from the
+    // buffer when they are requested, e.g. by getAttributeMap() or fillInHeader(), so the buffer
+    // has to outlive this header policy. The dictionary buffers own both of them. Use the copy
+    // constructor to keep the header after the buffer has been released.
     HeaderPolicy(const uint8_t *const dictBuf, const FormatUtils::FORMAT_VERSION formatVersion)
             : mDictFormatVersion(formatVersion),
               mDictionaryFlags(HeaderReadWriteUtils::getFlags(dictBuf)),
-              mSize(HeaderReadWriteUtils::getHeaderSize(dictBuf)),
-              mAttributeMap(createAttributeMapAndReadAllAttributes(dictBuf)),
-              mLocale(readLocale()),
+              mSize(HeaderReadWriteUtils::getHeaderSize(dictBuf)), mAttributeView(dictBuf),
+              mAttributeMap(), mAttributeMapMaterializationFlag(), mLocale(readLocale()),
               mMultiWordCostMultiplier(readMultipleWordCostMultiplier()),
               mRequiresGermanUmlautProcessing(readRequiresGermanUmlautProcessing()),
-              mIsDecayingDict(HeaderReadWriteUtils::readBoolAttributeValue(&mAttributeMap,
-                      IS_DECAYING_DICT_KEY, false /* defaultValue */)),
-              mDate(HeaderReadWriteUtils::readIntAttributeValue(&mAttributeMap,
-                      DATE_KEY, TimeKeeper::peekCurrentTime() /* defaultValue */)),
-              mLastDecayedTime(HeaderReadWriteUtils::readIntAttributeValue(&mAttributeMap,
-                      LAST_DECAYED_TIME_KEY, TimeKeeper::peekCurrentTime() /* defaultValue */)),
-              mUnigramCount(HeaderReadWriteUtils::readIntAttributeValue(&mAttributeMap,
-                      UNIGRAM_COUNT_KEY, 0 /* defaultValue */)),
-              mBigramCount(HeaderReadWriteUtils::readIntAttributeValue(&mAttributeMap,
-                      BIGRAM_COUNT_KEY, 0 /* defaultValue */)),
-              mExtendedRegionSize(HeaderReadWriteUtils::readIntAttributeValue(&mAttributeMap,
-                      EXTENDED_REGION_SIZE_KEY, 0 /* defaultValue */)),
-              mHasHistoricalInfoOfWords(HeaderReadWriteUtils::readBoolAttributeValue(
-                      &mAttributeMap, HAS_HISTORICAL_INFO_KEY, false /* defaultValue */)),
-              mForgettingCurveOccurrencesToLevelUp(HeaderReadWriteUtils::readIntAttributeValue(
-                      &mAttributeMap, FORGETTING_CURVE_OCCURRENCES_TO_LEVEL_UP_KEY,
+              mIsDecayingDict(readBoolAttributeValue(IS_DECAYING_DICT_KEY,
+                      false /* defaultValue */)),
+              mDate(readIntAttributeValue(DATE_KEY,
+                      TimeKeeper::peekCurrentTime() /* defaultValue */)),
+              mLastDecayedTime(readIntAttributeValue(LAST_DECAYED_TIME_KEY,
+                      TimeKeeper::peekCurrentTime() /* defaultValue */)),
+              mUnigramCount(readIntAttributeValue(UNIGRAM_COUNT_KEY, 0 /* defaultValue */)),
+              mBigramCount(readIntAttributeValue(BIGRAM_COUNT_KEY, 0 /* defaultValue */)),
+              mExtendedRegionSize(readIntAttributeValue(EXTENDED_REGION_SIZE_KEY,
+                      0 /* defaultValue */)),
+              mHasHistoricalInfoOfWords(readBoolAttributeValue(HAS_HISTORICAL_INFO_KEY,
+                      false /* defaultValue */)),
+              mForgettingCurveOccurrencesToLevelUp(readIntAttributeValue(
+                      FORGETTING_CURVE_OCCURRENCES_TO_LEVEL_UP_KEY,
                       DEFAULT_FORGETTING_CURVE_OCCURRENCES_TO_LEVEL_UP)),
-              mForgettingCurveProbabilityValuesTableId(HeaderReadWriteUtils::readIntAttributeValue(
-                      &mAttributeMap, FORGETTING_CURVE_PROBABILITY_VALUES_TABLE_ID_KEY,
+              mForgettingCurveProbabilityValuesTableId(readIntAttributeValue(
+                      FORGETTING_CURVE_PROBABILITY_VALUES_TABLE_ID_KEY,
                       DEFAULT_FORGETTING_CURVE_PROBABILITY_VALUES_TABLE_ID)),
-              mForgettingCurveDurationToLevelDown(HeaderReadWriteUtils::readIntAttributeValue(
-                      &mAttributeMap, FORGETTING_CURVE_DURATION_TO_LEVEL_DOWN_IN_SECONDS_KEY,
+              mForgettingCurveDurationToLevelDown(readIntAttributeValue(
+                      FORGETTING_CURVE_DURATION_TO_LEVEL_DOWN_IN_SECONDS_KEY,
                       DEFAULT_FORGETTING_CURVE_DURATION_TO_LEVEL_DOWN_IN_SECONDS)),
-              mMaxUnigramCount(HeaderReadWriteUtils::readIntAttributeValue(
-                      &mAttributeMap, MAX_UNIGRAM_COUNT_KEY, DEFAULT_MAX_UNIGRAM_COUNT)),
-              mMaxBigramCount(HeaderReadWriteUtils::readIntAttributeValue(
-                      &mAttributeMap, MAX_BIGRAM_COUNT_KEY, DEFAULT_MAX_BIGRAM_COUNT)) {}
+              mMaxUnigramCount(readIntAttributeValue(MAX_UNIGRAM_COUNT_KEY,
+                      DEFAULT_MAX_UNIGRAM_COUNT)),
+              mMaxBigramCount(readIntAttributeValue(MAX_BIGRAM_COUNT_KEY,
+                      DEFAULT_MAX_BIGRAM_COUNT)) {}
 
     // Constructs header information using an attribute map.
     HeaderPolicy(const FormatUtils::FORMAT_VERSION dictFormatVersion,
@@ -73,37 +75,39 @@ class HeaderPolicy : public DictionaryHeaderStructurePolicy {
             const DictionaryHeaderStructurePolicy::AttributeMap *const attributeMap)
             : mDictFormatVersion(dictFormatVersion),
               mDictionaryFlags(HeaderReadWriteUtils::createAndGetDictionaryFlagsUsingAttributeMap(
-                      attributeMap)), mSize(0), mAttributeMap(*attributeMap), mLocale(locale),
+                      attributeMap)), mSize(0), mAttributeView(), mAttributeMap(*attributeMap),
+              mAttributeMapMaterializationFlag(), mLocale(locale),
               mMultiWordCostMultiplier(readMultipleWordCostMultiplier()),
               mRequiresGermanUmlautProcessing(readRequiresGermanUmlautProcessing()),
-              mIsDecayingDict(HeaderReadWriteUtils::readBoolAttributeValue(&mAttributeMap,
-                      IS_DECAYING_DICT_KEY, false /* defaultValue */)),
-              mDate(HeaderReadWriteUtils::readIntAttributeValue(&mAttributeMap,
-                      DATE_KEY, TimeKeeper::peekCurrentTime() /* defaultValue */)),
-              mLastDecayedTime(HeaderReadWriteUtils::readIntAttributeValue(&mAttributeMap,
-                      DATE_KEY, TimeKeeper::peekCurrentTime() /* defaultValue */)),
+              mIsDecayingDict(readBoolAttributeValue(IS_DECAYING_DICT_KEY,
+                      false /* defaultValue */)),
+              mDate(readIntAttributeValue(DATE_KEY,
+                      TimeKeeper::peekCurrentTime() /* defaultValue */)),
+              mLastDecayedTime(readIntAttributeValue(DATE_KEY,
+                      TimeKeeper::peekCurrentTime() /* defaultValue */)),
               mUnigramCount(0), mBigramCount(0), mExtendedRegionSize(0),
-              mHasHistoricalInfoOfWords(HeaderReadWriteUtils::readBoolAttributeValue(
-                      &mAttributeMap, HAS_HISTORICAL_INFO_KEY, false /* defaultValue */)),
-              mForgettingCurveOccurrencesToLevelUp(HeaderReadWriteUtils::readIntAttributeValue(
-                      &mAttributeMap, FORGETTING_CURVE_OCCURRENCES_TO_LEVEL_UP_KEY,
+              mHasHistoricalInfoOfWords(readBoolAttributeValue(HAS_HISTORICAL_INFO_KEY,
+                      false /* defaultValue */)),
+              mForgettingCurveOccurrencesToLevelUp(readIntAttributeValue(
+                      FORGETTING_CURVE_OCCURRENCES_TO_LEVEL_UP_KEY,
                       DEFAULT_FORGETTING_CURVE_OCCURRENCES_TO_LEVEL_UP)),
-              mForgettingCurveProbabilityValuesTableId(HeaderReadWriteUtils::readIntAttributeValue(
-                      &mAttributeMap, FORGETTING_CURVE_PROBABILITY_VALUES_TABLE_ID_KEY,
+              mForgettingCurveProbabilityValuesTableId(readIntAttributeValue(
+                      FORGETTING_CURVE_PROBABILITY_VALUES_TABLE_ID_KEY,
                       DEFAULT_FORGETTING_CURVE_PROBABILITY_VALUES_TABLE_ID)),
-              mForgettingCurveDurationToLevelDown(HeaderReadWriteUtils::readIntAttributeValue(
-                      &mAttributeMap, FORGETTING_CURVE_DURATION_TO_LEVEL_DOWN_IN_SECONDS_KEY,
+              mForgettingCurveDurationToLevelDown(readIntAttributeValue(
+                      FORGETTING_CURVE_DURATION_TO_LEVEL_DOWN_IN_SECONDS_KEY,
                       DEFAULT_FORGETTING_CURVE_DURATION_TO_LEVEL_DOWN_IN_SECONDS)),
-              mMaxUnigramCount(HeaderReadWriteUtils::readIntAttributeValue(
-                      &mAttributeMap, MAX_UNIGRAM_COUNT_KEY, DEFAULT_MAX_UNIGRAM_COUNT)),
-              mMaxBigramCount(HeaderReadWriteUtils::readIntAttributeValue(
-                      &mAttributeMap, MAX_BIGRAM_COUNT_KEY, DEFAULT_MAX_BIGRAM_COUNT)) {}
+              mMaxUnigramCount(readIntAttributeValue(MAX_UNIGRAM_COUNT_KEY,
+                      DEFAULT_MAX_UNIGRAM_COUNT)),
+              mMaxBigramCount(readIntAttributeValue(MAX_BIGRAM_COUNT_KEY,
+                      DEFAULT_MAX_BIGRAM_COUNT)) {}
 
     // Copy header information
     HeaderPolicy(const HeaderPolicy *const headerPolicy)
             : mDictFormatVersion(headerPolicy->mDictFormatVersion),
               mDictionaryFlags(headerPolicy->mDictionaryFlags), mSize(headerPolicy->mSize),
-              mAttributeMap(headerPolicy->mAttributeMap), mLocale(headerPolicy->mLocale),
+              mAttributeView(), mAttributeMap(headerPolicy->createAttributeMap()),
+              mAttributeMapMaterializationFlag(), mLocale(headerPolicy->mLocale),
               mMultiWordCostMultiplier(headerPolicy->mMultiWordCostMultiplier),
               mRequiresGermanUmlautProcessing(headerPolicy->mRequiresGermanUmlautProcessing),
               mIsDecayingDict(headerPolicy->mIsDecayingDict),
@@ -123,7 +127,8 @@ class HeaderPolicy : public DictionaryHeaderStructurePolicy {
     // Temporary dummy header.
     HeaderPolicy()
             : mDictFormatVersion(FormatUtils::UNKNOWN_VERSION), mDictionaryFlags(0), mSize(0),
-              mAttributeMap(), mLocale(CharUtils::EMPTY_STRING), mMultiWordCostMultiplier(0.0f),
+              mAttributeView(), mAttributeMap(), mAttributeMapMaterializationFlag(),
+              mLocale(CharUtils::EMPTY_STRING), mMultiWordCostMultiplier(0.0f),
               mRequiresGermanUmlautProcessing(false), mIsDecayingDict(false),
               mDate(0), mLastDecayedTime(0), mUnigramCount(0), mBigramCount(0),
               mExtendedRegionSize(0), mHasHistoricalInfoOfWords(false),
@@ -139,6 +144,8 @@ class HeaderPolicy : public DictionaryHeaderStructurePolicy {
         switch (mDictFormatVersion) {
             case FormatUtils::VERSION_2:
                 return FormatUtils::VERSION_2;
+            case FormatUtils::VERSION_2_LOUDS:
+                return FormatUtils::VERSION_2_LOUDS;
             case FormatUtils::VERSION_4_ONLY_FOR_TESTING:
                 return FormatUtils::VERSION_4_ONLY_FOR_TESTING;
             case FormatUtils::VERSION_4:
@@ -207,9 +214,8 @@ class HeaderPolicy : public DictionaryHeaderStructurePolicy {
         return !isDecayingDict();
     }
 
-    const DictionaryHeaderStructurePolicy::AttributeMap *getAttributeMap() const {
-        return &mAttributeMap;
-    }
+    // The attribute map of a header read from a dictionary buffer is built on the first call.
+    const DictionaryHeaderStructurePolicy::AttributeMap *getAttributeMap() const;
 
     AK_FORCE_INLINE int getForgettingCurveOccurrencesToLevelUp() const {
         return mForgettingCurveOccurrencesToLevelUp;
@@ -238,6 +244,11 @@ class HeaderPolicy : public DictionaryHeaderStructurePolicy {
             const int unigramCount, const int bigramCount,
             const int extendedRegionSize, BufferWithExtendableBuffer *const outBuffer) const;
 
+    // Same as above, and records the checksum of the body that is written with the header.
+    bool fillInAndWriteHeaderToBuffer(const bool updatesLastDecayedTime,
+            const int unigramCount, const int bigramCount, const int extendedRegionSize,
+            const uint32_t bodyChecksum, BufferWithExtendableBuffer *const outBuffer) const;
+
     void fillInHeader(const bool updatesLastDecayedTime,
             const int unigramCount, const int bigramCount, const int extendedRegionSize,
             DictionaryHeaderStructurePolicy::AttributeMap *outAttributeMap) const;
@@ -246,6 +257,10 @@ class HeaderPolicy : public DictionaryHeaderStructurePolicy {
         return &mLocale;
     }
 
+    // Returns whether the header has the checksum of the dictionary body. The checksum is
+    // optional: only headers written with the checksum of their body have it.
+    bool readBodyChecksum(uint32_t *const outChecksum) const;
+
     bool supportsBeginningOfSentence() const {
         return mDictFormatVersion >= FormatUtils::VERSION_4;
     }
@@ -268,6 +283,7 @@ class HeaderPolicy : public DictionaryHeaderStructurePolicy {
     static const char *const FORGETTING_CURVE_DURATION_TO_LEVEL_DOWN_IN_SECONDS_KEY;
     static const char *const MAX_UNIGRAM_COUNT_KEY;
     static const char *const MAX_BIGRAM_COUNT_KEY;
+    static const char *const BODY_CHECKSUM_KEY;
     static const int DEFAULT_MULTIPLE_WORDS_DEMOTION_RATE;
     static const float MULTIPLE_WORD_COST_MULTIPLIER_SCALE;
     static const int DEFAULT_FORGETTING_CURVE_OCCURRENCES_TO_LEVEL_UP;
@@ -279,7 +295,11 @@ class HeaderPolicy : public DictionaryHeaderStructurePolicy {
     const FormatUtils::FORMAT_VERSION mDictFormatVersion;
     const HeaderReadWriteUtils::DictionaryFlags mDictionaryFlags;
     const int mSize;
-    DictionaryHeaderStructurePolicy::AttributeMap mAttributeMap;
+    // Attributes of the dictionary buffer. Invalid when the header is not read from a buffer.
+    const HeaderAttributeView mAttributeView;
+    // Materialized lazily from mAttributeView when mAttributeView is valid.
+    mutable DictionaryHeaderStructurePolicy::AttributeMap mAttributeMap;
+    mutable std::once_flag mAttributeMapMaterializationFlag;
     const std::vector<int> mLocale;
     const float mMultiWordCostMultiplier;
     const bool mRequiresGermanUmlautProcessing;
@@ -299,9 +319,12 @@ class HeaderPolicy : public DictionaryHeaderStructurePolicy {
     const std::vector<int> readLocale() const;
     float readMultipleWordCostMultiplier() const;
     bool readRequiresGermanUmlautProcessing() const;
-
-    static DictionaryHeaderStructurePolicy::AttributeMap createAttributeMapAndReadAllAttributes(
-            const uint8_t *const dictBuf);
+    int readIntAttributeValue(const char *const key, const int defaultValue) const;
+    bool readBoolAttributeValue(const char *const key, const bool defaultValue) const;
+    const DictionaryHeaderStructurePolicy::AttributeMap createAttributeMap() const;
+    bool writeHeaderToBuffer(
+            const DictionaryHeaderStructurePolicy::AttributeMap *const attributeMap,
+            BufferWithExtendableBuffer *const outBuffer) const;
 };
 } // namespace latinime
 #endif /* LATINIME_HEADER_POLICY_H */
@@ -57,6 +57,12 @@ class SingleDictContent : public DictContent {
         return mIsValid;
     }
 
+    void prepareForWriting() {
+        if (mMmappedBuffer) {
+            mMmappedBuffer->prepareForWriting();
+        }
+    }
+
     bool isNearSizeLimit() const {
         return mExpandableContentBuffer.isNearSizeLimit();
     }
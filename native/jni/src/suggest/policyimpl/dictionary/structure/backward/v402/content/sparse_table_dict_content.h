@@ -80,12 +80,28 @@ class SparseTableDictContent : public DictContent {
         return mIsValid;
     }
 
+    void prepareForWriting() {
+        if (mLookupTableBuffer) {
+            mLookupTableBuffer->prepareForWriting();
+        }
+        if (mAddressTableBuffer) {
+            mAddressTableBuffer->prepareForWriting();
+        }
+        if (mContentBuffer) {
+            mContentBuffer->prepareForWriting();
+        }
+    }
+
     bool isNearSizeLimit() const {
         return mExpandableLookupTableBuffer.isNearSizeLimit()
                 || mExpandableAddressTableBuffer.isNearSizeLimit()
                 || mExpandableContentBuffer.isNearSizeLimit();
     }
 
+    bool verifyStructure() const {
+        return mAddressLookupTable.verifyStructure(mExpandableContentBuffer.getTailPosition());
+    }
+
  protected:
     SparseTable *getUpdatableAddressLookupTable() {
         return &mAddressLookupTable;
@@ -56,6 +56,9 @@ class TerminalPositionLookupTable : public SingleDictContent {
 
     bool flushToFile(const char *const dictPath) const;
 
+    // Checks that every terminal position is inside the trie.
+    bool verifyStructure(const int trieSize) const;
+
     bool runGCTerminalIds(TerminalIdMap *const terminalIdMap);
 
  private:
@@ -28,6 +28,7 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 
+#include "suggest/policyimpl/dictionary/structure/backward/v402/ver4_pt_node_array_reader.h"
 #include "suggest/policyimpl/dictionary/utils/dict_file_writing_utils.h"
 #include "suggest/policyimpl/dictionary/utils/file_utils.h"
 #include "utils/byte_array_view.h"
@@ -46,8 +47,34 @@ namespace v402 {
     }
     // TODO: take only dictDirPath, and open both header and trie files in the constructor below
     const bool isUpdatable = headerBuffer->isUpdatable();
-    return Ver4DictBuffersPtr(new Ver4DictBuffers(dictPath, std::move(headerBuffer), isUpdatable,
-            formatVersion));
+    Ver4DictBuffersPtr dictBuffers(new Ver4DictBuffers(dictPath, std::move(headerBuffer),
+            isUpdatable, formatVersion));
+    // Detect broken dictionaries here rather than while they are being read for suggestions.
+    if (dictBuffers->isValid() && !dictBuffers->verifyStructure()) {
+        return Ver4DictBuffersPtr(nullptr);
+    }
+    return dictBuffers;
+}
+
+bool Ver4DictBuffers::verifyStructure() const {
+    if (!Ver4PtNodeArrayReader(&mExpandableTrieBuffer).verifyRootPtNodeArray(
+            mExpandableTrieBuffer.getTailPosition())) {
+        AKLOGE("The trie of the dictionary is corrupted.");
+        return false;
+    }
+    if (!mTerminalPositionLookupTable.verifyStructure(mExpandableTrieBuffer.getTailPosition())) {
+        AKLOGE("The terminal position lookup table of the dictionary is corrupted.");
+        return false;
+    }
+    if (!mBigramDictContent.verifyStructure()) {
+        AKLOGE("The bigram content of the dictionary is corrupted.");
+        return false;
+    }
+    if (!mShortcutDictContent.verifyStructure()) {
+        AKLOGE("The shortcut content of the dictionary is corrupted.");
+        return false;
+    }
+    return true;
 }
 
 bool Ver4DictBuffers::flushHeaderAndDictBuffers(const char *const dictDirPath,
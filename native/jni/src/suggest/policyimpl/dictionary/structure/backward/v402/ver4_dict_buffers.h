@@ -119,6 +119,20 @@ class Ver4DictBuffers {
         return mIsUpdatable;
     }
 
+    // Must be called before the mapped files are written in place.
+    void prepareForWriting() {
+        if (mHeaderBuffer) {
+            mHeaderBuffer->prepareForWriting();
+        }
+        if (mDictBuffer) {
+            mDictBuffer->prepareForWriting();
+        }
+        mTerminalPositionLookupTable.prepareForWriting();
+        mProbabilityDictContent.prepareForWriting();
+        mBigramDictContent.prepareForWriting();
+        mShortcutDictContent.prepareForWriting();
+    }
+
     bool flush(const char *const dictDirPath) const {
         return flushHeaderAndDictBuffers(dictDirPath, &mExpandableHeaderBuffer);
     }
@@ -135,6 +149,10 @@ class Ver4DictBuffers {
 
     Ver4DictBuffers(const HeaderPolicy *const headerPolicy, const int maxTrieSize);
 
+    // Checks the trie, the terminal position lookup table and the bigram and shortcut address
+    // tables, so that broken dictionaries are detected when they are opened.
+    bool verifyStructure() const;
+
     const MmappedBuffer::MmappedBufferPtr mHeaderBuffer;
     const MmappedBuffer::MmappedBufferPtr mDictBuffer;
     const HeaderPolicy mHeaderPolicy;
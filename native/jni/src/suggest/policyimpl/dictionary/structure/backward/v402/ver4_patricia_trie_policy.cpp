@@ -28,6 +28,7 @@
 
 #include "suggest/core/dicnode/dic_node.h"
 #include "suggest/core/dicnode/dic_node_vector.h"
+#include "suggest/core/dictionary/child_pt_node_listener.h"
 #include "suggest/core/dictionary/ngram_listener.h"
 #include "suggest/core/dictionary/property/bigram_property.h"
 #include "suggest/core/dictionary/property/unigram_property.h"
@@ -57,8 +58,14 @@ void Ver4PatriciaTriePolicy::createAndGetAllChildDicNodes(const DicNode *const d
     if (!dicNode->hasChildren()) {
         return;
     }
+    DicNodeVector::LeavingChildPusher leavingChildPusher(dicNode, childDicNodes);
+    iterateChildPtNodes(dicNode->getChildrenPtNodeArrayPos(), &leavingChildPusher);
+}
+
+void Ver4PatriciaTriePolicy::iterateChildPtNodes(const int ptNodeArrayPos,
+        ChildPtNodeListener *const listener) const {
     DynamicPtReadingHelper readingHelper(&mNodeReader, &mPtNodeArrayReader);
-    readingHelper.initWithPtNodeArrayPos(dicNode->getChildrenPtNodeArrayPos());
+    readingHelper.initWithPtNodeArrayPos(ptNodeArrayPos);
     while (!readingHelper.isEnd()) {
         const PtNodeParams ptNodeParams = readingHelper.getPtNodeParams();
         if (!ptNodeParams.isValid()) {
@@ -76,16 +83,15 @@ void Ver4PatriciaTriePolicy::createAndGetAllChildDicNodes(const DicNode *const d
             // Skip PtNodes that represent non-word information.
             continue;
         }
-        childDicNodes->pushLeavingChild(dicNode, ptNodeParams.getHeadPos(),
-                ptNodeParams.getChildrenPos(), ptNodeParams.getProbability(), isTerminal,
-                ptNodeParams.hasChildren(),
+        listener->onVisitChildPtNode(ptNodeParams.getHeadPos(), ptNodeParams.getChildrenPos(),
+                ptNodeParams.getProbability(), isTerminal, ptNodeParams.hasChildren(),
                 ptNodeParams.isBlacklisted()
                         || ptNodeParams.isNotAWord() /* isBlacklistedOrNotAWord */,
                 ptNodeParams.getCodePointCount(), ptNodeParams.getCodePoints());
     }
     if (readingHelper.isError()) {
         mIsCorrupted = true;
-        AKLOGE("Dictionary reading error in createAndGetAllChildDicNodes().");
+        AKLOGE("Dictionary reading error in iterateChildPtNodes().");
     }
 }
 
@@ -107,8 +113,9 @@ int Ver4PatriciaTriePolicy::getTerminalPtNodePositionOfWord(const int *const inW
         const int length, const bool forceLowerCaseSearch) const {
     DynamicPtReadingHelper readingHelper(&mNodeReader, &mPtNodeArrayReader);
     readingHelper.initWithPtNodeArrayPos(getRootPosition());
-    const int ptNodePos =
-            readingHelper.getTerminalPtNodePositionOfWord(inWord, length, forceLowerCaseSearch);
+    // The trie can be updated, so it doesn't have a FirstCodePointLookupTable.
+    const int ptNodePos = readingHelper.getTerminalPtNodePositionOfWord(inWord, length,
+            forceLowerCaseSearch, nullptr /* firstCodePointLookupTable */);
     if (readingHelper.isError()) {
         mIsCorrupted = true;
         AKLOGE("Dictionary reading error in createAndGetAllChildDicNodes().");
@@ -132,6 +139,13 @@ int Ver4PatriciaTriePolicy::getProbability(const int unigramProbability,
     }
 }
 
+int Ver4PatriciaTriePolicy::getUnigramProbabilityOfPtNode(const int ptNodePos) const {
+    if (ptNodePos == NOT_A_DICT_POS) {
+        return NOT_A_PROBABILITY;
+    }
+    return mNodeReader.fetchPtNodeParamsInBufferFromPtNodePos(ptNodePos).getProbability();
+}
+
 int Ver4PatriciaTriePolicy::getProbabilityOfPtNode(const int *const prevWordsPtNodePos,
         const int ptNodePos) const {
     if (ptNodePos == NOT_A_DICT_POS) {
@@ -199,6 +213,7 @@ bool Ver4PatriciaTriePolicy::addUnigramEntry(const int *const word, const int le
         AKLOGI("Warning: addUnigramEntry() is called for non-updatable dictionary.");
         return false;
     }
+    mBuffers->prepareForWriting();
     if (mDictBuffer->getTailPosition() >= MIN_DICT_SIZE_TO_REFUSE_DYNAMIC_OPERATIONS) {
         AKLOGE("The dictionary is too large to dynamically update. Dictionary size: %d",
                 mDictBuffer->getTailPosition());
@@ -264,6 +279,7 @@ bool Ver4PatriciaTriePolicy::addNgramEntry(const PrevWordsInfo *const prevWordsI
         AKLOGI("Warning: addNgramEntry() is called for non-updatable dictionary.");
         return false;
     }
+    mBuffers->prepareForWriting();
     if (mDictBuffer->getTailPosition() >= MIN_DICT_SIZE_TO_REFUSE_DYNAMIC_OPERATIONS) {
         AKLOGE("The dictionary is too large to dynamically update. Dictionary size: %d",
                 mDictBuffer->getTailPosition());
@@ -326,6 +342,7 @@ bool Ver4PatriciaTriePolicy::removeNgramEntry(const PrevWordsInfo *const prevWor
         AKLOGI("Warning: removeNgramEntry() is called for non-updatable dictionary.");
         return false;
     }
+    mBuffers->prepareForWriting();
     if (mDictBuffer->getTailPosition() >= MIN_DICT_SIZE_TO_REFUSE_DYNAMIC_OPERATIONS) {
         AKLOGE("The dictionary is too large to dynamically update. Dictionary size: %d",
                 mDictBuffer->getTailPosition());
@@ -377,6 +394,8 @@ bool Ver4PatriciaTriePolicy::flushWithGC(const char *const filePath) {
         AKLOGI("Warning: flushWithGC() is called for non-updatable dictionary.");
         return false;
     }
+    // GC marks and updates PtNodes in place before writing the new buffers.
+    mBuffers->prepareForWriting();
     if (!mWritingHelper.writeToDictFileWithGC(getRootPosition(), filePath)) {
         AKLOGE("Cannot flush the dictionary to file with GC.");
         mIsCorrupted = true;
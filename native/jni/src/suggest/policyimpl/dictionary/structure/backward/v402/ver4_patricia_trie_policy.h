@@ -25,6 +25,7 @@
 #ifndef LATINIME_BACKWARD_V402_VER4_PATRICIA_TRIE_POLICY_H
 #define LATINIME_BACKWARD_V402_VER4_PATRICIA_TRIE_POLICY_H
 
+#include <atomic>
 #include <vector>
 
 #include "defines.h"
@@ -81,6 +82,14 @@ class Ver4PatriciaTriePolicy : public DictionaryStructureWithBufferPolicy {
     void createAndGetAllChildDicNodes(const DicNode *const dicNode,
             DicNodeVector *const childDicNodes) const;
 
+    // The probabilities are read with the PtNodes.
+    void createAndGetAllChildDicNodesWithoutProbabilities(const DicNode *const dicNode,
+            DicNodeVector *const childDicNodes) const {
+        createAndGetAllChildDicNodes(dicNode, childDicNodes);
+    }
+
+    void iterateChildPtNodes(const int ptNodeArrayPos, ChildPtNodeListener *const listener) const;
+
     int getCodePointsAndProbabilityAndReturnCodePointCount(
             const int terminalPtNodePos, const int maxCodePointCount, int *const outCodePoints,
             int *const outUnigramProbability) const;
@@ -92,6 +101,8 @@ class Ver4PatriciaTriePolicy : public DictionaryStructureWithBufferPolicy {
 
     int getProbabilityOfPtNode(const int *const prevWordsPtNodePos, const int ptNodePos) const;
 
+    int getUnigramProbabilityOfPtNode(const int ptNodePos) const;
+
     void iterateNgramEntries(const int *const prevWordsPtNodePos,
             NgramListener *const listener) const;
 
@@ -163,7 +174,8 @@ class Ver4PatriciaTriePolicy : public DictionaryStructureWithBufferPolicy {
     int mUnigramCount;
     int mBigramCount;
     std::vector<int> mTerminalPtNodePositionsForIteratingWords;
-    mutable bool mIsCorrupted;
+    // Set from const methods of a policy that can be shared between threads.
+    mutable std::atomic<bool> mIsCorrupted;
 
     int getBigramsPositionOfPtNode(const int ptNodePos) const;
 };
@@ -140,7 +140,8 @@ bool Ver4PatriciaTrieWritingHelper::runGC(const int rootPtNodeArrayPos,
     DynamicPtGcEventListeners::TraversePolicyToPlaceAndWriteValidPtNodesToBuffer
             traversePolicyToPlaceAndWriteValidPtNodesToBuffer(&ptNodeWriterForNewBuffers,
                     buffersToWrite->getWritableTrieBuffer(), &dictPositionRelocationMap);
-    if (!readingHelper.traverseAllPtNodesInPtNodeArrayLevelPreorderDepthFirstManner(
+    if (!readingHelper.traverseAllPtNodesInPtNodeArrayLevelBlockedManner(
+            true /* ordersSiblingsByProbability */,
             &traversePolicyToPlaceAndWriteValidPtNodesToBuffer)) {
         return false;
     }
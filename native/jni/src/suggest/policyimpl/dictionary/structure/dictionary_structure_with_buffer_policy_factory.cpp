@@ -16,13 +16,17 @@
 
 #include "suggest/policyimpl/dictionary/structure/dictionary_structure_with_buffer_policy_factory.h"
 
+#include <cerrno>
 #include <climits>
+#include <sys/stat.h>
 
 #include "defines.h"
 #include "suggest/policyimpl/dictionary/structure/backward/v402/ver4_dict_buffers.h"
 #include "suggest/policyimpl/dictionary/structure/backward/v402/ver4_dict_constants.h"
 #include "suggest/policyimpl/dictionary/structure/backward/v402/ver4_patricia_trie_policy.h"
+#include "suggest/policyimpl/dictionary/structure/louds/louds_trie_policy.h"
 #include "suggest/policyimpl/dictionary/structure/pt_common/dynamic_pt_writing_utils.h"
+#include "suggest/policyimpl/dictionary/structure/shared_dictionary_structure_with_buffer_policy.h"
 #include "suggest/policyimpl/dictionary/structure/v2/patricia_trie_policy.h"
 #include "suggest/policyimpl/dictionary/structure/v4/ver4_dict_buffers.h"
 #include "suggest/policyimpl/dictionary/structure/v4/ver4_dict_constants.h"
@@ -35,6 +39,15 @@
 
 namespace latinime {
 
+// Read-only dictionaries start with the header followed by the root PtNode array, and every
+// search starts from there. Huge page alignment lets a large main dictionary be mapped with a
+// fraction of the page table entries. Locking is disabled by default because the hot prefix is
+// prefetched anyway and a locked region counts against RLIMIT_MEMLOCK.
+const MmappedBuffer::LoadingPolicy
+        DictionaryStructureWithBufferPolicyFactory::READ_ONLY_DICT_LOADING_POLICY(
+                true /* adviseRandomAccess */, 16 * 1024 /* prefetchedPrefixSize */,
+                0 /* lockedPrefixSize */, true /* useHugePageAlignment */);
+
 /* static */ DictionaryStructureWithBufferPolicy::StructurePolicyPtr
         DictionaryStructureWithBufferPolicyFactory::newPolicyForExistingDictFile(
                 const char *const path, const int bufOffset, const int size,
@@ -115,6 +128,7 @@ template<class DictConstants, class DictBuffers, class DictBuffersPtr, class Str
             mmappedBuffer->getReadOnlyByteArrayView().size());
     switch (formatVersion) {
         case FormatUtils::VERSION_2:
+        case FormatUtils::VERSION_2_LOUDS:
             AKLOGE("Given path is a directory but the format is version 2. path: %s", path);
             break;
         case FormatUtils::VERSION_4: {
@@ -164,21 +178,94 @@ template<class DictConstants, class DictBuffers, class DictBuffersPtr, class Str
             new StructurePolicy(std::move(dictBuffers)));
 }
 
+// Read-only file dictionaries are typically opened several times, e.g. by the main input and by
+// the spell checker. The mapping and the parsed header are shared by all of them. The file
+// identity is part of the key so that a dictionary replaced by an update is opened anew.
 /* static */ DictionaryStructureWithBufferPolicy::StructurePolicyPtr
         DictionaryStructureWithBufferPolicyFactory::newPolicyForFileDict(
                 const char *const path, const int bufOffset, const int size) {
+    struct stat fileStat;
+    if (stat(path, &fileStat) != 0) {
+        AKLOGE("DICT: Can't stat the dictionary file. path: %s errno: %d", path, errno);
+        return nullptr;
+    }
+    const FileDictKey key(std::string(path), bufOffset, size, fileStat.st_dev, fileStat.st_ino,
+            fileStat.st_mtime);
+    SharedFileDictRegistry *const registry = getSharedFileDictRegistry();
+    std::lock_guard<std::mutex> lock(registry->mMutex);
+    std::map<FileDictKey, SharedFileDictPolicy> *const policies = &registry->mPolicies;
+    for (auto it = policies->begin(); it != policies->end();) {
+        if (it->second.second.expired()) {
+            it = policies->erase(it);
+        } else {
+            ++it;
+        }
+    }
+    std::shared_ptr<DictionaryStructureWithBufferPolicy> sharedPolicy;
+    FormatUtils::FORMAT_VERSION formatVersion = FormatUtils::UNKNOWN_VERSION;
+    const auto it = policies->find(key);
+    if (it != policies->end()) {
+        formatVersion = it->second.first;
+        sharedPolicy = it->second.second.lock();
+    }
+    if (!sharedPolicy) {
+        sharedPolicy = openPolicyForFileDict(path, bufOffset, size, &formatVersion);
+        if (!sharedPolicy) {
+            return nullptr;
+        }
+        (*policies)[key] = SharedFileDictPolicy(formatVersion, sharedPolicy);
+    }
+    return newSharedPolicyHandle(formatVersion, sharedPolicy);
+}
+
+// The registry is intentionally leaked. Dictionaries can still be opened and closed by other
+// threads while static objects are destroyed at exit.
+/* static */ DictionaryStructureWithBufferPolicyFactory::SharedFileDictRegistry *
+        DictionaryStructureWithBufferPolicyFactory::getSharedFileDictRegistry() {
+    static SharedFileDictRegistry *const registry = new SharedFileDictRegistry();
+    return registry;
+}
+
+/* static */ DictionaryStructureWithBufferPolicy::StructurePolicyPtr
+        DictionaryStructureWithBufferPolicyFactory::newSharedPolicyHandle(
+                const FormatUtils::FORMAT_VERSION formatVersion,
+                const std::shared_ptr<DictionaryStructureWithBufferPolicy> &sharedPolicy) {
+    switch (formatVersion) {
+        case FormatUtils::VERSION_2:
+            return DictionaryStructureWithBufferPolicy::StructurePolicyPtr(
+                    new SharedDictionaryStructureWithBufferPolicy<PatriciaTriePolicy>(
+                            std::static_pointer_cast<PatriciaTriePolicy>(sharedPolicy)));
+        case FormatUtils::VERSION_2_LOUDS:
+            return DictionaryStructureWithBufferPolicy::StructurePolicyPtr(
+                    new SharedDictionaryStructureWithBufferPolicy<LoudsTriePolicy>(
+                            std::static_pointer_cast<LoudsTriePolicy>(sharedPolicy)));
+        default:
+            break;
+    }
+    ASSERT(false);
+    return nullptr;
+}
+
+/* static */ std::shared_ptr<DictionaryStructureWithBufferPolicy>
+        DictionaryStructureWithBufferPolicyFactory::openPolicyForFileDict(
+                const char *const path, const int bufOffset, const int size,
+                FormatUtils::FORMAT_VERSION *const outFormatVersion) {
     // Allocated buffer in MmapedBuffer::openBuffer() will be freed in the destructor of
     // MmappedBufferPtr if the instance has the responsibility.
     MmappedBuffer::MmappedBufferPtr mmappedBuffer(
-            MmappedBuffer::openBuffer(path, bufOffset, size, false /* isUpdatable */));
+            MmappedBuffer::openBuffer(path, bufOffset, size, false /* isUpdatable */,
+                    READ_ONLY_DICT_LOADING_POLICY));
     if (!mmappedBuffer) {
         return nullptr;
     }
-    switch (FormatUtils::detectFormatVersion(mmappedBuffer->getReadOnlyByteArrayView().data(),
-            mmappedBuffer->getReadOnlyByteArrayView().size())) {
+    *outFormatVersion = FormatUtils::detectFormatVersion(
+            mmappedBuffer->getReadOnlyByteArrayView().data(),
+            mmappedBuffer->getReadOnlyByteArrayView().size());
+    switch (*outFormatVersion) {
         case FormatUtils::VERSION_2:
-            return DictionaryStructureWithBufferPolicy::StructurePolicyPtr(
-                    new PatriciaTriePolicy(std::move(mmappedBuffer)));
+            return std::make_shared<PatriciaTriePolicy>(std::move(mmappedBuffer));
+        case FormatUtils::VERSION_2_LOUDS:
+            return std::make_shared<LoudsTriePolicy>(std::move(mmappedBuffer));
         case FormatUtils::VERSION_4_ONLY_FOR_TESTING:
         case FormatUtils::VERSION_4:
         case FormatUtils::VERSION_4_DEV:
@@ -17,6 +17,12 @@
 #ifndef LATINIME_DICTIONARY_STRUCTURE_WITH_BUFFER_POLICY_FACTORY_H
 #define LATINIME_DICTIONARY_STRUCTURE_WITH_BUFFER_POLICY_FACTORY_H
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+#include <tuple>
 #include <vector>
 
 #include "defines.h"
@@ -40,6 +46,25 @@ class DictionaryStructureWithBufferPolicyFactory {
  private:
     DISALLOW_IMPLICIT_CONSTRUCTORS(DictionaryStructureWithBufferPolicyFactory);
 
+    // (path, offset, size, device, inode, mtime) of a dictionary file.
+    typedef std::tuple<std::string, int, int, dev_t, ino_t, time_t> FileDictKey;
+
+    static const MmappedBuffer::LoadingPolicy READ_ONLY_DICT_LOADING_POLICY;
+
+    // Structure policy of an opened read-only file dictionary with its format version, which
+    // tells the concrete class of the policy.
+    typedef std::pair<FormatUtils::FORMAT_VERSION,
+            std::weak_ptr<DictionaryStructureWithBufferPolicy>> SharedFileDictPolicy;
+
+    // Structure policies of the opened read-only file dictionaries. Entries are dropped lazily
+    // once all the Dictionary instances using them have been closed.
+    struct SharedFileDictRegistry {
+        std::map<FileDictKey, SharedFileDictPolicy> mPolicies;
+        std::mutex mMutex;
+    };
+
+    static SharedFileDictRegistry *getSharedFileDictRegistry();
+
     template<class DictConstants, class DictBuffers, class DictBuffersPtr, class StructurePolicy>
     static DictionaryStructureWithBufferPolicy::StructurePolicyPtr
             newPolicyForOnMemoryV4Dict(const FormatUtils::FORMAT_VERSION formatVersion,
@@ -57,6 +82,14 @@ class DictionaryStructureWithBufferPolicyFactory {
     static DictionaryStructureWithBufferPolicy::StructurePolicyPtr
             newPolicyForFileDict(const char *const path, const int bufOffset, const int size);
 
+    static std::shared_ptr<DictionaryStructureWithBufferPolicy> openPolicyForFileDict(
+            const char *const path, const int bufOffset, const int size,
+            FormatUtils::FORMAT_VERSION *const outFormatVersion);
+
+    static DictionaryStructureWithBufferPolicy::StructurePolicyPtr newSharedPolicyHandle(
+            const FormatUtils::FORMAT_VERSION formatVersion,
+            const std::shared_ptr<DictionaryStructureWithBufferPolicy> &sharedPolicy);
+
     static void getHeaderFilePathInDictDir(const char *const dirPath,
             const int outHeaderFileBufSize, char *const outHeaderFilePath);
 };
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_LOUDS_BIGRAM_LIST_POLICY_H
+#define LATINIME_LOUDS_BIGRAM_LIST_POLICY_H
+
+#include <cstdint>
+
+#include "defines.h"
+#include "suggest/core/policy/dictionary_bigrams_structure_policy.h"
+#include "suggest/policyimpl/dictionary/utils/byte_array_utils.h"
+
+namespace latinime {
+
+/*
+ * A bigram list of the LOUDS format is an array of 4-byte entries:
+ *   flags (1 byte): has next (0x80), probability (0x0F)
+ *   terminal rank of the target word (3 bytes)
+ */
+class LoudsBigramListPolicy : public DictionaryBigramsStructurePolicy {
+ public:
+    static const int BIGRAM_ENTRY_SIZE = 4;
+    static const uint8_t FLAG_HAS_NEXT = 0x80;
+    static const uint8_t MASK_PROBABILITY = 0x0F;
+    static const int MAX_TARGET_PT_NODE_INDEX = 0xFFFFFF;
+
+    LoudsBigramListPolicy(const uint8_t *const bigramsBuf, const int bufSize)
+            : mBigramsBuf(bigramsBuf), mBufSize(bufSize) {}
+
+    ~LoudsBigramListPolicy() {}
+
+    void getNextBigram(int *const outBigramPos, int *const outProbability, bool *const outHasNext,
+            int *const pos) const {
+        if (*pos < 0 || *pos + BIGRAM_ENTRY_SIZE > mBufSize) {
+            AKLOGE("Cannot read bigram entry. mBufSize: %d, pos: %d. ", mBufSize, *pos);
+            *outBigramPos = NOT_A_DICT_POS;
+            *outProbability = NOT_A_PROBABILITY;
+            *outHasNext = false;
+            return;
+        }
+        const uint8_t flags = ByteArrayUtils::readUint8AndAdvancePosition(mBigramsBuf, pos);
+        *outBigramPos = ByteArrayUtils::readUint24AndAdvancePosition(mBigramsBuf, pos);
+        *outProbability = flags & MASK_PROBABILITY;
+        *outHasNext = (flags & FLAG_HAS_NEXT) != 0;
+    }
+
+    bool skipAllBigrams(int *const pos) const {
+        while (*pos >= 0 && *pos + BIGRAM_ENTRY_SIZE <= mBufSize) {
+            const uint8_t flags = ByteArrayUtils::readUint8(mBigramsBuf, *pos);
+            *pos += BIGRAM_ENTRY_SIZE;
+            if ((flags & FLAG_HAS_NEXT) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(LoudsBigramListPolicy);
+
+    const uint8_t *const mBigramsBuf;
+    const int mBufSize;
+};
+} // namespace latinime
+#endif // LATINIME_LOUDS_BIGRAM_LIST_POLICY_H
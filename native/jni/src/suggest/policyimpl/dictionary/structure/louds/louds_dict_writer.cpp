@@ -0,0 +1,264 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/policyimpl/dictionary/structure/louds/louds_dict_writer.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+#include "suggest/core/dictionary/binary_dictionary_bigrams_iterator.h"
+#include "suggest/policyimpl/dictionary/header/header_policy.h"
+#include "suggest/policyimpl/dictionary/structure/louds/louds_bigram_list_policy.h"
+#include "suggest/policyimpl/dictionary/structure/louds/louds_trie_reading_utils.h"
+#include "suggest/policyimpl/dictionary/structure/pt_common/patricia_trie_reading_utils.h"
+#include "suggest/policyimpl/dictionary/structure/pt_common/pt_node_params.h"
+#include "suggest/policyimpl/dictionary/structure/v2/bigram/bigram_list_policy.h"
+#include "suggest/policyimpl/dictionary/structure/v2/shortcut/shortcut_list_policy.h"
+#include "suggest/policyimpl/dictionary/structure/v2/ver2_patricia_trie_node_reader.h"
+#include "suggest/policyimpl/dictionary/structure/v2/ver2_pt_node_array_reader.h"
+#include "suggest/policyimpl/dictionary/utils/byte_array_utils.h"
+#include "suggest/policyimpl/dictionary/utils/dict_file_writing_utils.h"
+#include "suggest/policyimpl/dictionary/utils/format_utils.h"
+#include "suggest/policyimpl/dictionary/utils/succinct_bit_vector.h"
+
+namespace latinime {
+
+typedef LoudsTrieReadingUtils LtReadingUtils;
+
+/* static */ bool LoudsDictWriter::writeDictFileFromVer2Dict(
+        const ReadOnlyByteArrayView ver2Dict, const char *const filePath) {
+    if (FormatUtils::detectFormatVersion(ver2Dict.data(), ver2Dict.size())
+            != FormatUtils::VERSION_2) {
+        AKLOGE("The dictionary to convert is not a version 2 dictionary.");
+        return false;
+    }
+    const HeaderPolicy ver2HeaderPolicy(ver2Dict.data(), FormatUtils::VERSION_2);
+    std::vector<uint8_t> body;
+    int unigramCount = 0;
+    int bigramCount = 0;
+    if (!createBody(ver2Dict.data() + ver2HeaderPolicy.getSize(),
+            ver2Dict.size() - ver2HeaderPolicy.getSize(), &body, &unigramCount, &bigramCount)) {
+        return false;
+    }
+    return DictFileWritingUtils::writeDictFileConvertedFromVer2(filePath, ver2Dict,
+            FormatUtils::VERSION_2_LOUDS, unigramCount, bigramCount, &body);
+}
+
+// PtNode arrays are read in breadth-first order, which gives the index of every node, before
+// the sections are made, because bigram targets can be anywhere.
+/* static */ bool LoudsDictWriter::createBody(const uint8_t *const ver2DictRoot,
+        const int ver2DictSize, std::vector<uint8_t> *const outBody, int *const outUnigramCount,
+        int *const outBigramCount) {
+    const BigramListPolicy ver2BigramListPolicy(ver2DictRoot, ver2DictSize);
+    const ShortcutListPolicy ver2ShortcutListPolicy(ver2DictRoot);
+    const Ver2ParticiaTrieNodeReader ver2PtNodeReader(ver2DictRoot, ver2DictSize,
+            &ver2BigramListPolicy, &ver2ShortcutListPolicy);
+    const Ver2PtNodeArrayReader ver2PtNodeArrayReader(ver2DictRoot, ver2DictSize);
+    // The root node doesn't have a version 2 PtNode.
+    std::vector<int> ver2PtNodePositions(1 /* size */, NOT_A_DICT_POS);
+    std::vector<int> childCounts;
+    std::unordered_map<int, int> nodeIndices;
+    // Pairs of the first code point and the version 2 position of the PtNodes in an array.
+    std::vector<std::pair<int, int>> children;
+    for (int index = 0; index < static_cast<int>(ver2PtNodePositions.size()); ++index) {
+        int ver2PtNodeArrayPos = NOT_A_DICT_POS;
+        if (index == LtReadingUtils::ROOT_NODE_INDEX) {
+            ver2PtNodeArrayPos = 0;
+        } else {
+            const PtNodeParams ptNodeParams(ver2PtNodeReader.fetchPtNodeParamsInBufferFromPtNodePos(
+                    ver2PtNodePositions[index]));
+            if (ptNodeParams.hasChildren()) {
+                ver2PtNodeArrayPos = ptNodeParams.getChildrenPos();
+            }
+        }
+        children.clear();
+        if (ver2PtNodeArrayPos != NOT_A_DICT_POS) {
+            int ptNodeCount = 0;
+            int ver2PtNodePos = NOT_A_DICT_POS;
+            if (!ver2PtNodeArrayReader.readPtNodeArrayInfoAndReturnIfValid(ver2PtNodeArrayPos,
+                    &ptNodeCount, &ver2PtNodePos)) {
+                return false;
+            }
+            for (int i = 0; i < ptNodeCount; ++i) {
+                const PtNodeParams ptNodeParams(
+                        ver2PtNodeReader.fetchPtNodeParamsInBufferFromPtNodePos(ver2PtNodePos));
+                if (!ptNodeParams.isValid()) {
+                    return false;
+                }
+                children.emplace_back(ptNodeParams.getCodePoints()[0], ver2PtNodePos);
+                ver2PtNodePos = ptNodeParams.getSiblingNodePos();
+            }
+        }
+        std::stable_sort(children.begin(), children.end(),
+                [](const std::pair<int, int> &left, const std::pair<int, int> &right) {
+                    return left.first < right.first;
+                });
+        for (size_t i = 0; i < children.size(); ++i) {
+            if (i > 0 && children[i - 1].first == children[i].first) {
+                AKLOGE("PtNodes in an array start with the same code point: %x",
+                        children[i].first);
+                return false;
+            }
+            if (!nodeIndices.emplace(children[i].second, ver2PtNodePositions.size()).second) {
+                AKLOGE("PtNode is reached twice. pos: %d", children[i].second);
+                return false;
+            }
+            ver2PtNodePositions.push_back(children[i].second);
+        }
+        childCounts.push_back(children.size());
+    }
+    const int nodeCount = ver2PtNodePositions.size();
+    // Terminal ranks, and the alphabet of the most frequent code points.
+    std::vector<int> terminalRanks(nodeCount, NOT_A_DICT_POS);
+    std::unordered_map<int, int> codePointCounts;
+    int terminalCount = 0;
+    for (int index = LtReadingUtils::ROOT_NODE_INDEX + 1; index < nodeCount; ++index) {
+        const PtNodeParams ptNodeParams(ver2PtNodeReader.fetchPtNodeParamsInBufferFromPtNodePos(
+                ver2PtNodePositions[index]));
+        if (ptNodeParams.isTerminal()) {
+            terminalRanks[index] = terminalCount++;
+        }
+        for (int i = 0; i < ptNodeParams.getCodePointCount(); ++i) {
+            ++codePointCounts[ptNodeParams.getCodePoints()[i]];
+        }
+    }
+    if (terminalCount > LoudsBigramListPolicy::MAX_TARGET_PT_NODE_INDEX + 1) {
+        AKLOGE("Too many terminals: %d", terminalCount);
+        return false;
+    }
+    std::vector<std::pair<int, int>> alphabet(codePointCounts.begin(), codePointCounts.end());
+    std::sort(alphabet.begin(), alphabet.end(),
+            [](const std::pair<int, int> &left, const std::pair<int, int> &right) {
+                return left.second != right.second ? left.second > right.second
+                        : left.first < right.first;
+            });
+    if (alphabet.size() > LtReadingUtils::MAX_ALPHABET_SIZE) {
+        alphabet.resize(LtReadingUtils::MAX_ALPHABET_SIZE);
+    }
+    std::unordered_map<int, int> symbols;
+    std::vector<uint8_t> alphabetSection;
+    for (size_t i = 0; i < alphabet.size(); ++i) {
+        symbols[alphabet[i].first] = i;
+        appendUint(alphabet[i].first, LtReadingUtils::CODE_POINT_FIELD_SIZE, &alphabetSection);
+    }
+    // Makes the other sections.
+    std::vector<bool> loudsBits;
+    for (int index = 0; index < nodeCount; ++index) {
+        loudsBits.insert(loudsBits.end(), childCounts[index], true);
+        loudsBits.push_back(false);
+    }
+    std::vector<bool> labelBoundaryBits;
+    std::vector<bool> terminalBits(1 /* size */, false);
+    std::vector<bool> payloadBits;
+    std::vector<uint8_t> labels;
+    std::vector<uint8_t> probabilities;
+    std::vector<uint8_t> payloadOffsets;
+    std::vector<uint8_t> payload;
+    std::vector<std::pair<int, int>> bigramEntries;
+    *outUnigramCount = terminalCount;
+    *outBigramCount = 0;
+    for (int index = LtReadingUtils::ROOT_NODE_INDEX + 1; index < nodeCount; ++index) {
+        const PtNodeParams ptNodeParams(ver2PtNodeReader.fetchPtNodeParamsInBufferFromPtNodePos(
+                ver2PtNodePositions[index]));
+        for (int i = 0; i < ptNodeParams.getCodePointCount(); ++i) {
+            const int codePoint = ptNodeParams.getCodePoints()[i];
+            const auto it = symbols.find(codePoint);
+            labelBoundaryBits.push_back(i == 0);
+            if (it != symbols.end()) {
+                appendUint(it->second, 1 /* size */, &labels);
+            } else {
+                appendUint(LtReadingUtils::ESCAPE_SYMBOL, 1 /* size */, &labels);
+                labelBoundaryBits.insert(labelBoundaryBits.end(),
+                        LtReadingUtils::CODE_POINT_FIELD_SIZE, false);
+                appendUint(codePoint, LtReadingUtils::CODE_POINT_FIELD_SIZE, &labels);
+            }
+        }
+        terminalBits.push_back(ptNodeParams.isTerminal());
+        if (!ptNodeParams.isTerminal()) {
+            continue;
+        }
+        appendUint(ptNodeParams.getProbability(), LtReadingUtils::PROBABILITY_FIELD_SIZE,
+                &probabilities);
+        bigramEntries.clear();
+        BinaryDictionaryBigramsIterator bigramsIt(&ver2BigramListPolicy,
+                ptNodeParams.getBigramsPos());
+        while (bigramsIt.hasNext()) {
+            bigramsIt.next();
+            const auto it = nodeIndices.find(bigramsIt.getBigramPos());
+            if (it != nodeIndices.end() && terminalRanks[it->second] != NOT_A_DICT_POS) {
+                bigramEntries.emplace_back(terminalRanks[it->second], bigramsIt.getProbability());
+            }
+        }
+        const bool hasPayload = ptNodeParams.isBlacklisted() || ptNodeParams.isNotAWord()
+                || ptNodeParams.hasShortcutTargets() || !bigramEntries.empty();
+        payloadBits.push_back(hasPayload);
+        if (!hasPayload) {
+            continue;
+        }
+        appendUint(payload.size(), LtReadingUtils::PAYLOAD_OFFSET_FIELD_SIZE, &payloadOffsets);
+        appendUint(PatriciaTrieReadingUtils::createAndGetFlags(ptNodeParams.isBlacklisted(),
+                ptNodeParams.isNotAWord(), true /* isTerminal */,
+                ptNodeParams.hasShortcutTargets(), !bigramEntries.empty(),
+                false /* hasMultipleChars */, 0 /* childrenPositionFieldSize */),
+                LtReadingUtils::PAYLOAD_FLAGS_FIELD_SIZE, &payload);
+        if (ptNodeParams.hasShortcutTargets()) {
+            // The shortcut list has the same format. Its size field includes itself.
+            const int shortcutPos = ptNodeParams.getShortcutPos();
+            const int shortcutListSize = ByteArrayUtils::readUint16(ver2DictRoot, shortcutPos);
+            if (shortcutListSize > ver2DictSize - shortcutPos) {
+                return false;
+            }
+            payload.insert(payload.end(), ver2DictRoot + shortcutPos,
+                    ver2DictRoot + shortcutPos + shortcutListSize);
+        }
+        for (size_t i = 0; i < bigramEntries.size(); ++i) {
+            const bool hasNext = i + 1 < bigramEntries.size();
+            appendUint((hasNext ? LoudsBigramListPolicy::FLAG_HAS_NEXT : 0)
+                    | (bigramEntries[i].second & LoudsBigramListPolicy::MASK_PROBABILITY),
+                    1 /* size */, &payload);
+            appendUint(bigramEntries[i].first, 3 /* size */, &payload);
+        }
+        *outBigramCount += bigramEntries.size();
+    }
+    outBody->clear();
+    appendUint(nodeCount, LtReadingUtils::NODE_COUNT_FIELD_SIZE, outBody);
+    SuccinctBitVector::appendToBuffer(loudsBits, outBody);
+    SuccinctBitVector::appendToBuffer(labelBoundaryBits, outBody);
+    SuccinctBitVector::appendToBuffer(terminalBits, outBody);
+    SuccinctBitVector::appendToBuffer(payloadBits, outBody);
+    appendSection(alphabetSection, outBody);
+    appendSection(labels, outBody);
+    appendSection(probabilities, outBody);
+    appendSection(payloadOffsets, outBody);
+    appendSection(payload, outBody);
+    return true;
+}
+
+/* static */ void LoudsDictWriter::appendUint(const uint32_t data, const int size,
+        std::vector<uint8_t> *const buffer) {
+    int pos = buffer->size();
+    buffer->resize(pos + size);
+    ByteArrayUtils::writeUintAndAdvancePosition(buffer->data(), data, size, &pos);
+}
+
+/* static */ void LoudsDictWriter::appendSection(const std::vector<uint8_t> &section,
+        std::vector<uint8_t> *const buffer) {
+    appendUint(section.size(), LtReadingUtils::SECTION_SIZE_FIELD_SIZE, buffer);
+    buffer->insert(buffer->end(), section.begin(), section.end());
+}
+
+} // namespace latinime
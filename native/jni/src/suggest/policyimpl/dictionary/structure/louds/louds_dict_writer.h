@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_LOUDS_DICT_WRITER_H
+#define LATINIME_LOUDS_DICT_WRITER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "defines.h"
+#include "utils/byte_array_view.h"
+
+namespace latinime {
+
+// Writes a LOUDS dictionary with the content of a version 2 dictionary, which is what the
+// dictionary compiler makes. See LoudsTrieReadingUtils for the format.
+class LoudsDictWriter {
+ public:
+    static bool writeDictFileFromVer2Dict(const ReadOnlyByteArrayView ver2Dict,
+            const char *const filePath);
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(LoudsDictWriter);
+
+    static bool createBody(const uint8_t *const ver2DictRoot, const int ver2DictSize,
+            std::vector<uint8_t> *const outBody, int *const outUnigramCount,
+            int *const outBigramCount);
+    static void appendUint(const uint32_t data, const int size,
+            std::vector<uint8_t> *const buffer);
+    static void appendSection(const std::vector<uint8_t> &section,
+            std::vector<uint8_t> *const buffer);
+};
+} // namespace latinime
+#endif // LATINIME_LOUDS_DICT_WRITER_H
@@ -0,0 +1,539 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/policyimpl/dictionary/structure/louds/louds_trie_policy.h"
+
+#include <climits>
+#include <cstdio>
+#include <cstring>
+
+#include "defines.h"
+#include "suggest/core/dicnode/dic_node.h"
+#include "suggest/core/dicnode/dic_node_vector.h"
+#include "suggest/core/dictionary/binary_dictionary_bigrams_iterator.h"
+#include "suggest/core/dictionary/child_pt_node_listener.h"
+#include "suggest/core/dictionary/ngram_listener.h"
+#include "suggest/policyimpl/dictionary/structure/pt_common/shortcut/shortcut_list_reading_utils.h"
+#include "suggest/policyimpl/dictionary/utils/probability_utils.h"
+#include "utils/char_utils.h"
+#include "utils/memory_usage_utils.h"
+
+namespace latinime {
+
+typedef LoudsTrieReadingUtils LtReadingUtils;
+typedef PatriciaTrieReadingUtils PtReadingUtils;
+
+const char *const LoudsTriePolicy::RESIDENT_SIZE_QUERY = "RESIDENT_SIZE";
+const char *const LoudsTriePolicy::MAJOR_PAGE_FAULT_COUNT_QUERY = "MAJOR_PAGE_FAULT_COUNT";
+const char *const LoudsTriePolicy::MINOR_PAGE_FAULT_COUNT_QUERY = "MINOR_PAGE_FAULT_COUNT";
+
+void LoudsTriePolicy::createAndGetAllChildDicNodes(const DicNode *const dicNode,
+        DicNodeVector *const childDicNodes) const {
+    if (!dicNode->hasChildren()) {
+        return;
+    }
+    DicNodeVector::LeavingChildPusher leavingChildPusher(dicNode, childDicNodes);
+    iterateChildPtNodes(dicNode->getChildrenPtNodeArrayPos(), &leavingChildPusher);
+}
+
+// The children are consecutive nodes, so their labels, their LOUDS bits and their terminal
+// ranks are read sequentially after one select or rank for each.
+void LoudsTriePolicy::iterateChildPtNodes(const int ptNodeArrayPos,
+        ChildPtNodeListener *const listener) const {
+    if (mIsCorrupted) {
+        return;
+    }
+    if (ptNodeArrayPos < 0 || ptNodeArrayPos >= mLoudsBits.getBitCount()) {
+        AKLOGE("Children PtNode array position is invalid. pos: %d, LOUDS bit count: %d",
+                ptNodeArrayPos, mLoudsBits.getBitCount());
+        ASSERT(false);
+        return;
+    }
+    int firstChildIndex = 0;
+    int childCount = 0;
+    getChildren(ptNodeArrayPos, &firstChildIndex, &childCount);
+    if (childCount == 0) {
+        return;
+    }
+    int childLoudsPos = getLoudsPos(firstChildIndex);
+    int labelPos = getLabelPos(firstChildIndex);
+    int terminalRank = mTerminalBits.rank1(firstChildIndex);
+    int codePoints[MAX_WORD_LENGTH];
+    for (int nodeIndex = firstChildIndex; nodeIndex < firstChildIndex + childCount;
+            ++nodeIndex) {
+        const int labelEndPos = getLabelEndPos(labelPos);
+        const int codePointCount =
+                readLabelAndReturnCodePointCount(labelPos, labelEndPos, codePoints);
+        if (codePointCount == 0) {
+            return;
+        }
+        labelPos = labelEndPos;
+        const int loudsPos = childLoudsPos;
+        const bool hasChildren = mLoudsBits.get(loudsPos);
+        childLoudsPos = mLoudsBits.getNextClearBitPos(loudsPos) + 1;
+        const bool isTerminal = mTerminalBits.get(nodeIndex);
+        int probability = NOT_A_PROBABILITY;
+        bool isBlacklistedOrNotAWord = false;
+        if (isTerminal) {
+            probability = getTerminalProbability(terminalRank);
+            const int payloadPos = getPayloadPos(terminalRank);
+            if (payloadPos != NOT_A_DICT_POS) {
+                const PtReadingUtils::NodeFlags flags = getPayloadFlags(payloadPos);
+                isBlacklistedOrNotAWord =
+                        PtReadingUtils::isBlacklisted(flags) || PtReadingUtils::isNotAWord(flags);
+            }
+            ++terminalRank;
+        }
+        // Skip PtNodes don't start with Unicode code point because they represent non-word
+        // information.
+        if (!CharUtils::isInUnicodeSpace(codePoints[0])) {
+            continue;
+        }
+        listener->onVisitChildPtNode(nodeIndex, hasChildren ? loudsPos : NOT_A_DICT_POS,
+                probability, isTerminal, hasChildren, isBlacklistedOrNotAWord, codePointCount,
+                codePoints);
+    }
+}
+
+// The word is read by going up to the root with select on the LOUDS bits.
+int LoudsTriePolicy::getCodePointsAndProbabilityAndReturnCodePointCount(
+        const int nodePos, const int maxCodePointCount, int *const outCodePoints,
+        int *const outUnigramProbability) const {
+    *outUnigramProbability = NOT_A_PROBABILITY;
+    if (mIsCorrupted || !isValidNodePos(nodePos)) {
+        return 0;
+    }
+    int nodeIndices[MAX_WORD_LENGTH];
+    int depth = 0;
+    for (int nodeIndex = nodePos; nodeIndex != LtReadingUtils::ROOT_NODE_INDEX;
+            nodeIndex = getParentNodeIndex(nodeIndex)) {
+        if (nodeIndex == NOT_A_DICT_POS || depth >= MAX_WORD_LENGTH) {
+            AKLOGE("Cannot find the path to the node. pos: %d", nodePos);
+            mIsCorrupted = true;
+            ASSERT(false);
+            return 0;
+        }
+        nodeIndices[depth++] = nodeIndex;
+    }
+    int codePointCount = 0;
+    int codePoints[MAX_WORD_LENGTH];
+    for (int i = depth - 1; i >= 0; --i) {
+        const int labelPos = getLabelPos(nodeIndices[i]);
+        const int nodeCodePointCount = readLabelAndReturnCodePointCount(labelPos,
+                getLabelEndPos(labelPos), codePoints);
+        for (int j = 0; j < nodeCodePointCount && codePointCount < maxCodePointCount; ++j) {
+            outCodePoints[codePointCount++] = codePoints[j];
+        }
+    }
+    if (mTerminalBits.get(nodePos)) {
+        *outUnigramProbability = getTerminalProbability(mTerminalBits.rank1(nodePos));
+    }
+    return codePointCount;
+}
+
+// This function gets the position of the terminal node of the exact matching word in the
+// dictionary. If no match is found, it returns NOT_A_DICT_POS.
+int LoudsTriePolicy::getTerminalPtNodePositionOfWord(const int *const inWord,
+        const int length, const bool forceLowerCaseSearch) const {
+    if (mIsCorrupted) {
+        return NOT_A_DICT_POS;
+    }
+    int nodeIndex = LtReadingUtils::ROOT_NODE_INDEX;
+    int matchedCodePointCount = 0;
+    int codePoints[MAX_WORD_LENGTH];
+    while (matchedCodePointCount < length) {
+        int firstChildIndex = 0;
+        int childCount = 0;
+        getChildren(getLoudsPos(nodeIndex), &firstChildIndex, &childCount);
+        const int codePoint = forceLowerCaseSearch
+                ? CharUtils::toLowerCase(inWord[matchedCodePointCount])
+                : inWord[matchedCodePointCount];
+        int labelPos = (childCount > 0) ? getLabelPos(firstChildIndex) : 0;
+        int labelEndPos = 0;
+        nodeIndex = NOT_A_DICT_POS;
+        // Siblings are sorted by their first code point.
+        for (int childIndex = firstChildIndex; childIndex < firstChildIndex + childCount;
+                ++childIndex) {
+            labelEndPos = getLabelEndPos(labelPos);
+            int pos = labelPos;
+            const int firstCodePoint = readCodePointAndAdvancePosition(labelEndPos, &pos);
+            if (firstCodePoint == codePoint) {
+                nodeIndex = childIndex;
+                break;
+            }
+            if (firstCodePoint > codePoint || firstCodePoint == NOT_A_CODE_POINT) {
+                return NOT_A_DICT_POS;
+            }
+            labelPos = labelEndPos;
+        }
+        if (nodeIndex == NOT_A_DICT_POS) {
+            return NOT_A_DICT_POS;
+        }
+        const int codePointCount =
+                readLabelAndReturnCodePointCount(labelPos, labelEndPos, codePoints);
+        if (codePointCount == 0 || matchedCodePointCount + codePointCount > length) {
+            return NOT_A_DICT_POS;
+        }
+        for (int i = 1; i < codePointCount; ++i) {
+            const int wordCodePoint = inWord[matchedCodePointCount + i];
+            if (codePoints[i] != (forceLowerCaseSearch ? CharUtils::toLowerCase(wordCodePoint)
+                    : wordCodePoint)) {
+                return NOT_A_DICT_POS;
+            }
+        }
+        matchedCodePointCount += codePointCount;
+    }
+    return (nodeIndex != NOT_A_DICT_POS && mTerminalBits.get(nodeIndex))
+            ? nodeIndex : NOT_A_DICT_POS;
+}
+
+int LoudsTriePolicy::getProbability(const int unigramProbability,
+        const int bigramProbability) const {
+    // The probabilities are the ones of the version 2 dictionary, so they are combined in the
+    // same way as PatriciaTriePolicy does.
+    if (unigramProbability == NOT_A_PROBABILITY) {
+        return NOT_A_PROBABILITY;
+    } else if (bigramProbability == NOT_A_PROBABILITY) {
+        return ProbabilityUtils::backoff(unigramProbability);
+    } else {
+        return ProbabilityUtils::computeProbabilityForBigram(unigramProbability,
+                bigramProbability);
+    }
+}
+
+int LoudsTriePolicy::getUnigramProbabilityOfPtNode(const int ptNodePos) const {
+    if (mIsCorrupted || !isValidNodePos(ptNodePos) || !mTerminalBits.get(ptNodePos)) {
+        return NOT_A_PROBABILITY;
+    }
+    return getTerminalProbability(mTerminalBits.rank1(ptNodePos));
+}
+
+// Bigram targets are terminal ranks, so the rank of the node is compared with them.
+int LoudsTriePolicy::getProbabilityOfPtNode(const int *const prevWordsPtNodePos,
+        const int ptNodePos) const {
+    if (mIsCorrupted || !isValidNodePos(ptNodePos) || !mTerminalBits.get(ptNodePos)) {
+        return NOT_A_PROBABILITY;
+    }
+    const int terminalRank = mTerminalBits.rank1(ptNodePos);
+    const int payloadPos = getPayloadPos(terminalRank);
+    if (payloadPos != NOT_A_DICT_POS) {
+        const PtReadingUtils::NodeFlags flags = getPayloadFlags(payloadPos);
+        if (PtReadingUtils::isNotAWord(flags) || PtReadingUtils::isBlacklisted(flags)) {
+            // If this is not a word, or if it's a blacklisted entry, it should behave as
+            // having no probability outside of the suggestion process (where it should be used
+            // for shortcuts).
+            return NOT_A_PROBABILITY;
+        }
+    }
+    const int unigramProbability = getTerminalProbability(terminalRank);
+    if (prevWordsPtNodePos) {
+        BinaryDictionaryBigramsIterator bigramsIt(&mBigramListPolicy,
+                getBigramsPos(prevWordsPtNodePos[0]));
+        while (bigramsIt.hasNext()) {
+            bigramsIt.next();
+            if (bigramsIt.getBigramPos() == terminalRank
+                    && bigramsIt.getProbability() != NOT_A_PROBABILITY) {
+                return getProbability(unigramProbability, bigramsIt.getProbability());
+            }
+        }
+        return NOT_A_PROBABILITY;
+    }
+    return getProbability(unigramProbability, NOT_A_PROBABILITY);
+}
+
+void LoudsTriePolicy::iterateNgramEntries(const int *const prevWordsPtNodePos,
+        NgramListener *const listener) const {
+    if (!prevWordsPtNodePos) {
+        return;
+    }
+    BinaryDictionaryBigramsIterator bigramsIt(&mBigramListPolicy,
+            getBigramsPos(prevWordsPtNodePos[0]));
+    while (bigramsIt.hasNext()) {
+        bigramsIt.next();
+        const int targetNodePos = mTerminalBits.select1(bigramsIt.getBigramPos());
+        listener->onVisitEntry(bigramsIt.getProbability(),
+                (targetNodePos < mNodeCount) ? targetNodePos : NOT_A_DICT_POS);
+    }
+}
+
+int LoudsTriePolicy::getShortcutPositionOfPtNode(const int ptNodePos) const {
+    return getShortcutPos(ptNodePos);
+}
+
+const WordProperty LoudsTriePolicy::getWordProperty(const int *const codePoints,
+        const int codePointCount) const {
+    const int nodePos = getTerminalPtNodePositionOfWord(codePoints, codePointCount,
+            false /* forceLowerCaseSearch */);
+    if (nodePos == NOT_A_DICT_POS) {
+        AKLOGE("getWordProperty was called for invalid word.");
+        return WordProperty();
+    }
+    const int terminalRank = mTerminalBits.rank1(nodePos);
+    const int payloadPos = getPayloadPos(terminalRank);
+    const PtReadingUtils::NodeFlags flags =
+            (payloadPos != NOT_A_DICT_POS) ? getPayloadFlags(payloadPos) : 0;
+    const std::vector<int> codePointVector(codePoints, codePoints + codePointCount);
+    // Fetch bigram information.
+    std::vector<BigramProperty> bigrams;
+    int bigramWord1CodePoints[MAX_WORD_LENGTH];
+    BinaryDictionaryBigramsIterator bigramsIt(&mBigramListPolicy, getBigramsPos(nodePos));
+    while (bigramsIt.hasNext()) {
+        // Fetch the next bigram information and forward the iterator.
+        bigramsIt.next();
+        int word1Probability = NOT_A_PROBABILITY;
+        const int word1CodePointCount = getCodePointsAndProbabilityAndReturnCodePointCount(
+                mTerminalBits.select1(bigramsIt.getBigramPos()), MAX_WORD_LENGTH,
+                bigramWord1CodePoints, &word1Probability);
+        const std::vector<int> word1(bigramWord1CodePoints,
+                bigramWord1CodePoints + word1CodePointCount);
+        const int probability = getProbability(word1Probability, bigramsIt.getProbability());
+        bigrams.emplace_back(&word1, probability,
+                NOT_A_TIMESTAMP /* timestamp */, 0 /* level */, 0 /* count */);
+    }
+    // Fetch shortcut information.
+    std::vector<UnigramProperty::ShortcutProperty> shortcuts;
+    int shortcutPos = getShortcutPos(nodePos);
+    if (shortcutPos != NOT_A_DICT_POS) {
+        const uint8_t *const payload = mPayload.data();
+        int shortcutTargetCodePoints[MAX_WORD_LENGTH];
+        ShortcutListReadingUtils::getShortcutListSizeAndForwardPointer(payload, &shortcutPos);
+        bool hasNext = true;
+        while (hasNext) {
+            const ShortcutListReadingUtils::ShortcutFlags shortcutFlags =
+                    ShortcutListReadingUtils::getFlagsAndForwardPointer(payload, &shortcutPos);
+            hasNext = ShortcutListReadingUtils::hasNext(shortcutFlags);
+            const int shortcutTargetLength = ShortcutListReadingUtils::readShortcutTarget(
+                    payload, MAX_WORD_LENGTH, shortcutTargetCodePoints, &shortcutPos);
+            const std::vector<int> shortcutTarget(shortcutTargetCodePoints,
+                    shortcutTargetCodePoints + shortcutTargetLength);
+            const int shortcutProbability =
+                    ShortcutListReadingUtils::getProbabilityFromFlags(shortcutFlags);
+            shortcuts.emplace_back(&shortcutTarget, shortcutProbability);
+        }
+    }
+    const bool isNotAWord = PtReadingUtils::isNotAWord(flags);
+    const UnigramProperty unigramProperty(
+            isNotAWord && codePoints[0] == CODE_POINT_BEGINNING_OF_SENTENCE, isNotAWord,
+            PtReadingUtils::isBlacklisted(flags), getTerminalProbability(terminalRank),
+            NOT_A_TIMESTAMP /* timestamp */, 0 /* level */, 0 /* count */, &shortcuts);
+    return WordProperty(&codePointVector, &unigramProperty, &bigrams);
+}
+
+// The token is the position of the terminal node of the word to return next.
+int LoudsTriePolicy::getNextWordAndNextToken(const int token, int *const outCodePoints,
+        int *const outCodePointCount,
+        std::vector<int> *const terminalPtNodePositionsForIteratingWords) const {
+    *outCodePointCount = 0;
+    if (mIsCorrupted) {
+        return 0;
+    }
+    const int terminalNodePos = (token == 0) ? mTerminalBits.select1(0 /* index */) : token;
+    if (!isValidNodePos(terminalNodePos) || !mTerminalBits.get(terminalNodePos)) {
+        AKLOGE("Given token %d is invalid.", token);
+        return 0;
+    }
+    int unigramProbability = NOT_A_PROBABILITY;
+    *outCodePointCount = getCodePointsAndProbabilityAndReturnCodePointCount(terminalNodePos,
+            MAX_WORD_LENGTH, outCodePoints, &unigramProbability);
+    const int nextToken = mTerminalBits.getNextSetBitPos(terminalNodePos + 1);
+    // 0 means that all words have been iterated.
+    return (nextToken < mNodeCount) ? nextToken : 0;
+}
+
+void LoudsTriePolicy::getProperty(const char *const query, const int queryLength,
+        char *const outResult, const int maxResultLength) {
+    const int compareLength = queryLength + 1 /* terminator */;
+    if (strncmp(query, RESIDENT_SIZE_QUERY, compareLength) == 0) {
+        snprintf(outResult, maxResultLength, "%d", mMmappedBuffer->getResidentSize());
+    } else if (strncmp(query, MAJOR_PAGE_FAULT_COUNT_QUERY, compareLength) == 0) {
+        snprintf(outResult, maxResultLength, "%d", MemoryUsageUtils::getMajorPageFaultCount());
+    } else if (strncmp(query, MINOR_PAGE_FAULT_COUNT_QUERY, compareLength) == 0) {
+        snprintf(outResult, maxResultLength, "%d", MemoryUsageUtils::getMinorPageFaultCount());
+    } else if (maxResultLength > 0) {
+        outResult[0] = '\0';
+    }
+}
+
+/* static */ int LoudsTriePolicy::readNodeCount(const uint8_t *const dictRoot,
+        const int dictBufferSize) {
+    if (dictBufferSize < LtReadingUtils::NODE_COUNT_FIELD_SIZE) {
+        return 0;
+    }
+    const uint32_t nodeCount =
+            ByteArrayUtils::readUint32(dictRoot, LtReadingUtils::NODE_COUNT_FIELD_POS);
+    // Each node has at least 2 LOUDS bits.
+    if (nodeCount > static_cast<uint32_t>(dictBufferSize) * CHAR_BIT / 2) {
+        AKLOGE("Node count is invalid. node count: %u, buffer size: %d", nodeCount,
+                dictBufferSize);
+        return 0;
+    }
+    return static_cast<int>(nodeCount);
+}
+
+/* static */ const ReadOnlyByteArrayView LoudsTriePolicy::readSection(
+        const uint8_t *const dictRoot, const int dictBufferSize, const int pos) {
+    if (pos < 0 || pos > dictBufferSize - LtReadingUtils::SECTION_SIZE_FIELD_SIZE) {
+        return ReadOnlyByteArrayView(dictRoot + dictBufferSize, 0 /* size */);
+    }
+    const uint32_t sectionSize = ByteArrayUtils::readUint32(dictRoot, pos);
+    const int sectionPos = pos + LtReadingUtils::SECTION_SIZE_FIELD_SIZE;
+    if (sectionSize > static_cast<uint32_t>(dictBufferSize - sectionPos)) {
+        AKLOGE("Section doesn't fit in the buffer. pos: %d, size: %u, buffer size: %d", pos,
+                sectionSize, dictBufferSize);
+        return ReadOnlyByteArrayView(dictRoot + dictBufferSize, 0 /* size */);
+    }
+    return ReadOnlyByteArrayView(dictRoot + sectionPos, sectionSize);
+}
+
+// The sizes of the sections are checked against each other once, so that the readers don't
+// check the bounds of every access.
+bool LoudsTriePolicy::checkSections() const {
+    if (mNodeCount <= LtReadingUtils::ROOT_NODE_INDEX || !mLoudsBits.isValid()
+            || !mLabelBoundaryBits.isValid() || !mTerminalBits.isValid()
+            || !mPayloadBits.isValid()) {
+        AKLOGE("LOUDS dictionary is broken. node count: %d", mNodeCount);
+        return false;
+    }
+    const int edgeCount = mNodeCount - 1;
+    const int terminalCount = mTerminalBits.getOneCount();
+    if (mLoudsBits.getBitCount() != mNodeCount + edgeCount
+            || mLoudsBits.getOneCount() != edgeCount
+            || mLabelBoundaryBits.getBitCount() != static_cast<int>(mLabels.size())
+            || mLabelBoundaryBits.getOneCount() != edgeCount
+            || (edgeCount > 0 && !mLabelBoundaryBits.get(0))
+            || mTerminalBits.getBitCount() != mNodeCount
+            || mTerminalBits.get(LtReadingUtils::ROOT_NODE_INDEX)
+            || mPayloadBits.getBitCount() != terminalCount
+            || mAlphabet.size() % LtReadingUtils::CODE_POINT_FIELD_SIZE != 0
+            || mAlphabetSize > LtReadingUtils::MAX_ALPHABET_SIZE
+            || static_cast<int>(mProbabilities.size())
+                    != terminalCount * LtReadingUtils::PROBABILITY_FIELD_SIZE
+            || static_cast<int>(mPayloadOffsets.size())
+                    != mPayloadBits.getOneCount() * LtReadingUtils::PAYLOAD_OFFSET_FIELD_SIZE) {
+        AKLOGE("Sections of LOUDS dictionary don't match. node count: %d", mNodeCount);
+        return false;
+    }
+    return true;
+}
+
+// The LOUDS bits of node i are after the (i - 1)-th zero.
+int LoudsTriePolicy::getLoudsPos(const int nodeIndex) const {
+    return (nodeIndex == LtReadingUtils::ROOT_NODE_INDEX)
+            ? 0 : mLoudsBits.select0(nodeIndex - 1) + 1;
+}
+
+// The children of a node start after the children of the nodes before it, so the first child is
+// the number of the ones before the LOUDS bits of the node plus the root.
+void LoudsTriePolicy::getChildren(const int loudsPos, int *const outFirstChildIndex,
+        int *const outChildCount) const {
+    *outChildCount = mLoudsBits.getNextClearBitPos(loudsPos) - loudsPos;
+    *outFirstChildIndex = mLoudsBits.rank1(loudsPos) + 1;
+}
+
+// Node i (i > 0) is the child that the (i - 1)-th one makes, and the parent is the number of
+// zeros before the one.
+int LoudsTriePolicy::getParentNodeIndex(const int nodeIndex) const {
+    const int onePos = mLoudsBits.select1(nodeIndex - 1);
+    if (onePos >= mLoudsBits.getBitCount()) {
+        return NOT_A_DICT_POS;
+    }
+    return onePos - (nodeIndex - 1);
+}
+
+// Returns 0 when the label is broken.
+int LoudsTriePolicy::readLabelAndReturnCodePointCount(const int labelPos,
+        const int labelEndPos, int *const outCodePoints) const {
+    int pos = labelPos;
+    int codePointCount = 0;
+    while (pos < labelEndPos) {
+        const int codePoint = readCodePointAndAdvancePosition(labelEndPos, &pos);
+        if (codePoint == NOT_A_CODE_POINT || codePointCount >= MAX_WORD_LENGTH) {
+            AKLOGE("Label is invalid. pos: %d, end pos: %d", labelPos, labelEndPos);
+            mIsCorrupted = true;
+            ASSERT(false);
+            return 0;
+        }
+        outCodePoints[codePointCount++] = codePoint;
+    }
+    return codePointCount;
+}
+
+int LoudsTriePolicy::getTerminalProbability(const int terminalRank) const {
+    return ByteArrayUtils::readUint8(mProbabilities.data(),
+            terminalRank * LtReadingUtils::PROBABILITY_FIELD_SIZE);
+}
+
+int LoudsTriePolicy::getPayloadPos(const int terminalRank) const {
+    if (!mPayloadBits.get(terminalRank)) {
+        return NOT_A_DICT_POS;
+    }
+    const int payloadPos = ByteArrayUtils::readUint32(mPayloadOffsets.data(),
+            mPayloadBits.rank1(terminalRank) * LtReadingUtils::PAYLOAD_OFFSET_FIELD_SIZE);
+    if (payloadPos < 0 || payloadPos
+            > static_cast<int>(mPayload.size()) - LtReadingUtils::PAYLOAD_FLAGS_FIELD_SIZE) {
+        AKLOGE("Payload position is invalid. pos: %d, payload size: %zd", payloadPos,
+                mPayload.size());
+        mIsCorrupted = true;
+        ASSERT(false);
+        return NOT_A_DICT_POS;
+    }
+    return payloadPos;
+}
+
+PatriciaTrieReadingUtils::NodeFlags LoudsTriePolicy::getPayloadFlags(const int payloadPos) const {
+    return ByteArrayUtils::readUint8(mPayload.data(), payloadPos);
+}
+
+int LoudsTriePolicy::getShortcutPos(const int nodeIndex) const {
+    if (mIsCorrupted || !isValidNodePos(nodeIndex) || !mTerminalBits.get(nodeIndex)) {
+        return NOT_A_DICT_POS;
+    }
+    const int payloadPos = getPayloadPos(mTerminalBits.rank1(nodeIndex));
+    if (payloadPos == NOT_A_DICT_POS
+            || !PtReadingUtils::hasShortcutTargets(getPayloadFlags(payloadPos))) {
+        return NOT_A_DICT_POS;
+    }
+    return payloadPos + LtReadingUtils::PAYLOAD_FLAGS_FIELD_SIZE;
+}
+
+int LoudsTriePolicy::getBigramsPos(const int nodeIndex) const {
+    if (mIsCorrupted || !isValidNodePos(nodeIndex) || !mTerminalBits.get(nodeIndex)) {
+        return NOT_A_DICT_POS;
+    }
+    const int payloadPos = getPayloadPos(mTerminalBits.rank1(nodeIndex));
+    if (payloadPos == NOT_A_DICT_POS) {
+        return NOT_A_DICT_POS;
+    }
+    const PtReadingUtils::NodeFlags flags = getPayloadFlags(payloadPos);
+    if (!PtReadingUtils::hasBigrams(flags)) {
+        return NOT_A_DICT_POS;
+    }
+    int pos = payloadPos + LtReadingUtils::PAYLOAD_FLAGS_FIELD_SIZE;
+    if (PtReadingUtils::hasShortcutTargets(flags)) {
+        if (pos > static_cast<int>(mPayload.size())
+                - ShortcutListReadingUtils::getShortcutListSizeFieldSize()) {
+            AKLOGE("Shortcut list position is invalid. pos: %d, payload size: %zd", pos,
+                    mPayload.size());
+            mIsCorrupted = true;
+            ASSERT(false);
+            return NOT_A_DICT_POS;
+        }
+        mShortcutListPolicy.skipAllShortcuts(&pos);
+    }
+    return pos;
+}
+
+} // namespace latinime
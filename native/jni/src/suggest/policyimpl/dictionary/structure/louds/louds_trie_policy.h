@@ -0,0 +1,246 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_LOUDS_TRIE_POLICY_H
+#define LATINIME_LOUDS_TRIE_POLICY_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "defines.h"
+#include "suggest/core/policy/dictionary_structure_with_buffer_policy.h"
+#include "suggest/policyimpl/dictionary/header/header_policy.h"
+#include "suggest/policyimpl/dictionary/structure/louds/louds_bigram_list_policy.h"
+#include "suggest/policyimpl/dictionary/structure/louds/louds_trie_reading_utils.h"
+#include "suggest/policyimpl/dictionary/structure/pt_common/patricia_trie_reading_utils.h"
+#include "suggest/policyimpl/dictionary/structure/v2/shortcut/shortcut_list_policy.h"
+#include "suggest/policyimpl/dictionary/utils/format_utils.h"
+#include "suggest/policyimpl/dictionary/utils/mmapped_buffer.h"
+#include "suggest/policyimpl/dictionary/utils/succinct_bit_vector.h"
+#include "utils/byte_array_view.h"
+
+namespace latinime {
+
+class DicNode;
+class DicNodeVector;
+
+// Read-only dictionary with a LOUDS succinct trie. See LoudsTrieReadingUtils for the format. It
+// has the same content as the version 2 dictionary it's converted from. The position of a
+// PtNode is the index of the node, and the position of its children PtNode array is the
+// position of its LOUDS bits, which iterating the PtNodes gives without select.
+class LoudsTriePolicy : public DictionaryStructureWithBufferPolicy {
+ public:
+    LoudsTriePolicy(MmappedBuffer::MmappedBufferPtr mmappedBuffer)
+            : mMmappedBuffer(std::move(mmappedBuffer)),
+              mHeaderPolicy(mMmappedBuffer->getReadOnlyByteArrayView().data(),
+                      FormatUtils::VERSION_2_LOUDS),
+              mDictRoot(mMmappedBuffer->getReadOnlyByteArrayView().data()
+                      + mHeaderPolicy.getSize()),
+              mDictBufferSize(mMmappedBuffer->getReadOnlyByteArrayView().size()
+                      - mHeaderPolicy.getSize()),
+              mNodeCount(readNodeCount(mDictRoot, mDictBufferSize)),
+              mLoudsBits(mDictRoot, mDictBufferSize, LoudsTrieReadingUtils::NODE_COUNT_FIELD_SIZE),
+              mLabelBoundaryBits(mDictRoot, mDictBufferSize, mLoudsBits.getEndPos()),
+              mTerminalBits(mDictRoot, mDictBufferSize, mLabelBoundaryBits.getEndPos()),
+              mPayloadBits(mDictRoot, mDictBufferSize, mTerminalBits.getEndPos()),
+              mAlphabet(readSection(mDictRoot, mDictBufferSize, mPayloadBits.getEndPos())),
+              mLabels(readSection(mDictRoot, mDictBufferSize, getEndPos(mAlphabet))),
+              mProbabilities(readSection(mDictRoot, mDictBufferSize, getEndPos(mLabels))),
+              mPayloadOffsets(readSection(mDictRoot, mDictBufferSize, getEndPos(mProbabilities))),
+              mPayload(readSection(mDictRoot, mDictBufferSize, getEndPos(mPayloadOffsets))),
+              mAlphabetSize(mAlphabet.size() / LoudsTrieReadingUtils::CODE_POINT_FIELD_SIZE),
+              mBigramListPolicy(mPayload.data(), mPayload.size()),
+              mShortcutListPolicy(mPayload.data()), mIsCorrupted(!checkSections()) {}
+
+    // The LOUDS bits of the root are at 0.
+    AK_FORCE_INLINE int getRootPosition() const {
+        return 0;
+    }
+
+    void createAndGetAllChildDicNodes(const DicNode *const dicNode,
+            DicNodeVector *const childDicNodes) const;
+
+    // The probabilities are read with the PtNodes.
+    void createAndGetAllChildDicNodesWithoutProbabilities(const DicNode *const dicNode,
+            DicNodeVector *const childDicNodes) const {
+        createAndGetAllChildDicNodes(dicNode, childDicNodes);
+    }
+
+    void iterateChildPtNodes(const int ptNodeArrayPos, ChildPtNodeListener *const listener) const;
+
+    int getCodePointsAndProbabilityAndReturnCodePointCount(
+            const int terminalNodePos, const int maxCodePointCount, int *const outCodePoints,
+            int *const outUnigramProbability) const;
+
+    int getTerminalPtNodePositionOfWord(const int *const inWord,
+            const int length, const bool forceLowerCaseSearch) const;
+
+    int getProbability(const int unigramProbability, const int bigramProbability) const;
+
+    int getProbabilityOfPtNode(const int *const prevWordsPtNodePos, const int ptNodePos) const;
+
+    int getUnigramProbabilityOfPtNode(const int ptNodePos) const;
+
+    void iterateNgramEntries(const int *const prevWordsPtNodePos,
+            NgramListener *const listener) const;
+
+    int getShortcutPositionOfPtNode(const int ptNodePos) const;
+
+    const DictionaryHeaderStructurePolicy *getHeaderStructurePolicy() const {
+        return &mHeaderPolicy;
+    }
+
+    const DictionaryShortcutsStructurePolicy *getShortcutsStructurePolicy() const {
+        return &mShortcutListPolicy;
+    }
+
+    bool addUnigramEntry(const int *const word, const int length,
+            const UnigramProperty *const unigramProperty) {
+        // This method should not be called for non-updatable dictionary.
+        AKLOGI("Warning: addUnigramEntry() is called for non-updatable dictionary.");
+        return false;
+    }
+
+    bool removeUnigramEntry(const int *const word, const int length) {
+        // This method should not be called for non-updatable dictionary.
+        AKLOGI("Warning: removeUnigramEntry() is called for non-updatable dictionary.");
+        return false;
+    }
+
+    bool addNgramEntry(const PrevWordsInfo *const prevWordsInfo,
+            const BigramProperty *const bigramProperty) {
+        // This method should not be called for non-updatable dictionary.
+        AKLOGI("Warning: addNgramEntry() is called for non-updatable dictionary.");
+        return false;
+    }
+
+    bool removeNgramEntry(const PrevWordsInfo *const prevWordsInfo, const int *const word,
+            const int length) {
+        // This method should not be called for non-updatable dictionary.
+        AKLOGI("Warning: removeNgramEntry() is called for non-updatable dictionary.");
+        return false;
+    }
+
+    bool flush(const char *const filePath) {
+        // This method should not be called for non-updatable dictionary.
+        AKLOGI("Warning: flush() is called for non-updatable dictionary.");
+        return false;
+    }
+
+    bool flushWithGC(const char *const filePath) {
+        // This method should not be called for non-updatable dictionary.
+        AKLOGI("Warning: flushWithGC() is called for non-updatable dictionary.");
+        return false;
+    }
+
+    bool needsToRunGC(const bool mindsBlockByGC) const {
+        // This method should not be called for non-updatable dictionary.
+        AKLOGI("Warning: needsToRunGC() is called for non-updatable dictionary.");
+        return false;
+    }
+
+    void getProperty(const char *const query, const int queryLength, char *const outResult,
+            const int maxResultLength);
+
+    const WordProperty getWordProperty(const int *const codePoints,
+            const int codePointCount) const;
+
+    int getNextWordAndNextToken(const int token, int *const outCodePoints,
+            int *const outCodePointCount) {
+        return getNextWordAndNextToken(token, outCodePoints, outCodePointCount,
+                nullptr /* terminalPtNodePositionsForIteratingWords */);
+    }
+
+    // The token is enough to continue the iteration, so no state is kept.
+    int getNextWordAndNextToken(const int token, int *const outCodePoints,
+            int *const outCodePointCount,
+            std::vector<int> *const terminalPtNodePositionsForIteratingWords) const;
+
+    bool isCorrupted() const {
+        return mIsCorrupted;
+    }
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(LoudsTriePolicy);
+
+    static const char *const RESIDENT_SIZE_QUERY;
+    static const char *const MAJOR_PAGE_FAULT_COUNT_QUERY;
+    static const char *const MINOR_PAGE_FAULT_COUNT_QUERY;
+
+    const MmappedBuffer::MmappedBufferPtr mMmappedBuffer;
+    const HeaderPolicy mHeaderPolicy;
+    const uint8_t *const mDictRoot;
+    const int mDictBufferSize;
+    const int mNodeCount;
+    const SuccinctBitVector mLoudsBits;
+    const SuccinctBitVector mLabelBoundaryBits;
+    const SuccinctBitVector mTerminalBits;
+    const SuccinctBitVector mPayloadBits;
+    const ReadOnlyByteArrayView mAlphabet;
+    const ReadOnlyByteArrayView mLabels;
+    const ReadOnlyByteArrayView mProbabilities;
+    const ReadOnlyByteArrayView mPayloadOffsets;
+    const ReadOnlyByteArrayView mPayload;
+    const int mAlphabetSize;
+    const LoudsBigramListPolicy mBigramListPolicy;
+    const ShortcutListPolicy mShortcutListPolicy;
+    // Set from const methods of a policy that can be shared between threads.
+    mutable std::atomic<bool> mIsCorrupted;
+
+    static int readNodeCount(const uint8_t *const dictRoot, const int dictBufferSize);
+    // Returns an empty view at the end of the buffer when the section doesn't fit in the buffer.
+    static const ReadOnlyByteArrayView readSection(const uint8_t *const dictRoot,
+            const int dictBufferSize, const int pos);
+
+    AK_FORCE_INLINE int getEndPos(const ReadOnlyByteArrayView &section) const {
+        return section.data() + section.size() - mDictRoot;
+    }
+
+    AK_FORCE_INLINE bool isValidNodePos(const int nodePos) const {
+        return nodePos > LoudsTrieReadingUtils::ROOT_NODE_INDEX && nodePos < mNodeCount;
+    }
+
+    // The label of node i (i > 0) starts at the (i - 1)-th label boundary.
+    AK_FORCE_INLINE int getLabelPos(const int nodeIndex) const {
+        return mLabelBoundaryBits.select1(nodeIndex - 1);
+    }
+
+    AK_FORCE_INLINE int getLabelEndPos(const int labelPos) const {
+        return mLabelBoundaryBits.getNextSetBitPos(labelPos + 1);
+    }
+
+    AK_FORCE_INLINE int readCodePointAndAdvancePosition(const int labelEndPos,
+            int *const labelPos) const {
+        return LoudsTrieReadingUtils::readCodePointAndAdvancePosition(mLabels.data(),
+                labelEndPos, mAlphabet.data(), mAlphabetSize, labelPos);
+    }
+
+    bool checkSections() const;
+    int getLoudsPos(const int nodeIndex) const;
+    void getChildren(const int loudsPos, int *const outFirstChildIndex,
+            int *const outChildCount) const;
+    int getParentNodeIndex(const int nodeIndex) const;
+    int readLabelAndReturnCodePointCount(const int labelPos, const int labelEndPos,
+            int *const outCodePoints) const;
+    int getTerminalProbability(const int terminalRank) const;
+    int getPayloadPos(const int terminalRank) const;
+    PatriciaTrieReadingUtils::NodeFlags getPayloadFlags(const int payloadPos) const;
+    int getShortcutPos(const int nodeIndex) const;
+    int getBigramsPos(const int nodeIndex) const;
+};
+} // namespace latinime
+#endif // LATINIME_LOUDS_TRIE_POLICY_H
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_LOUDS_TRIE_READING_UTILS_H
+#define LATINIME_LOUDS_TRIE_READING_UTILS_H
+
+#include <cstdint>
+
+#include "defines.h"
+#include "suggest/policyimpl/dictionary/utils/byte_array_utils.h"
+
+namespace latinime {
+
+/*
+ * The body of a LOUDS dictionary follows the header of the version 2 format and has these
+ * sections in this order:
+ *   node count (4 bytes)
+ *   LOUDS bits: 1 for each child and then 0, for each node (see SuccinctBitVector for the
+ *       layout of bit vectors)
+ *   label boundary bits: 1 for the first label byte of each node
+ *   terminal bits: 1 for each terminal node
+ *   payload bits: 1 for each terminal that has a payload
+ *   alphabet: size (4 bytes), code points (3 bytes each)
+ *   labels: size (4 bytes), label bytes of the nodes except the root
+ *   probabilities: size (4 bytes), probability of each terminal (1 byte each)
+ *   payload offsets: size (4 bytes), offset of each payload (4 bytes each)
+ *   payload: size (4 bytes), payloads
+ *
+ * Nodes are the PtNodes of the version 2 dictionary and the root, in breadth-first order with
+ * the children of a node sorted by their first code point, so the index of a node is its
+ * position and the children of a node are consecutive. A label byte is an index to the
+ * alphabet, or ESCAPE_SYMBOL followed by a code point (3 bytes) that is not in the alphabet.
+ * Terminals are counted by the terminal rank, which is the number of terminal nodes before the
+ * node. A terminal has a payload when it's blacklisted, not a word, or has shortcuts or bigrams.
+ * The payload has the version 2 PtNode flags (1 byte), then the version 2 shortcut list and the
+ * bigram list (see LoudsBigramListPolicy) whose targets are terminal ranks.
+ */
+class LoudsTrieReadingUtils {
+ public:
+    static const int NODE_COUNT_FIELD_POS = 0;
+    static const int NODE_COUNT_FIELD_SIZE = 4;
+    static const int SECTION_SIZE_FIELD_SIZE = 4;
+    static const int ROOT_NODE_INDEX = 0;
+    static const int CODE_POINT_FIELD_SIZE = 3;
+    static const int PROBABILITY_FIELD_SIZE = 1;
+    static const int PAYLOAD_OFFSET_FIELD_SIZE = 4;
+    static const int PAYLOAD_FLAGS_FIELD_SIZE = 1;
+    static const uint8_t ESCAPE_SYMBOL = 0xFF;
+    static const int MAX_ALPHABET_SIZE = ESCAPE_SYMBOL;
+
+    // Returns NOT_A_CODE_POINT when the label byte is not valid or the label is shorter than a
+    // code point.
+    static AK_FORCE_INLINE int readCodePointAndAdvancePosition(const uint8_t *const labels,
+            const int labelEndPos, const uint8_t *const alphabet, const int alphabetSize,
+            int *const pos) {
+        if (*pos >= labelEndPos) {
+            return NOT_A_CODE_POINT;
+        }
+        const uint8_t symbol = ByteArrayUtils::readUint8AndAdvancePosition(labels, pos);
+        if (symbol == ESCAPE_SYMBOL) {
+            if (*pos > labelEndPos - CODE_POINT_FIELD_SIZE) {
+                return NOT_A_CODE_POINT;
+            }
+            return ByteArrayUtils::readUint24AndAdvancePosition(labels, pos);
+        }
+        if (symbol >= alphabetSize) {
+            return NOT_A_CODE_POINT;
+        }
+        return ByteArrayUtils::readUint24(alphabet, symbol * CODE_POINT_FIELD_SIZE);
+    }
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(LoudsTrieReadingUtils);
+};
+} // namespace latinime
+#endif // LATINIME_LOUDS_TRIE_READING_UTILS_H
@@ -26,6 +26,26 @@ namespace latinime {
 bool DynamicPtGcEventListeners
         ::TraversePolicyToUpdateUnigramProbabilityAndMarkUselessPtNodesAsDeleted
                 ::onVisitingPtNode(const PtNodeParams *const ptNodeParams) {
+    // mChildrenValue is for the children of the previous sibling when this PtNode doesn't have
+    // children.
+    const bool hasValidChildren = ptNodeParams->hasChildren() && mChildrenValue > 0;
+    if (ptNodeParams->isDeleted()) {
+        if (!hasValidChildren) {
+            // Remove children as all children are useless.
+            return !ptNodeParams->hasChildren() || mPtNodeWriter->updateChildrenPosition(
+                    ptNodeParams, NOT_A_DICT_POS /* newChildrenPosition */);
+        }
+        // The PtNode of a removed word is needed by its children. It is written as a
+        // non-terminal PtNode.
+        if (!ptNodeParams->isTerminal()
+                || !mPtNodeWriter->markPtNodeAsWillBecomeNonTerminal(ptNodeParams)) {
+            AKLOGE("Cannot keep deleted PtNode that has children. PtNode pos: %d",
+                    ptNodeParams->getHeadPos());
+            return false;
+        }
+        mValueStack.back() += 1;
+        return true;
+    }
     // PtNode is useless when the PtNode is not a terminal and doesn't have any not useless
     // children.
     bool isUselessPtNode = !ptNodeParams->isTerminal();
@@ -40,7 +60,7 @@ bool DynamicPtGcEventListeners
             isUselessPtNode = true;
         }
     }
-    if (mChildrenValue > 0) {
+    if (hasValidChildren) {
         isUselessPtNode = false;
     } else if (ptNodeParams->isTerminal()) {
         // Remove children as all children are useless.
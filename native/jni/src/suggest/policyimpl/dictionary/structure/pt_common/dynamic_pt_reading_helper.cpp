@@ -16,6 +16,11 @@
 
 #include "suggest/policyimpl/dictionary/structure/pt_common/dynamic_pt_reading_helper.h"
 
+#include <algorithm>
+#include <deque>
+
+#include "suggest/policyimpl/dictionary/structure/pt_common/dynamic_pt_writing_utils.h"
+#include "suggest/policyimpl/dictionary/structure/pt_common/first_code_point_lookup_table.h"
 #include "suggest/policyimpl/dictionary/structure/pt_common/pt_node_array_reader.h"
 #include "utils/char_utils.h"
 
@@ -25,6 +30,9 @@ namespace latinime {
 const int DynamicPtReadingHelper::MAX_CHILD_COUNT_TO_AVOID_INFINITE_LOOP = 100000;
 const int DynamicPtReadingHelper::MAX_PT_NODE_ARRAY_COUNT_TO_AVOID_INFINITE_LOOP = 100000;
 const size_t DynamicPtReadingHelper::MAX_READING_STATE_STACK_SIZE = MAX_WORD_LENGTH;
+// A page and a cache line.
+const int DynamicPtReadingHelper::BLOCK_SIZES[] = { 4096, 64 };
+const int DynamicPtReadingHelper::BLOCK_LEVEL_COUNT = NELEMS(BLOCK_SIZES);
 
 bool DynamicPtReadingHelper::TraversePolicyToGetAllTerminalPtNodePositions::onVisitingPtNode(
         const PtNodeParams *const ptNodeParams) {
@@ -34,6 +42,43 @@ bool DynamicPtReadingHelper::TraversePolicyToGetAllTerminalPtNodePositions::onVi
     return true;
 }
 
+bool DynamicPtReadingHelper::TraversePolicyToGetSubtreeProbabilities::onAscend() {
+    if (mProbabilityStack.empty()) {
+        return false;
+    }
+    mChildrenProbability = mProbabilityStack.back();
+    mProbabilityStack.pop_back();
+    return true;
+}
+
+bool DynamicPtReadingHelper::TraversePolicyToGetSubtreeProbabilities::onDescend(
+        const int ptNodeArrayPos) {
+    mProbabilityStack.push_back(NOT_A_PROBABILITY);
+    return true;
+}
+
+bool DynamicPtReadingHelper::TraversePolicyToGetSubtreeProbabilities::onVisitingPtNode(
+        const PtNodeParams *const ptNodeParams) {
+    if (mProbabilityStack.empty()) {
+        return false;
+    }
+    int probability = NOT_A_PROBABILITY;
+    if (!ptNodeParams->isDeleted()) {
+        if (ptNodeParams->isTerminal()) {
+            probability = ptNodeParams->getProbability();
+        }
+        // mChildrenProbability is for the children of the previous sibling when this PtNode
+        // doesn't have children.
+        if (ptNodeParams->hasChildren()) {
+            probability = std::max(probability, mChildrenProbability);
+        }
+    }
+    mSubtreeProbabilities->insert(
+            SubtreeProbabilityMap::value_type(ptNodeParams->getHeadPos(), probability));
+    mProbabilityStack.back() = std::max(mProbabilityStack.back(), probability);
+    return true;
+}
+
 // Visits all PtNodes in post-order depth first manner.
 // For example, visits c -> b -> y -> x -> a for the following dictionary:
 // a _ b _ c
@@ -175,6 +220,149 @@ bool DynamicPtReadingHelper::traverseAllPtNodesInPtNodeArrayLevelPreorderDepthFi
     return !isError();
 }
 
+// Visits all PtNode arrays in nested blocks, which is the order in which the GC places them.
+// A page block has the PtNode arrays near the top of a subtree, which are visited in breadth first
+// order until they have the page size. The PtNode arrays that don't fit in the block start the
+// following blocks, which are visited in depth first order. Each element of the breadth first
+// order is itself a cache line block, which is filled from its first PtNode array in the same
+// way. So a search descending from any PtNode array reads few pages and only a cache line or two
+// per level in the top levels of each block.
+bool DynamicPtReadingHelper::traverseAllPtNodesInPtNodeArrayLevelBlockedManner(
+        const bool ordersSiblingsByProbability, TraversingEventListener *const listener) {
+    const int rootPtNodeArrayPos = getPosOfLastPtNodeArrayHead();
+    SubtreeProbabilityMap subtreeProbabilities;
+    if (ordersSiblingsByProbability) {
+        TraversePolicyToGetSubtreeProbabilities traversePolicyToGetSubtreeProbabilities(
+                &subtreeProbabilities);
+        if (!traverseAllPtNodesInPostorderDepthFirstManner(
+                &traversePolicyToGetSubtreeProbabilities)) {
+            return false;
+        }
+    }
+    std::vector<PtNodeArrayToVisit> blockStack;
+    blockStack.emplace_back(rootPtNodeArrayPos, 0 /* depth */);
+    std::vector<PtNodeArrayToVisit> followingPtNodeArrays;
+    while (!blockStack.empty()) {
+        const PtNodeArrayToVisit firstPtNodeArray = blockStack.back();
+        blockStack.pop_back();
+        int blockSize = 0;
+        followingPtNodeArrays.clear();
+        if (!visitPtNodeArrayBlock(0 /* blockLevel */, firstPtNodeArray,
+                ordersSiblingsByProbability ? &subtreeProbabilities : nullptr, listener,
+                &blockSize, &followingPtNodeArrays)) {
+            return false;
+        }
+        // The first following block is visited next.
+        blockStack.insert(blockStack.end(), followingPtNodeArrays.rbegin(),
+                followingPtNodeArrays.rend());
+    }
+    return !isError();
+}
+
+// Visits the block of the level that starts with firstPtNodeArray. The PtNode arrays that come
+// after the block in breadth first order are added to outFollowingPtNodeArrays.
+bool DynamicPtReadingHelper::visitPtNodeArrayBlock(const int blockLevel,
+        const PtNodeArrayToVisit &firstPtNodeArray,
+        const SubtreeProbabilityMap *const subtreeProbabilities,
+        TraversingEventListener *const listener, int *const outBlockSize,
+        std::vector<PtNodeArrayToVisit> *const outFollowingPtNodeArrays) {
+    std::deque<PtNodeArrayToVisit> ptNodeArrayQueue;
+    ptNodeArrayQueue.push_back(firstPtNodeArray);
+    std::vector<PtNodeArrayToVisit> nextPtNodeArrays;
+    int blockSize = 0;
+    while (!ptNodeArrayQueue.empty()) {
+        const PtNodeArrayToVisit ptNodeArray = ptNodeArrayQueue.front();
+        ptNodeArrayQueue.pop_front();
+        if (blockSize >= BLOCK_SIZES[blockLevel]) {
+            outFollowingPtNodeArrays->push_back(ptNodeArray);
+            continue;
+        }
+        int size = 0;
+        nextPtNodeArrays.clear();
+        const bool succeeded = (blockLevel + 1 < BLOCK_LEVEL_COUNT) ?
+                visitPtNodeArrayBlock(blockLevel + 1, ptNodeArray, subtreeProbabilities,
+                        listener, &size, &nextPtNodeArrays) :
+                visitPtNodeArray(ptNodeArray, subtreeProbabilities, listener, &size,
+                        &nextPtNodeArrays);
+        if (!succeeded) {
+            return false;
+        }
+        blockSize += size;
+        ptNodeArrayQueue.insert(ptNodeArrayQueue.end(), nextPtNodeArrays.begin(),
+                nextPtNodeArrays.end());
+    }
+    *outBlockSize = blockSize;
+    return true;
+}
+
+// Visits the PtNodes of the PtNode array and its forward linked arrays, and outputs the size of
+// the valid PtNodes and the children PtNode arrays.
+bool DynamicPtReadingHelper::visitPtNodeArray(const PtNodeArrayToVisit &ptNodeArray,
+        const SubtreeProbabilityMap *const subtreeProbabilities,
+        TraversingEventListener *const listener, int *const outPtNodeArraySize,
+        std::vector<PtNodeArrayToVisit> *const outChildPtNodeArrays) {
+    if (ptNodeArray.mDepth > static_cast<int>(MAX_READING_STATE_STACK_SIZE)) {
+        AKLOGI("PtNode array is too deep. Max depth: %zd", MAX_READING_STATE_STACK_SIZE);
+        ASSERT(false);
+        mIsError = true;
+        return false;
+    }
+    if (!listener->onDescend(ptNodeArray.mPtNodeArrayPos)) {
+        return false;
+    }
+    initWithPtNodeArrayPos(ptNodeArray.mPtNodeArrayPos);
+    std::vector<PtNodeParams> ptNodes;
+    while (!isEnd()) {
+        const PtNodeParams ptNodeParams(getPtNodeParams());
+        if (!ptNodeParams.isValid()) {
+            break;
+        }
+        ptNodes.push_back(ptNodeParams);
+        readNextSiblingNode(ptNodeParams);
+    }
+    if (isError()) {
+        return false;
+    }
+    std::vector<int> order(ptNodes.size());
+    for (size_t i = 0; i < ptNodes.size(); ++i) {
+        order[i] = i;
+    }
+    if (subtreeProbabilities) {
+        std::vector<int> probabilities(ptNodes.size(), NOT_A_PROBABILITY);
+        for (size_t i = 0; i < ptNodes.size(); ++i) {
+            const SubtreeProbabilityMap::const_iterator it =
+                    subtreeProbabilities->find(ptNodes[i].getHeadPos());
+            if (it != subtreeProbabilities->end()) {
+                probabilities[i] = it->second;
+            }
+        }
+        std::stable_sort(order.begin(), order.end(),
+                [&probabilities](const int left, const int right) {
+                    return probabilities[left] > probabilities[right];
+                });
+    }
+    int ptNodeArraySize = 0;
+    for (const int index : order) {
+        const PtNodeParams &ptNodeParams = ptNodes[index];
+        if (!listener->onVisitingPtNode(&ptNodeParams)) {
+            return false;
+        }
+        if (!ptNodeParams.isDeleted()) {
+            ptNodeArraySize += ptNodeParams.getChildrenPosFieldPos()
+                    + DynamicPtWritingUtils::DICT_OFFSET_FIELD_SIZE - ptNodeParams.getHeadPos();
+        }
+        if (ptNodeParams.hasChildren()) {
+            outChildPtNodeArrays->emplace_back(ptNodeParams.getChildrenPos(),
+                    ptNodeArray.mDepth + 1);
+        }
+    }
+    if (!listener->onReadingPtNodeArrayTail() || !listener->onAscend()) {
+        return false;
+    }
+    *outPtNodeArraySize = ptNodeArraySize;
+    return true;
+}
+
 int DynamicPtReadingHelper::getCodePointsAndProbabilityAndReturnCodePointCount(
         const int maxCodePointCount, int *const outCodePoints, int *const outUnigramProbability) {
     // This method traverses parent nodes from the terminal by following parent pointers; thus,
@@ -218,11 +406,15 @@ int DynamicPtReadingHelper::getCodePointsAndProbabilityAndReturnCodePointCount(
 }
 
 int DynamicPtReadingHelper::getTerminalPtNodePositionOfWord(const int *const inWord,
-        const int length, const bool forceLowerCaseSearch) {
+        const int length, const bool forceLowerCaseSearch,
+        const FirstCodePointLookupTable *const firstCodePointLookupTable) {
     int searchCodePoints[length];
     for (int i = 0; i < length; ++i) {
         searchCodePoints[i] = forceLowerCaseSearch ? CharUtils::toLowerCase(inWord[i]) : inWord[i];
     }
+    if (firstCodePointLookupTable && length > 0) {
+        readPtNodeStartingWithCodePoint(firstCodePointLookupTable, searchCodePoints[0]);
+    }
     while (!isEnd()) {
         const PtNodeParams ptNodeParams(getPtNodeParams());
         const int matchedCodePointCount = getPrevTotalCodePointCount();
@@ -255,12 +447,33 @@ int DynamicPtReadingHelper::getTerminalPtNodePositionOfWord(const int *const inW
         }
         // Advance to the children nodes.
         readChildNode(ptNodeParams);
+        if (firstCodePointLookupTable) {
+            readPtNodeStartingWithCodePoint(firstCodePointLookupTable,
+                    searchCodePoints[getPrevTotalCodePointCount()]);
+        }
     }
     // If we already traversed the tree further than the word is long, there means
     // there was no match (or we would have found it).
     return NOT_A_DICT_POS;
 }
 
+// Moves to the PtNode that starts with the code point when the current PtNode array is in the
+// table. The PtNode is the only one left to read in the array, so the reading ends when it doesn't
+// match. Does nothing when the array is not in the table.
+void DynamicPtReadingHelper::readPtNodeStartingWithCodePoint(
+        const FirstCodePointLookupTable *const firstCodePointLookupTable, const int codePoint) {
+    if (isEnd()) {
+        return;
+    }
+    int ptNodePos = NOT_A_DICT_POS;
+    if (!firstCodePointLookupTable->lookUpPtNodePos(mReadingState.mPosOfThisPtNodeArrayHead,
+            codePoint, &ptNodePos)) {
+        return;
+    }
+    mReadingState.mPos = ptNodePos;
+    mReadingState.mRemainingPtNodeCountInThisArray = 1;
+}
+
 // Read node array size and process empty node arrays. Nodes and arrays are counted up in this
 // method to avoid an infinite loop.
 void DynamicPtReadingHelper::nextPtNodeArray() {
@@ -18,6 +18,7 @@
 #define LATINIME_DYNAMIC_PT_READING_HELPER_H
 
 #include <cstddef>
+#include <unordered_map>
 #include <vector>
 
 #include "defines.h"
@@ -27,6 +28,7 @@
 namespace latinime {
 
 class DictionaryShortcutsStructurePolicy;
+class FirstCodePointLookupTable;
 class PtNodeArrayReader;
 
 /*
@@ -128,6 +130,13 @@ class DynamicPtReadingHelper {
         return mPtNodeReader->fetchPtNodeParamsInBufferFromPtNodePos(mReadingState.mPos);
     }
 
+    AK_FORCE_INLINE const PtNodeParams getPtNodeHeaderParams() const {
+        if (isEnd()) {
+            return PtNodeParams();
+        }
+        return mPtNodeReader->fetchPtNodeHeaderParamsInBufferFromPtNodePos(mReadingState.mPos);
+    }
+
     AK_FORCE_INLINE bool isValidTerminalNode(const PtNodeParams &ptNodeParams) const {
         return !isEnd() && !ptNodeParams.isDeleted() && ptNodeParams.isTerminal();
     }
@@ -211,11 +220,22 @@ class DynamicPtReadingHelper {
     bool traverseAllPtNodesInPtNodeArrayLevelPreorderDepthFirstManner(
             TraversingEventListener *const listener);
 
+    // Visits all PtNode arrays in blocks of the size of a page and of a cache line. Each PtNode
+    // array is visited as onDescend(), onVisitingPtNode() for each PtNode,
+    // onReadingPtNodeArrayTail() and onAscend(). When ordersSiblingsByProbability is true, the
+    // PtNodes of each array are visited in the descending order of the highest probability in
+    // their subtrees.
+    bool traverseAllPtNodesInPtNodeArrayLevelBlockedManner(
+            const bool ordersSiblingsByProbability, TraversingEventListener *const listener);
+
     int getCodePointsAndProbabilityAndReturnCodePointCount(const int maxCodePointCount,
             int *const outCodePoints, int *const outUnigramProbability);
 
+    // firstCodePointLookupTable can be nullptr. The PtNode arrays in the table are searched with
+    // the table instead of reading the siblings.
     int getTerminalPtNodePositionOfWord(const int *const inWord, const int length,
-            const bool forceLowerCaseSearch);
+            const bool forceLowerCaseSearch,
+            const FirstCodePointLookupTable *const firstCodePointLookupTable);
 
  private:
     DISALLOW_COPY_AND_ASSIGN(DynamicPtReadingHelper);
@@ -244,9 +264,42 @@ class DynamicPtReadingHelper {
         int mPosOfThisPtNodeArrayHead;
     };
 
+    // Mapping from PtNode positions to the highest probabilities in their subtrees.
+    typedef std::unordered_map<int, int> SubtreeProbabilityMap;
+
+    class TraversePolicyToGetSubtreeProbabilities : public TraversingEventListener {
+     public:
+        TraversePolicyToGetSubtreeProbabilities(SubtreeProbabilityMap *const subtreeProbabilities)
+                : mSubtreeProbabilities(subtreeProbabilities), mProbabilityStack(),
+                  mChildrenProbability(NOT_A_PROBABILITY) {}
+
+        bool onAscend();
+        bool onDescend(const int ptNodeArrayPos);
+        bool onReadingPtNodeArrayTail() { return true; }
+        bool onVisitingPtNode(const PtNodeParams *const ptNodeParams);
+
+     private:
+        DISALLOW_IMPLICIT_CONSTRUCTORS(TraversePolicyToGetSubtreeProbabilities);
+
+        SubtreeProbabilityMap *const mSubtreeProbabilities;
+        std::vector<int> mProbabilityStack;
+        int mChildrenProbability;
+    };
+
+    // A PtNode array to visit in traverseAllPtNodesInPtNodeArrayLevelBlockedManner().
+    struct PtNodeArrayToVisit {
+        PtNodeArrayToVisit(const int ptNodeArrayPos, const int depth)
+                : mPtNodeArrayPos(ptNodeArrayPos), mDepth(depth) {}
+
+        int mPtNodeArrayPos;
+        int mDepth;
+    };
+
     static const int MAX_CHILD_COUNT_TO_AVOID_INFINITE_LOOP;
     static const int MAX_PT_NODE_ARRAY_COUNT_TO_AVOID_INFINITE_LOOP;
     static const size_t MAX_READING_STATE_STACK_SIZE;
+    static const int BLOCK_SIZES[];
+    static const int BLOCK_LEVEL_COUNT;
 
     // TODO: Introduce error code to track what caused the error.
     bool mIsError;
@@ -259,6 +312,19 @@ class DynamicPtReadingHelper {
 
     void followForwardLink();
 
+    void readPtNodeStartingWithCodePoint(
+            const FirstCodePointLookupTable *const firstCodePointLookupTable, const int codePoint);
+
+    bool visitPtNodeArrayBlock(const int blockLevel, const PtNodeArrayToVisit &firstPtNodeArray,
+            const SubtreeProbabilityMap *const subtreeProbabilities,
+            TraversingEventListener *const listener, int *const outBlockSize,
+            std::vector<PtNodeArrayToVisit> *const outFollowingPtNodeArrays);
+
+    bool visitPtNodeArray(const PtNodeArrayToVisit &ptNodeArray,
+            const SubtreeProbabilityMap *const subtreeProbabilities,
+            TraversingEventListener *const listener, int *const outPtNodeArraySize,
+            std::vector<PtNodeArrayToVisit> *const outChildPtNodeArrays);
+
     AK_FORCE_INLINE void pushReadingStateToStack() {
         if (mReadingStateStack.size() > MAX_READING_STATE_STACK_SIZE) {
             AKLOGI("Reading state stack overflow. Max size: %zd", MAX_READING_STATE_STACK_SIZE);
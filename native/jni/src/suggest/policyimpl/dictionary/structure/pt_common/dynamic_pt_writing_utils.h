@@ -29,6 +29,8 @@ class BufferWithExtendableBuffer;
 class DynamicPtWritingUtils {
  public:
     static const int NODE_FLAG_FIELD_SIZE;
+    // The size of the parent position, children position and forward link fields.
+    static const int DICT_OFFSET_FIELD_SIZE;
 
     static bool writeEmptyDictionary(BufferWithExtendableBuffer *const buffer, const int rootPos);
 
@@ -67,7 +69,6 @@ class DynamicPtWritingUtils {
     static const int SMALL_PTNODE_ARRAY_SIZE_FIELD_SIZE;
     static const int LARGE_PTNODE_ARRAY_SIZE_FIELD_SIZE;
     static const int LARGE_PTNODE_ARRAY_SIZE_FIELD_SIZE_FLAG;
-    static const int DICT_OFFSET_FIELD_SIZE;
     static const int MAX_DICT_OFFSET_VALUE;
     static const int MIN_DICT_OFFSET_VALUE;
     static const int DICT_OFFSET_NEGATIVE_FLAG;
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/policyimpl/dictionary/structure/pt_common/first_code_point_lookup_table.h"
+
+#include <algorithm>
+
+namespace latinime {
+
+void FirstCodePointLookupTable::addPtNodeArray(const int ptNodeArrayPos,
+        const std::vector<int> &firstCodePoints, const std::vector<int> &ptNodePositions) {
+    const int count = static_cast<int>(firstCodePoints.size());
+    std::vector<int> order(count);
+    for (int i = 0; i < count; ++i) {
+        order[i] = i;
+    }
+    // Stable so that the first one of PtNodes that have the same first code point is found as
+    // when reading the siblings one by one.
+    std::stable_sort(order.begin(), order.end(), [&firstCodePoints](const int a, const int b) {
+        return firstCodePoints[a] < firstCodePoints[b];
+    });
+    const int begin = static_cast<int>(mFirstCodePoints.size());
+    for (const int index : order) {
+        mFirstCodePoints.push_back(firstCodePoints[index]);
+        mPtNodePositions.push_back(ptNodePositions[index]);
+    }
+    mPtNodeArrayRanges[ptNodeArrayPos] = std::make_pair(begin, begin + count);
+}
+
+bool FirstCodePointLookupTable::lookUpPtNodePos(const int ptNodeArrayPos, const int codePoint,
+        int *const outPtNodePos) const {
+    const auto it = mPtNodeArrayRanges.find(ptNodeArrayPos);
+    if (it == mPtNodeArrayRanges.end()) {
+        return false;
+    }
+    const std::vector<int>::const_iterator end = mFirstCodePoints.begin() + it->second.second;
+    const std::vector<int>::const_iterator found =
+            std::lower_bound(mFirstCodePoints.begin() + it->second.first, end, codePoint);
+    if (found == end || *found != codePoint) {
+        *outPtNodePos = NOT_A_DICT_POS;
+    } else {
+        *outPtNodePos = mPtNodePositions[found - mFirstCodePoints.begin()];
+    }
+    return true;
+}
+
+} // namespace latinime
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_FIRST_CODE_POINT_LOOKUP_TABLE_H
+#define LATINIME_FIRST_CODE_POINT_LOOKUP_TABLE_H
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "defines.h"
+
+namespace latinime {
+
+/*
+ * Side table that has the PtNodes of some PtNode arrays sorted by their first code points. Finding
+ * the child that starts with a code point is a binary search in the table instead of reading the
+ * siblings one by one. This is only valid for PtNode arrays that are never updated and don't have
+ * forward links.
+ */
+class FirstCodePointLookupTable {
+ public:
+    FirstCodePointLookupTable()
+            : mPtNodeArrayRanges(), mFirstCodePoints(), mPtNodePositions() {}
+
+    // firstCodePoints[i] is the first code point of the PtNode at ptNodePositions[i]. The PtNodes
+    // have to be in the order in the PtNode array.
+    void addPtNodeArray(const int ptNodeArrayPos, const std::vector<int> &firstCodePoints,
+            const std::vector<int> &ptNodePositions);
+
+    // Returns false when the table doesn't have the PtNode array. Otherwise, outPtNodePos is the
+    // position of the first PtNode in the array that starts with the code point, or
+    // NOT_A_DICT_POS when there is no such PtNode.
+    bool lookUpPtNodePos(const int ptNodeArrayPos, const int codePoint,
+            int *const outPtNodePos) const;
+
+    int getPtNodeArrayCount() const {
+        return static_cast<int>(mPtNodeArrayRanges.size());
+    }
+
+ private:
+    DISALLOW_COPY_AND_ASSIGN(FirstCodePointLookupTable);
+
+    // The range of the entries of each PtNode array in mFirstCodePoints and mPtNodePositions.
+    std::unordered_map<int, std::pair<int, int>> mPtNodeArrayRanges;
+    std::vector<int> mFirstCodePoints;
+    std::vector<int> mPtNodePositions;
+};
+} // namespace latinime
+#endif // LATINIME_FIRST_CODE_POINT_LOOKUP_TABLE_H
@@ -35,6 +35,23 @@ class PtNodeArrayReader {
     virtual bool readForwardLinkAndReturnIfValid(const int forwordLinkPos,
             int *const outNextPtNodeArrayPos) const = 0;
 
+    // Returns whether the root PtNode array at position 0 fits in a trie of the given size.
+    // Deeper PtNode arrays are checked when they are read.
+    bool verifyRootPtNodeArray(const int trieSize) const {
+        if (trieSize <= 0) {
+            AKLOGE("The trie is empty.");
+            return false;
+        }
+        int ptNodeCount = 0;
+        int firstPtNodePos = NOT_A_DICT_POS;
+        if (!readPtNodeArrayInfoAndReturnIfValid(0 /* ptNodeArrayPos */, &ptNodeCount,
+                &firstPtNodePos)) {
+            return false;
+        }
+        // Each PtNode has at least one byte.
+        return firstPtNodePos + ptNodeCount <= trieSize;
+    }
+
  protected:
     PtNodeArrayReader() {};
 
@@ -30,6 +30,14 @@ class PtNodeReader {
     virtual const PtNodeParams fetchPtNodeParamsInBufferFromPtNodePos(
             const int ptNodePos) const = 0;
 
+    // Reads the PtNode without the attributes that are stored out of the trie, e.g. the
+    // probability in a language model, which is NOT_YET_READ_PROBABILITY for terminals. Readers
+    // whose PtNodes have all the attributes in the trie read the whole PtNode.
+    virtual const PtNodeParams fetchPtNodeHeaderParamsInBufferFromPtNodePos(
+            const int ptNodePos) const {
+        return fetchPtNodeParamsInBufferFromPtNodePos(ptNodePos);
+    }
+
  protected:
     PtNodeReader() {};
 
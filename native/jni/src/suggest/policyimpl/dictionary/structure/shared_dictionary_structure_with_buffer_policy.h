@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_SHARED_DICTIONARY_STRUCTURE_WITH_BUFFER_POLICY_H
+#define LATINIME_SHARED_DICTIONARY_STRUCTURE_WITH_BUFFER_POLICY_H
+
+#include <memory>
+#include <vector>
+
+#include "defines.h"
+#include "suggest/core/policy/dictionary_structure_with_buffer_policy.h"
+
+namespace latinime {
+
+// Handle to a read-only structure policy that is shared by all the Dictionary instances opening
+// the same dictionary file. The mapping and the parsed header are released when the last handle
+// is deleted. Handles are used from different threads, so only const methods of the shared policy
+// are called, and the state of getNextWordAndNextToken() is kept in each handle.
+template<class StructurePolicy>
+class SharedDictionaryStructureWithBufferPolicy : public DictionaryStructureWithBufferPolicy {
+ public:
+    SharedDictionaryStructureWithBufferPolicy(
+            const std::shared_ptr<StructurePolicy> &sharedPolicy)
+            : mSharedPolicy(sharedPolicy), mTerminalPtNodePositionsForIteratingWords() {}
+
+    int getRootPosition() const {
+        return mSharedPolicy->getRootPosition();
+    }
+
+    void createAndGetAllChildDicNodes(const DicNode *const dicNode,
+            DicNodeVector *const childDicNodes) const {
+        mSharedPolicy->createAndGetAllChildDicNodes(dicNode, childDicNodes);
+    }
+
+    void createAndGetAllChildDicNodesWithoutProbabilities(const DicNode *const dicNode,
+            DicNodeVector *const childDicNodes) const {
+        mSharedPolicy->createAndGetAllChildDicNodesWithoutProbabilities(dicNode, childDicNodes);
+    }
+
+    void iterateChildPtNodes(const int ptNodeArrayPos,
+            ChildPtNodeListener *const listener) const {
+        mSharedPolicy->iterateChildPtNodes(ptNodeArrayPos, listener);
+    }
+
+    int getCodePointsAndProbabilityAndReturnCodePointCount(
+            const int nodePos, const int maxCodePointCount, int *const outCodePoints,
+            int *const outUnigramProbability) const {
+        return mSharedPolicy->getCodePointsAndProbabilityAndReturnCodePointCount(nodePos,
+                maxCodePointCount, outCodePoints, outUnigramProbability);
+    }
+
+    int getTerminalPtNodePositionOfWord(const int *const inWord,
+            const int length, const bool forceLowerCaseSearch) const {
+        return mSharedPolicy->getTerminalPtNodePositionOfWord(inWord, length,
+                forceLowerCaseSearch);
+    }
+
+    int getProbability(const int unigramProbability, const int bigramProbability) const {
+        return mSharedPolicy->getProbability(unigramProbability, bigramProbability);
+    }
+
+    int getProbabilityOfPtNode(const int *const prevWordsPtNodePos, const int nodePos) const {
+        return mSharedPolicy->getProbabilityOfPtNode(prevWordsPtNodePos, nodePos);
+    }
+
+    int getUnigramProbabilityOfPtNode(const int ptNodePos) const {
+        return mSharedPolicy->getUnigramProbabilityOfPtNode(ptNodePos);
+    }
+
+    void iterateNgramEntries(const int *const prevWordsPtNodePos,
+            NgramListener *const listener) const {
+        mSharedPolicy->iterateNgramEntries(prevWordsPtNodePos, listener);
+    }
+
+    int getShortcutPositionOfPtNode(const int nodePos) const {
+        return mSharedPolicy->getShortcutPositionOfPtNode(nodePos);
+    }
+
+    const DictionaryHeaderStructurePolicy *getHeaderStructurePolicy() const {
+        return mSharedPolicy->getHeaderStructurePolicy();
+    }
+
+    const DictionaryShortcutsStructurePolicy *getShortcutsStructurePolicy() const {
+        return mSharedPolicy->getShortcutsStructurePolicy();
+    }
+
+    bool addUnigramEntry(const int *const word, const int length,
+            const UnigramProperty *const unigramProperty) {
+        // Shared policies are read-only.
+        AKLOGI("Warning: addUnigramEntry() is called for a shared dictionary.");
+        return false;
+    }
+
+    bool removeUnigramEntry(const int *const word, const int length) {
+        // Shared policies are read-only.
+        AKLOGI("Warning: removeUnigramEntry() is called for a shared dictionary.");
+        return false;
+    }
+
+    bool addNgramEntry(const PrevWordsInfo *const prevWordsInfo,
+            const BigramProperty *const bigramProperty) {
+        // Shared policies are read-only.
+        AKLOGI("Warning: addNgramEntry() is called for a shared dictionary.");
+        return false;
+    }
+
+    bool removeNgramEntry(const PrevWordsInfo *const prevWordsInfo, const int *const word,
+            const int length) {
+        // Shared policies are read-only.
+        AKLOGI("Warning: removeNgramEntry() is called for a shared dictionary.");
+        return false;
+    }
+
+    bool flush(const char *const filePath) {
+        // Shared policies are read-only.
+        AKLOGI("Warning: flush() is called for a shared dictionary.");
+        return false;
+    }
+
+    bool flushWithGC(const char *const filePath) {
+        // Shared policies are read-only.
+        AKLOGI("Warning: flushWithGC() is called for a shared dictionary.");
+        return false;
+    }
+
+    bool needsToRunGC(const bool mindsBlockByGC) const {
+        return false;
+    }
+
+    // getProperty() of the read-only policies only reads.
+    void getProperty(const char *const query, const int queryLength, char *const outResult,
+            const int maxResultLength) {
+        mSharedPolicy->getProperty(query, queryLength, outResult, maxResultLength);
+    }
+
+    const WordProperty getWordProperty(const int *const codePoints,
+            const int codePointCount) const {
+        return mSharedPolicy->getWordProperty(codePoints, codePointCount);
+    }
+
+    int getNextWordAndNextToken(const int token, int *const outCodePoints,
+            int *const outCodePointCount) {
+        return mSharedPolicy->getNextWordAndNextToken(token, outCodePoints, outCodePointCount,
+                &mTerminalPtNodePositionsForIteratingWords);
+    }
+
+    bool isCorrupted() const {
+        return mSharedPolicy->isCorrupted();
+    }
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(SharedDictionaryStructureWithBufferPolicy);
+
+    const std::shared_ptr<StructurePolicy> mSharedPolicy;
+    std::vector<int> mTerminalPtNodePositionsForIteratingWords;
+};
+} // namespace latinime
+#endif // LATINIME_SHARED_DICTIONARY_STRUCTURE_WITH_BUFFER_POLICY_H
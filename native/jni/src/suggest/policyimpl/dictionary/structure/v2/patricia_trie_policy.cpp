@@ -17,25 +17,43 @@
 
 #include "suggest/policyimpl/dictionary/structure/v2/patricia_trie_policy.h"
 
+#include <cstdio>
+#include <cstring>
+
 #include "defines.h"
 #include "suggest/core/dicnode/dic_node.h"
 #include "suggest/core/dicnode/dic_node_vector.h"
 #include "suggest/core/dictionary/binary_dictionary_bigrams_iterator.h"
+#include "suggest/core/dictionary/child_pt_node_listener.h"
 #include "suggest/core/dictionary/ngram_listener.h"
 #include "suggest/core/session/prev_words_info.h"
 #include "suggest/policyimpl/dictionary/structure/pt_common/dynamic_pt_reading_helper.h"
 #include "suggest/policyimpl/dictionary/structure/pt_common/patricia_trie_reading_utils.h"
 #include "suggest/policyimpl/dictionary/utils/probability_utils.h"
 #include "utils/char_utils.h"
+#include "utils/memory_usage_utils.h"
 
 namespace latinime {
 
+const char *const PatriciaTriePolicy::RESIDENT_SIZE_QUERY = "RESIDENT_SIZE";
+const char *const PatriciaTriePolicy::MAJOR_PAGE_FAULT_COUNT_QUERY = "MAJOR_PAGE_FAULT_COUNT";
+const char *const PatriciaTriePolicy::MINOR_PAGE_FAULT_COUNT_QUERY = "MINOR_PAGE_FAULT_COUNT";
+const int PatriciaTriePolicy::TOP_LEVEL_PT_NODE_ARRAY_PREFETCH_SIZE = 4096;
+const int PatriciaTriePolicy::FIRST_CODE_POINT_LOOKUP_TABLE_MAX_DEPTH = 3;
+const int PatriciaTriePolicy::FIRST_CODE_POINT_LOOKUP_TABLE_MIN_PT_NODE_COUNT = 4;
+
 void PatriciaTriePolicy::createAndGetAllChildDicNodes(const DicNode *const dicNode,
         DicNodeVector *const childDicNodes) const {
     if (!dicNode->hasChildren()) {
         return;
     }
-    int nextPos = dicNode->getChildrenPtNodeArrayPos();
+    DicNodeVector::LeavingChildPusher leavingChildPusher(dicNode, childDicNodes);
+    iterateChildPtNodes(dicNode->getChildrenPtNodeArrayPos(), &leavingChildPusher);
+}
+
+void PatriciaTriePolicy::iterateChildPtNodes(const int ptNodeArrayPos,
+        ChildPtNodeListener *const listener) const {
+    int nextPos = ptNodeArrayPos;
     if (nextPos < 0 || nextPos >= mDictBufferSize) {
         AKLOGE("Children PtNode array position is invalid. pos: %d, dict size: %d",
                 nextPos, mDictBufferSize);
@@ -53,7 +71,7 @@ void PatriciaTriePolicy::createAndGetAllChildDicNodes(const DicNode *const dicNo
             ASSERT(false);
             return;
         }
-        nextPos = createAndGetLeavingChildNode(dicNode, nextPos, childDicNodes);
+        nextPos = visitChildPtNode(nextPos, listener);
     }
 }
 
@@ -272,8 +290,8 @@ int PatriciaTriePolicy::getTerminalPtNodePositionOfWord(const int *const inWord,
         const int length, const bool forceLowerCaseSearch) const {
     DynamicPtReadingHelper readingHelper(&mPtNodeReader, &mPtNodeArrayReader);
     readingHelper.initWithPtNodeArrayPos(getRootPosition());
-    const int ptNodePos =
-            readingHelper.getTerminalPtNodePositionOfWord(inWord, length, forceLowerCaseSearch);
+    const int ptNodePos = readingHelper.getTerminalPtNodePositionOfWord(inWord, length,
+            forceLowerCaseSearch, &mFirstCodePointLookupTable);
     if (readingHelper.isError()) {
         mIsCorrupted = true;
         AKLOGE("Dictionary reading error in createAndGetAllChildDicNodes().");
@@ -297,6 +315,13 @@ int PatriciaTriePolicy::getProbability(const int unigramProbability,
     }
 }
 
+int PatriciaTriePolicy::getUnigramProbabilityOfPtNode(const int ptNodePos) const {
+    if (ptNodePos == NOT_A_DICT_POS) {
+        return NOT_A_PROBABILITY;
+    }
+    return mPtNodeReader.fetchPtNodeParamsInBufferFromPtNodePos(ptNodePos).getProbability();
+}
+
 int PatriciaTriePolicy::getProbabilityOfPtNode(const int *const prevWordsPtNodePos,
         const int ptNodePos) const {
     if (ptNodePos == NOT_A_DICT_POS) {
@@ -352,8 +377,8 @@ int PatriciaTriePolicy::getBigramsPositionOfPtNode(const int ptNodePos) const {
     return mPtNodeReader.fetchPtNodeParamsInBufferFromPtNodePos(ptNodePos).getBigramsPos();
 }
 
-int PatriciaTriePolicy::createAndGetLeavingChildNode(const DicNode *const dicNode,
-        const int ptNodePos, DicNodeVector *childDicNodes) const {
+int PatriciaTriePolicy::visitChildPtNode(const int ptNodePos,
+        ChildPtNodeListener *const listener) const {
     PatriciaTrieReadingUtils::NodeFlags flags;
     int mergedNodeCodePointCount = 0;
     int mergedNodeCodePoints[MAX_WORD_LENGTH];
@@ -367,7 +392,7 @@ int PatriciaTriePolicy::createAndGetLeavingChildNode(const DicNode *const dicNod
             &probability, &childrenPos, &shortcutPos, &bigramPos, &siblingPos);
     // Skip PtNodes don't start with Unicode code point because they represent non-word information.
     if (CharUtils::isInUnicodeSpace(mergedNodeCodePoints[0])) {
-        childDicNodes->pushLeavingChild(dicNode, ptNodePos, childrenPos, probability,
+        listener->onVisitChildPtNode(ptNodePos, childrenPos, probability,
                 PatriciaTrieReadingUtils::isTerminal(flags),
                 PatriciaTrieReadingUtils::hasChildrenInFlags(flags),
                 PatriciaTrieReadingUtils::isBlacklisted(flags)
@@ -437,34 +462,118 @@ const WordProperty PatriciaTriePolicy::getWordProperty(const int *const codePoin
 }
 
 int PatriciaTriePolicy::getNextWordAndNextToken(const int token, int *const outCodePoints,
-        int *const outCodePointCount) {
+        int *const outCodePointCount,
+        std::vector<int> *const terminalPtNodePositionsForIteratingWords) const {
     *outCodePointCount = 0;
     if (token == 0) {
         // Start iterating the dictionary.
-        mTerminalPtNodePositionsForIteratingWords.clear();
+        terminalPtNodePositionsForIteratingWords->clear();
         DynamicPtReadingHelper::TraversePolicyToGetAllTerminalPtNodePositions traversePolicy(
-                &mTerminalPtNodePositionsForIteratingWords);
+                terminalPtNodePositionsForIteratingWords);
         DynamicPtReadingHelper readingHelper(&mPtNodeReader, &mPtNodeArrayReader);
         readingHelper.initWithPtNodeArrayPos(getRootPosition());
         readingHelper.traverseAllPtNodesInPostorderDepthFirstManner(&traversePolicy);
     }
     const int terminalPtNodePositionsVectorSize =
-            static_cast<int>(mTerminalPtNodePositionsForIteratingWords.size());
+            static_cast<int>(terminalPtNodePositionsForIteratingWords->size());
     if (token < 0 || token >= terminalPtNodePositionsVectorSize) {
         AKLOGE("Given token %d is invalid.", token);
         return 0;
     }
-    const int terminalPtNodePos = mTerminalPtNodePositionsForIteratingWords[token];
+    const int terminalPtNodePos = (*terminalPtNodePositionsForIteratingWords)[token];
     int unigramProbability = NOT_A_PROBABILITY;
     *outCodePointCount = getCodePointsAndProbabilityAndReturnCodePointCount(terminalPtNodePos,
             MAX_WORD_LENGTH, outCodePoints, &unigramProbability);
     const int nextToken = token + 1;
     if (nextToken >= terminalPtNodePositionsVectorSize) {
         // All words have been iterated.
-        mTerminalPtNodePositionsForIteratingWords.clear();
+        terminalPtNodePositionsForIteratingWords->clear();
         return 0;
     }
     return nextToken;
 }
 
+void PatriciaTriePolicy::getProperty(const char *const query, const int queryLength,
+        char *const outResult, const int maxResultLength) {
+    const int compareLength = queryLength + 1 /* terminator */;
+    if (strncmp(query, RESIDENT_SIZE_QUERY, compareLength) == 0) {
+        snprintf(outResult, maxResultLength, "%d", mMmappedBuffer->getResidentSize());
+    } else if (strncmp(query, MAJOR_PAGE_FAULT_COUNT_QUERY, compareLength) == 0) {
+        snprintf(outResult, maxResultLength, "%d", MemoryUsageUtils::getMajorPageFaultCount());
+    } else if (strncmp(query, MINOR_PAGE_FAULT_COUNT_QUERY, compareLength) == 0) {
+        snprintf(outResult, maxResultLength, "%d", MemoryUsageUtils::getMinorPageFaultCount());
+    } else if (maxResultLength > 0) {
+        outResult[0] = '\0';
+    }
+}
+
+// The header and the root PtNode array are at the head of the buffer, but the PtNode arrays of
+// the next level are spread over the whole buffer. Every search visits them, so ask for them to
+// be read in before the first search does.
+void PatriciaTriePolicy::prefetchTopLevelPtNodeArrays() const {
+    if (mMmappedBuffer->getLoadingPolicy()->getPrefetchedPrefixSize() <= 0) {
+        return;
+    }
+    int ptNodeCount = 0;
+    int ptNodePos = NOT_A_DICT_POS;
+    if (!mPtNodeArrayReader.readPtNodeArrayInfoAndReturnIfValid(getRootPosition(),
+            &ptNodeCount, &ptNodePos)) {
+        return;
+    }
+    for (int i = 0; i < ptNodeCount; ++i) {
+        if (ptNodePos < 0 || ptNodePos >= mDictBufferSize) {
+            return;
+        }
+        const PtNodeParams ptNodeParams =
+                mPtNodeReader.fetchPtNodeParamsInBufferFromPtNodePos(ptNodePos);
+        if (ptNodeParams.hasChildren()) {
+            mMmappedBuffer->prefetch(mHeaderPolicy.getSize() + ptNodeParams.getChildrenPos(),
+                    TOP_LEVEL_PT_NODE_ARRAY_PREFETCH_SIZE);
+        }
+        ptNodePos = ptNodeParams.getSiblingNodePos();
+    }
+}
+
+void PatriciaTriePolicy::buildFirstCodePointLookupTable() {
+    std::vector<int> ptNodeArrayPositions(1 /* size */, getRootPosition());
+    std::vector<int> childPtNodeArrayPositions;
+    std::vector<int> firstCodePoints;
+    std::vector<int> ptNodePositions;
+    for (int depth = 0; depth < FIRST_CODE_POINT_LOOKUP_TABLE_MAX_DEPTH; ++depth) {
+        childPtNodeArrayPositions.clear();
+        for (const int ptNodeArrayPos : ptNodeArrayPositions) {
+            int ptNodeCount = 0;
+            int ptNodePos = NOT_A_DICT_POS;
+            if (!mPtNodeArrayReader.readPtNodeArrayInfoAndReturnIfValid(ptNodeArrayPos,
+                    &ptNodeCount, &ptNodePos)) {
+                return;
+            }
+            firstCodePoints.clear();
+            ptNodePositions.clear();
+            for (int i = 0; i < ptNodeCount; ++i) {
+                if (ptNodePos < 0 || ptNodePos >= mDictBufferSize) {
+                    // The dictionary is broken. The PtNode arrays added so far are still valid.
+                    return;
+                }
+                const PtNodeParams ptNodeParams =
+                        mPtNodeReader.fetchPtNodeParamsInBufferFromPtNodePos(ptNodePos);
+                if (ptNodeParams.getCodePointCount() <= 0) {
+                    return;
+                }
+                firstCodePoints.push_back(ptNodeParams.getCodePoints()[0]);
+                ptNodePositions.push_back(ptNodePos);
+                if (ptNodeParams.hasChildren()) {
+                    childPtNodeArrayPositions.push_back(ptNodeParams.getChildrenPos());
+                }
+                ptNodePos = ptNodeParams.getSiblingNodePos();
+            }
+            if (ptNodeCount >= FIRST_CODE_POINT_LOOKUP_TABLE_MIN_PT_NODE_COUNT) {
+                mFirstCodePointLookupTable.addPtNodeArray(ptNodeArrayPos, firstCodePoints,
+                        ptNodePositions);
+            }
+        }
+        ptNodeArrayPositions.swap(childPtNodeArrayPositions);
+    }
+}
+
 } // namespace latinime
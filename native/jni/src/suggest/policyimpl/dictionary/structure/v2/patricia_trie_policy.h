@@ -17,12 +17,14 @@
 #ifndef LATINIME_PATRICIA_TRIE_POLICY_H
 #define LATINIME_PATRICIA_TRIE_POLICY_H
 
+#include <atomic>
 #include <cstdint>
 #include <vector>
 
 #include "defines.h"
 #include "suggest/core/policy/dictionary_structure_with_buffer_policy.h"
 #include "suggest/policyimpl/dictionary/header/header_policy.h"
+#include "suggest/policyimpl/dictionary/structure/pt_common/first_code_point_lookup_table.h"
 #include "suggest/policyimpl/dictionary/structure/v2/bigram/bigram_list_policy.h"
 #include "suggest/policyimpl/dictionary/structure/v2/shortcut/shortcut_list_policy.h"
 #include "suggest/policyimpl/dictionary/structure/v2/ver2_patricia_trie_node_reader.h"
@@ -49,7 +51,11 @@ class PatriciaTriePolicy : public DictionaryStructureWithBufferPolicy {
               mBigramListPolicy(mDictRoot, mDictBufferSize), mShortcutListPolicy(mDictRoot),
               mPtNodeReader(mDictRoot, mDictBufferSize, &mBigramListPolicy, &mShortcutListPolicy),
               mPtNodeArrayReader(mDictRoot, mDictBufferSize),
-              mTerminalPtNodePositionsForIteratingWords(), mIsCorrupted(false) {}
+              mFirstCodePointLookupTable(), mTerminalPtNodePositionsForIteratingWords(),
+              mIsCorrupted(false) {
+        prefetchTopLevelPtNodeArrays();
+        buildFirstCodePointLookupTable();
+    }
 
     AK_FORCE_INLINE int getRootPosition() const {
         return 0;
@@ -58,6 +64,14 @@ class PatriciaTriePolicy : public DictionaryStructureWithBufferPolicy {
     void createAndGetAllChildDicNodes(const DicNode *const dicNode,
             DicNodeVector *const childDicNodes) const;
 
+    // The probabilities are read with the PtNodes.
+    void createAndGetAllChildDicNodesWithoutProbabilities(const DicNode *const dicNode,
+            DicNodeVector *const childDicNodes) const {
+        createAndGetAllChildDicNodes(dicNode, childDicNodes);
+    }
+
+    void iterateChildPtNodes(const int ptNodeArrayPos, ChildPtNodeListener *const listener) const;
+
     int getCodePointsAndProbabilityAndReturnCodePointCount(
             const int terminalNodePos, const int maxCodePointCount, int *const outCodePoints,
             int *const outUnigramProbability) const;
@@ -69,6 +83,8 @@ class PatriciaTriePolicy : public DictionaryStructureWithBufferPolicy {
 
     int getProbabilityOfPtNode(const int *const prevWordsPtNodePos, const int ptNodePos) const;
 
+    int getUnigramProbabilityOfPtNode(const int ptNodePos) const;
+
     void iterateNgramEntries(const int *const prevWordsPtNodePos,
             NgramListener *const listener) const;
 
@@ -128,18 +144,22 @@ class PatriciaTriePolicy : public DictionaryStructureWithBufferPolicy {
     }
 
     void getProperty(const char *const query, const int queryLength, char *const outResult,
-            const int maxResultLength) {
-        // getProperty is not supported for this class.
-        if (maxResultLength > 0) {
-            outResult[0] = '\0';
-        }
-    }
+            const int maxResultLength);
 
     const WordProperty getWordProperty(const int *const codePoints,
             const int codePointCount) const;
 
     int getNextWordAndNextToken(const int token, int *const outCodePoints,
-            int *const outCodePointCount);
+            int *const outCodePointCount) {
+        return getNextWordAndNextToken(token, outCodePoints, outCodePointCount,
+                &mTerminalPtNodePositionsForIteratingWords);
+    }
+
+    // The iteration state is kept by the caller, so that a policy shared by several Dictionary
+    // instances can be iterated by all of them at the same time.
+    int getNextWordAndNextToken(const int token, int *const outCodePoints,
+            int *const outCodePointCount,
+            std::vector<int> *const terminalPtNodePositionsForIteratingWords) const;
 
     bool isCorrupted() const {
         return mIsCorrupted;
@@ -148,6 +168,17 @@ class PatriciaTriePolicy : public DictionaryStructureWithBufferPolicy {
  private:
     DISALLOW_IMPLICIT_CONSTRUCTORS(PatriciaTriePolicy);
 
+    static const char *const RESIDENT_SIZE_QUERY;
+    static const char *const MAJOR_PAGE_FAULT_COUNT_QUERY;
+    static const char *const MINOR_PAGE_FAULT_COUNT_QUERY;
+    // Size to prefetch from the head of each PtNode array in the level under the root.
+    static const int TOP_LEVEL_PT_NODE_ARRAY_PREFETCH_SIZE;
+    // The FirstCodePointLookupTable has the PtNode arrays that are in these levels from the root
+    // and have at least this number of PtNodes. Large arrays are near the root, and reading the
+    // whole trie would make opening the dictionary slow.
+    static const int FIRST_CODE_POINT_LOOKUP_TABLE_MAX_DEPTH;
+    static const int FIRST_CODE_POINT_LOOKUP_TABLE_MIN_PT_NODE_COUNT;
+
     const MmappedBuffer::MmappedBufferPtr mMmappedBuffer;
     const HeaderPolicy mHeaderPolicy;
     const uint8_t *const mDictRoot;
@@ -156,12 +187,15 @@ class PatriciaTriePolicy : public DictionaryStructureWithBufferPolicy {
     const ShortcutListPolicy mShortcutListPolicy;
     const Ver2ParticiaTrieNodeReader mPtNodeReader;
     const Ver2PtNodeArrayReader mPtNodeArrayReader;
+    FirstCodePointLookupTable mFirstCodePointLookupTable;
     std::vector<int> mTerminalPtNodePositionsForIteratingWords;
-    mutable bool mIsCorrupted;
+    // Set from const methods of a policy that can be shared between threads.
+    mutable std::atomic<bool> mIsCorrupted;
 
+    void prefetchTopLevelPtNodeArrays() const;
+    void buildFirstCodePointLookupTable();
     int getBigramsPositionOfPtNode(const int ptNodePos) const;
-    int createAndGetLeavingChildNode(const DicNode *const dicNode, const int ptNodePos,
-            DicNodeVector *const childDicNodes) const;
+    int visitChildPtNode(const int ptNodePos, ChildPtNodeListener *const listener) const;
 };
 } // namespace latinime
 #endif // LATINIME_PATRICIA_TRIE_POLICY_H
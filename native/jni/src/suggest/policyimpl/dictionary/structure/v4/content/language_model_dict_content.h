@@ -47,6 +47,10 @@ class LanguageModelDictContent {
         return mTrieMap.isNearSizeLimit();
     }
 
+    bool verifyStructure() const {
+        return mTrieMap.verifyStructure();
+    }
+
     bool save(FILE *const file) const;
 
     bool runGC(const TerminalPositionLookupTable::TerminalIdMap *const terminalIdMap,
@@ -63,6 +63,10 @@ class SparseTableDictContent {
                 || mExpandableContentBuffer.isNearSizeLimit();
     }
 
+    bool verifyStructure() const {
+        return mAddressLookupTable.verifyStructure(mExpandableContentBuffer.getTailPosition());
+    }
+
  protected:
     SparseTable *getUpdatableAddressLookupTable() {
         return &mAddressLookupTable;
@@ -50,6 +50,24 @@ bool TerminalPositionLookupTable::setTerminalPtNodePosition(
             Ver4DictConstants::TERMINAL_ADDRESS_TABLE_ADDRESS_SIZE, getEntryPos(terminalId));
 }
 
+bool TerminalPositionLookupTable::verifyStructure(const int trieSize) const {
+    if (getBuffer()->getTailPosition() % Ver4DictConstants::TERMINAL_ADDRESS_TABLE_ADDRESS_SIZE
+            != 0) {
+        AKLOGE("Invalid terminal position lookup table size: %d",
+                getBuffer()->getTailPosition());
+        return false;
+    }
+    for (int terminalId = 0; terminalId < mSize; ++terminalId) {
+        const int terminalPtNodePos = getTerminalPtNodePosition(terminalId);
+        if (terminalPtNodePos != NOT_A_DICT_POS && terminalPtNodePos >= trieSize) {
+            AKLOGE("Invalid terminal PtNode position %d for terminal id %d. trie size: %d",
+                    terminalPtNodePos, terminalId, trieSize);
+            return false;
+        }
+    }
+    return true;
+}
+
 bool TerminalPositionLookupTable::flushToFile(FILE *const file) const {
     // If the used buffer size is smaller than the actual buffer size, regenerate the lookup
     // table and write the new table to the file.
@@ -48,6 +48,9 @@ class TerminalPositionLookupTable : public SingleDictContent {
 
     bool flushToFile(FILE *const file) const;
 
+    // Checks that every terminal position is inside the trie.
+    bool verifyStructure(const int trieSize) const;
+
     bool runGCTerminalIds(TerminalIdMap *const terminalIdMap);
 
  private:
@@ -17,19 +17,38 @@
 #include "suggest/policyimpl/dictionary/structure/v4/ver4_dict_buffers.h"
 
 #include <cerrno>
+#include <chrono>
 #include <cstring>
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <vector>
 
+#include "suggest/policyimpl/dictionary/structure/v4/ver4_pt_node_array_reader.h"
 #include "suggest/policyimpl/dictionary/utils/byte_array_utils.h"
+#include "suggest/policyimpl/dictionary/utils/checksum_utils.h"
 #include "suggest/policyimpl/dictionary/utils/dict_file_writing_utils.h"
 #include "suggest/policyimpl/dictionary/utils/file_utils.h"
 #include "utils/byte_array_view.h"
+#include "utils/thread_pool.h"
 
 namespace latinime {
 
+const int Ver4DictBuffers::TRIE_SECTION_INDEX = 0;
+const int Ver4DictBuffers::TERMINAL_POSITION_LOOKUP_TABLE_SECTION_INDEX = 1;
+const int Ver4DictBuffers::LANGUAGE_MODEL_SECTION_INDEX = 2;
+const int Ver4DictBuffers::BIGRAM_SECTION_INDEX = 3;
+const int Ver4DictBuffers::SHORTCUT_SECTION_INDEX = 4;
+const int Ver4DictBuffers::BODY_CHECKSUM_SECTION_INDEX = 5;
+const char *const Ver4DictBuffers::VERIFIED_SECTION_NAMES[NUM_OF_VERIFIED_SECTIONS] =
+        { "trie", "terminalPositionLookupTable", "languageModel", "bigram", "shortcut",
+                "bodyChecksum" };
+
+static int getElapsedMicroseconds(const std::chrono::steady_clock::time_point startTime) {
+    return static_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - startTime).count());
+}
+
 /* static */ Ver4DictBuffers::Ver4DictBuffersPtr Ver4DictBuffers::openVer4DictBuffers(
         const char *const dictPath, MmappedBuffer::MmappedBufferPtr &&headerBuffer,
         const FormatUtils::FORMAT_VERSION formatVersion) {
@@ -39,6 +58,7 @@ namespace latinime {
         return Ver4DictBuffersPtr(nullptr);
     }
     // TODO: take only dictDirPath, and open both header and trie files in the constructor below
+    const std::chrono::steady_clock::time_point openStartTime = std::chrono::steady_clock::now();
     const bool isUpdatable = headerBuffer->isUpdatable();
     MmappedBuffer::MmappedBufferPtr bodyBuffer = MmappedBuffer::openBuffer(dictPath,
             Ver4DictConstants::BODY_FILE_EXTENSION, isUpdatable);
@@ -65,12 +85,105 @@ namespace latinime {
         AKLOGE("The dict body file is corrupted.");
         return Ver4DictBuffersPtr(nullptr);
     }
-    return Ver4DictBuffersPtr(new Ver4DictBuffers(std::move(headerBuffer), std::move(bodyBuffer),
-            formatVersion, buffers, bufferSizes));
+    Ver4DictBuffersPtr dictBuffers(new Ver4DictBuffers(std::move(headerBuffer),
+            std::move(bodyBuffer), formatVersion, buffers, bufferSizes));
+    dictBuffers->mBodyOpenTimeInMicroseconds = getElapsedMicroseconds(openStartTime);
+    // Detect broken dictionaries here rather than while they are being read for suggestions.
+    if (!dictBuffers->verifySections()) {
+        return Ver4DictBuffersPtr(nullptr);
+    }
+    return dictBuffers;
+}
+
+void Ver4DictBuffers::getOpenTimings(char *const outResult, const int maxResultLength) const {
+    int length = snprintf(outResult, maxResultLength, "body:%d", mBodyOpenTimeInMicroseconds);
+    for (int i = 0; i < NUM_OF_VERIFIED_SECTIONS; ++i) {
+        if (length < 0 || length >= maxResultLength) {
+            return;
+        }
+        length += snprintf(outResult + length, maxResultLength - length, " %s:%d",
+                VERIFIED_SECTION_NAMES[i], mSectionVerificationTimesInMicroseconds[i]);
+    }
+}
+
+bool Ver4DictBuffers::verifySections() {
+    bool results[NUM_OF_VERIFIED_SECTIONS];
+    // The sections are independent views of the body buffer and are only read here.
+    ThreadPool::getInstance()->runTasks(NUM_OF_VERIFIED_SECTIONS,
+            [this, &results](const int sectionIndex) {
+                const std::chrono::steady_clock::time_point startTime =
+                        std::chrono::steady_clock::now();
+                results[sectionIndex] = verifySection(sectionIndex);
+                mSectionVerificationTimesInMicroseconds[sectionIndex] =
+                        getElapsedMicroseconds(startTime);
+            });
+    for (int i = 0; i < NUM_OF_VERIFIED_SECTIONS; ++i) {
+        if (!results[i]) {
+            AKLOGE("The %s section of the dict body file is corrupted.",
+                    VERIFIED_SECTION_NAMES[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Ver4DictBuffers::verifySection(const int sectionIndex) const {
+    if (sectionIndex == TRIE_SECTION_INDEX) {
+        return Ver4PtNodeArrayReader(&mExpandableTrieBuffer).verifyRootPtNodeArray(
+                mExpandableTrieBuffer.getTailPosition());
+    } else if (sectionIndex == TERMINAL_POSITION_LOOKUP_TABLE_SECTION_INDEX) {
+        return mTerminalPositionLookupTable.verifyStructure(
+                mExpandableTrieBuffer.getTailPosition());
+    } else if (sectionIndex == LANGUAGE_MODEL_SECTION_INDEX) {
+        return mLanguageModelDictContent.verifyStructure();
+    } else if (sectionIndex == BIGRAM_SECTION_INDEX) {
+        return mBigramDictContent.verifyStructure();
+    } else if (sectionIndex == SHORTCUT_SECTION_INDEX) {
+        return mShortcutDictContent.verifyStructure();
+    } else if (sectionIndex == BODY_CHECKSUM_SECTION_INDEX) {
+        return verifyBodyChecksum();
+    }
+    return false;
+}
+
+bool Ver4DictBuffers::verifyBodyChecksum() const {
+    uint32_t expectedChecksum = 0;
+    if (!mHeaderPolicy.readBodyChecksum(&expectedChecksum)) {
+        // The checksum is optional.
+        return true;
+    }
+    const ReadOnlyByteArrayView body = mDictBuffer->getReadOnlyByteArrayView();
+    return ChecksumUtils::getAdler32(body.data(), body.size()) == expectedChecksum;
 }
 
 bool Ver4DictBuffers::flushHeaderAndDictBuffers(const char *const dictDirPath,
         const BufferWithExtendableBuffer *const headerBuffer) const {
+    return flushBodyAndHeader(dictDirPath,
+            [headerBuffer](const uint32_t /* bodyChecksum */) { return headerBuffer; });
+}
+
+bool Ver4DictBuffers::flushHeaderAndDictBuffersWithBodyChecksum(const char *const dictDirPath,
+        const HeaderPolicy *const headerPolicy, const bool updatesLastDecayedTime,
+        const int unigramCount, const int bigramCount, const int extendedRegionSize) const {
+    BufferWithExtendableBuffer headerBuffer(
+            BufferWithExtendableBuffer::DEFAULT_MAX_ADDITIONAL_BUFFER_SIZE);
+    return flushBodyAndHeader(dictDirPath, [&](const uint32_t bodyChecksum)
+            -> const BufferWithExtendableBuffer * {
+        if (!headerPolicy->fillInAndWriteHeaderToBuffer(updatesLastDecayedTime, unigramCount,
+                bigramCount, extendedRegionSize, bodyChecksum, &headerBuffer)) {
+            AKLOGE("Cannot write header structure to buffer. "
+                    "updatesLastDecayedTime: %d, unigramCount: %d, bigramCount: %d, "
+                    "extendedRegionSize: %d", updatesLastDecayedTime, unigramCount, bigramCount,
+                    extendedRegionSize);
+            return nullptr;
+        }
+        return &headerBuffer;
+    });
+}
+
+template<typename HeaderBufferCreator>
+bool Ver4DictBuffers::flushBodyAndHeader(const char *const dictDirPath,
+        const HeaderBufferCreator &createHeaderBuffer) const {
     // Create temporary directory.
     const int tmpDirPathBufSize = FileUtils::getFilePathWithSuffixBufSize(dictDirPath,
             DictFileWritingUtils::TEMP_FILE_SUFFIX_FOR_WRITING_DICT_FILE);
@@ -98,14 +211,6 @@ bool Ver4DictBuffers::flushHeaderAndDictBuffers(const char *const dictDirPath,
     char dictPath[dictPathBufSize];
     FileUtils::getFilePath(tmpDirPath, dictName, dictPathBufSize, dictPath);
 
-    // Write header file.
-    if (!DictFileWritingUtils::flushBufferToFileWithSuffix(dictPath,
-            Ver4DictConstants::HEADER_FILE_EXTENSION, headerBuffer)) {
-        AKLOGE("Dictionary header file %s%s cannot be written.", tmpDirPath,
-                Ver4DictConstants::HEADER_FILE_EXTENSION);
-        return false;
-    }
-
     // Write body file.
     const int bodyFilePathBufSize = FileUtils::getFilePathWithSuffixBufSize(dictPath,
             Ver4DictConstants::BODY_FILE_EXTENSION);
@@ -131,6 +236,23 @@ bool Ver4DictBuffers::flushHeaderAndDictBuffers(const char *const dictDirPath,
         return false;
     }
     fclose(file);
+    // Write header file. The body is written first so that the header can have its checksum.
+    const MmappedBuffer::MmappedBufferPtr writtenBodyBuffer =
+            MmappedBuffer::openBuffer(bodyFilePath, false /* isUpdatable */);
+    if (!writtenBodyBuffer) {
+        AKLOGE("Dictionary body file %s cannot be read.", bodyFilePath);
+        return false;
+    }
+    const ReadOnlyByteArrayView writtenBody = writtenBodyBuffer->getReadOnlyByteArrayView();
+    const BufferWithExtendableBuffer *const headerBuffer = createHeaderBuffer(
+            ChecksumUtils::getAdler32(writtenBody.data(), writtenBody.size()));
+    if (!headerBuffer || !DictFileWritingUtils::flushBufferToFileWithSuffix(dictPath,
+            Ver4DictConstants::HEADER_FILE_EXTENSION, headerBuffer)) {
+        AKLOGE("Dictionary header file %s%s cannot be written.", tmpDirPath,
+                Ver4DictConstants::HEADER_FILE_EXTENSION);
+        return false;
+    }
+
     // Remove existing dictionary.
     if (!FileUtils::removeDirAndFiles(dictDirPath)) {
         AKLOGE("Existing directory %s cannot be removed.", dictDirPath);
@@ -201,7 +323,8 @@ Ver4DictBuffers::Ver4DictBuffers(MmappedBuffer::MmappedBufferPtr &&headerBuffer,
                   mHeaderPolicy.hasHistoricalInfoOfWords()),
           mShortcutDictContent(&contentBuffers[Ver4DictConstants::SHORTCUT_BUFFERS_INDEX],
                   &contentBufferSizes[Ver4DictConstants::SHORTCUT_BUFFERS_INDEX]),
-          mIsUpdatable(mDictBuffer->isUpdatable()) {}
+          mIsUpdatable(mDictBuffer->isUpdatable()), mBodyOpenTimeInMicroseconds(0),
+          mSectionVerificationTimesInMicroseconds() {}
 
 Ver4DictBuffers::Ver4DictBuffers(const HeaderPolicy *const headerPolicy, const int maxTrieSize)
         : mHeaderBuffer(nullptr), mDictBuffer(nullptr), mHeaderPolicy(headerPolicy),
@@ -209,6 +332,7 @@ Ver4DictBuffers::Ver4DictBuffers(const HeaderPolicy *const headerPolicy, const i
           mExpandableTrieBuffer(maxTrieSize), mTerminalPositionLookupTable(),
           mLanguageModelDictContent(headerPolicy->hasHistoricalInfoOfWords()),
           mBigramDictContent(headerPolicy->hasHistoricalInfoOfWords()), mShortcutDictContent(),
-          mIsUpdatable(true) {}
+          mIsUpdatable(true), mBodyOpenTimeInMicroseconds(0),
+          mSectionVerificationTimesInMicroseconds() {}
 
 } // namespace latinime
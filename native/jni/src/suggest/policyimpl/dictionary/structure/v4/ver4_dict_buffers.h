@@ -109,16 +109,59 @@ class Ver4DictBuffers {
         return mIsUpdatable;
     }
 
+    // Must be called before the mapped files are written in place.
+    void prepareForWriting() {
+        if (mHeaderBuffer) {
+            mHeaderBuffer->prepareForWriting();
+        }
+        if (mDictBuffer) {
+            mDictBuffer->prepareForWriting();
+        }
+    }
+
+    // Returns the number of bytes of the mapped files that are resident in memory.
+    int getResidentSize() const {
+        return (mHeaderBuffer ? mHeaderBuffer->getResidentSize() : 0)
+                + (mDictBuffer ? mDictBuffer->getResidentSize() : 0);
+    }
+
+    // Returns the number of bytes of the mapped files that have been copied into anonymous
+    // memory by in-place updates.
+    int getAnonymousSize() const {
+        return (mHeaderBuffer ? mHeaderBuffer->getAnonymousSize() : 0)
+                + (mDictBuffer ? mDictBuffer->getAnonymousSize() : 0);
+    }
+
     bool flush(const char *const dictDirPath) const {
         return flushHeaderAndDictBuffers(dictDirPath, &mExpandableHeaderBuffer);
     }
 
+    // Writes the header as is, so it doesn't have the checksum of the body.
     bool flushHeaderAndDictBuffers(const char *const dictDirPath,
             const BufferWithExtendableBuffer *const headerBuffer) const;
 
+    // Writes the body and then the header filled in by the header policy with the checksum of
+    // the written body.
+    bool flushHeaderAndDictBuffersWithBodyChecksum(const char *const dictDirPath,
+            const HeaderPolicy *const headerPolicy, const bool updatesLastDecayedTime,
+            const int unigramCount, const int bigramCount, const int extendedRegionSize) const;
+
+    // Writes the time in microseconds that each step of openVer4DictBuffers() took, e.g.
+    // "body:12 trie:3 ...".
+    void getOpenTimings(char *const outResult, const int maxResultLength) const;
+
  private:
     DISALLOW_COPY_AND_ASSIGN(Ver4DictBuffers);
 
+    static const int TRIE_SECTION_INDEX;
+    static const int TERMINAL_POSITION_LOOKUP_TABLE_SECTION_INDEX;
+    static const int LANGUAGE_MODEL_SECTION_INDEX;
+    static const int BIGRAM_SECTION_INDEX;
+    static const int SHORTCUT_SECTION_INDEX;
+    static const int BODY_CHECKSUM_SECTION_INDEX;
+    static const int NUM_OF_VERIFIED_SECTIONS = 6;
+    static const char *const VERIFIED_SECTION_NAMES[NUM_OF_VERIFIED_SECTIONS];
+
     Ver4DictBuffers(MmappedBuffer::MmappedBufferPtr &&headerBuffer,
             MmappedBuffer::MmappedBufferPtr &&bodyBuffer,
             const FormatUtils::FORMAT_VERSION formatVersion,
@@ -127,8 +170,22 @@ class Ver4DictBuffers {
 
     Ver4DictBuffers(const HeaderPolicy *const headerPolicy, const int maxTrieSize);
 
+    // Writes the body file and then the header file returned by createHeaderBuffer, which is
+    // called with the checksum of the written body, and replaces the dictionary with them.
+    template<typename HeaderBufferCreator>
+    bool flushBodyAndHeader(const char *const dictDirPath,
+            const HeaderBufferCreator &createHeaderBuffer) const;
+
     bool flushDictBuffers(FILE *const file) const;
 
+    // Verifies all sections concurrently and records how long each verification took.
+    bool verifySections();
+
+    bool verifySection(const int sectionIndex) const;
+
+    // The body checksum in the header is optional, and is checked only when it exists.
+    bool verifyBodyChecksum() const;
+
     const MmappedBuffer::MmappedBufferPtr mHeaderBuffer;
     const MmappedBuffer::MmappedBufferPtr mDictBuffer;
     const HeaderPolicy mHeaderPolicy;
@@ -139,6 +196,8 @@ class Ver4DictBuffers {
     BigramDictContent mBigramDictContent;
     ShortcutDictContent mShortcutDictContent;
     const int mIsUpdatable;
+    int mBodyOpenTimeInMicroseconds;
+    int mSectionVerificationTimesInMicroseconds[NUM_OF_VERIFIED_SECTIONS];
 };
 } // namespace latinime
 #endif /* LATINIME_VER4_DICT_BUFFER_H */
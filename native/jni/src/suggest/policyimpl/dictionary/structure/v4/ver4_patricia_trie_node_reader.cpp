@@ -27,7 +27,7 @@
 namespace latinime {
 
 const PtNodeParams Ver4PatriciaTrieNodeReader::fetchPtNodeInfoFromBufferAndProcessMovedPtNode(
-        const int ptNodePos, const int siblingNodePos) const {
+        const int ptNodePos, const int siblingNodePos, const bool readsProbability) const {
     if (ptNodePos < 0 || ptNodePos >= mBuffer->getTailPosition()) {
         // Reading invalid position because of bug or broken dictionary.
         AKLOGE("Fetching PtNode info from invalid dictionary position: %d, dictionary size: %d",
@@ -61,14 +61,17 @@ const PtNodeParams Ver4PatriciaTrieNodeReader::fetchPtNodeInfoFromBufferAndProce
             terminalIdFieldPos += mBuffer->getOriginalBufferSize();
         }
         terminalId = Ver4PatriciaTrieReadingUtils::getTerminalIdAndAdvancePosition(dictBuf, &pos);
-        // TODO: Quit reading probability here.
-        const ProbabilityEntry probabilityEntry =
-                mLanguageModelDictContent->getProbabilityEntry(terminalId);
-        if (probabilityEntry.hasHistoricalInfo()) {
-            probability = ForgettingCurveUtils::decodeProbability(
-                    probabilityEntry.getHistoricalInfo(), mHeaderPolicy);
+        if (readsProbability) {
+            const ProbabilityEntry probabilityEntry =
+                    mLanguageModelDictContent->getProbabilityEntry(terminalId);
+            if (probabilityEntry.hasHistoricalInfo()) {
+                probability = ForgettingCurveUtils::decodeProbability(
+                        probabilityEntry.getHistoricalInfo(), mHeaderPolicy);
+            } else {
+                probability = probabilityEntry.getProbability();
+            }
         } else {
-            probability = probabilityEntry.getProbability();
+            probability = NOT_YET_READ_PROBABILITY;
         }
     }
     int childrenPosFieldPos = pos;
@@ -88,7 +91,8 @@ const PtNodeParams Ver4PatriciaTrieNodeReader::fetchPtNodeInfoFromBufferAndProce
     // Read destination node if the read node is a moved node.
     if (DynamicPtReadingUtils::isMoved(flags)) {
         // The destination position is stored at the same place as the parent position.
-        return fetchPtNodeInfoFromBufferAndProcessMovedPtNode(parentPos, newSiblingNodePos);
+        return fetchPtNodeInfoFromBufferAndProcessMovedPtNode(parentPos, newSiblingNodePos,
+                readsProbability);
     } else {
         return PtNodeParams(headPos, flags, parentPos, codePonitCount, codePoints,
                 terminalIdFieldPos, terminalId, probability, childrenPosFieldPos, childrenPos,
@@ -43,7 +43,13 @@ class Ver4PatriciaTrieNodeReader : public PtNodeReader {
 
     virtual const PtNodeParams fetchPtNodeParamsInBufferFromPtNodePos(const int ptNodePos) const {
         return fetchPtNodeInfoFromBufferAndProcessMovedPtNode(ptNodePos,
-                NOT_A_DICT_POS /* siblingNodePos */);
+                NOT_A_DICT_POS /* siblingNodePos */, true /* readsProbability */);
+    }
+
+    virtual const PtNodeParams fetchPtNodeHeaderParamsInBufferFromPtNodePos(
+            const int ptNodePos) const {
+        return fetchPtNodeInfoFromBufferAndProcessMovedPtNode(ptNodePos,
+                NOT_A_DICT_POS /* siblingNodePos */, false /* readsProbability */);
     }
 
  private:
@@ -54,7 +60,7 @@ class Ver4PatriciaTrieNodeReader : public PtNodeReader {
     const HeaderPolicy *const mHeaderPolicy;
 
     const PtNodeParams fetchPtNodeInfoFromBufferAndProcessMovedPtNode(const int ptNodePos,
-            const int siblingNodePos) const;
+            const int siblingNodePos, const bool readsProbability) const;
 };
 } // namespace latinime
 #endif /* LATINIME_VER4_PATRICIA_TRIE_NODE_READER_H */
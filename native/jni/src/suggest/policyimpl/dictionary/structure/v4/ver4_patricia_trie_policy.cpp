@@ -20,6 +20,7 @@
 
 #include "suggest/core/dicnode/dic_node.h"
 #include "suggest/core/dicnode/dic_node_vector.h"
+#include "suggest/core/dictionary/child_pt_node_listener.h"
 #include "suggest/core/dictionary/ngram_listener.h"
 #include "suggest/core/dictionary/property/bigram_property.h"
 #include "suggest/core/dictionary/property/unigram_property.h"
@@ -29,6 +30,7 @@
 #include "suggest/policyimpl/dictionary/structure/v4/ver4_patricia_trie_node_reader.h"
 #include "suggest/policyimpl/dictionary/utils/forgetting_curve_utils.h"
 #include "suggest/policyimpl/dictionary/utils/probability_utils.h"
+#include "utils/memory_usage_utils.h"
 
 namespace latinime {
 
@@ -38,6 +40,11 @@ const char *const Ver4PatriciaTriePolicy::UNIGRAM_COUNT_QUERY = "UNIGRAM_COUNT";
 const char *const Ver4PatriciaTriePolicy::BIGRAM_COUNT_QUERY = "BIGRAM_COUNT";
 const char *const Ver4PatriciaTriePolicy::MAX_UNIGRAM_COUNT_QUERY = "MAX_UNIGRAM_COUNT";
 const char *const Ver4PatriciaTriePolicy::MAX_BIGRAM_COUNT_QUERY = "MAX_BIGRAM_COUNT";
+const char *const Ver4PatriciaTriePolicy::RESIDENT_SIZE_QUERY = "RESIDENT_SIZE";
+const char *const Ver4PatriciaTriePolicy::ANONYMOUS_SIZE_QUERY = "ANONYMOUS_SIZE";
+const char *const Ver4PatriciaTriePolicy::MAJOR_PAGE_FAULT_COUNT_QUERY = "MAJOR_PAGE_FAULT_COUNT";
+const char *const Ver4PatriciaTriePolicy::MINOR_PAGE_FAULT_COUNT_QUERY = "MINOR_PAGE_FAULT_COUNT";
+const char *const Ver4PatriciaTriePolicy::OPEN_TIMINGS_QUERY = "OPEN_TIMINGS";
 const int Ver4PatriciaTriePolicy::MARGIN_TO_REFUSE_DYNAMIC_OPERATIONS = 1024;
 const int Ver4PatriciaTriePolicy::MIN_DICT_SIZE_TO_REFUSE_DYNAMIC_OPERATIONS =
         Ver4DictConstants::MAX_DICTIONARY_SIZE - MARGIN_TO_REFUSE_DYNAMIC_OPERATIONS;
@@ -47,10 +54,30 @@ void Ver4PatriciaTriePolicy::createAndGetAllChildDicNodes(const DicNode *const d
     if (!dicNode->hasChildren()) {
         return;
     }
+    DicNodeVector::LeavingChildPusher leavingChildPusher(dicNode, childDicNodes);
+    iterateChildPtNodes(dicNode->getChildrenPtNodeArrayPos(), &leavingChildPusher);
+}
+
+void Ver4PatriciaTriePolicy::createAndGetAllChildDicNodesWithoutProbabilities(
+        const DicNode *const dicNode, DicNodeVector *const childDicNodes) const {
+    if (!dicNode->hasChildren()) {
+        return;
+    }
+    DicNodeVector::LeavingChildPusher leavingChildPusher(dicNode, childDicNodes);
+    // The probabilities of a decaying dictionary decide whether terminals are valid, so they are
+    // read with the PtNodes.
+    iterateChildPtNodes(dicNode->getChildrenPtNodeArrayPos(),
+            mHeaderPolicy->isDecayingDict() /* readsProbabilities */, &leavingChildPusher);
+}
+
+void Ver4PatriciaTriePolicy::iterateChildPtNodes(const int ptNodeArrayPos,
+        const bool readsProbabilities,
+        ChildPtNodeListener *const listener) const {
     DynamicPtReadingHelper readingHelper(&mNodeReader, &mPtNodeArrayReader);
-    readingHelper.initWithPtNodeArrayPos(dicNode->getChildrenPtNodeArrayPos());
+    readingHelper.initWithPtNodeArrayPos(ptNodeArrayPos);
     while (!readingHelper.isEnd()) {
-        const PtNodeParams ptNodeParams = readingHelper.getPtNodeParams();
+        const PtNodeParams ptNodeParams = readsProbabilities ?
+                readingHelper.getPtNodeParams() : readingHelper.getPtNodeHeaderParams();
         if (!ptNodeParams.isValid()) {
             break;
         }
@@ -66,16 +93,15 @@ void Ver4PatriciaTriePolicy::createAndGetAllChildDicNodes(const DicNode *const d
             // Skip PtNodes that represent non-word information.
             continue;
         }
-        childDicNodes->pushLeavingChild(dicNode, ptNodeParams.getHeadPos(),
-                ptNodeParams.getChildrenPos(), ptNodeParams.getProbability(), isTerminal,
-                ptNodeParams.hasChildren(),
+        listener->onVisitChildPtNode(ptNodeParams.getHeadPos(), ptNodeParams.getChildrenPos(),
+                ptNodeParams.getProbability(), isTerminal, ptNodeParams.hasChildren(),
                 ptNodeParams.isBlacklisted()
                         || ptNodeParams.isNotAWord() /* isBlacklistedOrNotAWord */,
                 ptNodeParams.getCodePointCount(), ptNodeParams.getCodePoints());
     }
     if (readingHelper.isError()) {
         mIsCorrupted = true;
-        AKLOGE("Dictionary reading error in createAndGetAllChildDicNodes().");
+        AKLOGE("Dictionary reading error in iterateChildPtNodes().");
     }
 }
 
@@ -97,8 +123,9 @@ int Ver4PatriciaTriePolicy::getTerminalPtNodePositionOfWord(const int *const inW
         const int length, const bool forceLowerCaseSearch) const {
     DynamicPtReadingHelper readingHelper(&mNodeReader, &mPtNodeArrayReader);
     readingHelper.initWithPtNodeArrayPos(getRootPosition());
-    const int ptNodePos =
-            readingHelper.getTerminalPtNodePositionOfWord(inWord, length, forceLowerCaseSearch);
+    // The trie can be updated, so it doesn't have a FirstCodePointLookupTable.
+    const int ptNodePos = readingHelper.getTerminalPtNodePositionOfWord(inWord, length,
+            forceLowerCaseSearch, nullptr /* firstCodePointLookupTable */);
     if (readingHelper.isError()) {
         mIsCorrupted = true;
         AKLOGE("Dictionary reading error in createAndGetAllChildDicNodes().");
@@ -122,6 +149,13 @@ int Ver4PatriciaTriePolicy::getProbability(const int unigramProbability,
     }
 }
 
+int Ver4PatriciaTriePolicy::getUnigramProbabilityOfPtNode(const int ptNodePos) const {
+    if (ptNodePos == NOT_A_DICT_POS) {
+        return NOT_A_PROBABILITY;
+    }
+    return mNodeReader.fetchPtNodeParamsInBufferFromPtNodePos(ptNodePos).getProbability();
+}
+
 int Ver4PatriciaTriePolicy::getProbabilityOfPtNode(const int *const prevWordsPtNodePos,
         const int ptNodePos) const {
     if (ptNodePos == NOT_A_DICT_POS) {
@@ -189,6 +223,7 @@ bool Ver4PatriciaTriePolicy::addUnigramEntry(const int *const word, const int le
         AKLOGI("Warning: addUnigramEntry() is called for non-updatable dictionary.");
         return false;
     }
+    mBuffers->prepareForWriting();
     if (mDictBuffer->getTailPosition() >= MIN_DICT_SIZE_TO_REFUSE_DYNAMIC_OPERATIONS) {
         AKLOGE("The dictionary is too large to dynamically update. Dictionary size: %d",
                 mDictBuffer->getTailPosition());
@@ -253,6 +288,7 @@ bool Ver4PatriciaTriePolicy::removeUnigramEntry(const int *const word, const int
         AKLOGI("Warning: removeUnigramEntry() is called for non-updatable dictionary.");
         return false;
     }
+    mBuffers->prepareForWriting();
     const int ptNodePos = getTerminalPtNodePositionOfWord(word, length,
             false /* forceLowerCaseSearch */);
     if (ptNodePos == NOT_A_DICT_POS) {
@@ -275,6 +311,7 @@ bool Ver4PatriciaTriePolicy::addNgramEntry(const PrevWordsInfo *const prevWordsI
         AKLOGI("Warning: addNgramEntry() is called for non-updatable dictionary.");
         return false;
     }
+    mBuffers->prepareForWriting();
     if (mDictBuffer->getTailPosition() >= MIN_DICT_SIZE_TO_REFUSE_DYNAMIC_OPERATIONS) {
         AKLOGE("The dictionary is too large to dynamically update. Dictionary size: %d",
                 mDictBuffer->getTailPosition());
@@ -338,6 +375,7 @@ bool Ver4PatriciaTriePolicy::removeNgramEntry(const PrevWordsInfo *const prevWor
         AKLOGI("Warning: removeNgramEntry() is called for non-updatable dictionary.");
         return false;
     }
+    mBuffers->prepareForWriting();
     if (mDictBuffer->getTailPosition() >= MIN_DICT_SIZE_TO_REFUSE_DYNAMIC_OPERATIONS) {
         AKLOGE("The dictionary is too large to dynamically update. Dictionary size: %d",
                 mDictBuffer->getTailPosition());
@@ -389,6 +427,8 @@ bool Ver4PatriciaTriePolicy::flushWithGC(const char *const filePath) {
         AKLOGI("Warning: flushWithGC() is called for non-updatable dictionary.");
         return false;
     }
+    // GC marks and updates PtNodes in place before writing the new buffers.
+    mBuffers->prepareForWriting();
     if (!mWritingHelper.writeToDictFileWithGC(getRootPosition(), filePath)) {
         AKLOGE("Cannot flush the dictionary to file with GC.");
         mIsCorrupted = true;
@@ -439,6 +479,16 @@ void Ver4PatriciaTriePolicy::getProperty(const char *const query, const int quer
                         ForgettingCurveUtils::getBigramCountHardLimit(
                                 mHeaderPolicy->getMaxBigramCount()) :
                         static_cast<int>(Ver4DictConstants::MAX_DICTIONARY_SIZE));
+    } else if (strncmp(query, RESIDENT_SIZE_QUERY, compareLength) == 0) {
+        snprintf(outResult, maxResultLength, "%d", mBuffers->getResidentSize());
+    } else if (strncmp(query, ANONYMOUS_SIZE_QUERY, compareLength) == 0) {
+        snprintf(outResult, maxResultLength, "%d", mBuffers->getAnonymousSize());
+    } else if (strncmp(query, MAJOR_PAGE_FAULT_COUNT_QUERY, compareLength) == 0) {
+        snprintf(outResult, maxResultLength, "%d", MemoryUsageUtils::getMajorPageFaultCount());
+    } else if (strncmp(query, MINOR_PAGE_FAULT_COUNT_QUERY, compareLength) == 0) {
+        snprintf(outResult, maxResultLength, "%d", MemoryUsageUtils::getMinorPageFaultCount());
+    } else if (strncmp(query, OPEN_TIMINGS_QUERY, compareLength) == 0) {
+        mBuffers->getOpenTimings(outResult, maxResultLength);
     }
 }
 
@@ -17,6 +17,7 @@
 #ifndef LATINIME_VER4_PATRICIA_TRIE_POLICY_H
 #define LATINIME_VER4_PATRICIA_TRIE_POLICY_H
 
+#include <atomic>
 #include <vector>
 
 #include "defines.h"
@@ -63,6 +64,13 @@ class Ver4PatriciaTriePolicy : public DictionaryStructureWithBufferPolicy {
     void createAndGetAllChildDicNodes(const DicNode *const dicNode,
             DicNodeVector *const childDicNodes) const;
 
+    void createAndGetAllChildDicNodesWithoutProbabilities(const DicNode *const dicNode,
+            DicNodeVector *const childDicNodes) const;
+
+    void iterateChildPtNodes(const int ptNodeArrayPos, ChildPtNodeListener *const listener) const {
+        iterateChildPtNodes(ptNodeArrayPos, true /* readsProbabilities */, listener);
+    }
+
     int getCodePointsAndProbabilityAndReturnCodePointCount(
             const int terminalPtNodePos, const int maxCodePointCount, int *const outCodePoints,
             int *const outUnigramProbability) const;
@@ -74,6 +82,8 @@ class Ver4PatriciaTriePolicy : public DictionaryStructureWithBufferPolicy {
 
     int getProbabilityOfPtNode(const int *const prevWordsPtNodePos, const int ptNodePos) const;
 
+    int getUnigramProbabilityOfPtNode(const int ptNodePos) const;
+
     void iterateNgramEntries(const int *const prevWordsPtNodePos,
             NgramListener *const listener) const;
 
@@ -124,6 +134,11 @@ class Ver4PatriciaTriePolicy : public DictionaryStructureWithBufferPolicy {
     static const char *const BIGRAM_COUNT_QUERY;
     static const char *const MAX_UNIGRAM_COUNT_QUERY;
     static const char *const MAX_BIGRAM_COUNT_QUERY;
+    static const char *const RESIDENT_SIZE_QUERY;
+    static const char *const ANONYMOUS_SIZE_QUERY;
+    static const char *const MAJOR_PAGE_FAULT_COUNT_QUERY;
+    static const char *const MINOR_PAGE_FAULT_COUNT_QUERY;
+    static const char *const OPEN_TIMINGS_QUERY;
     // When the dictionary size is near the maximum size, we have to refuse dynamic operations to
     // prevent the dictionary from overflowing.
     static const int MARGIN_TO_REFUSE_DYNAMIC_OPERATIONS;
@@ -142,9 +157,15 @@ class Ver4PatriciaTriePolicy : public DictionaryStructureWithBufferPolicy {
     int mUnigramCount;
     int mBigramCount;
     std::vector<int> mTerminalPtNodePositionsForIteratingWords;
-    mutable bool mIsCorrupted;
+    // Set from const methods of a policy that can be shared between threads.
+    mutable std::atomic<bool> mIsCorrupted;
 
     int getBigramsPositionOfPtNode(const int ptNodePos) const;
+
+    // Without readsProbabilities, the probabilities of terminals are NOT_YET_READ_PROBABILITY
+    // and the language model isn't looked up.
+    void iterateChildPtNodes(const int ptNodeArrayPos,
+            const bool readsProbabilities, ChildPtNodeListener *const listener) const;
 };
 } // namespace latinime
 #endif // LATINIME_VER4_PATRICIA_TRIE_POLICY_H
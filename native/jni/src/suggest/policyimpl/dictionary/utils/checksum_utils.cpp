@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/policyimpl/dictionary/utils/checksum_utils.h"
+
+#include <algorithm>
+
+namespace latinime {
+
+const uint32_t ChecksumUtils::ADLER32_MODULUS = 65521;
+// The largest block size for which the sums cannot overflow 32 bits before being reduced.
+const int ChecksumUtils::ADLER32_MAX_BLOCK_SIZE = 5552;
+
+/* static */ uint32_t ChecksumUtils::getAdler32(const uint8_t *const buffer, const int size) {
+    uint32_t a = 1;
+    uint32_t b = 0;
+    int pos = 0;
+    while (pos < size) {
+        const int blockEnd = std::min(size, pos + ADLER32_MAX_BLOCK_SIZE);
+        for (; pos < blockEnd; ++pos) {
+            a += buffer[pos];
+            b += a;
+        }
+        a %= ADLER32_MODULUS;
+        b %= ADLER32_MODULUS;
+    }
+    return (b << 16) | a;
+}
+
+} // namespace latinime
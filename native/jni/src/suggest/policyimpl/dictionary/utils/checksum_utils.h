@@ -0,0 +1,39 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_CHECKSUM_UTILS_H
+#define LATINIME_CHECKSUM_UTILS_H
+
+#include <cstdint>
+
+#include "defines.h"
+
+namespace latinime {
+
+class ChecksumUtils {
+ public:
+    // Returns the Adler-32 checksum of the buffer. This is the same value as
+    // java.util.zip.Adler32 computes.
+    static uint32_t getAdler32(const uint8_t *const buffer, const int size);
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(ChecksumUtils);
+
+    static const uint32_t ADLER32_MODULUS;
+    static const int ADLER32_MAX_BLOCK_SIZE;
+};
+} // namespace latinime
+#endif /* LATINIME_CHECKSUM_UTILS_H */
@@ -24,11 +24,13 @@
 
 #include "suggest/policyimpl/dictionary/header/header_policy.h"
 #include "suggest/policyimpl/dictionary/structure/backward/v402/ver4_dict_buffers.h"
+#include "suggest/policyimpl/dictionary/structure/louds/louds_dict_writer.h"
 #include "suggest/policyimpl/dictionary/structure/pt_common/dynamic_pt_writing_utils.h"
 #include "suggest/policyimpl/dictionary/structure/v4/ver4_dict_buffers.h"
 #include "suggest/policyimpl/dictionary/utils/buffer_with_extendable_buffer.h"
 #include "suggest/policyimpl/dictionary/utils/file_utils.h"
 #include "suggest/policyimpl/dictionary/utils/format_utils.h"
+#include "suggest/policyimpl/dictionary/utils/mmapped_buffer.h"
 #include "utils/time_keeper.h"
 
 namespace latinime {
@@ -79,6 +81,77 @@ template<class DictConstants, class DictBuffers, class DictBuffersPtr>
     return dictBuffers->flush(dirPath);
 }
 
+/* static */ bool DictFileWritingUtils::convertVer2DictFile(const char *const ver2DictFilePath,
+        const char *const filePath, const int dictVersion) {
+    const MmappedBuffer::MmappedBufferPtr ver2DictBuffer =
+            MmappedBuffer::openBuffer(ver2DictFilePath, false /* isUpdatable */);
+    if (!ver2DictBuffer) {
+        AKLOGE("Dictionary %s cannot be opened.", ver2DictFilePath);
+        return false;
+    }
+    const FormatUtils::FORMAT_VERSION formatVersion = FormatUtils::getFormatVersion(dictVersion);
+    switch (formatVersion) {
+        case FormatUtils::VERSION_2_LOUDS:
+            return LoudsDictWriter::writeDictFileFromVer2Dict(
+                    ver2DictBuffer->getReadOnlyByteArrayView(), filePath);
+        default:
+            AKLOGE("Cannot convert dictionary %s because format version %d is not supported.",
+                    ver2DictFilePath, dictVersion);
+            return false;
+    }
+}
+
+/* static */ bool DictFileWritingUtils::writeDictFileConvertedFromVer2(
+        const char *const filePath, const ReadOnlyByteArrayView ver2Dict,
+        const FormatUtils::FORMAT_VERSION formatVersion, const int unigramCount,
+        const int bigramCount, const std::vector<uint8_t> *const body) {
+    const HeaderPolicy ver2HeaderPolicy(ver2Dict.data(), FormatUtils::VERSION_2);
+    DictionaryHeaderStructurePolicy::AttributeMap attributeMap(
+            *ver2HeaderPolicy.getAttributeMap());
+    HeaderReadWriteUtils::setIntAttribute(&attributeMap, "UNIGRAM_COUNT", unigramCount);
+    HeaderReadWriteUtils::setIntAttribute(&attributeMap, "BIGRAM_COUNT", bigramCount);
+    BufferWithExtendableBuffer headerBuffer(
+            BufferWithExtendableBuffer::DEFAULT_MAX_ADDITIONAL_BUFFER_SIZE);
+    int writingPos = 0;
+    if (!HeaderReadWriteUtils::writeDictionaryVersion(&headerBuffer, formatVersion,
+            &writingPos)) {
+        return false;
+    }
+    if (!HeaderReadWriteUtils::writeDictionaryFlags(&headerBuffer,
+            HeaderReadWriteUtils::getFlags(ver2Dict.data()), &writingPos)) {
+        return false;
+    }
+    // Temporarily writes a dummy header size.
+    int headerSizeFieldPos = writingPos;
+    if (!HeaderReadWriteUtils::writeDictionaryHeaderSize(&headerBuffer, 0 /* size */,
+            &writingPos)) {
+        return false;
+    }
+    if (!HeaderReadWriteUtils::writeHeaderAttributes(&headerBuffer, &attributeMap,
+            &writingPos)) {
+        return false;
+    }
+    // Writes the actual header size.
+    if (!HeaderReadWriteUtils::writeDictionaryHeaderSize(&headerBuffer, writingPos,
+            &headerSizeFieldPos)) {
+        return false;
+    }
+    FILE *const file = fopen(filePath, "wb");
+    if (!file) {
+        AKLOGE("File %s cannot be opened. errno: %d", filePath, errno);
+        return false;
+    }
+    if (!writeBufferToFile(file, &headerBuffer)
+            || fwrite(body->data(), body->size(), 1 /* count */, file) < 1) {
+        fclose(file);
+        remove(filePath);
+        AKLOGE("Dictionary cannot be written to the file %s.", filePath);
+        return false;
+    }
+    fclose(file);
+    return true;
+}
+
 /* static */ bool DictFileWritingUtils::flushBufferToFileWithSuffix(const char *const basePath,
         const char *const suffix, const BufferWithExtendableBuffer *const buffer) {
     const int filePathBufSize = FileUtils::getFilePathWithSuffixBufSize(basePath, suffix);
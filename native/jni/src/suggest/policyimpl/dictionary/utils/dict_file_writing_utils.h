@@ -17,11 +17,14 @@
 #ifndef LATINIME_DICT_FILE_WRITING_UTILS_H
 #define LATINIME_DICT_FILE_WRITING_UTILS_H
 
+#include <cstdint>
 #include <cstdio>
+#include <vector>
 
 #include "defines.h"
 #include "suggest/policyimpl/dictionary/header/header_read_write_utils.h"
 #include "suggest/policyimpl/dictionary/utils/format_utils.h"
+#include "utils/byte_array_view.h"
 
 namespace latinime {
 
@@ -35,6 +38,16 @@ class DictFileWritingUtils {
             const std::vector<int> localeAsCodePointVector,
             const DictionaryHeaderStructurePolicy::AttributeMap *const attributeMap);
 
+    // Converts the version 2 dictionary file to a read-only dictionary of the given version.
+    static bool convertVer2DictFile(const char *const ver2DictFilePath,
+            const char *const filePath, const int dictVersion);
+
+    // Writes a read-only dictionary that has the header attributes of the given version 2
+    // dictionary, so it has the same date and version, and the given body.
+    static bool writeDictFileConvertedFromVer2(const char *const filePath,
+            const ReadOnlyByteArrayView ver2Dict, const FormatUtils::FORMAT_VERSION formatVersion,
+            const int unigramCount, const int bigramCount, const std::vector<uint8_t> *const body);
+
     static bool flushBufferToFileWithSuffix(const char *const basePath, const char *const suffix,
             const BufferWithExtendableBuffer *const buffer);
 
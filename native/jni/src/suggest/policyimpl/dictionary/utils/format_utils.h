@@ -31,6 +31,8 @@ class FormatUtils {
     enum FORMAT_VERSION {
         // These MUST have the same values as the relevant constants in FormatSpec.java.
         VERSION_2 = 2,
+        // Read-only variant of version 2 with a LOUDS succinct trie.
+        VERSION_2_LOUDS = 203,
         VERSION_4_ONLY_FOR_TESTING = 399,
         VERSION_4 = 402,
         VERSION_4_DEV = 403,
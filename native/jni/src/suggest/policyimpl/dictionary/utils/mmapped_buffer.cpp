@@ -16,20 +16,34 @@
 
 #include "suggest/policyimpl/dictionary/utils/mmapped_buffer.h"
 
+#include <algorithm>
 #include <cerrno>
 #include <climits>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <fcntl.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
+#include <vector>
 
 #include "suggest/policyimpl/dictionary/utils/file_utils.h"
 
 namespace latinime {
 
+const MmappedBuffer::LoadingPolicy MmappedBuffer::LoadingPolicy::NO_HINTS(
+        false /* adviseRandomAccess */, 0 /* prefetchedPrefixSize */, 0 /* lockedPrefixSize */,
+        false /* useHugePageAlignment */);
+
+const int MmappedBuffer::HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+const bool MmappedBuffer::USES_SHADOW_FILE_FOR_UPDATABLE_BUFFERS = true;
+// mkstemp() template. Only used when O_TMPFILE is not available.
+const char *const MmappedBuffer::SHADOW_FILE_NAME_SUFFIX = ".shadow.XXXXXX";
+
 /* static */ MmappedBuffer::MmappedBufferPtr MmappedBuffer::openBuffer(
         const char *const path, const int bufferOffset, const int bufferSize,
-        const bool isUpdatable) {
+        const bool isUpdatable, const LoadingPolicy &loadingPolicy) {
     const int mmapFd = open(path, O_RDONLY);
     if (mmapFd < 0) {
         AKLOGE("DICT: Can't open the source. path=%s errno=%d", path, errno);
@@ -37,11 +51,11 @@ namespace latinime {
     }
     const int pagesize = sysconf(_SC_PAGESIZE);
     const int offset = bufferOffset % pagesize;
-    int alignedOffset = bufferOffset - offset;
-    int alignedSize = bufferSize + offset;
+    const int alignedOffset = bufferOffset - offset;
+    const int alignedSize = bufferSize + offset;
     const int protMode = isUpdatable ? PROT_READ | PROT_WRITE : PROT_READ;
-    void *const mmappedBuffer = mmap(0, alignedSize, protMode, MAP_PRIVATE, mmapFd,
-            alignedOffset);
+    void *const mmappedBuffer = mapFile(mmapFd, alignedOffset, alignedSize, protMode,
+            MAP_PRIVATE, loadingPolicy.useHugePageAlignment() && !isUpdatable);
     if (mmappedBuffer == MAP_FAILED) {
         AKLOGE("DICT: Can't mmap dictionary. errno=%d", errno);
         close(mmapFd);
@@ -53,8 +67,10 @@ namespace latinime {
         close(mmapFd);
         return nullptr;
     }
+    applyLoadingPolicy(static_cast<uint8_t *>(mmappedBuffer), alignedSize, offset,
+            loadingPolicy);
     return MmappedBufferPtr(new MmappedBuffer(buffer, bufferSize, mmappedBuffer, alignedSize,
-            mmapFd, isUpdatable));
+            mmapFd, isUpdatable, loadingPolicy, path));
 }
 
 /* static */ MmappedBuffer::MmappedBufferPtr MmappedBuffer::openBuffer(
@@ -81,6 +97,205 @@ namespace latinime {
     return openBuffer(filePath, isUpdatable);
 }
 
+void MmappedBuffer::prefetch(const int bufferOffset, const int size) const {
+    if (mLoadingPolicy.getPrefetchedPrefixSize() <= 0 || size <= 0
+            || bufferOffset < 0 || bufferOffset >= static_cast<int>(mByteArrayView.size())) {
+        return;
+    }
+    const int pagesize = sysconf(_SC_PAGESIZE);
+    // Offset of the buffer in the mapping.
+    const int offset = static_cast<int>(mByteArrayView.data()
+            - static_cast<const uint8_t *>(mMmappedBuffer));
+    const int startInMapping = offset + bufferOffset;
+    const int alignedStart = startInMapping - startInMapping % pagesize;
+    const int end = std::min(startInMapping + size, mAlignedSize);
+    if (madvise(static_cast<uint8_t *>(mMmappedBuffer) + alignedStart, end - alignedStart,
+            MADV_WILLNEED) != 0) {
+        AKLOGE("DICT: Failure in madvise(MADV_WILLNEED). errno=%d", errno);
+    }
+}
+
+int MmappedBuffer::getResidentSize() const {
+    if (mAlignedSize == 0) {
+        return 0;
+    }
+    const int pagesize = sysconf(_SC_PAGESIZE);
+    const int pageCount = (mAlignedSize + pagesize - 1) / pagesize;
+    std::vector<unsigned char> residencyVector(pageCount);
+    if (mincore(mMmappedBuffer, mAlignedSize, residencyVector.data()) != 0) {
+        AKLOGE("DICT: Failure in mincore. errno=%d", errno);
+        return 0;
+    }
+    int residentPageCount = 0;
+    for (const unsigned char residency : residencyVector) {
+        if (residency & 1) {
+            residentPageCount++;
+        }
+    }
+    return residentPageCount * pagesize;
+}
+
+/* static */ void *MmappedBuffer::mapFile(const int mmapFd, const int alignedOffset,
+        const int alignedSize, const int protMode, const int mapFlags,
+        const bool useHugePageAlignment) {
+    if (!useHugePageAlignment || alignedSize < HUGE_PAGE_SIZE) {
+        return mmap(0, alignedSize, protMode, mapFlags, mmapFd, alignedOffset);
+    }
+    // Huge pages can only back a file mapping whose address is congruent to its file offset
+    // modulo the huge page size. Reserve an address range that is large enough to contain such
+    // a mapping, map the file over the right part of it and give back the rest.
+    const int reservedSize = alignedSize + 2 * HUGE_PAGE_SIZE;
+    void *const reservedRange = mmap(0, reservedSize, PROT_NONE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1 /* fd */, 0 /* offset */);
+    if (reservedRange == MAP_FAILED) {
+        return mmap(0, alignedSize, protMode, mapFlags, mmapFd, alignedOffset);
+    }
+    const uintptr_t reservedStart = reinterpret_cast<uintptr_t>(reservedRange);
+    const uintptr_t reservedEnd = reservedStart + reservedSize;
+    const uintptr_t mappingStart = ((reservedStart + HUGE_PAGE_SIZE - 1) & ~static_cast<uintptr_t>(
+            HUGE_PAGE_SIZE - 1)) + (alignedOffset % HUGE_PAGE_SIZE);
+    const uintptr_t mappingEnd = mappingStart + alignedSize;
+    void *const mmappedBuffer = mmap(reinterpret_cast<void *>(mappingStart), alignedSize,
+            protMode, mapFlags | MAP_FIXED, mmapFd, alignedOffset);
+    if (mmappedBuffer == MAP_FAILED) {
+        munmap(reservedRange, reservedSize);
+        return mmap(0, alignedSize, protMode, mapFlags, mmapFd, alignedOffset);
+    }
+    if (mappingStart > reservedStart) {
+        munmap(reservedRange, mappingStart - reservedStart);
+    }
+    const int pagesize = sysconf(_SC_PAGESIZE);
+    const uintptr_t tailStart = (mappingEnd + pagesize - 1) & ~static_cast<uintptr_t>(pagesize - 1);
+    if (reservedEnd > tailStart) {
+        munmap(reinterpret_cast<void *>(tailStart), reservedEnd - tailStart);
+    }
+#ifdef MADV_HUGEPAGE
+    if (madvise(mmappedBuffer, alignedSize, MADV_HUGEPAGE) != 0) {
+        AKLOGI("DICT: MADV_HUGEPAGE is not available. errno=%d", errno);
+    }
+#endif // MADV_HUGEPAGE
+    return mmappedBuffer;
+}
+
+void MmappedBuffer::prepareForWriting() {
+    if (!USES_SHADOW_FILE_FOR_UPDATABLE_BUFFERS || !mIsUpdatable || mAlignedSize == 0
+            || mIsMappedFromShadowFile) {
+        return;
+    }
+    // Copying from the mapping rather than from the file keeps pages that have already been
+    // written privately, e.g. when an earlier attempt failed.
+    const int shadowFd = createShadowFile(mPath.c_str(),
+            static_cast<const uint8_t *>(mMmappedBuffer), mAlignedSize);
+    if (shadowFd < 0) {
+        // Keep writing to the private mapping.
+        return;
+    }
+    // The shadow file has the same contents, so replacing the mapping in place is invisible to
+    // readers of the buffer.
+    if (mmap(mMmappedBuffer, mAlignedSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED,
+            shadowFd, 0 /* offset */) == MAP_FAILED) {
+        AKLOGE("DICT: Can't mmap the shadow file. path=%s errno=%d", mPath.c_str(), errno);
+        close(shadowFd);
+        return;
+    }
+    if (mLoadingPolicy.adviseRandomAccess()
+            && madvise(mMmappedBuffer, mAlignedSize, MADV_RANDOM) != 0) {
+        AKLOGE("DICT: Failure in madvise(MADV_RANDOM). errno=%d", errno);
+    }
+    close(mMmapFd);
+    mMmapFd = shadowFd;
+    mIsMappedFromShadowFile = true;
+}
+
+// Creates an unlinked file next to the given path that contains a copy of the source. Returns the
+// file descriptor of the copy or -1 on failure.
+/* static */ int MmappedBuffer::createShadowFile(const char *const path,
+        const uint8_t *const source, const int size) {
+    const int dirPathBufSize = strlen(path) + 1 /* terminator */;
+    char dirPath[dirPathBufSize];
+    FileUtils::getDirPath(path, dirPathBufSize, dirPath);
+    int shadowFd = -1;
+#ifdef O_TMPFILE
+    shadowFd = open(dirPath, O_TMPFILE | O_RDWR, S_IRUSR | S_IWUSR);
+#endif // O_TMPFILE
+    if (shadowFd < 0) {
+        const int shadowFilePathBufSize =
+                FileUtils::getFilePathWithSuffixBufSize(path, SHADOW_FILE_NAME_SUFFIX);
+        char shadowFilePath[shadowFilePathBufSize];
+        FileUtils::getFilePathWithSuffix(path, SHADOW_FILE_NAME_SUFFIX, shadowFilePathBufSize,
+                shadowFilePath);
+        shadowFd = mkstemp(shadowFilePath);
+        if (shadowFd < 0) {
+            AKLOGE("DICT: Can't create the shadow file. path=%s errno=%d", path, errno);
+            return -1;
+        }
+        unlink(shadowFilePath);
+    }
+    int writtenSize = 0;
+    while (writtenSize < size) {
+        const ssize_t chunkSize = write(shadowFd, source + writtenSize, size - writtenSize);
+        if (chunkSize <= 0) {
+            AKLOGE("DICT: Can't fill the shadow file. path=%s errno=%d", path, errno);
+            close(shadowFd);
+            return -1;
+        }
+        writtenSize += chunkSize;
+    }
+    return shadowFd;
+}
+
+/* static */ void MmappedBuffer::applyLoadingPolicy(uint8_t *const mmappedBuffer,
+        const int alignedSize, const int offset, const LoadingPolicy &loadingPolicy) {
+    if (loadingPolicy.adviseRandomAccess()
+            && madvise(mmappedBuffer, alignedSize, MADV_RANDOM) != 0) {
+        AKLOGE("DICT: Failure in madvise(MADV_RANDOM). errno=%d", errno);
+    }
+    const int prefetchedSize =
+            std::min(offset + loadingPolicy.getPrefetchedPrefixSize(), alignedSize);
+    if (loadingPolicy.getPrefetchedPrefixSize() > 0
+            && madvise(mmappedBuffer, prefetchedSize, MADV_WILLNEED) != 0) {
+        AKLOGE("DICT: Failure in madvise(MADV_WILLNEED). errno=%d", errno);
+    }
+    // The locked region is released by munmap() in the destructor.
+    const int lockedSize = std::min(offset + loadingPolicy.getLockedPrefixSize(), alignedSize);
+    if (loadingPolicy.getLockedPrefixSize() > 0 && mlock(mmappedBuffer, lockedSize) != 0) {
+        // This fails when RLIMIT_MEMLOCK is too small. The buffer is still usable.
+        AKLOGI("DICT: The hot prefix of the buffer cannot be locked. errno=%d", errno);
+    }
+}
+
+int MmappedBuffer::getAnonymousSize() const {
+    if (mAlignedSize == 0) {
+        return 0;
+    }
+    FILE *const file = fopen("/proc/self/smaps", "r");
+    if (!file) {
+        AKLOGE("DICT: Can't open smaps. errno=%d", errno);
+        return 0;
+    }
+    // The mapping can be split into several areas, e.g. by madvise() or mlock(). Areas end at
+    // page boundaries.
+    const int pagesize = sysconf(_SC_PAGESIZE);
+    const unsigned long mappingStart = reinterpret_cast<uintptr_t>(mMmappedBuffer);
+    const unsigned long mappingEnd =
+            mappingStart + (mAlignedSize + pagesize - 1) / pagesize * pagesize;
+    bool isInMapping = false;
+    int anonymousSizeInKb = 0;
+    char line[256];
+    while (fgets(line, NELEMS(line), file)) {
+        unsigned long areaStart = 0;
+        unsigned long areaEnd = 0;
+        int sizeInKb = 0;
+        if (sscanf(line, "%lx-%lx ", &areaStart, &areaEnd) == 2) {
+            isInMapping = areaStart >= mappingStart && areaEnd <= mappingEnd;
+        } else if (isInMapping && sscanf(line, "Anonymous: %d kB", &sizeInKb) == 1) {
+            anonymousSizeInKb += sizeInKb;
+        }
+    }
+    fclose(file);
+    return anonymousSizeInKb * 1024;
+}
+
 MmappedBuffer::~MmappedBuffer() {
     if (mAlignedSize == 0) {
         return;
@@ -19,6 +19,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
 
 #include "defines.h"
 #include "utils/byte_array_view.h"
@@ -27,10 +28,61 @@ namespace latinime {
 
 class MmappedBuffer {
  public:
-    typedef std::unique_ptr<const MmappedBuffer> MmappedBufferPtr;
+    typedef std::unique_ptr<MmappedBuffer> MmappedBufferPtr;
+
+    // Paging hints applied to a buffer right after it has been mapped. Read-only dictionaries are
+    // read randomly, so read-ahead can be disabled for the whole mapping and only the prefix
+    // holding the header and the top levels of the trie be faulted in up front.
+    class LoadingPolicy {
+     public:
+        // Applies no hint at all and keeps the kernel's read-ahead. Buffers that are read front
+        // to back, e.g. by GC and flush, benefit from it.
+        static const LoadingPolicy NO_HINTS;
+
+        LoadingPolicy(const bool adviseRandomAccess, const int prefetchedPrefixSize,
+                const int lockedPrefixSize, const bool useHugePageAlignment)
+                : mAdviseRandomAccess(adviseRandomAccess),
+                  mPrefetchedPrefixSize(prefetchedPrefixSize),
+                  mLockedPrefixSize(lockedPrefixSize),
+                  mUseHugePageAlignment(useHugePageAlignment) {}
+
+        bool adviseRandomAccess() const {
+            return mAdviseRandomAccess;
+        }
+
+        // Size of the prefix that is requested with MADV_WILLNEED.
+        int getPrefetchedPrefixSize() const {
+            return mPrefetchedPrefixSize;
+        }
+
+        // Size of the prefix that is pinned in memory with mlock(). 0 disables locking.
+        int getLockedPrefixSize() const {
+            return mLockedPrefixSize;
+        }
+
+        // Whether the mapping is aligned so that transparent huge pages can back it. This is
+        // only applied to read-only buffers.
+        bool useHugePageAlignment() const {
+            return mUseHugePageAlignment;
+        }
+
+     private:
+        DISALLOW_DEFAULT_CONSTRUCTOR(LoadingPolicy);
+
+        const bool mAdviseRandomAccess;
+        const int mPrefetchedPrefixSize;
+        const int mLockedPrefixSize;
+        const bool mUseHugePageAlignment;
+    };
 
     static MmappedBufferPtr openBuffer(const char *const path,
-            const int bufferOffset, const int bufferSize, const bool isUpdatable);
+            const int bufferOffset, const int bufferSize, const bool isUpdatable,
+            const LoadingPolicy &loadingPolicy);
+
+    static MmappedBufferPtr openBuffer(const char *const path,
+            const int bufferOffset, const int bufferSize, const bool isUpdatable) {
+        return openBuffer(path, bufferOffset, bufferSize, isUpdatable, LoadingPolicy::NO_HINTS);
+    }
 
     // Mmap entire file.
     static MmappedBufferPtr openBuffer(const char *const path, const bool isUpdatable);
@@ -52,25 +104,68 @@ class MmappedBuffer {
         return mIsUpdatable;
     }
 
+    AK_FORCE_INLINE const LoadingPolicy *getLoadingPolicy() const {
+        return &mLoadingPolicy;
+    }
+
+    // Asks the kernel to start reading the given range in. This is a no-op unless the loading
+    // policy of this buffer enables prefetching.
+    void prefetch(const int bufferOffset, const int size) const;
+
+    // Must be called before the first in-place write to an updatable buffer. See
+    // USES_SHADOW_FILE_FOR_UPDATABLE_BUFFERS. Buffers that are never written are not copied.
+    void prepareForWriting();
+
+    // Returns the number of bytes of the mapping that are currently resident in memory.
+    int getResidentSize() const;
+
+    // Returns the number of bytes of the mapping that are backed by anonymous memory, i.e. pages
+    // of a private mapping that have been copied on write.
+    int getAnonymousSize() const;
+
  private:
+    static const int HUGE_PAGE_SIZE;
+    // Updatable buffers are written in place. With a private file mapping, every written page is
+    // copied into anonymous memory that cannot be reclaimed. When this is true, the mapping is
+    // moved onto an unlinked copy of the file mapped shared right before the first write, so that
+    // written pages stay file-backed.
+    static const bool USES_SHADOW_FILE_FOR_UPDATABLE_BUFFERS;
+    static const char *const SHADOW_FILE_NAME_SUFFIX;
+
+    static void *mapFile(const int mmapFd, const int alignedOffset, const int alignedSize,
+            const int protMode, const int mapFlags, const bool useHugePageAlignment);
+    static int createShadowFile(const char *const path, const uint8_t *const source,
+            const int size);
+    static void applyLoadingPolicy(uint8_t *const mmappedBuffer, const int alignedSize,
+            const int offset, const LoadingPolicy &loadingPolicy);
+
     AK_FORCE_INLINE MmappedBuffer(uint8_t *const buffer, const int bufferSize,
             void *const mmappedBuffer, const int alignedSize, const int mmapFd,
-            const bool isUpdatable)
+            const bool isUpdatable, const LoadingPolicy &loadingPolicy, const char *const path)
             : mByteArrayView(buffer, bufferSize), mMmappedBuffer(mmappedBuffer),
-              mAlignedSize(alignedSize), mMmapFd(mmapFd), mIsUpdatable(isUpdatable) {}
+              mAlignedSize(alignedSize), mMmapFd(mmapFd), mIsUpdatable(isUpdatable),
+              mLoadingPolicy(loadingPolicy), mPath(isUpdatable ? path : ""),
+              mIsMappedFromShadowFile(false) {}
 
     // Empty file. We have to handle an empty file as a valid part of a dictionary.
     AK_FORCE_INLINE MmappedBuffer(const bool isUpdatable)
             : mByteArrayView(), mMmappedBuffer(nullptr), mAlignedSize(0),
-              mMmapFd(0), mIsUpdatable(isUpdatable) {}
+              mMmapFd(0), mIsUpdatable(isUpdatable), mLoadingPolicy(LoadingPolicy::NO_HINTS),
+              mPath(), mIsMappedFromShadowFile(false) {}
 
     DISALLOW_IMPLICIT_CONSTRUCTORS(MmappedBuffer);
 
     const ReadWriteByteArrayView mByteArrayView;
     void *const mMmappedBuffer;
     const int mAlignedSize;
-    const int mMmapFd;
+    // The fd and the backing of the mapping change in prepareForWriting(). The mapped address
+    // and contents do not, so views of the buffer stay valid.
+    int mMmapFd;
     const bool mIsUpdatable;
+    const LoadingPolicy mLoadingPolicy;
+    // Path of the mapped file. Only kept for updatable buffers, to place the shadow file.
+    const std::string mPath;
+    bool mIsMappedFromShadowFile;
 };
 }
 #endif /* LATINIME_MMAPPED_BUFFER_H */
@@ -85,6 +85,33 @@ bool SparseTable::set(const int id, const uint32_t value) {
     return mContentTableBuffer->writeUint(value, mDataSize, getPosInContentTable(id, index));
 }
 
+bool SparseTable::verifyStructure(const int valueLimit) const {
+    const int indexTableSize = mIndexTableBuffer->getTailPosition();
+    const int contentTableSize = mContentTableBuffer->getTailPosition();
+    const int blockByteSize = mBlockSize * mDataSize;
+    if (indexTableSize % INDEX_SIZE != 0 || contentTableSize % blockByteSize != 0) {
+        AKLOGE("Invalid sparse table sizes. index table: %d, content table: %d",
+                indexTableSize, contentTableSize);
+        return false;
+    }
+    const int blockCount = contentTableSize / blockByteSize;
+    for (int pos = 0; pos < indexTableSize; pos += INDEX_SIZE) {
+        const int index = mIndexTableBuffer->readUint(INDEX_SIZE, pos);
+        if (index != NOT_EXIST && (index < 0 || index >= blockCount)) {
+            AKLOGE("Invalid index %d at %d. block count: %d", index, pos, blockCount);
+            return false;
+        }
+    }
+    for (int pos = 0; pos < contentTableSize; pos += mDataSize) {
+        const int value = mContentTableBuffer->readUint(mDataSize, pos);
+        if (value != NOT_EXIST && (value < 0 || value >= valueLimit)) {
+            AKLOGE("Invalid value %d at %d. limit: %d", value, pos, valueLimit);
+            return false;
+        }
+    }
+    return true;
+}
+
 int SparseTable::getIndexFromContentTablePos(const int contentTablePos) const {
     return contentTablePos / mDataSize / mBlockSize;
 }
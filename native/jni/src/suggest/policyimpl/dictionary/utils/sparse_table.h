@@ -40,6 +40,10 @@ class SparseTable {
 
     bool set(const int id, const uint32_t value);
 
+    // Checks that the index table only refers to blocks in the content table and that every
+    // existing value is smaller than valueLimit.
+    bool verifyStructure(const int valueLimit) const;
+
  private:
     DISALLOW_IMPLICIT_CONSTRUCTORS(SparseTable);
 
@@ -0,0 +1,253 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/policyimpl/dictionary/utils/succinct_bit_vector.h"
+
+#include <algorithm>
+
+namespace latinime {
+
+const int SuccinctBitVector::BIT_COUNT_FIELD_SIZE = 4;
+const int SuccinctBitVector::WORD_SIZE = 8;
+const int SuccinctBitVector::RANK_FIELD_SIZE = 4;
+const int SuccinctBitVector::BITS_PER_WORD = 64;
+const int SuccinctBitVector::WORDS_PER_BLOCK = 8;
+const int SuccinctBitVector::BITS_PER_BLOCK = BITS_PER_WORD * WORDS_PER_BLOCK;
+const int SuccinctBitVector::HINT_FIELD_SIZE = 4;
+const int SuccinctBitVector::BITS_PER_HINT = 128;
+
+SuccinctBitVector::SuccinctBitVector(const uint8_t *const buffer, const int bufferSize,
+        const int pos)
+        : mWords(nullptr), mRanks(nullptr), mOneHints(nullptr), mZeroHints(nullptr),
+          mBitCount(0), mWordCount(0), mBlockCount(0), mOneCount(0), mEndPos(bufferSize),
+          mIsValid(false) {
+    if (pos < 0 || pos > bufferSize - BIT_COUNT_FIELD_SIZE) {
+        return;
+    }
+    const uint32_t bitCount = ByteArrayUtils::readUint32(buffer, pos);
+    const int64_t wordCount = (static_cast<int64_t>(bitCount) + BITS_PER_WORD - 1)
+            / BITS_PER_WORD;
+    const int64_t blockCount = (wordCount + WORDS_PER_BLOCK - 1) / WORDS_PER_BLOCK;
+    const int64_t hintsPos = pos + BIT_COUNT_FIELD_SIZE + wordCount * WORD_SIZE
+            + (blockCount + 1) * RANK_FIELD_SIZE;
+    if (hintsPos > bufferSize) {
+        AKLOGE("Bit vector doesn't fit in the buffer. bit count: %u, pos: %d, buffer size: %d",
+                bitCount, pos, bufferSize);
+        return;
+    }
+    mWords = buffer + pos + BIT_COUNT_FIELD_SIZE;
+    mRanks = mWords + wordCount * WORD_SIZE;
+    mBitCount = bitCount;
+    mWordCount = wordCount;
+    mBlockCount = blockCount;
+    mOneCount = getRank(mBlockCount);
+    if (mOneCount < 0 || mOneCount > mBitCount) {
+        AKLOGE("Bit vector has an invalid one count. bit count: %d, one count: %d", mBitCount,
+                mOneCount);
+        mOneCount = 0;
+        return;
+    }
+    const int64_t endPos = hintsPos + (getHintCount(mOneCount)
+            + getHintCount(mBitCount - mOneCount)) * HINT_FIELD_SIZE;
+    if (endPos > bufferSize) {
+        AKLOGE("Select hints don't fit in the buffer. bit count: %d, pos: %d, buffer size: %d",
+                mBitCount, pos, bufferSize);
+        mOneCount = 0;
+        return;
+    }
+    mOneHints = buffer + hintsPos;
+    mZeroHints = mOneHints + getHintCount(mOneCount) * HINT_FIELD_SIZE;
+    mEndPos = endPos;
+    mIsValid = true;
+}
+
+int SuccinctBitVector::rank1(const int pos) const {
+    const int blockIndex = pos / BITS_PER_BLOCK;
+    int rank = getRank(blockIndex);
+    const int wordIndex = pos / BITS_PER_WORD;
+    for (int i = blockIndex * WORDS_PER_BLOCK; i < wordIndex; ++i) {
+        rank += __builtin_popcountll(readWord(i));
+    }
+    const int bitIndex = pos % BITS_PER_WORD;
+    if (bitIndex > 0) {
+        rank += __builtin_popcountll(readWord(wordIndex) & ((1ULL << bitIndex) - 1));
+    }
+    return rank;
+}
+
+int SuccinctBitVector::select1(const int index) const {
+    if (index < 0 || index >= mOneCount) {
+        return mBitCount;
+    }
+    return select(mOneHints, getHintCount(mOneCount), index, false /* selectsZero */);
+}
+
+int SuccinctBitVector::select0(const int index) const {
+    const int zeroCount = mBitCount - mOneCount;
+    if (index < 0 || index >= zeroCount) {
+        return mBitCount;
+    }
+    return select(mZeroHints, getHintCount(zeroCount), index, true /* selectsZero */);
+}
+
+// The words from the hint are counted when the next hint is close. Otherwise, the block is found
+// by a binary search over the ranks between the hints, and the words of the block are counted.
+int SuccinctBitVector::select(const uint8_t *const hints, const int hintCount, const int index,
+        const bool selectsZero) const {
+    const uint64_t flipMask = selectsZero ? ~0ULL : 0;
+    const int hintIndex = index / BITS_PER_HINT;
+    // Broken hints are clamped so that they don't make reads out of the vector.
+    const int hintPos = std::min<uint32_t>(
+            ByteArrayUtils::readUint32(hints, hintIndex * HINT_FIELD_SIZE), mBitCount - 1);
+    const int nextHintPos = (hintIndex + 1 < hintCount) ? std::min<uint32_t>(
+            ByteArrayUtils::readUint32(hints, (hintIndex + 1) * HINT_FIELD_SIZE), mBitCount - 1)
+            : mBitCount - 1;
+    int wordIndex = hintPos / BITS_PER_WORD;
+    uint64_t word = 0;
+    int remainingIndex = 0;
+    if (nextHintPos / BITS_PER_WORD - wordIndex <= WORDS_PER_BLOCK) {
+        word = (readWord(wordIndex) ^ flipMask) & (~0ULL << (hintPos % BITS_PER_WORD));
+        remainingIndex = index % BITS_PER_HINT;
+    } else {
+        int low = hintPos / BITS_PER_BLOCK;
+        int high = nextHintPos / BITS_PER_BLOCK + 1;
+        while (high - low > 1) {
+            const int middle = low + (high - low) / 2;
+            if ((selectsZero ? getZeroRank(middle) : getRank(middle)) <= index) {
+                low = middle;
+            } else {
+                high = middle;
+            }
+        }
+        wordIndex = low * WORDS_PER_BLOCK;
+        word = readWord(wordIndex) ^ flipMask;
+        remainingIndex = index - (selectsZero ? getZeroRank(low) : getRank(low));
+    }
+    while (true) {
+        const int count = __builtin_popcountll(word);
+        if (remainingIndex < count) {
+            return wordIndex * BITS_PER_WORD + selectInWord(word, remainingIndex);
+        }
+        remainingIndex -= count;
+        if (++wordIndex >= mWordCount) {
+            return mBitCount;
+        }
+        word = readWord(wordIndex) ^ flipMask;
+    }
+}
+
+int SuccinctBitVector::getNextSetBitPos(const int pos) const {
+    if (pos < 0 || pos >= mBitCount) {
+        return mBitCount;
+    }
+    int wordIndex = pos / BITS_PER_WORD;
+    uint64_t word = readWord(wordIndex) & (~0ULL << (pos % BITS_PER_WORD));
+    while (word == 0) {
+        if (++wordIndex >= mWordCount) {
+            return mBitCount;
+        }
+        word = readWord(wordIndex);
+    }
+    return wordIndex * BITS_PER_WORD + __builtin_ctzll(word);
+}
+
+int SuccinctBitVector::getNextClearBitPos(const int pos) const {
+    if (pos < 0 || pos >= mBitCount) {
+        return mBitCount;
+    }
+    int wordIndex = pos / BITS_PER_WORD;
+    uint64_t word = ~readWord(wordIndex) & (~0ULL << (pos % BITS_PER_WORD));
+    while (word == 0) {
+        if (++wordIndex >= mWordCount) {
+            return mBitCount;
+        }
+        word = ~readWord(wordIndex);
+    }
+    // The bits after the bit count are 0, so they can be found here.
+    const int clearBitPos = wordIndex * BITS_PER_WORD + __builtin_ctzll(word);
+    return clearBitPos < mBitCount ? clearBitPos : mBitCount;
+}
+
+/* static */ void SuccinctBitVector::appendToBuffer(const std::vector<bool> &bits,
+        std::vector<uint8_t> *const buffer) {
+    const int bitCount = bits.size();
+    const int wordCount = (bitCount + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    const int blockCount = (wordCount + WORDS_PER_BLOCK - 1) / WORDS_PER_BLOCK;
+    const int oneCount = std::count(bits.begin(), bits.end(), true);
+    int pos = buffer->size();
+    buffer->resize(pos + BIT_COUNT_FIELD_SIZE + wordCount * WORD_SIZE
+            + (blockCount + 1) * RANK_FIELD_SIZE
+            + (getHintCount(oneCount) + getHintCount(bitCount - oneCount)) * HINT_FIELD_SIZE);
+    uint8_t *const data = buffer->data();
+    ByteArrayUtils::writeUintAndAdvancePosition(data, bitCount, BIT_COUNT_FIELD_SIZE, &pos);
+    std::vector<uint32_t> ranks;
+    std::vector<uint32_t> oneHints;
+    std::vector<uint32_t> zeroHints;
+    int rank = 0;
+    for (int i = 0; i < wordCount; ++i) {
+        if (i % WORDS_PER_BLOCK == 0) {
+            ranks.push_back(rank);
+        }
+        uint64_t word = 0;
+        for (int j = 0; j < BITS_PER_WORD && i * BITS_PER_WORD + j < bitCount; ++j) {
+            const int bitPos = i * BITS_PER_WORD + j;
+            const int zeroRank = bitPos - rank;
+            if (bits[bitPos]) {
+                if (rank % BITS_PER_HINT == 0) {
+                    oneHints.push_back(bitPos);
+                }
+                word |= 1ULL << j;
+                ++rank;
+            } else if (zeroRank % BITS_PER_HINT == 0) {
+                zeroHints.push_back(bitPos);
+            }
+        }
+        // Big-endian
+        ByteArrayUtils::writeUintAndAdvancePosition(data, word >> 32, 4 /* size */, &pos);
+        ByteArrayUtils::writeUintAndAdvancePosition(data, word & 0xFFFFFFFF, 4 /* size */, &pos);
+    }
+    ranks.push_back(rank);
+    for (const uint32_t blockRank : ranks) {
+        ByteArrayUtils::writeUintAndAdvancePosition(data, blockRank, RANK_FIELD_SIZE, &pos);
+    }
+    for (const uint32_t hint : oneHints) {
+        ByteArrayUtils::writeUintAndAdvancePosition(data, hint, HINT_FIELD_SIZE, &pos);
+    }
+    for (const uint32_t hint : zeroHints) {
+        ByteArrayUtils::writeUintAndAdvancePosition(data, hint, HINT_FIELD_SIZE, &pos);
+    }
+}
+
+/* static */ int SuccinctBitVector::selectInWord(const uint64_t word, const int index) {
+    int remainingIndex = index;
+    int shift = 0;
+    // Skips bytes first.
+    while (true) {
+        const int oneCount = __builtin_popcount((word >> shift) & 0xFF);
+        if (remainingIndex < oneCount) {
+            break;
+        }
+        remainingIndex -= oneCount;
+        shift += 8;
+    }
+    uint64_t remainingWord = word >> shift;
+    for (int i = 0; i < remainingIndex; ++i) {
+        remainingWord &= remainingWord - 1;
+    }
+    return shift + __builtin_ctzll(remainingWord);
+}
+
+} // namespace latinime
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_SUCCINCT_BIT_VECTOR_H
+#define LATINIME_SUCCINCT_BIT_VECTOR_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "defines.h"
+#include "suggest/policyimpl/dictionary/utils/byte_array_utils.h"
+
+namespace latinime {
+
+/*
+ * Read-only view of a bit vector in a buffer with a rank directory, which supports rank and
+ * select without building anything on the heap. The layout is:
+ *   bit count (4 bytes), words[(bit count + 63) / 64] (8 bytes each),
+ *   ranks[(word count + 7) / 8 + 1] (4 bytes each),
+ *   one hints[(one count + 127) / 128] (4 bytes each),
+ *   zero hints[(zero count + 127) / 128] (4 bytes each)
+ * Bit i is the (i % 64)-th lowest bit of the i / 64-th word. The bits after the bit count in the
+ * last word are 0. Ranks[b] is the number of ones before the b-th block of 8 words, so the last
+ * one is the number of ones in the vector. One hints[j] is the position of the (j * 128)-th one,
+ * and zero hints are the same for zeros, so select usually reads a hint and a few words after
+ * it. Integers are big-endian as in the rest of the dictionary.
+ */
+class SuccinctBitVector {
+ public:
+    // The view is invalid when the bit vector doesn't fit in the buffer.
+    SuccinctBitVector(const uint8_t *const buffer, const int bufferSize, const int pos);
+
+    AK_FORCE_INLINE bool isValid() const {
+        return mIsValid;
+    }
+
+    AK_FORCE_INLINE int getBitCount() const {
+        return mBitCount;
+    }
+
+    AK_FORCE_INLINE int getOneCount() const {
+        return mOneCount;
+    }
+
+    // The position after the bit vector in the buffer. It's the buffer size for an invalid view.
+    AK_FORCE_INLINE int getEndPos() const {
+        return mEndPos;
+    }
+
+    AK_FORCE_INLINE bool get(const int pos) const {
+        return ((readWord(pos / BITS_PER_WORD) >> (pos % BITS_PER_WORD)) & 1) != 0;
+    }
+
+    // Returns the number of ones before pos, which is in [0, bit count].
+    int rank1(const int pos) const;
+
+    // Returns the position of the index-th one (0-based), or the bit count when there are not
+    // that many ones.
+    int select1(const int index) const;
+
+    // Returns the position of the index-th zero (0-based), or the bit count when there are not
+    // that many zeros.
+    int select0(const int index) const;
+
+    // Returns the first position from pos that has one, or the bit count if there is none.
+    int getNextSetBitPos(const int pos) const;
+
+    // Returns the first position from pos that has zero, or the bit count if there is none.
+    int getNextClearBitPos(const int pos) const;
+
+    static void appendToBuffer(const std::vector<bool> &bits, std::vector<uint8_t> *const buffer);
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(SuccinctBitVector);
+
+    static const int BIT_COUNT_FIELD_SIZE;
+    static const int WORD_SIZE;
+    static const int RANK_FIELD_SIZE;
+    static const int BITS_PER_WORD;
+    static const int WORDS_PER_BLOCK;
+    static const int BITS_PER_BLOCK;
+    static const int HINT_FIELD_SIZE;
+    static const int BITS_PER_HINT;
+
+    const uint8_t *mWords;
+    const uint8_t *mRanks;
+    const uint8_t *mOneHints;
+    const uint8_t *mZeroHints;
+    int mBitCount;
+    int mWordCount;
+    int mBlockCount;
+    int mOneCount;
+    int mEndPos;
+    bool mIsValid;
+
+    AK_FORCE_INLINE uint64_t readWord(const int wordIndex) const {
+        uint64_t word;
+        memcpy(&word, mWords + wordIndex * WORD_SIZE, sizeof(word));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        word = __builtin_bswap64(word);
+#endif
+        return word;
+    }
+
+    AK_FORCE_INLINE int getRank(const int blockIndex) const {
+        return ByteArrayUtils::readUint32(mRanks, blockIndex * RANK_FIELD_SIZE);
+    }
+
+    // Zeros after the bit count are counted, but they are after all the others.
+    AK_FORCE_INLINE int getZeroRank(const int blockIndex) const {
+        return blockIndex * BITS_PER_BLOCK - getRank(blockIndex);
+    }
+
+    static int getHintCount(const int count) {
+        return (count + BITS_PER_HINT - 1) / BITS_PER_HINT;
+    }
+
+    int select(const uint8_t *const hints, const int hintCount, const int index,
+            const bool selectsZero) const;
+    static int selectInWord(const uint64_t word, const int index);
+};
+} // namespace latinime
+#endif // LATINIME_SUCCINCT_BIT_VECTOR_H
@@ -108,6 +108,54 @@ bool TrieMap::save(FILE *const file) const {
     return DictFileWritingUtils::writeBufferToFileTail(file, &mBuffer);
 }
 
+bool TrieMap::verifyStructure() const {
+    if (mBuffer.getTailPosition() < ROOT_BITMAP_ENTRY_POS + ENTRY_SIZE
+            || (mBuffer.getTailPosition() - ROOT_BITMAP_ENTRY_POS) % ENTRY_SIZE != 0) {
+        AKLOGE("Invalid trie map size: %d", mBuffer.getTailPosition());
+        return false;
+    }
+    const int tailEntryIndex = getTailEntryIndex();
+    // Each reachable entry is visited once unless the tables overlap, so visiting more entries
+    // than the buffer has means the links are broken.
+    int remainingEntryCount = tailEntryIndex;
+    std::vector<TableIterationState> tablesToVisit;
+    tablesToVisit.emplace_back(1 /* tableSize */, ROOT_BITMAP_ENTRY_INDEX);
+    while (!tablesToVisit.empty()) {
+        const TableIterationState table = tablesToVisit.back();
+        tablesToVisit.pop_back();
+        if (table.mTableIndex < 0 || table.mTableIndex + table.mTableSize > tailEntryIndex) {
+            AKLOGE("Invalid trie map table. index: %d, size: %d, entry count: %d",
+                    table.mTableIndex, table.mTableSize, tailEntryIndex);
+            return false;
+        }
+        remainingEntryCount -= table.mTableSize;
+        if (remainingEntryCount < 0) {
+            AKLOGE("Trie map tables overlap.");
+            return false;
+        }
+        for (int i = 0; i < table.mTableSize; ++i) {
+            const Entry entry = readEntry(table.mTableIndex + i);
+            if (entry.isBitmapEntry()) {
+                if (entry.getBitmap() != 0) {
+                    tablesToVisit.emplace_back(popCount(entry.getBitmap()),
+                            entry.getTableIndex());
+                }
+            } else if (entry.hasTerminalLink()) {
+                // The value entry is followed by the bitmap entry of the next level map. Only
+                // the bitmap entry is visited because the value entry has no links.
+                const int nextLevelBitmapEntryIndex = entry.getValueEntryIndex() + 1;
+                if (nextLevelBitmapEntryIndex >= tailEntryIndex) {
+                    AKLOGE("Invalid terminal link: %d", entry.getValueEntryIndex());
+                    return false;
+                }
+                remainingEntryCount -= 1;
+                tablesToVisit.emplace_back(1 /* tableSize */, nextLevelBitmapEntryIndex);
+            }
+        }
+    }
+    return true;
+}
+
 /**
  * Iterate next entry in a certain level.
  *
@@ -202,6 +202,10 @@ class TrieMap {
 
     bool save(FILE *const file) const;
 
+    // Checks that every table reachable from the root bitmap entry is inside the buffer. This
+    // visits each entry at most once.
+    bool verifyStructure() const;
+
  private:
     DISALLOW_COPY_AND_ASSIGN(TrieMap);
 
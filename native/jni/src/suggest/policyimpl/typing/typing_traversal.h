@@ -161,8 +161,10 @@ class TypingTraversal : public Traversal {
         return true;
     }
 
-    AK_FORCE_INLINE bool isGoodToTraverseNextWord(const DicNode *const dicNode) const {
-        const int probability = dicNode->getProbability();
+    AK_FORCE_INLINE bool isGoodToTraverseNextWord(const DicTraverseSession *const traverseSession,
+            const DicNode *const dicNode) const {
+        const int probability =
+                dicNode->getProbability(traverseSession->getDictionaryStructurePolicy());
         if (probability < ScoringParams::THRESHOLD_NEXT_WORD_PROBABILITY) {
             return false;
         }
@@ -66,6 +66,18 @@ class DamerauLevenshteinEditDistancePolicy : public EditDistancePolicy {
         return mString1Length;
     }
 
+    bool hasUnitCosts() const {
+        return true;
+    }
+
+    AK_FORCE_INLINE int getComparedCodePoint0(const int index0) const {
+        return CharUtils::toBaseLowerCase(mString0[index0]);
+    }
+
+    AK_FORCE_INLINE int getComparedCodePoint1(const int index1) const {
+        return CharUtils::toBaseLowerCase(mString1[index1]);
+    }
+
  private:
     DISALLOW_COPY_AND_ASSIGN (DamerauLevenshteinEditDistancePolicy);
 
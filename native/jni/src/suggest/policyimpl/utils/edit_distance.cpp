@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/policyimpl/utils/edit_distance.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace latinime {
+
+const int EditDistance::MAX_UNIT_COST_STRING0_LENGTH = 64;
+
+namespace {
+
+// Maps each compared code point of string 0 to the bit vector of its positions. The hash table
+// has twice as many slots as the distinct code points at most, so probing always ends.
+class PositionMaskTable {
+ public:
+    explicit PositionMaskTable(const EditDistancePolicy *const policy) : mCodePointCount(0) {
+        memset(mSlots, 0, sizeof(mSlots));
+        const int length = policy->getString0Length();
+        for (int i = 0; i < length; ++i) {
+            const int codePoint = policy->getComparedCodePoint0(i);
+            int slot = getFirstSlot(codePoint);
+            while (mSlots[slot] != 0 && mCodePoints[mSlots[slot] - 1] != codePoint) {
+                slot = (slot + 1) % SLOT_COUNT;
+            }
+            if (mSlots[slot] == 0) {
+                mCodePoints[mCodePointCount] = codePoint;
+                mMasks[mCodePointCount] = 0;
+                mCodePointCount++;
+                mSlots[slot] = static_cast<uint8_t>(mCodePointCount);
+            }
+            mMasks[mSlots[slot] - 1] |= static_cast<uint64_t>(1) << i;
+        }
+    }
+
+    AK_FORCE_INLINE uint64_t getMask(const int codePoint) const {
+        int slot = getFirstSlot(codePoint);
+        while (mSlots[slot] != 0) {
+            if (mCodePoints[mSlots[slot] - 1] == codePoint) {
+                return mMasks[mSlots[slot] - 1];
+            }
+            slot = (slot + 1) % SLOT_COUNT;
+        }
+        return 0;
+    }
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(PositionMaskTable);
+
+    static const int SLOT_COUNT = 128;
+    static const int MAX_CODE_POINT_COUNT = 64;
+
+    // 1 + the index in mCodePoints, or 0 for an empty slot.
+    uint8_t mSlots[SLOT_COUNT];
+    int mCodePoints[MAX_CODE_POINT_COUNT];
+    uint64_t mMasks[MAX_CODE_POINT_COUNT];
+    int mCodePointCount;
+
+    static AK_FORCE_INLINE int getFirstSlot(const int codePoint) {
+        // Fibonacci hashing; the top 7 bits select one of the 128 slots.
+        return static_cast<int>((static_cast<uint32_t>(codePoint) * 0x9E3779B1u) >> 25);
+    }
+};
+
+} // namespace
+
+// Bit i of a vertical delta vector is the difference between the cells at rows i + 1 and i in
+// the current column of the dynamic programming matrix, and bit i of a horizontal delta vector
+// is the difference between the cells at row i + 1 in the current and the previous column.
+// A column is computed from the previous one with a few word operations; see H. Hyyro, "A
+// bit-vector algorithm for computing Levenshtein and Damerau edit distances", 2003.
+/* static */ int EditDistance::getUnitCostEditDistance(const EditDistancePolicy *const policy,
+        const int maxDistance) {
+    const int length0 = policy->getString0Length();
+    const int length1 = policy->getString1Length();
+    // The distance is at least the difference of the lengths.
+    if (abs(length0 - length1) > maxDistance) {
+        return maxDistance + 1;
+    }
+    if (length0 == 0) {
+        return length1;
+    }
+    const PositionMaskTable positionMaskTable(policy);
+    const uint64_t lastRowBit = static_cast<uint64_t>(1) << (length0 - 1);
+    uint64_t verticalPositive = ~static_cast<uint64_t>(0);
+    uint64_t verticalNegative = 0;
+    uint64_t prevDiagonalZero = 0;
+    uint64_t prevMatch = 0;
+    int distance = length0;
+    for (int j = 0; j < length1; ++j) {
+        const uint64_t match = positionMaskTable.getMask(policy->getComparedCodePoint1(j));
+        const uint64_t transposition = (((~prevDiagonalZero) & match) << 1) & prevMatch;
+        const uint64_t diagonalZero = (((match & verticalPositive) + verticalPositive)
+                ^ verticalPositive) | match | verticalNegative | transposition;
+        const uint64_t horizontalPositive = verticalNegative
+                | ~(diagonalZero | verticalPositive);
+        const uint64_t horizontalNegative = verticalPositive & diagonalZero;
+        if (horizontalPositive & lastRowBit) {
+            ++distance;
+        } else if (horizontalNegative & lastRowBit) {
+            --distance;
+        }
+        // Each of the remaining columns can decrease the distance by at most 1.
+        if (distance - (length1 - j - 1) > maxDistance) {
+            return maxDistance + 1;
+        }
+        // The cell at row 0 increases by 1 in each column.
+        const uint64_t shiftedHorizontalPositive = (horizontalPositive << 1) | 1;
+        verticalNegative = shiftedHorizontalPositive & diagonalZero;
+        verticalPositive = (horizontalNegative << 1)
+                | ~(shiftedHorizontalPositive | diagonalZero);
+        prevDiagonalZero = diagonalZero;
+        prevMatch = match;
+    }
+    return distance;
+}
+
+} // namespace latinime
@@ -28,6 +28,63 @@ class EditDistance {
  public:
     // CAVEAT: There may be performance penalty if you need the edit distance as an integer value.
     AK_FORCE_INLINE static float getEditDistance(const EditDistancePolicy *const policy) {
+        if (canUseUnitCostEditDistance(policy)) {
+            return static_cast<float>(getUnitCostEditDistance(policy, S_INT_MAX));
+        }
+        return getEditDistanceWithPolicyCosts(policy);
+    }
+
+    // For callers that only need to know whether the edit distance is at most maxDistance.
+    // Returns the edit distance when it is at most maxDistance and a value larger than
+    // maxDistance otherwise. The computation stops as soon as the distance is known to exceed
+    // maxDistance when the policy has unit costs.
+    AK_FORCE_INLINE static float getEditDistanceWithinThreshold(
+            const EditDistancePolicy *const policy, const int maxDistance) {
+        if (canUseUnitCostEditDistance(policy)) {
+            return static_cast<float>(getUnitCostEditDistance(policy, maxDistance));
+        }
+        return getEditDistanceWithPolicyCosts(policy);
+    }
+
+    AK_FORCE_INLINE static void dumpEditDistance10ForDebug(const float *const editDistanceTable,
+            const int editDistanceTableWidth, const int outputLength) {
+        if (DEBUG_DICT) {
+            AKLOGI("EditDistanceTable");
+            for (int i = 0; i <= 10; ++i) {
+                float c[11];
+                for (int j = 0; j <= 10; ++j) {
+                    if (j < editDistanceTableWidth + 1 && i < outputLength + 1) {
+                        c[j] = (editDistanceTable + i * (editDistanceTableWidth + 1))[j];
+                    } else {
+                        c[j] = -1.0f;
+                    }
+                }
+                AKLOGI("[ %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f ]",
+                        c[0], c[1], c[2], c[3], c[4], c[5], c[6], c[7], c[8], c[9], c[10]);
+                (void)c; // To suppress compiler warning
+            }
+        }
+    }
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(EditDistance);
+
+    // The bit vectors have a bit for each character of string 0.
+    static const int MAX_UNIT_COST_STRING0_LENGTH;
+
+    AK_FORCE_INLINE static bool canUseUnitCostEditDistance(
+            const EditDistancePolicy *const policy) {
+        return policy->hasUnitCosts()
+                && policy->getString0Length() <= MAX_UNIT_COST_STRING0_LENGTH;
+    }
+
+    // Computes the optimal string alignment distance column by column with Hyyro's bit-parallel
+    // algorithm. Returns maxDistance + 1 as soon as the distance is known to exceed maxDistance.
+    static int getUnitCostEditDistance(const EditDistancePolicy *const policy,
+            const int maxDistance);
+
+    AK_FORCE_INLINE static float getEditDistanceWithPolicyCosts(
+            const EditDistancePolicy *const policy) {
         const int beforeLength = policy->getString0Length();
         const int afterLength = policy->getString1Length();
         float dp[(beforeLength + 1) * (afterLength + 1)];
@@ -63,29 +120,6 @@ class EditDistance {
         }
         return dp[(beforeLength + 1) * (afterLength + 1) - 1];
     }
-
-    AK_FORCE_INLINE static void dumpEditDistance10ForDebug(const float *const editDistanceTable,
-            const int editDistanceTableWidth, const int outputLength) {
-        if (DEBUG_DICT) {
-            AKLOGI("EditDistanceTable");
-            for (int i = 0; i <= 10; ++i) {
-                float c[11];
-                for (int j = 0; j <= 10; ++j) {
-                    if (j < editDistanceTableWidth + 1 && i < outputLength + 1) {
-                        c[j] = (editDistanceTable + i * (editDistanceTableWidth + 1))[j];
-                    } else {
-                        c[j] = -1.0f;
-                    }
-                }
-                AKLOGI("[ %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f ]",
-                        c[0], c[1], c[2], c[3], c[4], c[5], c[6], c[7], c[8], c[9], c[10]);
-                (void)c; // To suppress compiler warning
-            }
-        }
-    }
-
- private:
-    DISALLOW_IMPLICIT_CONSTRUCTORS(EditDistance);
 };
 } // namespace latinime
 
@@ -31,6 +31,23 @@ class EditDistancePolicy {
     virtual int getString0Length() const = 0;
     virtual int getString1Length() const = 0;
 
+    // A policy with unit costs lets EditDistance compute the distance with bit vectors without
+    // calling the cost methods above. Such a policy charges 1 for each insertion, deletion and
+    // transposition and for each substitution of characters whose compared code points differ,
+    // and allows a transposition exactly when the compared code points of two adjacent
+    // characters cross.
+    virtual bool hasUnitCosts() const {
+        return false;
+    }
+
+    virtual int getComparedCodePoint0(const int index0) const {
+        return NOT_A_CODE_POINT;
+    }
+
+    virtual int getComparedCodePoint1(const int index1) const {
+        return NOT_A_CODE_POINT;
+    }
+
  protected:
     EditDistancePolicy() {}
     virtual ~EditDistancePolicy() {}
@@ -72,7 +72,12 @@ const int AutocorrectionThresholdUtils::FULL_WORD_MULTIPLIER = 2;
     if (0 == beforeLength || 0 == afterLength) {
         return 0.0f;
     }
-    const int distance = editDistance(before, beforeLength, after, afterLength);
+    // The score is 0 when the edit distance is afterLength or larger, so the exact distance is
+    // needed only when it's smaller.
+    const DamerauLevenshteinEditDistancePolicy daemaruLevenshtein(
+            before, beforeLength, after, afterLength);
+    const int distance = static_cast<int>(EditDistance::getEditDistanceWithinThreshold(
+            &daemaruLevenshtein, afterLength - 1 /* maxDistance */));
     int spaceCount = 0;
     for (int i = 0; i < afterLength; ++i) {
         if (after[i] == KEYCODE_SPACE) {
@@ -17,6 +17,7 @@
 #include "utils/char_utils.h"
 
 #include <cstdlib>
+#include <cstring>
 
 #include "defines.h"
 
@@ -1278,5 +1279,75 @@ static int compare_pair_capital(const void *a, const void *b) {
     /* U+04F8 */ 0x042B, 0x044B, 0x04FA, 0x04FB, 0x04FC, 0x04FD, 0x04FE, 0x04FF,
 };
 
+/* static */ uint8_t CharUtils::sLowerCasePages[CharUtils::FOLDING_PAGE_COUNT];
+/* static */ uint8_t CharUtils::sBasePages[CharUtils::FOLDING_PAGE_COUNT];
+/* static */ uint8_t CharUtils::sBaseLowerCasePages[CharUtils::FOLDING_PAGE_COUNT];
+/* static */ uint16_t
+        CharUtils::sFoldingLeaves[CharUtils::MAX_FOLDING_LEAF_COUNT][CharUtils::FOLDING_PAGE_SIZE];
+/* static */ const bool CharUtils::sAreFoldingTablesInitialized =
+        CharUtils::initializeFoldingTables();
+
+static int toLowerCaseWithoutFoldingTables(const int c) {
+    if (CharUtils::isAsciiUpper(c)) {
+        return CharUtils::toAsciiLower(c);
+    }
+    if (CharUtils::isAscii(c)) {
+        return c;
+    }
+    return static_cast<int>(CharUtils::latin_tolower(static_cast<unsigned short>(c)));
+}
+
+/* static */ bool CharUtils::initializeFoldingTables() {
+    // Only the pages that have a code point mapped to another one need a leaf of their own.
+    bool hasMappedCodePoints[FOLDING_PAGE_COUNT];
+    for (int page = 0; page < FOLDING_PAGE_COUNT; ++page) {
+        hasMappedCodePoints[page] = page * FOLDING_PAGE_SIZE < BASE_CHARS_SIZE;
+    }
+    for (size_t i = 0; i < NELEMS(SORTED_CHAR_MAP); ++i) {
+        hasMappedCodePoints[SORTED_CHAR_MAP[i].capital / FOLDING_PAGE_SIZE] = true;
+    }
+    // Leaf 0 is all zero and maps every code point to itself.
+    int leafCount = 1;
+    uint16_t lowerCaseLeaf[FOLDING_PAGE_SIZE];
+    uint16_t baseLeaf[FOLDING_PAGE_SIZE];
+    uint16_t baseLowerCaseLeaf[FOLDING_PAGE_SIZE];
+    for (int page = 0; page < FOLDING_PAGE_COUNT; ++page) {
+        if (!hasMappedCodePoints[page]) {
+            sLowerCasePages[page] = 0;
+            sBasePages[page] = 0;
+            sBaseLowerCasePages[page] = 0;
+            continue;
+        }
+        for (int i = 0; i < FOLDING_PAGE_SIZE; ++i) {
+            const int c = page * FOLDING_PAGE_SIZE + i;
+            const int baseCodePoint = c < BASE_CHARS_SIZE ? static_cast<int>(BASE_CHARS[c]) : c;
+            lowerCaseLeaf[i] = static_cast<uint16_t>(toLowerCaseWithoutFoldingTables(c) - c);
+            baseLeaf[i] = static_cast<uint16_t>(baseCodePoint - c);
+            baseLowerCaseLeaf[i] =
+                    static_cast<uint16_t>(toLowerCaseWithoutFoldingTables(baseCodePoint) - c);
+        }
+        sLowerCasePages[page] = addFoldingLeaf(lowerCaseLeaf, &leafCount);
+        sBasePages[page] = addFoldingLeaf(baseLeaf, &leafCount);
+        sBaseLowerCasePages[page] = addFoldingLeaf(baseLowerCaseLeaf, &leafCount);
+    }
+    return true;
+}
+
+// Returns the index of the leaf that is equal to the given one, adding the leaf if there is none.
+/* static */ uint8_t CharUtils::addFoldingLeaf(const uint16_t *const leaf, int *const leafCount) {
+    for (int i = 0; i < *leafCount; ++i) {
+        if (memcmp(sFoldingLeaves[i], leaf, sizeof(sFoldingLeaves[i])) == 0) {
+            return static_cast<uint8_t>(i);
+        }
+    }
+    if (*leafCount >= MAX_FOLDING_LEAF_COUNT) {
+        AKLOGE("Too many case folding table leaves. MAX_FOLDING_LEAF_COUNT has to be increased.");
+        ASSERT(false);
+        return 0;
+    }
+    memcpy(sFoldingLeaves[*leafCount], leaf, sizeof(sFoldingLeaves[*leafCount]));
+    return static_cast<uint8_t>((*leafCount)++);
+}
+
 /* static */ const std::vector<int> CharUtils::EMPTY_STRING(1 /* size */, '\0' /* value */);
 } // namespace latinime
@@ -18,6 +18,7 @@
 #define LATINIME_CHAR_UTILS_H
 
 #include <cctype>
+#include <cstdint>
 #include <cstring>
 #include <vector>
 
@@ -42,17 +43,11 @@ class CharUtils {
     }
 
     static AK_FORCE_INLINE int toLowerCase(const int c) {
-        if (isAsciiUpper(c)) {
-            return toAsciiLower(c);
-        }
-        if (isAscii(c)) {
-            return c;
-        }
-        return static_cast<int>(latin_tolower(static_cast<unsigned short>(c)));
+        return foldCodePoint(sLowerCasePages, c);
     }
 
     static AK_FORCE_INLINE int toBaseLowerCase(const int c) {
-        return toLowerCase(toBaseCodePoint(c));
+        return foldCodePoint(sBaseLowerCasePages, c);
     }
 
     static AK_FORCE_INLINE bool isIntentionalOmissionCodePoint(const int codePoint) {
@@ -71,10 +66,7 @@ class CharUtils {
     }
 
     static AK_FORCE_INLINE int toBaseCodePoint(int c) {
-        if (c < BASE_CHARS_SIZE) {
-            return static_cast<int>(BASE_CHARS[c]);
-        }
-        return c;
+        return foldCodePoint(sBasePages, c);
     }
 
     static AK_FORCE_INLINE int getSpaceCount(const int *const codePointBuffer, const int length) {
@@ -125,6 +117,35 @@ class CharUtils {
      */
     static const int BASE_CHARS_SIZE = 0x0500;
     static const unsigned short BASE_CHARS[BASE_CHARS_SIZE];
+
+    /*
+     * Two-level tables for toLowerCase(), toBaseCodePoint() and toBaseLowerCase() over the BMP,
+     * built from SORTED_CHAR_MAP and BASE_CHARS when the library is loaded. The page table of
+     * each mapping has the index of the leaf for each 256 code point page. A leaf has the
+     * difference between the mapped code point and the code point modulo 0x10000 for each code
+     * point in the page. Leaves are shared between pages and mappings, and leaf 0, which maps
+     * every code point to itself, is used for most pages.
+     */
+    static const int FOLDING_PAGE_SIZE = 0x100;
+    static const int FOLDING_PAGE_COUNT = 0x100;
+    static const int MAX_FOLDING_LEAF_COUNT = 32;
+    static uint8_t sLowerCasePages[FOLDING_PAGE_COUNT];
+    static uint8_t sBasePages[FOLDING_PAGE_COUNT];
+    static uint8_t sBaseLowerCasePages[FOLDING_PAGE_COUNT];
+    static uint16_t sFoldingLeaves[MAX_FOLDING_LEAF_COUNT][FOLDING_PAGE_SIZE];
+    static const bool sAreFoldingTablesInitialized;
+
+    static bool initializeFoldingTables();
+    static uint8_t addFoldingLeaf(const uint16_t *const leaf, int *const leafCount);
+
+    // Code points out of the BMP are not mapped.
+    static AK_FORCE_INLINE int foldCodePoint(const uint8_t *const pages, const int c) {
+        if (static_cast<unsigned int>(c) >= FOLDING_PAGE_COUNT * FOLDING_PAGE_SIZE) {
+            return c;
+        }
+        const uint16_t delta = sFoldingLeaves[pages[c / FOLDING_PAGE_SIZE]][c % FOLDING_PAGE_SIZE];
+        return (c + delta) & (FOLDING_PAGE_COUNT * FOLDING_PAGE_SIZE - 1);
+    }
 };
 } // namespace latinime
 #endif // LATINIME_CHAR_UTILS_H
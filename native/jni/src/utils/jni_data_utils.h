@@ -72,6 +72,22 @@ class JniDataUtils {
             const bool needsNullTermination) {
         const int codePointBufSize = std::min(maxLength, codePointCount);
         int outputCodePonts[codePointBufSize];
+        const int outputCodePointCount = outputCodePoints(outputCodePonts, codePointBufSize,
+                codePoints, codePointCount, false /* needsNullTermination */);
+        env->SetIntArrayRegion(intArrayToOutputCodePoints, start, outputCodePointCount,
+                outputCodePonts);
+        if (needsNullTermination && outputCodePointCount < maxLength) {
+            env->SetIntArrayRegion(intArrayToOutputCodePoints, start + outputCodePointCount,
+                    1 /* len */, &CODE_POINT_NULL);
+        }
+    }
+
+    // Same as above but writes to a native buffer. Returns the number of the written code points
+    // excluding the null termination.
+    static int outputCodePoints(int *const outCodePoints, const int maxLength,
+            const int *const codePoints, const int codePointCount,
+            const bool needsNullTermination) {
+        const int codePointBufSize = std::min(maxLength, codePointCount);
         int outputCodePointCount = 0;
         for (int i = 0; i < codePointBufSize; ++i) {
             const int codePoint = codePoints[i];
@@ -86,14 +102,12 @@ class JniDataUtils {
                 // Control code.
                 codePointToOutput = CODE_POINT_REPLACEMENT_CHARACTER;
             }
-            outputCodePonts[outputCodePointCount++] = codePointToOutput;
+            outCodePoints[outputCodePointCount++] = codePointToOutput;
         }
-        env->SetIntArrayRegion(intArrayToOutputCodePoints, start, outputCodePointCount,
-                outputCodePonts);
         if (needsNullTermination && outputCodePointCount < maxLength) {
-            env->SetIntArrayRegion(intArrayToOutputCodePoints, start + outputCodePointCount,
-                    1 /* len */, &CODE_POINT_NULL);
+            outCodePoints[outputCodePointCount] = CODE_POINT_NULL;
         }
+        return outputCodePointCount;
     }
 
     static PrevWordsInfo constructPrevWordsInfo(JNIEnv *env, jobjectArray prevWordCodePointArrays,
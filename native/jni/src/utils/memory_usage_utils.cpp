@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/memory_usage_utils.h"
+
+#include <cerrno>
+#include <sys/resource.h>
+
+namespace latinime {
+
+static bool getResourceUsage(struct rusage *const outUsage) {
+    if (getrusage(RUSAGE_SELF, outUsage) != 0) {
+        AKLOGE("Failure in getrusage. errno=%d", errno);
+        return false;
+    }
+    return true;
+}
+
+/* static */ int MemoryUsageUtils::getMajorPageFaultCount() {
+    struct rusage usage;
+    return getResourceUsage(&usage) ? static_cast<int>(usage.ru_majflt) : 0;
+}
+
+/* static */ int MemoryUsageUtils::getMinorPageFaultCount() {
+    struct rusage usage;
+    return getResourceUsage(&usage) ? static_cast<int>(usage.ru_minflt) : 0;
+}
+
+/* static */ int MemoryUsageUtils::getMaxResidentSetSizeInKb() {
+    struct rusage usage;
+    // ru_maxrss is in kilobytes, which doesn't overflow int unlike the size in bytes.
+    return getResourceUsage(&usage) ? static_cast<int>(usage.ru_maxrss) : 0;
+}
+
+} // namespace latinime
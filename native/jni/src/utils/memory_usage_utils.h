@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_MEMORY_USAGE_UTILS_H
+#define LATINIME_MEMORY_USAGE_UTILS_H
+
+#include "defines.h"
+
+namespace latinime {
+
+// Process-wide paging counters. They are used to compare the cost of opening a dictionary and
+// of the first searches on it with and without loading hints.
+class MemoryUsageUtils {
+ public:
+    // Page faults that required I/O.
+    static int getMajorPageFaultCount();
+
+    // Page faults that were served without I/O.
+    static int getMinorPageFaultCount();
+
+    // Peak resident set size in kilobytes.
+    static int getMaxResidentSetSizeInKb();
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(MemoryUsageUtils);
+};
+} // namespace latinime
+#endif // LATINIME_MEMORY_USAGE_UTILS_H
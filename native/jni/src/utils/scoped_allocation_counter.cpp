@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/scoped_allocation_counter.h"
+
+#ifdef FLAG_COUNT_ALLOCATIONS
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<int> sCountingScopeCount(0);
+std::atomic<int> sAllocationCount(0);
+} // namespace
+
+// The other forms of new and delete call these.
+void *operator new(std::size_t size) {
+    if (sCountingScopeCount > 0) {
+        ++sAllocationCount;
+    }
+    void *const ptr = malloc(size > 0 ? size : 1);
+    if (!ptr) {
+        abort();
+    }
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept {
+    free(ptr);
+}
+#endif // FLAG_COUNT_ALLOCATIONS
+
+namespace latinime {
+
+const int ScopedAllocationCounter::NOT_AN_ALLOCATION_COUNT = -1;
+
+#ifdef FLAG_COUNT_ALLOCATIONS
+/* static */ bool ScopedAllocationCounter::isAvailable() {
+    return true;
+}
+
+ScopedAllocationCounter::ScopedAllocationCounter() : mInitialAllocationCount(sAllocationCount) {
+    ++sCountingScopeCount;
+}
+
+ScopedAllocationCounter::~ScopedAllocationCounter() {
+    --sCountingScopeCount;
+}
+
+int ScopedAllocationCounter::getAllocationCount() const {
+    return sAllocationCount - mInitialAllocationCount;
+}
+#else // FLAG_COUNT_ALLOCATIONS
+/* static */ bool ScopedAllocationCounter::isAvailable() {
+    return false;
+}
+
+ScopedAllocationCounter::ScopedAllocationCounter()
+        : mInitialAllocationCount(NOT_AN_ALLOCATION_COUNT) {}
+
+ScopedAllocationCounter::~ScopedAllocationCounter() {}
+
+int ScopedAllocationCounter::getAllocationCount() const {
+    return NOT_AN_ALLOCATION_COUNT;
+}
+#endif // FLAG_COUNT_ALLOCATIONS
+
+} // namespace latinime
@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_SCOPED_ALLOCATION_COUNTER_H
+#define LATINIME_SCOPED_ALLOCATION_COUNTER_H
+
+#include "defines.h"
+
+namespace latinime {
+
+// Counts the heap allocations of the process made while it is alive. Allocations are counted
+// only in builds with FLAG_COUNT_ALLOCATIONS, which replace the global operator new. The unit
+// tests are built with it.
+class ScopedAllocationCounter {
+ public:
+    static const int NOT_AN_ALLOCATION_COUNT;
+
+    static bool isAvailable();
+
+    ScopedAllocationCounter();
+    ~ScopedAllocationCounter();
+
+    // Returns NOT_AN_ALLOCATION_COUNT when allocations are not counted.
+    int getAllocationCount() const;
+
+ private:
+    DISALLOW_COPY_AND_ASSIGN(ScopedAllocationCounter);
+
+    const int mInitialAllocationCount;
+};
+} // namespace latinime
+#endif // LATINIME_SCOPED_ALLOCATION_COUNTER_H
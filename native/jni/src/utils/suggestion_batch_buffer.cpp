@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/suggestion_batch_buffer.h"
+
+#include <algorithm>
+
+namespace latinime {
+
+SuggestionBatchBuffer::SuggestionBatchBuffer(int *const buffer, const int size)
+        : mBuffer(buffer), mSize(size), mIsValid(false), mInputRecordPositions() {
+    mIsValid = parseBatch();
+    if (!mIsValid) {
+        mInputRecordPositions.clear();
+    }
+}
+
+std::vector<std::vector<int>> SuggestionBatchBuffer::getQueryGroupsByContext() const {
+    const int queryCount = getQueryCount();
+    std::vector<const int *> prevWordsRecords(queryCount, nullptr);
+    std::vector<int> prevWordsRecordSizes(queryCount, 0);
+    for (int i = 0; i < queryCount; ++i) {
+        const SuggestionBuffer query(getOutputRecord(i), getInputRecord(i),
+                getInputRecordSize(i));
+        // Invalid queries have no result and are grouped with the queries without context.
+        if (query.isValid()) {
+            prevWordsRecords[i] = query.getPrevWordsRecord();
+            prevWordsRecordSizes[i] = query.getPrevWordsRecordSize();
+        }
+    }
+    std::vector<int> queryIndices(queryCount);
+    for (int i = 0; i < queryCount; ++i) {
+        queryIndices[i] = i;
+    }
+    const auto isLess = [&](const int left, const int right) {
+        return std::lexicographical_compare(prevWordsRecords[left],
+                prevWordsRecords[left] + prevWordsRecordSizes[left], prevWordsRecords[right],
+                prevWordsRecords[right] + prevWordsRecordSizes[right]);
+    };
+    std::stable_sort(queryIndices.begin(), queryIndices.end(), isLess);
+    std::vector<std::vector<int>> queryGroups;
+    for (int i = 0; i < queryCount; ++i) {
+        if (i == 0 || isLess(queryIndices[i - 1], queryIndices[i])) {
+            queryGroups.emplace_back();
+        }
+        queryGroups.back().push_back(queryIndices[i]);
+    }
+    std::sort(queryGroups.begin(), queryGroups.end(),
+            [](const std::vector<int> &left, const std::vector<int> &right) {
+                return left[0] < right[0];
+            });
+    return queryGroups;
+}
+
+bool SuggestionBatchBuffer::parseBatch() {
+    if (!mBuffer || mSize < HEADER_SIZE) {
+        AKLOGE("Invalid suggestion batch buffer size: %d", mSize);
+        return false;
+    }
+    const int queryCount = mBuffer[QUERY_COUNT];
+    // Divided to avoid overflow.
+    if (queryCount < 0
+            || queryCount > (mSize - HEADER_SIZE) / SuggestionBuffer::OUTPUT_RECORD_SIZE) {
+        AKLOGE("Invalid query count: %d, buffer size: %d", queryCount, mSize);
+        return false;
+    }
+    mInputRecordPositions.reserve(queryCount);
+    int pos = HEADER_SIZE + queryCount * SuggestionBuffer::OUTPUT_RECORD_SIZE;
+    for (int i = 0; i < queryCount; ++i) {
+        if (pos >= mSize) {
+            return false;
+        }
+        const int inputRecordSize = mBuffer[pos];
+        ++pos;
+        if (inputRecordSize < 0 || inputRecordSize > mSize - pos) {
+            AKLOGE("Invalid input record size: %d", inputRecordSize);
+            return false;
+        }
+        mInputRecordPositions.push_back(pos);
+        pos += inputRecordSize;
+    }
+    return true;
+}
+
+} // namespace latinime
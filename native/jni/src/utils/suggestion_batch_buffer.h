@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_SUGGESTION_BATCH_BUFFER_H
+#define LATINIME_SUGGESTION_BATCH_BUFFER_H
+
+#include <vector>
+
+#include "defines.h"
+#include "utils/suggestion_buffer.h"
+
+namespace latinime {
+
+/*
+ * A view of the direct buffer that holds the queries of a batch and their results. The buffer
+ * is an array of native-endian 32-bit values:
+ *
+ *   query count,
+ *   output records[query count] (each of SuggestionBuffer::OUTPUT_RECORD_SIZE),
+ *   { input record size, input record } for each query
+ *
+ * The records have the layout of SuggestionBuffer. The output records have a fixed size and come
+ * first so that the Java side can find the results of each query without walking the input.
+ */
+class SuggestionBatchBuffer {
+ public:
+    // Need to update com.android.inputmethod.latin.NativeSuggestionBatchBuffer when you change
+    // the layout.
+    static const int QUERY_COUNT = 0;
+    static const int HEADER_SIZE = 1;
+
+    // Parses the framing of the input records. isValid() returns false when the records don't
+    // fit in the buffer. Each input record is parsed when its query runs.
+    SuggestionBatchBuffer(int *const buffer, const int size);
+
+    bool isValid() const { return mIsValid; }
+
+    int getQueryCount() const { return static_cast<int>(mInputRecordPositions.size()); }
+
+    int *getOutputRecord(const int queryIndex) const {
+        return &mBuffer[HEADER_SIZE + queryIndex * SuggestionBuffer::OUTPUT_RECORD_SIZE];
+    }
+
+    int *getInputRecord(const int queryIndex) const {
+        return &mBuffer[mInputRecordPositions[queryIndex]];
+    }
+
+    int getInputRecordSize(const int queryIndex) const {
+        return mBuffer[mInputRecordPositions[queryIndex] - 1];
+    }
+
+    // Groups the queries by their previous words. The queries in a group are in the order of the
+    // batch, and so are the groups by their first queries.
+    std::vector<std::vector<int>> getQueryGroupsByContext() const;
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(SuggestionBatchBuffer);
+
+    int *const mBuffer;
+    const int mSize;
+    bool mIsValid;
+    std::vector<int> mInputRecordPositions;
+
+    bool parseBatch();
+};
+} // namespace latinime
+#endif // LATINIME_SUGGESTION_BATCH_BUFFER_H
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/suggestion_buffer.h"
+
+namespace latinime {
+
+SuggestionBuffer::SuggestionBuffer(int *const buffer, const int size)
+        : SuggestionBuffer(buffer,
+                (buffer && size >= INPUT_RECORD) ? buffer + INPUT_RECORD : nullptr,
+                size - INPUT_RECORD) {}
+
+SuggestionBuffer::SuggestionBuffer(int *const outputRecord, int *const inputRecord,
+        const int inputRecordSize)
+        : mOutputRecord(outputRecord), mInputRecord(inputRecord),
+          mInputRecordSize(inputRecordSize), mIsValid(false), mOptions(nullptr),
+          mInputCodePoints(nullptr), mXCoordinates(nullptr), mYCoordinates(nullptr),
+          mTimes(nullptr), mPointerIds(nullptr), mPrevWords(nullptr), mPrevWordsRecordSize(0) {
+    mIsValid = parseInputRecord();
+}
+
+PrevWordsInfo SuggestionBuffer::getPrevWordsInfo() const {
+    int prevWordCodePoints[MAX_PREV_WORD_COUNT_FOR_N_GRAM][MAX_WORD_LENGTH];
+    int prevWordCodePointCount[MAX_PREV_WORD_COUNT_FOR_N_GRAM];
+    bool isBeginningOfSentence[MAX_PREV_WORD_COUNT_FOR_N_GRAM];
+    const int prevWordCount = mInputRecord[PREV_WORD_COUNT];
+    const int *prevWord = mPrevWords;
+    // Previous words that are too long are ignored as JniDataUtils::constructPrevWordsInfo()
+    // does.
+    for (int i = 0; i < MAX_PREV_WORD_COUNT_FOR_N_GRAM; ++i) {
+        prevWordCodePointCount[i] = 0;
+        isBeginningOfSentence[i] = false;
+        if (i >= prevWordCount) {
+            continue;
+        }
+        const int codePointCount = prevWord[1];
+        if (codePointCount <= MAX_WORD_LENGTH) {
+            memmove(prevWordCodePoints[i], &prevWord[2], sizeof(prevWord[0]) * codePointCount);
+            prevWordCodePointCount[i] = codePointCount;
+            isBeginningOfSentence[i] = prevWord[0] != 0;
+        }
+        prevWord += 2 + codePointCount;
+    }
+    return PrevWordsInfo(prevWordCodePoints, prevWordCodePointCount, isBeginningOfSentence,
+            MAX_PREV_WORD_COUNT_FOR_N_GRAM);
+}
+
+void SuggestionBuffer::getPaddedInputCodePoints(int *const outCodePoints) const {
+    const int inputCodePointCount = getInputCodePointCount();
+    memmove(outCodePoints, mInputCodePoints, sizeof(outCodePoints[0]) * inputCodePointCount);
+    for (int i = inputCodePointCount; i < MAX_WORD_LENGTH; ++i) {
+        outCodePoints[i] = NOT_A_CODE_POINT;
+    }
+}
+
+bool SuggestionBuffer::parseInputRecord() {
+    if (!mOutputRecord || !mInputRecord || mInputRecordSize < INPUT_RECORD_HEADER_SIZE) {
+        AKLOGE("Invalid suggestion input record size: %d", mInputRecordSize);
+        return false;
+    }
+    const int inputSize = getInputSize();
+    const int pointCount = getPointCount();
+    const int inputCodePointCount = getInputCodePointCount();
+    const int optionCount = getOptionCount();
+    const int prevWordCount = mInputRecord[PREV_WORD_COUNT];
+    if (inputSize < 0 || pointCount < 0 || inputCodePointCount < 0
+            || inputCodePointCount > MAX_WORD_LENGTH || optionCount < 0 || prevWordCount < 0) {
+        AKLOGE("Invalid suggestion input record. inputSize: %d, pointCount: %d, "
+                "inputCodePointCount: %d, optionCount: %d, prevWordCount: %d", inputSize,
+                pointCount, inputCodePointCount, optionCount, prevWordCount);
+        return false;
+    }
+    const int size = mInputRecordSize;
+    int pos = INPUT_RECORD_HEADER_SIZE;
+    if (optionCount > size - pos) {
+        return false;
+    }
+    mOptions = &mInputRecord[pos];
+    pos += optionCount;
+    mPrevWords = &mInputRecord[pos];
+    const int prevWordsPos = pos;
+    for (int i = 0; i < prevWordCount; ++i) {
+        if (size - pos < 2) {
+            return false;
+        }
+        const int codePointCount = mInputRecord[pos + 1];
+        if (codePointCount < 0 || codePointCount > size - pos - 2) {
+            return false;
+        }
+        pos += 2 + codePointCount;
+    }
+    mPrevWordsRecordSize = pos - prevWordsPos;
+    if (inputCodePointCount > size - pos) {
+        return false;
+    }
+    mInputCodePoints = &mInputRecord[pos];
+    pos += inputCodePointCount;
+    // Divided to avoid overflow.
+    if (pointCount > (size - pos) / 4) {
+        return false;
+    }
+    mXCoordinates = &mInputRecord[pos];
+    mYCoordinates = mXCoordinates + pointCount;
+    mTimes = mYCoordinates + pointCount;
+    mPointerIds = mTimes + pointCount;
+    return true;
+}
+
+} // namespace latinime
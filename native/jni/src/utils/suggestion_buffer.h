@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_SUGGESTION_BUFFER_H
+#define LATINIME_SUGGESTION_BUFFER_H
+
+#include <cstring>
+
+#include "defines.h"
+#include "suggest/core/session/prev_words_info.h"
+
+namespace latinime {
+
+/*
+ * A view of the direct buffer that holds both the input and the output of one getSuggestions()
+ * call. The buffer is an array of native-endian 32-bit values. The output record of fixed size
+ * comes first and the input record follows it:
+ *
+ * Output record
+ *   suggestion count, auto-commit first word confidence, language weight (float),
+ *   scores[MAX_RESULTS], space indices[MAX_RESULTS], types[MAX_RESULTS],
+ *   code points[MAX_RESULTS * MAX_WORD_LENGTH]
+ * Input record
+ *   input size, point count, input code point count, option count, previous word count,
+ *   language weight (float), gesture points generation, options[option count],
+ *   { is beginning of sentence, code point count, code points[code point count] } for each
+ *   previous word,
+ *   input code points[input code point count], x coordinates[point count],
+ *   y coordinates[point count], times[point count], pointer ids[point count]
+ *
+ * The native side only reads the input record and only writes the output record. A batch of
+ * queries has the records in separate places (see SuggestionBatchBuffer), so a view can also be
+ * made of an output record and an input record given separately.
+ */
+class SuggestionBuffer {
+ public:
+    // Need to update com.android.inputmethod.latin.NativeSuggestionBuffer when you change the
+    // layout.
+    static const int SUGGESTION_COUNT = 0;
+    static const int AUTO_COMMIT_FIRST_WORD_CONFIDENCE = 1;
+    static const int OUTPUT_LANGUAGE_WEIGHT = 2;
+    static const int SCORES = 3;
+    static const int SPACE_INDICES = SCORES + MAX_RESULTS;
+    static const int TYPES = SPACE_INDICES + MAX_RESULTS;
+    static const int CODE_POINTS = TYPES + MAX_RESULTS;
+    static const int OUTPUT_RECORD_SIZE = CODE_POINTS + MAX_RESULTS * MAX_WORD_LENGTH;
+    static const int INPUT_RECORD = OUTPUT_RECORD_SIZE;
+    // Relative to INPUT_RECORD
+    static const int INPUT_SIZE = 0;
+    static const int POINT_COUNT = 1;
+    static const int INPUT_CODE_POINT_COUNT = 2;
+    static const int OPTION_COUNT = 3;
+    static const int PREV_WORD_COUNT = 4;
+    static const int INPUT_LANGUAGE_WEIGHT = 5;
+    static const int GESTURE_POINTS_GENERATION = 6;
+    static const int INPUT_RECORD_HEADER_SIZE = 7;
+
+    // Parses the input record. isValid() returns false when the record doesn't fit in the buffer,
+    // and the input must not be read in that case.
+    SuggestionBuffer(int *const buffer, const int size);
+    SuggestionBuffer(int *const outputRecord, int *const inputRecord, const int inputRecordSize);
+
+    bool isValid() const { return mIsValid; }
+
+    int getInputSize() const { return mInputRecord[INPUT_SIZE]; }
+    int getPointCount() const { return mInputRecord[POINT_COUNT]; }
+    int getInputCodePointCount() const { return mInputRecord[INPUT_CODE_POINT_COUNT]; }
+    int getOptionCount() const { return mInputRecord[OPTION_COUNT]; }
+    float getInputLanguageWeight() const { return getFloat(INPUT_LANGUAGE_WEIGHT); }
+    // The generation of the points streamed to the session, which are used instead of the
+    // coordinates of this record when it is still the generation of the session.
+    int getGesturePointsGeneration() const { return mInputRecord[GESTURE_POINTS_GENERATION]; }
+    const int *getOptions() const { return mOptions; }
+    const int *getInputCodePoints() const { return mInputCodePoints; }
+    int *getXCoordinates() const { return mXCoordinates; }
+    int *getYCoordinates() const { return mYCoordinates; }
+    int *getTimes() const { return mTimes; }
+    int *getPointerIds() const { return mPointerIds; }
+    PrevWordsInfo getPrevWordsInfo() const;
+    // Copies the input code points padded with NOT_A_CODE_POINT up to MAX_WORD_LENGTH as the
+    // Java side does for getSuggestionsNative().
+    void getPaddedInputCodePoints(int *const outCodePoints) const;
+    // The previous words part of the input record. Queries that have the same previous words
+    // part have the same context.
+    const int *getPrevWordsRecord() const { return mPrevWords; }
+    int getPrevWordsRecordSize() const { return mPrevWordsRecordSize; }
+
+    void setSuggestionCount(const int suggestionCount) {
+        mOutputRecord[SUGGESTION_COUNT] = suggestionCount;
+    }
+
+    void setAutoCommitFirstWordConfidence(const int confidence) {
+        mOutputRecord[AUTO_COMMIT_FIRST_WORD_CONFIDENCE] = confidence;
+    }
+
+    void setLanguageWeight(const float languageWeight) {
+        memcpy(&mOutputRecord[OUTPUT_LANGUAGE_WEIGHT], &languageWeight, sizeof(languageWeight));
+    }
+
+    void setSuggestion(const int index, const int score, const int spaceIndex, const int type) {
+        mOutputRecord[SCORES + index] = score;
+        mOutputRecord[SPACE_INDICES + index] = spaceIndex;
+        mOutputRecord[TYPES + index] = type;
+    }
+
+    // The code points of the index-th suggestion. There are MAX_WORD_LENGTH entries.
+    int *getCodePointsOfSuggestion(const int index) {
+        return &mOutputRecord[CODE_POINTS + index * MAX_WORD_LENGTH];
+    }
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(SuggestionBuffer);
+
+    int *const mOutputRecord;
+    int *const mInputRecord;
+    const int mInputRecordSize;
+    bool mIsValid;
+    const int *mOptions;
+    const int *mInputCodePoints;
+    int *mXCoordinates;
+    int *mYCoordinates;
+    int *mTimes;
+    int *mPointerIds;
+    const int *mPrevWords;
+    int mPrevWordsRecordSize;
+
+    float getFloat(const int pos) const {
+        float value;
+        memcpy(&value, &mInputRecord[pos], sizeof(value));
+        return value;
+    }
+
+    bool parseInputRecord();
+};
+} // namespace latinime
+#endif // LATINIME_SUGGESTION_BUFFER_H
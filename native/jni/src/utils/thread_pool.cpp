@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/thread_pool.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace latinime {
+
+// The calling thread runs tasks too, so this keeps a few cores free for the UI.
+const int ThreadPool::MAX_WORKER_THREAD_COUNT = 3;
+
+/* static */ ThreadPool *ThreadPool::getInstance() {
+    // Intentionally leaked: the worker threads are never joined, so the pool must outlive them.
+    static ThreadPool *const threadPool = new ThreadPool(std::max(1, std::min(
+            MAX_WORKER_THREAD_COUNT,
+            static_cast<int>(std::thread::hardware_concurrency()) - 1)));
+    return threadPool;
+}
+
+ThreadPool::ThreadPool(const int workerThreadCount)
+        : mWorkerThreadCount(workerThreadCount), mMutex(), mBatchAddedCondition(),
+          mBatchFinishedCondition(), mBatches() {
+    for (int i = 0; i < mWorkerThreadCount; ++i) {
+        std::thread(&ThreadPool::runWorkerThread, this).detach();
+    }
+}
+
+void ThreadPool::runTasks(const int taskCount, const TaskFunction taskFunction,
+        const void *const context) {
+    if (taskCount <= 0) {
+        return;
+    }
+    Batch batch(taskFunction, context, taskCount);
+    std::unique_lock<std::mutex> lock(mMutex);
+    if (taskCount > 1) {
+        mBatches.push_back(&batch);
+        mBatchAddedCondition.notify_all();
+    }
+    while (runNextTaskLocked(&batch, &lock)) {}
+    // Workers may still be running tasks of the batch, which lives on this stack.
+    mBatchFinishedCondition.wait(lock, [&batch] {
+        return batch.mFinishedTaskCount == batch.mTaskCount;
+    });
+}
+
+void ThreadPool::runWorkerThread() {
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true) {
+        mBatchAddedCondition.wait(lock, [this] { return !mBatches.empty(); });
+        runNextTaskLocked(mBatches.front(), &lock);
+    }
+}
+
+bool ThreadPool::runNextTaskLocked(Batch *const batch, std::unique_lock<std::mutex> *const lock) {
+    if (batch->mNextTaskIndex >= batch->mTaskCount) {
+        return false;
+    }
+    const int taskIndex = batch->mNextTaskIndex++;
+    if (batch->mNextTaskIndex == batch->mTaskCount) {
+        const auto it = std::find(mBatches.begin(), mBatches.end(), batch);
+        if (it != mBatches.end()) {
+            mBatches.erase(it);
+        }
+    }
+    lock->unlock();
+    batch->mTaskFunction(batch->mContext, taskIndex);
+    lock->lock();
+    ++batch->mFinishedTaskCount;
+    if (batch->mFinishedTaskCount == batch->mTaskCount) {
+        mBatchFinishedCondition.notify_all();
+    }
+    return true;
+}
+
+} // namespace latinime
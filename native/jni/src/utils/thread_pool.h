@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_THREAD_POOL_H
+#define LATINIME_THREAD_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+#include "defines.h"
+
+namespace latinime {
+
+// Runs independent tasks on a fixed set of worker threads that are started once and then live
+// as long as the process.
+class ThreadPool {
+ public:
+    // Returns the pool shared by the process. It is created on first use and never destroyed.
+    static ThreadPool *getInstance();
+
+    // Calls task(i) for every i in [0, taskCount) and returns when all calls have returned. The
+    // calling thread runs tasks too, so tasks may call this again. Tasks must not throw.
+    template<typename Task>
+    void runTasks(const int taskCount, const Task &task) {
+        runTasks(taskCount, [](const void *const context, const int taskIndex) {
+            (*static_cast<const Task *>(context))(taskIndex);
+        }, &task);
+    }
+
+    int getWorkerThreadCount() const {
+        return mWorkerThreadCount;
+    }
+
+ private:
+    DISALLOW_COPY_AND_ASSIGN(ThreadPool);
+
+    typedef void (*TaskFunction)(const void *const context, const int taskIndex);
+
+    // Tasks of one runTasks() call. The fields are guarded by the mutex of the pool.
+    struct Batch {
+        Batch(const TaskFunction taskFunction, const void *const context, const int taskCount)
+                : mTaskFunction(taskFunction), mContext(context), mTaskCount(taskCount),
+                  mNextTaskIndex(0), mFinishedTaskCount(0) {}
+
+        const TaskFunction mTaskFunction;
+        const void *const mContext;
+        const int mTaskCount;
+        int mNextTaskIndex;
+        int mFinishedTaskCount;
+    };
+
+    static const int MAX_WORKER_THREAD_COUNT;
+
+    explicit ThreadPool(const int workerThreadCount);
+
+    void runTasks(const int taskCount, const TaskFunction taskFunction,
+            const void *const context);
+    void runWorkerThread();
+    // Runs a task of the batch if one hasn't been started yet. The lock has to be held and is
+    // released while the task runs.
+    bool runNextTaskLocked(Batch *const batch, std::unique_lock<std::mutex> *const lock);
+
+    const int mWorkerThreadCount;
+    std::mutex mMutex;
+    // Notified when a batch is added.
+    std::condition_variable mBatchAddedCondition;
+    // Notified when a batch has finished.
+    std::condition_variable mBatchFinishedCondition;
+    // Batches that have tasks that haven't been started yet.
+    std::deque<Batch *> mBatches;
+};
+} // namespace latinime
+#endif /* LATINIME_THREAD_POOL_H */
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/core/dictionary/exact_match_matcher.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "suggest/core/dictionary/property/unigram_property.h"
+#include "suggest/core/policy/dictionary_header_structure_policy.h"
+#include "suggest/policyimpl/dictionary/structure/dictionary_structure_with_buffer_policy_factory.h"
+#include "suggest/policyimpl/dictionary/utils/format_utils.h"
+
+namespace latinime {
+namespace {
+
+void addUnigram(DictionaryStructureWithBufferPolicy *const policy, const std::vector<int> &word,
+        const int probability) {
+    const std::vector<UnigramProperty::ShortcutProperty> shortcuts;
+    const UnigramProperty unigramProperty(false /* representsBeginningOfSentence */,
+            false /* isNotAWord */, false /* isBlacklisted */, probability, NOT_A_TIMESTAMP,
+            0 /* level */, 0 /* count */, &shortcuts);
+    policy->addUnigramEntry(word.data(), word.size(), &unigramProperty);
+}
+
+int getMaxProbability(ExactMatchMatcher *const matcher, const std::vector<int> &word) {
+    int maxProbability = NOT_A_PROBABILITY;
+    EXPECT_TRUE(matcher->getMaxProbabilityOfExactMatches(word.data(), word.size(),
+            &maxProbability));
+    return maxProbability;
+}
+
+TEST(ExactMatchMatcherTest, TestMaxProbability) {
+    DictionaryHeaderStructurePolicy::AttributeMap attributeMap;
+    const std::vector<int> locale = {'e', 'n'};
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy =
+            DictionaryStructureWithBufferPolicyFactory::newPolicyForOnMemoryDict(
+                    FormatUtils::VERSION_4, locale, &attributeMap);
+    ASSERT_TRUE(policy);
+    addUnigram(policy.get(), {'c', 'a', 'f', 'e'}, 100);
+    addUnigram(policy.get(), {'c', 'a', 'f', 0xE9}, 120);
+    addUnigram(policy.get(), {'d', 'o', 'n', '\'', 't'}, 90);
+    addUnigram(policy.get(), {'H', 'e', 'l', 'l', 'o'}, 80);
+    addUnigram(policy.get(), {'h', 'e', 'l', 'l', 'o', 'w'}, 70);
+
+    ExactMatchMatcher matcher(policy.get());
+    EXPECT_EQ(120, getMaxProbability(&matcher, {'c', 'a', 'f', 'e'}));
+    EXPECT_EQ(120, getMaxProbability(&matcher, {'C', 'A', 'F', 0xC9}));
+    EXPECT_EQ(90, getMaxProbability(&matcher, {'d', 'o', 'n', 't'}));
+    EXPECT_EQ(90, getMaxProbability(&matcher, {'d', 'o', 'n', '\'', 't'}));
+    EXPECT_EQ(80, getMaxProbability(&matcher, {'h', 'e', 'l', 'l', 'o'}));
+    EXPECT_EQ(70, getMaxProbability(&matcher, {'h', 'e', 'l', 'l', 'o', 'w'}));
+    EXPECT_EQ(NOT_A_PROBABILITY, getMaxProbability(&matcher, {'h', 'e', 'l', 'l'}));
+    EXPECT_EQ(NOT_A_PROBABILITY, getMaxProbability(&matcher, {'h', 'a', 'l', 'l', 'o'}));
+    EXPECT_EQ(NOT_A_PROBABILITY, getMaxProbability(&matcher, {}));
+}
+
+}  // namespace
+}  // namespace latinime
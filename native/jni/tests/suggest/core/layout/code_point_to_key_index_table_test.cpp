@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/core/layout/code_point_to_key_index_table.h"
+
+#include <gtest/gtest.h>
+
+#include "utils/char_utils.h"
+
+namespace latinime {
+namespace {
+
+TEST(CodePointToKeyIndexTableTest, TestGetKeyIndex) {
+    // Latin, Cyrillic, Greek, CJK and a duplicated key.
+    const int keyLowerCodePoints[] = {'q', 'w', 'e', 0x0430 /* CYRILLIC SMALL LETTER A */,
+            0x03B1 /* GREEK SMALL LETTER ALPHA */, 0x4E00, 'w'};
+    const int keyCount = NELEMS(keyLowerCodePoints);
+    CodePointToKeyIndexTable table;
+    table.build(keyLowerCodePoints, keyCount);
+
+    EXPECT_EQ(0, table.getKeyIndex('q'));
+    EXPECT_EQ(0, table.getKeyIndex('Q'));
+    EXPECT_EQ(2, table.getKeyIndex('E'));
+    EXPECT_EQ(3, table.getKeyIndex(0x0410 /* CYRILLIC CAPITAL LETTER A */));
+    EXPECT_EQ(4, table.getKeyIndex(0x0391 /* GREEK CAPITAL LETTER ALPHA */));
+    EXPECT_EQ(5, table.getKeyIndex(0x4E00));
+    // The last key is used for duplicated code points.
+    EXPECT_EQ(6, table.getKeyIndex('w'));
+    EXPECT_EQ(6, table.getKeyIndex('W'));
+    EXPECT_EQ(NOT_AN_INDEX, table.getKeyIndex('z'));
+    EXPECT_EQ(NOT_AN_INDEX, table.getKeyIndex(0x4E01));
+    EXPECT_EQ(NOT_AN_INDEX, table.getKeyIndex(NOT_A_CODE_POINT));
+
+    for (int codePoint = 0; codePoint < 0x10000; ++codePoint) {
+        const int lowerCodePoint = CharUtils::toLowerCase(codePoint);
+        int expectedKeyIndex = NOT_AN_INDEX;
+        for (int i = 0; i < keyCount; ++i) {
+            if (keyLowerCodePoints[i] == lowerCodePoint) {
+                expectedKeyIndex = i;
+            }
+        }
+        EXPECT_EQ(expectedKeyIndex, table.getKeyIndex(codePoint));
+    }
+}
+
+TEST(CodePointToKeyIndexTableTest, TestEmptyTable) {
+    CodePointToKeyIndexTable table;
+    EXPECT_EQ(NOT_AN_INDEX, table.getKeyIndex('a'));
+    table.build(nullptr, 0);
+    EXPECT_EQ(NOT_AN_INDEX, table.getKeyIndex('a'));
+    EXPECT_EQ(NOT_AN_INDEX, table.getKeyIndex(0x4E00));
+}
+
+}  // namespace
+}  // namespace latinime
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/core/layout/key_distance_utils.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cstdlib>
+
+namespace latinime {
+namespace {
+
+static const float SQUARED_MOST_COMMON_KEY_WIDTH = 100.0f * 100.0f;
+
+void initKeyCenters(const int keyCount, KeyDistanceUtils::KeyCenters *const keyCenters) {
+    srand(0);
+    for (int i = 0; i < keyCount; ++i) {
+        const int centerX = rand() % 1000;
+        // Some keys are wider than the most common key.
+        const int keyWidthHalfDiff = (i % 3 == 0) ? rand() % 200 : 0;
+        keyCenters->centerXMins[i] = static_cast<float>(centerX - keyWidthHalfDiff);
+        keyCenters->centerXMaxs[i] = static_cast<float>(centerX + keyWidthHalfDiff);
+        keyCenters->centerYs[i] = static_cast<float>(rand() % 500);
+        keyCenters->bottomYLimits[i] = (i % 4 == 0) ? FLT_MAX : -FLT_MAX;
+    }
+}
+
+float getExpectedDistance(const KeyDistanceUtils::KeyCenters *const keyCenters,
+        const int keyId, const int x, const int y) {
+    float centerX = keyCenters->centerXMins[keyId];
+    if (x > keyCenters->centerXMaxs[keyId]) {
+        centerX = keyCenters->centerXMaxs[keyId];
+    } else if (x > keyCenters->centerXMins[keyId]) {
+        centerX = static_cast<float>(x);
+    }
+    float centerY = keyCenters->centerYs[keyId];
+    if (keyCenters->bottomYLimits[keyId] > 0.0f && centerY < y) {
+        centerY = static_cast<float>(y);
+    }
+    const float deltaX = centerX - static_cast<float>(x);
+    const float deltaY = centerY - static_cast<float>(y);
+    return (deltaX * deltaX + deltaY * deltaY) / SQUARED_MOST_COMMON_KEY_WIDTH;
+}
+
+TEST(KeyDistanceUtilsTest, TestGetNormalizedSquaredDistances) {
+    KeyDistanceUtils::KeyCenters keyCenters;
+    initKeyCenters(MAX_KEY_COUNT_IN_A_KEYBOARD, &keyCenters);
+    float distances[MAX_KEY_COUNT_IN_A_KEYBOARD];
+    // Key counts that are not multiples of the vector width are also tested.
+    for (int keyCount = 0; keyCount <= MAX_KEY_COUNT_IN_A_KEYBOARD; keyCount += 7) {
+        for (int x = -100; x < 1200; x += 37) {
+            for (int y = -100; y < 700; y += 41) {
+                const float minDistance = KeyDistanceUtils::getNormalizedSquaredDistances(
+                        &keyCenters, keyCount, static_cast<float>(x), static_cast<float>(y),
+                        SQUARED_MOST_COMMON_KEY_WIDTH, distances);
+                float expectedMinDistance = static_cast<float>(MAX_VALUE_FOR_WEIGHTING);
+                for (int i = 0; i < keyCount; ++i) {
+                    const float expectedDistance = getExpectedDistance(&keyCenters, i, x, y);
+                    EXPECT_FLOAT_EQ(expectedDistance, distances[i]);
+                    expectedMinDistance = std::min(expectedMinDistance, expectedDistance);
+                }
+                EXPECT_FLOAT_EQ(expectedMinDistance, minDistance);
+            }
+        }
+    }
+}
+
+}  // namespace
+}  // namespace latinime
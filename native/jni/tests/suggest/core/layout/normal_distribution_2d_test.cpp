@@ -18,6 +18,7 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <vector>
 
 namespace latinime {
@@ -64,5 +65,40 @@ TEST(NormalDistribution2DTest, Rotate) {
     }
 }
 
+TEST(NormalDistribution2DTest, ApproximateProbabilityDensity) {
+    const NormalDistribution2D distribution(ORIGIN_X, LARGE_STANDARD_DEVIATION, ORIGIN_Y,
+            SMALL_STANDARD_DEVIATION, M_PI_4 / 3.0f);
+    const float maxProbabilityDensity = distribution.getProbabilityDensity(ORIGIN_X, ORIGIN_Y);
+    for (float x = -1000.0f; x <= 1000.0f; x += 3.7f) {
+        for (float y = -100.0f; y <= 100.0f; y += 0.37f) {
+            const float probabilityDensity = distribution.getProbabilityDensity(x, y);
+            const float approximateProbabilityDensity =
+                    distribution.getApproximateProbabilityDensity(x, y);
+            if (approximateProbabilityDensity == 0.0f) {
+                EXPECT_LT(probabilityDensity, maxProbabilityDensity * expf(-63.0f))
+                        << "(" << x << ", " << y << ")";
+            } else {
+                EXPECT_NEAR(probabilityDensity, approximateProbabilityDensity, probabilityDensity
+                        * NormalDistribution::MAX_RELATIVE_ERROR_OF_APPROXIMATION)
+                        << "(" << x << ", " << y << ")";
+            }
+        }
+    }
+}
+
+TEST(NormalDistribution2DTest, ApproximateExpOfNegative) {
+    // The tables are exact at their entries.
+    EXPECT_FLOAT_EQ(1.0f, NormalDistribution::getApproximateExpOfNegative(0.0f));
+    EXPECT_FLOAT_EQ(expf(-3.0f), NormalDistribution::getApproximateExpOfNegative(3.0f));
+    EXPECT_FLOAT_EQ(expf(-3.5f), NormalDistribution::getApproximateExpOfNegative(3.5f));
+    for (float t = 0.0f; t < 64.0f; t += 0.0037f) {
+        const float expOfNegative = expf(-t);
+        EXPECT_NEAR(expOfNegative, NormalDistribution::getApproximateExpOfNegative(t),
+                expOfNegative * NormalDistribution::MAX_RELATIVE_ERROR_OF_APPROXIMATION) << t;
+    }
+    EXPECT_EQ(0.0f, NormalDistribution::getApproximateExpOfNegative(64.0f));
+    EXPECT_EQ(0.0f, NormalDistribution::getApproximateExpOfNegative(200.0f));
+}
+
 }  // namespace
 }  // namespace latinime
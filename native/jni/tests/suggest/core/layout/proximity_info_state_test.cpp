@@ -0,0 +1,257 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/core/layout/proximity_info_state.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "suggest/core/layout/proximity_info.h"
+
+namespace latinime {
+namespace {
+
+const int KEY_WIDTH = 100;
+const int KEY_HEIGHT = 150;
+const int KEYBOARD_WIDTH = 10 * KEY_WIDTH;
+const int KEYBOARD_HEIGHT = 3 * KEY_HEIGHT;
+const int GRID_WIDTH = 32;
+const int GRID_HEIGHT = 16;
+const float MAX_POINT_TO_KEY_LENGTH = 1.0f;
+
+// A qwerty keyboard without touch position correction data.
+class TestKeyboard {
+ public:
+    TestKeyboard() : mKeyXs(), mKeyYs(), mKeyCodePoints() {
+        const char *const rows[] = {"qwertyuiop", "asdfghjkl", "zxcvbnm"};
+        const int rowOffsets[] = {0, KEY_WIDTH / 2, KEY_WIDTH * 3 / 2};
+        for (size_t row = 0; row < NELEMS(rows); ++row) {
+            for (int i = 0; rows[row][i] != '\0'; ++i) {
+                mKeyXs.push_back(rowOffsets[row] + i * KEY_WIDTH);
+                mKeyYs.push_back(row * KEY_HEIGHT);
+                mKeyCodePoints.push_back(rows[row][i]);
+            }
+        }
+        const int keyCount = static_cast<int>(mKeyCodePoints.size());
+        const std::vector<int> keyWidths(keyCount, KEY_WIDTH);
+        const std::vector<int> keyHeights(keyCount, KEY_HEIGHT);
+        const std::vector<int> proximityChars = createProximityChars();
+        mProximityInfo.reset(new ProximityInfo("en_US", KEYBOARD_WIDTH, KEYBOARD_HEIGHT,
+                GRID_WIDTH, GRID_HEIGHT, KEY_WIDTH, KEY_HEIGHT, proximityChars.data(), keyCount,
+                mKeyXs.data(), mKeyYs.data(), keyWidths.data(), keyHeights.data(),
+                mKeyCodePoints.data(), nullptr /* sweetSpotCenterXs */,
+                nullptr /* sweetSpotCenterYs */, nullptr /* sweetSpotRadii */));
+    }
+
+    const ProximityInfo *getProximityInfo() const { return mProximityInfo.get(); }
+
+    int getKeyCenterX(const char codePoint) const {
+        return mKeyXs[getKeyIndex(codePoint)] + KEY_WIDTH / 2;
+    }
+
+    int getKeyCenterY(const char codePoint) const {
+        return mKeyYs[getKeyIndex(codePoint)] + KEY_HEIGHT / 2;
+    }
+
+ private:
+    DISALLOW_COPY_AND_ASSIGN(TestKeyboard);
+
+    std::vector<int> mKeyXs;
+    std::vector<int> mKeyYs;
+    std::vector<int> mKeyCodePoints;
+    std::unique_ptr<ProximityInfo> mProximityInfo;
+
+    int getKeyIndex(const char codePoint) const {
+        return std::find(mKeyCodePoints.begin(), mKeyCodePoints.end(), codePoint)
+                - mKeyCodePoints.begin();
+    }
+
+    // The keys within a key width of each cell, padded with NOT_A_CODE_POINT as the Java side
+    // does.
+    std::vector<int> createProximityChars() const {
+        std::vector<int> proximityChars(GRID_WIDTH * GRID_HEIGHT * MAX_PROXIMITY_CHARS_SIZE,
+                NOT_A_CODE_POINT);
+        const int cellWidth = (KEYBOARD_WIDTH + GRID_WIDTH - 1) / GRID_WIDTH;
+        const int cellHeight = (KEYBOARD_HEIGHT + GRID_HEIGHT - 1) / GRID_HEIGHT;
+        for (int cell = 0; cell < GRID_WIDTH * GRID_HEIGHT; ++cell) {
+            const int x = (cell % GRID_WIDTH) * cellWidth + cellWidth / 2;
+            const int y = (cell / GRID_WIDTH) * cellHeight + cellHeight / 2;
+            int count = 0;
+            for (size_t i = 0; i < mKeyCodePoints.size()
+                    && count < MAX_PROXIMITY_CHARS_SIZE; ++i) {
+                if (abs(x - (mKeyXs[i] + KEY_WIDTH / 2)) <= KEY_WIDTH
+                        && abs(y - (mKeyYs[i] + KEY_HEIGHT / 2)) <= KEY_HEIGHT) {
+                    proximityChars[cell * MAX_PROXIMITY_CHARS_SIZE + count++] =
+                            mKeyCodePoints[i];
+                }
+            }
+        }
+        return proximityChars;
+    }
+};
+
+// The points of a gesture that passes through the keys of the word, one point every 10 ms.
+struct GesturePoints {
+    GesturePoints(const TestKeyboard &keyboard, const char *const word) {
+        const int POINT_COUNT_PER_STROKE = 12;
+        xs.push_back(keyboard.getKeyCenterX(word[0]));
+        ys.push_back(keyboard.getKeyCenterY(word[0]));
+        for (int i = 1; word[i] != '\0'; ++i) {
+            const int startX = keyboard.getKeyCenterX(word[i - 1]);
+            const int startY = keyboard.getKeyCenterY(word[i - 1]);
+            const int endX = keyboard.getKeyCenterX(word[i]);
+            const int endY = keyboard.getKeyCenterY(word[i]);
+            for (int j = 1; j <= POINT_COUNT_PER_STROKE; ++j) {
+                // Slow down near the keys as people do.
+                const float ratio = static_cast<float>(j) / POINT_COUNT_PER_STROKE;
+                const float easedRatio = ratio * ratio * (3.0f - 2.0f * ratio);
+                xs.push_back(startX + static_cast<int>((endX - startX) * easedRatio));
+                ys.push_back(startY + static_cast<int>((endY - startY) * easedRatio));
+            }
+        }
+        for (size_t i = 0; i < xs.size(); ++i) {
+            times.push_back(static_cast<int>(i) * 10);
+            pointerIds.push_back(0);
+        }
+    }
+
+    int size() const { return static_cast<int>(xs.size()); }
+
+    std::vector<int> xs;
+    std::vector<int> ys;
+    std::vector<int> times;
+    std::vector<int> pointerIds;
+};
+
+void initInputParams(const TestKeyboard &keyboard, const GesturePoints &points,
+        const int inputSize, const bool isAppendedInput, ProximityInfoState *const state) {
+    int inputCodePoints[MAX_WORD_LENGTH];
+    std::fill(inputCodePoints, inputCodePoints + MAX_WORD_LENGTH, NOT_A_CODE_POINT);
+    state->initInputParams(0 /* pointerId */, MAX_POINT_TO_KEY_LENGTH,
+            keyboard.getProximityInfo(), inputCodePoints, inputSize, points.xs.data(),
+            points.ys.data(), points.times.data(), points.pointerIds.data(),
+            true /* isGeometric */, isAppendedInput);
+}
+
+// Feeds the points chunkSize by chunkSize the way DicTraverseSession does while the points of a
+// gesture are streamed to it.
+void streamPoints(const TestKeyboard &keyboard, const GesturePoints &points,
+        const int chunkSize, ProximityInfoState *const state) {
+    for (int inputSize = chunkSize; ; inputSize += chunkSize) {
+        inputSize = std::min(inputSize, points.size());
+        initInputParams(keyboard, points, inputSize, inputSize > chunkSize /* isAppendedInput */,
+                state);
+        if (inputSize == points.size()) {
+            return;
+        }
+    }
+}
+
+// Compares what is derived from the whole trail every time: the sampled points and the beeline
+// speed rates.
+void expectSameTrail(const ProximityInfoState &expected, const ProximityInfoState &actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (int i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected.getInputX(i), actual.getInputX(i)) << i;
+        EXPECT_EQ(expected.getInputY(i), actual.getInputY(i)) << i;
+        EXPECT_EQ(expected.getInputTime(i), actual.getInputTime(i)) << i;
+        EXPECT_EQ(expected.getInputIndexOfSampledPoint(i), actual.getInputIndexOfSampledPoint(i))
+                << i;
+        EXPECT_EQ(expected.getLengthCache(i), actual.getLengthCache(i)) << i;
+        EXPECT_EQ(expected.getBeelineSpeedPercentile(i), actual.getBeelineSpeedPercentile(i))
+                << i;
+        if (i < expected.size() - 1) {
+            // The direction is to the next point.
+            EXPECT_FLOAT_EQ(expected.getDirection(i), actual.getDirection(i)) << i;
+        }
+    }
+}
+
+// Compares what is computed once for each point when it is added: the speed rates and the
+// probabilities of aligning the points to the keys and skipping them.
+void expectSameAlignment(const ProximityInfoState &expected, const ProximityInfoState &actual,
+        const int keyCount) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (int i = 0; i < expected.size(); ++i) {
+        EXPECT_FLOAT_EQ(expected.getSpeedRate(i), actual.getSpeedRate(i)) << i;
+        for (int keyIndex = NOT_AN_INDEX; keyIndex < keyCount; ++keyIndex) {
+            EXPECT_FLOAT_EQ(expected.getProbability(i, keyIndex),
+                    actual.getProbability(i, keyIndex)) << i << " " << keyIndex;
+        }
+    }
+    int expectedMostProbableString[MAX_WORD_LENGTH];
+    int actualMostProbableString[MAX_WORD_LENGTH];
+    EXPECT_FLOAT_EQ(expected.getMostProbableString(expectedMostProbableString),
+            actual.getMostProbableString(actualMostProbableString));
+    EXPECT_EQ(0, memcmp(expectedMostProbableString, actualMostProbableString,
+            sizeof(expectedMostProbableString)));
+}
+
+TEST(ProximityInfoStateTest, TestStreamedInputIsSameAsCheckedContinuousInput) {
+    const TestKeyboard keyboard;
+    const GesturePoints points(keyboard, "quickly");
+    for (const int chunkSize : {1, 3, 7, 20}) {
+        SCOPED_TRACE(chunkSize);
+        ProximityInfoState streamedState;
+        streamPoints(keyboard, points, chunkSize, &streamedState);
+        EXPECT_TRUE(streamedState.isContinuousSuggestionPossible());
+        // The same points given without isAppendedInput go through the continuity check.
+        ProximityInfoState checkedState;
+        for (int inputSize = chunkSize; ; inputSize += chunkSize) {
+            inputSize = std::min(inputSize, points.size());
+            initInputParams(keyboard, points, inputSize, false /* isAppendedInput */,
+                    &checkedState);
+            if (inputSize == points.size()) {
+                break;
+            }
+        }
+        EXPECT_TRUE(checkedState.isContinuousSuggestionPossible());
+        expectSameTrail(checkedState, streamedState);
+        expectSameAlignment(checkedState, streamedState,
+                keyboard.getProximityInfo()->getKeyCount());
+    }
+}
+
+// As for any continuous input, the speed rates and the alignment probabilities of the points that
+// were already there keep the values computed with the average speed of the shorter input, so
+// only the trail is compared with the input given at once.
+TEST(ProximityInfoStateTest, TestStreamedInputIsSameAsOneShotInput) {
+    const TestKeyboard keyboard;
+    const GesturePoints points(keyboard, "quickly");
+    ProximityInfoState oneShotState;
+    initInputParams(keyboard, points, points.size(), false /* isAppendedInput */,
+            &oneShotState);
+    EXPECT_FALSE(oneShotState.isContinuousSuggestionPossible());
+    for (const int chunkSize : {1, 3, 7, 20}) {
+        SCOPED_TRACE(chunkSize);
+        ProximityInfoState streamedState;
+        streamPoints(keyboard, points, chunkSize, &streamedState);
+        expectSameTrail(oneShotState, streamedState);
+    }
+    // A single chunk is the same input.
+    ProximityInfoState streamedState;
+    streamPoints(keyboard, points, points.size(), &streamedState);
+    expectSameTrail(oneShotState, streamedState);
+    expectSameAlignment(oneShotState, streamedState, keyboard.getProximityInfo()->getKeyCount());
+}
+
+}  // namespace
+}  // namespace latinime
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/core/result/suggestion_results.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "utils/scoped_allocation_counter.h"
+#include "utils/suggestion_buffer.h"
+
+namespace latinime {
+namespace {
+
+void addSuggestion(SuggestionResults *const suggestionResults, const int codePointCount,
+        const int score) {
+    const std::vector<int> codePoints(codePointCount, 'a');
+    suggestionResults->addSuggestion(codePoints.data(), codePointCount, score, 0 /* type */,
+            NOT_AN_INDEX, NOT_A_FIRST_WORD_CONFIDENCE);
+}
+
+TEST(SuggestionResultsTest, TestTopSuggestions) {
+    SuggestionResults suggestionResults(3 /* maxSuggestionCount */);
+    addSuggestion(&suggestionResults, 2, 10);
+    addSuggestion(&suggestionResults, 2, 30);
+    addSuggestion(&suggestionResults, 2, 20);
+    EXPECT_EQ(3, suggestionResults.getSuggestionCount());
+    // Doesn't rank above the worst one.
+    addSuggestion(&suggestionResults, 2, 5);
+    addSuggestion(&suggestionResults, 2, 10);
+    addSuggestion(&suggestionResults, 3, 10);
+    // Replaces the worst one.
+    addSuggestion(&suggestionResults, 2, 25);
+    EXPECT_EQ(3, suggestionResults.getSuggestionCount());
+    int scores[3];
+    suggestionResults.getSortedScores(scores);
+    EXPECT_EQ(30, scores[0]);
+    EXPECT_EQ(25, scores[1]);
+    EXPECT_EQ(20, scores[2]);
+    // The shorter one ranks above among the same scores.
+    addSuggestion(&suggestionResults, 1, 20);
+    suggestionResults.getSortedScores(scores);
+    EXPECT_EQ(20, scores[2]);
+    // Invalid words are ignored.
+    addSuggestion(&suggestionResults, 0, 100);
+    addSuggestion(&suggestionResults, MAX_WORD_LENGTH + 1, 100);
+    suggestionResults.getSortedScores(scores);
+    EXPECT_EQ(30, scores[0]);
+}
+
+TEST(SuggestionResultsTest, TestNoAllocationInSteadyState) {
+    // The unit tests are built with FLAG_COUNT_ALLOCATIONS.
+    ASSERT_TRUE(ScopedAllocationCounter::isAvailable());
+    std::vector<std::vector<int>> words;
+    for (int i = 0; i < 100; ++i) {
+        words.push_back(std::vector<int>(1 + i % MAX_WORD_LENGTH, 'a' + i % 26));
+    }
+    std::vector<int> buffer(
+            SuggestionBuffer::INPUT_RECORD + SuggestionBuffer::INPUT_RECORD_HEADER_SIZE, 0);
+    SuggestionBuffer suggestionBuffer(buffer.data(), buffer.size());
+    SuggestionResults suggestionResults(MAX_RESULTS);
+    {
+        // The results are filled and output as getSuggestionsWithBuffer() does.
+        const ScopedAllocationCounter allocationCounter;
+        for (int i = 0; i < static_cast<int>(words.size()); ++i) {
+            if (i % 2 == 0) {
+                suggestionResults.addSuggestion(words[i].data(), words[i].size(),
+                        (i * 37) % 101, 0 /* type */, NOT_AN_INDEX, NOT_A_FIRST_WORD_CONFIDENCE);
+            } else {
+                suggestionResults.addPrediction(words[i].data(), words[i].size(),
+                        (i * 37) % 101);
+            }
+        }
+        suggestionResults.outputSuggestions(&suggestionBuffer);
+        EXPECT_EQ(0, allocationCounter.getAllocationCount());
+    }
+    // The counter sees the allocations of the scope.
+    {
+        const ScopedAllocationCounter allocationCounter;
+        const std::vector<int> codePoints(words[0]);
+        EXPECT_EQ(1, allocationCounter.getAllocationCount());
+        EXPECT_EQ(words[0], codePoints);
+    }
+    ASSERT_EQ(MAX_RESULTS, buffer[SuggestionBuffer::SUGGESTION_COUNT]);
+    for (int i = 1; i < MAX_RESULTS; ++i) {
+        EXPECT_LE(buffer[SuggestionBuffer::SCORES + i - 1], buffer[SuggestionBuffer::SCORES + i]);
+    }
+    // The best one comes last.
+    EXPECT_EQ(100, buffer[SuggestionBuffer::SCORES + MAX_RESULTS - 1]);
+    EXPECT_EQ(0, suggestionResults.getSuggestionCount());
+}
+
+}  // namespace
+}  // namespace latinime
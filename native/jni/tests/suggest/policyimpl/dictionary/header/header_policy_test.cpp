@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/policyimpl/dictionary/header/header_policy.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "suggest/policyimpl/dictionary/header/header_read_write_utils.h"
+#include "suggest/policyimpl/dictionary/utils/buffer_with_extendable_buffer.h"
+#include "suggest/policyimpl/dictionary/utils/format_utils.h"
+
+namespace latinime {
+namespace {
+
+typedef std::vector<std::pair<std::string, std::string>> Attributes;
+
+std::vector<int> toCodePoints(const std::string &str) {
+    return std::vector<int>(str.begin(), str.end());
+}
+
+// Writes a header with the attributes in the given order. Unlike the header writer, this can
+// write the same key more than once.
+std::vector<uint8_t> createHeader(const Attributes &attributes) {
+    BufferWithExtendableBuffer buffer(
+            BufferWithExtendableBuffer::DEFAULT_MAX_ADDITIONAL_BUFFER_SIZE);
+    int writingPos = 0;
+    EXPECT_TRUE(HeaderReadWriteUtils::writeDictionaryVersion(&buffer, FormatUtils::VERSION_4_DEV,
+            &writingPos));
+    EXPECT_TRUE(HeaderReadWriteUtils::writeDictionaryFlags(&buffer, 0 /* flags */,
+            &writingPos));
+    int headerSizeFieldPos = writingPos;
+    EXPECT_TRUE(HeaderReadWriteUtils::writeDictionaryHeaderSize(&buffer, 0 /* size */,
+            &writingPos));
+    for (const auto &attribute : attributes) {
+        const std::vector<int> key = toCodePoints(attribute.first);
+        const std::vector<int> value = toCodePoints(attribute.second);
+        EXPECT_TRUE(buffer.writeCodePointsAndAdvancePosition(key.data(), key.size(),
+                true /* writesTerminator */, &writingPos));
+        EXPECT_TRUE(buffer.writeCodePointsAndAdvancePosition(value.data(), value.size(),
+                true /* writesTerminator */, &writingPos));
+    }
+    const int headerSize = writingPos;
+    EXPECT_TRUE(HeaderReadWriteUtils::writeDictionaryHeaderSize(&buffer, headerSize,
+            &headerSizeFieldPos));
+    const uint8_t *const data = buffer.getBuffer(true /* usesAdditionalBuffer */);
+    return std::vector<uint8_t>(data, data + headerSize);
+}
+
+// Returns the value of the key in the materialized attribute map, or an empty string.
+std::string getValueInAttributeMap(const HeaderPolicy *const headerPolicy, const char *const key) {
+    const DictionaryHeaderStructurePolicy::AttributeMap *const attributeMap =
+            headerPolicy->getAttributeMap();
+    const auto it = attributeMap->find(toCodePoints(key));
+    return it == attributeMap->end() ? std::string() : std::string(it->second.begin(),
+            it->second.end());
+}
+
+TEST(HeaderPolicyTest, TestReadAttributes) {
+    const std::vector<uint8_t> header = createHeader({{"UNIGRAM_COUNT", "123"},
+            {"BIGRAM_COUNT", "45"}, {"USES_FORGETTING_CURVE", "1"},
+            {"HAS_HISTORICAL_INFO", "1"}, {"locale", "en_US"}});
+    const HeaderPolicy headerPolicy(header.data(), FormatUtils::VERSION_4_DEV);
+    EXPECT_EQ(static_cast<int>(header.size()), headerPolicy.getSize());
+    EXPECT_EQ(123, headerPolicy.getUnigramCount());
+    EXPECT_EQ(45, headerPolicy.getBigramCount());
+    EXPECT_TRUE(headerPolicy.isDecayingDict());
+    EXPECT_EQ(toCodePoints("en_US"), *headerPolicy.getLocale());
+    EXPECT_EQ(5u, headerPolicy.getAttributeMap()->size());
+    EXPECT_EQ("45", getValueInAttributeMap(&headerPolicy, "BIGRAM_COUNT"));
+}
+
+// The first occurrence of a duplicated key is used, both by the attribute view and by the
+// materialized attribute map.
+TEST(HeaderPolicyTest, TestDuplicatedKeys) {
+    Attributes attributes = {{"UNIGRAM_COUNT", "10"}, {"locale", "en_US"},
+            {"UNIGRAM_COUNT", "20"}, {"locale", "fr"}};
+    // Attributes beyond the indexed ones are found by scanning the header.
+    for (int i = 0; i < 40; ++i) {
+        attributes.emplace_back("KEY_" + std::to_string(i), std::to_string(i));
+    }
+    attributes.emplace_back("UNIGRAM_COUNT", "30");
+    attributes.emplace_back("BIGRAM_COUNT", "40");
+    attributes.emplace_back("BIGRAM_COUNT", "50");
+    const std::vector<uint8_t> header = createHeader(attributes);
+    const HeaderPolicy headerPolicy(header.data(), FormatUtils::VERSION_4_DEV);
+    EXPECT_EQ(10, headerPolicy.getUnigramCount());
+    EXPECT_EQ(40, headerPolicy.getBigramCount());
+    EXPECT_EQ(toCodePoints("en_US"), *headerPolicy.getLocale());
+    EXPECT_EQ("10", getValueInAttributeMap(&headerPolicy, "UNIGRAM_COUNT"));
+    EXPECT_EQ("40", getValueInAttributeMap(&headerPolicy, "BIGRAM_COUNT"));
+    EXPECT_EQ("en_US", getValueInAttributeMap(&headerPolicy, "locale"));
+    EXPECT_EQ("39", getValueInAttributeMap(&headerPolicy, "KEY_39"));
+    int value[8];
+    headerPolicy.readHeaderValueOrQuestionMark("BIGRAM_COUNT", value, NELEMS(value));
+    EXPECT_EQ('4', value[0]);
+    EXPECT_EQ('0', value[1]);
+    EXPECT_EQ(0, value[2]);
+}
+
+// A copy of a header policy doesn't refer to the dictionary buffer.
+TEST(HeaderPolicyTest, TestCopyOutlivesBuffer) {
+    std::unique_ptr<std::vector<uint8_t>> header(new std::vector<uint8_t>(
+            createHeader({{"UNIGRAM_COUNT", "123"}, {"locale", "en_US"}})));
+    std::unique_ptr<HeaderPolicy> headerPolicy(
+            new HeaderPolicy(header->data(), FormatUtils::VERSION_4_DEV));
+    const HeaderPolicy copiedHeaderPolicy(headerPolicy.get());
+    headerPolicy.reset();
+    header.reset();
+    EXPECT_EQ(123, copiedHeaderPolicy.getUnigramCount());
+    EXPECT_EQ("123", getValueInAttributeMap(&copiedHeaderPolicy, "UNIGRAM_COUNT"));
+    EXPECT_EQ(toCodePoints("en_US"), *copiedHeaderPolicy.getLocale());
+}
+
+} // namespace
+} // namespace latinime
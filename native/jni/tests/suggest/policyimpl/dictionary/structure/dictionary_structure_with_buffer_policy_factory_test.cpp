@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/policyimpl/dictionary/structure/dictionary_structure_with_buffer_policy_factory.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "suggest/policyimpl/dictionary/structure/v2/ver2_test_dict_builder.h"
+#include "suggest/policyimpl/dictionary/utils/file_utils.h"
+
+namespace latinime {
+namespace {
+
+const int WORD_COUNT = 500;
+
+std::string getWord(const int index) {
+    char word[16];
+    snprintf(word, NELEMS(word), "word%d", index);
+    return std::string(word);
+}
+
+std::set<std::string> iterateAllWords(DictionaryStructureWithBufferPolicy *const policy) {
+    std::set<std::string> words;
+    int codePoints[MAX_WORD_LENGTH];
+    int codePointCount = 0;
+    int token = 0;
+    do {
+        token = policy->getNextWordAndNextToken(token, codePoints, &codePointCount);
+        words.insert(std::string(codePoints, codePoints + codePointCount));
+    } while (token != 0);
+    return words;
+}
+
+class DictionaryStructureWithBufferPolicyFactoryTest : public ::testing::Test {
+ protected:
+    virtual void SetUp() {
+        snprintf(mFilePath, NELEMS(mFilePath), "/tmp/dict_policy_factory_test_XXXXXX");
+        const int fd = mkstemp(mFilePath);
+        ASSERT_LE(0, fd);
+        close(fd);
+        Ver2TestDictBuilder builder;
+        for (int i = 0; i < WORD_COUNT; ++i) {
+            builder.addWord(getWord(i).c_str(), 100 + i % 100);
+            mExpectedWords.insert(getWord(i));
+        }
+        ASSERT_TRUE(builder.writeToFile(mFilePath));
+    }
+
+    virtual void TearDown() {
+        unlink(mFilePath);
+    }
+
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr openPolicy() const {
+        return DictionaryStructureWithBufferPolicyFactory::newPolicyForExistingDictFile(
+                mFilePath, 0 /* bufOffset */, FileUtils::getFileSize(mFilePath),
+                false /* isUpdatable */);
+    }
+
+    char mFilePath[64];
+    std::set<std::string> mExpectedWords;
+};
+
+TEST_F(DictionaryStructureWithBufferPolicyFactoryTest, TestIterateSharedDictionary) {
+    const DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy = openPolicy();
+    ASSERT_NE(nullptr, policy);
+    EXPECT_EQ(mExpectedWords, iterateAllWords(policy.get()));
+    // Iterating again restarts from the first word.
+    EXPECT_EQ(mExpectedWords, iterateAllWords(policy.get()));
+}
+
+TEST_F(DictionaryStructureWithBufferPolicyFactoryTest, TestIterateSharedDictionaryConcurrently) {
+    const DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy0 = openPolicy();
+    const DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy1 = openPolicy();
+    ASSERT_NE(nullptr, policy0);
+    ASSERT_NE(nullptr, policy1);
+    const int ITERATION_COUNT = 20;
+    std::vector<std::set<std::string>> iteratedWords0;
+    std::vector<std::set<std::string>> iteratedWords1;
+    std::thread thread([&]() {
+        for (int i = 0; i < ITERATION_COUNT; ++i) {
+            iteratedWords0.push_back(iterateAllWords(policy0.get()));
+        }
+    });
+    for (int i = 0; i < ITERATION_COUNT; ++i) {
+        iteratedWords1.push_back(iterateAllWords(policy1.get()));
+    }
+    thread.join();
+    for (int i = 0; i < ITERATION_COUNT; ++i) {
+        EXPECT_EQ(mExpectedWords, iteratedWords0[i]);
+        EXPECT_EQ(mExpectedWords, iteratedWords1[i]);
+    }
+    EXPECT_FALSE(policy0->isCorrupted());
+    EXPECT_FALSE(policy1->isCorrupted());
+}
+
+TEST_F(DictionaryStructureWithBufferPolicyFactoryTest, TestSharedDictionaryOutlivesHandle) {
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy0 = openPolicy();
+    const DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy1 = openPolicy();
+    ASSERT_NE(nullptr, policy0);
+    ASSERT_NE(nullptr, policy1);
+    policy0.reset();
+    EXPECT_EQ(mExpectedWords, iterateAllWords(policy1.get()));
+}
+
+}  // namespace
+}  // namespace latinime
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/policyimpl/dictionary/structure/louds/louds_bigram_list_policy.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace latinime {
+namespace {
+
+TEST(LoudsBigramListPolicyTest, TestGetNextBigram) {
+    const std::vector<uint8_t> buffer = {
+        0x00 /* padding */,
+        0x80 | 0x0A, 0x00, 0x01, 0x02,
+        0x80 | 0x0F, 0x12, 0x34, 0x56,
+        0x03, 0x00, 0x00, 0x07,
+    };
+    const LoudsBigramListPolicy policy(buffer.data(), buffer.size());
+    int pos = 1;
+    int targetIndex = NOT_A_DICT_POS;
+    int probability = NOT_A_PROBABILITY;
+    bool hasNext = false;
+    policy.getNextBigram(&targetIndex, &probability, &hasNext, &pos);
+    EXPECT_EQ(0x0102, targetIndex);
+    EXPECT_EQ(10, probability);
+    EXPECT_TRUE(hasNext);
+    policy.getNextBigram(&targetIndex, &probability, &hasNext, &pos);
+    EXPECT_EQ(0x123456, targetIndex);
+    EXPECT_EQ(15, probability);
+    EXPECT_TRUE(hasNext);
+    policy.getNextBigram(&targetIndex, &probability, &hasNext, &pos);
+    EXPECT_EQ(7, targetIndex);
+    EXPECT_EQ(3, probability);
+    EXPECT_FALSE(hasNext);
+    EXPECT_EQ(static_cast<int>(buffer.size()), pos);
+
+    pos = 1;
+    EXPECT_TRUE(policy.skipAllBigrams(&pos));
+    EXPECT_EQ(static_cast<int>(buffer.size()), pos);
+}
+
+TEST(LoudsBigramListPolicyTest, TestTruncatedList) {
+    const std::vector<uint8_t> buffer = {
+        0x80 | 0x0A, 0x00, 0x00, 0x02,
+        0x80 | 0x0B, 0x00,
+    };
+    const LoudsBigramListPolicy policy(buffer.data(), buffer.size());
+    int pos = 0;
+    EXPECT_FALSE(policy.skipAllBigrams(&pos));
+    pos = 4;
+    int targetIndex = 0;
+    int probability = 0;
+    bool hasNext = true;
+    policy.getNextBigram(&targetIndex, &probability, &hasNext, &pos);
+    EXPECT_EQ(NOT_A_DICT_POS, targetIndex);
+    EXPECT_FALSE(hasNext);
+}
+
+}  // namespace
+}  // namespace latinime
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/policyimpl/dictionary/structure/pt_common/first_code_point_lookup_table.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace latinime {
+namespace {
+
+TEST(FirstCodePointLookupTableTest, TestLookUp) {
+    FirstCodePointLookupTable table;
+    table.addPtNodeArray(10 /* ptNodeArrayPos */, {'t', 'a', 'x', 0x3042, 'b'},
+            {11, 20, 31, 45, 52});
+    table.addPtNodeArray(100 /* ptNodeArrayPos */, {'o', 'e'}, {101, 110});
+    EXPECT_EQ(2, table.getPtNodeArrayCount());
+    int ptNodePos = NOT_A_DICT_POS;
+    EXPECT_TRUE(table.lookUpPtNodePos(10, 'a', &ptNodePos));
+    EXPECT_EQ(20, ptNodePos);
+    EXPECT_TRUE(table.lookUpPtNodePos(10, 't', &ptNodePos));
+    EXPECT_EQ(11, ptNodePos);
+    EXPECT_TRUE(table.lookUpPtNodePos(10, 0x3042, &ptNodePos));
+    EXPECT_EQ(45, ptNodePos);
+    EXPECT_TRUE(table.lookUpPtNodePos(10, 'o', &ptNodePos));
+    EXPECT_EQ(NOT_A_DICT_POS, ptNodePos);
+    EXPECT_TRUE(table.lookUpPtNodePos(100, 'o', &ptNodePos));
+    EXPECT_EQ(101, ptNodePos);
+    EXPECT_TRUE(table.lookUpPtNodePos(100, 'z', &ptNodePos));
+    EXPECT_EQ(NOT_A_DICT_POS, ptNodePos);
+    EXPECT_FALSE(table.lookUpPtNodePos(11, 'a', &ptNodePos));
+}
+
+TEST(FirstCodePointLookupTableTest, TestSameFirstCodePoint) {
+    FirstCodePointLookupTable table;
+    table.addPtNodeArray(0 /* ptNodeArrayPos */, {'c', 'b', 'c', 'a'}, {1, 5, 9, 13});
+    int ptNodePos = NOT_A_DICT_POS;
+    EXPECT_TRUE(table.lookUpPtNodePos(0, 'c', &ptNodePos));
+    // The first one in the PtNode array is found.
+    EXPECT_EQ(1, ptNodePos);
+}
+
+}  // namespace
+}  // namespace latinime
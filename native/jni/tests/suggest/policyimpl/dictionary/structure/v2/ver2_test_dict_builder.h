@@ -0,0 +1,299 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_VER2_TEST_DICT_BUILDER_H
+#define LATINIME_VER2_TEST_DICT_BUILDER_H
+
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "defines.h"
+#include "suggest/policyimpl/dictionary/structure/pt_common/patricia_trie_reading_utils.h"
+#include "suggest/policyimpl/dictionary/utils/byte_array_utils.h"
+#include "suggest/policyimpl/dictionary/utils/format_utils.h"
+
+namespace latinime {
+
+// Builds small version 2 dictionaries for tests, the way the dictionary compiler lays them out:
+// each PtNode array is followed by the arrays of its descendants and children are sorted by code
+// point. Addresses are always written on 3 bytes.
+class Ver2TestDictBuilder {
+ public:
+    Ver2TestDictBuilder() : mRoot(new Node()) {}
+
+    static std::vector<int> toCodePoints(const char *const word) {
+        std::vector<int> codePoints;
+        for (const char *c = word; *c != '\0'; ++c) {
+            codePoints.push_back(static_cast<unsigned char>(*c));
+        }
+        return codePoints;
+    }
+
+    void addWord(const std::vector<int> &word, const int probability,
+            const bool isNotAWord = false, const bool isBlacklisted = false) {
+        Node *const node = getOrCreateNode(word);
+        node->mIsTerminal = true;
+        node->mProbability = probability;
+        node->mIsNotAWord = isNotAWord;
+        node->mIsBlacklisted = isBlacklisted;
+    }
+
+    void addWord(const char *const word, const int probability) {
+        addWord(toCodePoints(word), probability);
+    }
+
+    // The probability is the 4 bit value stored in the shortcut flags.
+    void addShortcut(const char *const word, const char *const target, const int probability) {
+        getOrCreateNode(toCodePoints(word))->mShortcuts.emplace_back(toCodePoints(target),
+                probability);
+    }
+
+    // The probability is the 4 bit value stored in the bigram flags.
+    void addBigram(const char *const word0, const char *const word1, const int probability) {
+        getOrCreateNode(toCodePoints(word0))->mBigrams.emplace_back(toCodePoints(word1),
+                probability);
+    }
+
+    std::vector<uint8_t> build() const {
+        std::vector<uint8_t> dict = buildHeader();
+        const std::vector<uint8_t> body = buildBody();
+        dict.insert(dict.end(), body.begin(), body.end());
+        return dict;
+    }
+
+    bool writeToFile(const char *const filePath) const {
+        const std::vector<uint8_t> dict = build();
+        FILE *const file = fopen(filePath, "wb");
+        if (!file) {
+            return false;
+        }
+        const bool written = fwrite(dict.data(), dict.size(), 1 /* count */, file) == 1;
+        fclose(file);
+        return written;
+    }
+
+ private:
+    DISALLOW_COPY_AND_ASSIGN(Ver2TestDictBuilder);
+
+    static const int ADDRESS_SIZE = 3;
+
+    struct Node {
+        Node() : mCodePoints(), mIsTerminal(false), mProbability(NOT_A_PROBABILITY),
+                mIsNotAWord(false), mIsBlacklisted(false), mShortcuts(), mBigrams(),
+                mChildren(), mPos(NOT_A_DICT_POS), mChildrenPos(NOT_A_DICT_POS) {}
+
+        std::vector<int> mCodePoints;
+        bool mIsTerminal;
+        int mProbability;
+        bool mIsNotAWord;
+        bool mIsBlacklisted;
+        std::vector<std::pair<std::vector<int>, int>> mShortcuts;
+        std::vector<std::pair<std::vector<int>, int>> mBigrams;
+        std::map<int, std::unique_ptr<Node>> mChildren;
+        mutable int mPos;
+        mutable int mChildrenPos;
+    };
+
+    const std::unique_ptr<Node> mRoot;
+
+    Node *getOrCreateNode(const std::vector<int> &word) {
+        Node *node = mRoot.get();
+        for (const int codePoint : word) {
+            std::unique_ptr<Node> &child = node->mChildren[codePoint];
+            if (!child) {
+                child.reset(new Node());
+                child->mCodePoints.push_back(codePoint);
+            }
+            node = child.get();
+        }
+        return node;
+    }
+
+    // Returns the PtNode that represents the word after chains have been merged by
+    // getPtNodeArray().
+    const Node *findPtNode(const std::vector<int> &word) const {
+        const Node *node = mRoot.get();
+        for (const int codePoint : word) {
+            node = node->mChildren.at(codePoint).get();
+        }
+        return node;
+    }
+
+    // Follows the chain of single children that are not words, which are written as one PtNode
+    // with multiple code points.
+    static const Node *getLastNodeOfPtNode(const Node *node, std::vector<int> *const codePoints) {
+        codePoints->insert(codePoints->end(), node->mCodePoints.begin(), node->mCodePoints.end());
+        while (!node->mIsTerminal && node->mChildren.size() == 1) {
+            node = node->mChildren.begin()->second.get();
+            codePoints->insert(codePoints->end(), node->mCodePoints.begin(),
+                    node->mCodePoints.end());
+        }
+        return node;
+    }
+
+    static int getCodePointsSize(const std::vector<int> &codePoints) {
+        return ByteArrayUtils::calculateRequiredByteCountToStoreCodePoints(codePoints.data(),
+                codePoints.size(), codePoints.size() > 1 /* writesTerminator */);
+    }
+
+    static int getShortcutListSize(const Node *const node) {
+        int size = 2 /* list size field */;
+        for (const auto &shortcut : node->mShortcuts) {
+            size += 1 /* flags */ + ByteArrayUtils::calculateRequiredByteCountToStoreCodePoints(
+                    shortcut.first.data(), shortcut.first.size(), true /* writesTerminator */);
+        }
+        return size;
+    }
+
+    static int getPtNodeSize(const Node *const node, const std::vector<int> &codePoints) {
+        int size = 1 /* flags */ + getCodePointsSize(codePoints);
+        if (node->mIsTerminal) {
+            size += 1 /* probability */;
+        }
+        if (!node->mChildren.empty()) {
+            size += ADDRESS_SIZE;
+        }
+        if (!node->mShortcuts.empty()) {
+            size += getShortcutListSize(node);
+        }
+        size += node->mBigrams.size() * (1 /* flags */ + ADDRESS_SIZE);
+        return size;
+    }
+
+    static void appendUint(const int value, const int size, std::vector<uint8_t> *const buffer) {
+        for (int i = size - 1; i >= 0; --i) {
+            buffer->push_back(static_cast<uint8_t>((value >> (8 * i)) & 0xFF));
+        }
+    }
+
+    static void appendCodePoints(const std::vector<int> &codePoints, const bool writesTerminator,
+            std::vector<uint8_t> *const buffer) {
+        uint8_t bytes[MAX_WORD_LENGTH * 3 + 1];
+        int size = 0;
+        ByteArrayUtils::writeCodePointsAndAdvancePosition(bytes, codePoints.data(),
+                codePoints.size(), writesTerminator, &size);
+        buffer->insert(buffer->end(), bytes, bytes + size);
+    }
+
+    static void appendPtNodeArraySize(const int size, std::vector<uint8_t> *const buffer) {
+        if (size < 0x80) {
+            appendUint(size, 1, buffer);
+        } else {
+            appendUint(size | 0x8000, 2, buffer);
+        }
+    }
+
+    // HeaderReadWriteUtils doesn't write version 2 headers. This header has no attributes.
+    std::vector<uint8_t> buildHeader() const {
+        std::vector<uint8_t> header;
+        appendUint(FormatUtils::MAGIC_NUMBER, 4, &header);
+        appendUint(FormatUtils::VERSION_2, 2, &header);
+        appendUint(0 /* flags */, 2, &header);
+        appendUint(12 /* header size */, 4, &header);
+        return header;
+    }
+
+    // Returns the PtNodes of the PtNode array that has the children of the given node, with
+    // their code points.
+    static std::vector<std::pair<const Node *, std::vector<int>>> getPtNodeArray(
+            const Node *const parent) {
+        std::vector<std::pair<const Node *, std::vector<int>>> ptNodes;
+        for (const auto &child : parent->mChildren) {
+            std::vector<int> codePoints;
+            const Node *const lastNode = getLastNodeOfPtNode(child.second.get(), &codePoints);
+            ptNodes.emplace_back(lastNode, codePoints);
+        }
+        return ptNodes;
+    }
+
+    // Assigns positions to the PtNode array that has the children of the given node, followed by
+    // the PtNode arrays of their descendants.
+    static void layOutPtNodeArrays(const Node *const parent, int *const pos,
+            std::vector<std::vector<std::pair<const Node *, std::vector<int>>>> *const
+                    ptNodeArrays) {
+        ptNodeArrays->push_back(getPtNodeArray(parent));
+        const std::vector<std::pair<const Node *, std::vector<int>>> &ptNodeArray =
+                ptNodeArrays->back();
+        parent->mChildrenPos = *pos;
+        *pos += (ptNodeArray.size() < 0x80) ? 1 : 2;
+        std::vector<const Node *> parents;
+        for (const auto &ptNode : ptNodeArray) {
+            ptNode.first->mPos = *pos;
+            *pos += getPtNodeSize(ptNode.first, ptNode.second);
+            if (!ptNode.first->mChildren.empty()) {
+                parents.push_back(ptNode.first);
+            }
+        }
+        for (const Node *const node : parents) {
+            layOutPtNodeArrays(node, pos, ptNodeArrays);
+        }
+    }
+
+    std::vector<uint8_t> buildBody() const {
+        // The reverse lookup of version 2 dictionaries relies on the children of a PtNode being
+        // placed before the children of its next siblings.
+        std::vector<std::vector<std::pair<const Node *, std::vector<int>>>> ptNodeArrays;
+        int pos = 0;
+        layOutPtNodeArrays(mRoot.get(), &pos, &ptNodeArrays);
+        std::vector<uint8_t> body;
+        for (const auto &ptNodeArray : ptNodeArrays) {
+            appendPtNodeArraySize(ptNodeArray.size(), &body);
+            for (const auto &ptNode : ptNodeArray) {
+                appendPtNode(ptNode.first, ptNode.second, &body);
+            }
+        }
+        return body;
+    }
+
+    void appendPtNode(const Node *const node, const std::vector<int> &codePoints,
+            std::vector<uint8_t> *const buffer) const {
+        buffer->push_back(PatriciaTrieReadingUtils::createAndGetFlags(node->mIsBlacklisted,
+                node->mIsNotAWord, node->mIsTerminal, !node->mShortcuts.empty(),
+                !node->mBigrams.empty(), codePoints.size() > 1,
+                node->mChildren.empty() ? 0 : ADDRESS_SIZE));
+        appendCodePoints(codePoints, codePoints.size() > 1 /* writesTerminator */, buffer);
+        if (node->mIsTerminal) {
+            appendUint(node->mProbability, 1, buffer);
+        }
+        if (!node->mChildren.empty()) {
+            // The children position is relative to the position of the field.
+            appendUint(node->mChildrenPos - static_cast<int>(buffer->size()), ADDRESS_SIZE,
+                    buffer);
+        }
+        if (!node->mShortcuts.empty()) {
+            appendUint(getShortcutListSize(node), 2, buffer);
+            for (size_t i = 0; i < node->mShortcuts.size(); ++i) {
+                const bool hasNext = i + 1 < node->mShortcuts.size();
+                buffer->push_back((hasNext ? 0x80 : 0) | node->mShortcuts[i].second);
+                appendCodePoints(node->mShortcuts[i].first, true /* writesTerminator */, buffer);
+            }
+        }
+        for (size_t i = 0; i < node->mBigrams.size(); ++i) {
+            const bool hasNext = i + 1 < node->mBigrams.size();
+            const int targetPos = findPtNode(node->mBigrams[i].first)->mPos;
+            // The offset is relative to the position of the address field.
+            const int offset = targetPos - (static_cast<int>(buffer->size()) + 1 /* flags */);
+            buffer->push_back((hasNext ? 0x80 : 0) | (offset < 0 ? 0x40 : 0)
+                    | 0x30 /* 3 byte address */ | node->mBigrams[i].second);
+            appendUint(offset < 0 ? -offset : offset, ADDRESS_SIZE, buffer);
+        }
+    }
+};
+} // namespace latinime
+#endif // LATINIME_VER2_TEST_DICT_BUILDER_H
@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/policyimpl/dictionary/structure/v4/ver4_dict_buffers.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "suggest/policyimpl/dictionary/structure/backward/v402/ver4_dict_constants.h"
+#include "suggest/policyimpl/dictionary/structure/dictionary_structure_with_buffer_policy_factory.h"
+#include "suggest/policyimpl/dictionary/structure/v4/ver4_dict_constants.h"
+#include "suggest/policyimpl/dictionary/structure/v4/ver4_test_dict_utils.h"
+#include "suggest/policyimpl/dictionary/utils/file_utils.h"
+#include "suggest/policyimpl/dictionary/utils/format_utils.h"
+
+namespace latinime {
+namespace {
+
+const char *const DICT_NAME = "test_dict";
+
+class Ver4DictBuffersTest : public ::testing::Test {
+ protected:
+    virtual void SetUp() {
+        snprintf(mTmpDirPath, NELEMS(mTmpDirPath), "/tmp/ver4_dict_buffers_test_XXXXXX");
+        ASSERT_NE(nullptr, mkdtemp(mTmpDirPath));
+        mDictDirPath = std::string(mTmpDirPath) + "/" + DICT_NAME;
+    }
+
+    virtual void TearDown() {
+        FileUtils::removeDirAndFiles(mTmpDirPath);
+    }
+
+    void writeDict(const int formatVersion) const {
+        DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy =
+                Ver4TestDictUtils::newOnMemoryDict(formatVersion);
+        ASSERT_NE(nullptr, policy);
+        ASSERT_TRUE(Ver4TestDictUtils::addWord(policy.get(), "apple", 100, "pie", 10));
+        ASSERT_TRUE(Ver4TestDictUtils::addWord(policy.get(), "banana", 120));
+        ASSERT_TRUE(Ver4TestDictUtils::addWord(policy.get(), "cherry", 80));
+        ASSERT_TRUE(Ver4TestDictUtils::addBigram(policy.get(), "apple", "banana", 150));
+        ASSERT_TRUE(policy->flush(mDictDirPath.c_str()));
+    }
+
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr openDict() const {
+        return DictionaryStructureWithBufferPolicyFactory::newPolicyForExistingDictFile(
+                mDictDirPath.c_str(), 0 /* bufOffset */, 0 /* size */, false /* isUpdatable */);
+    }
+
+    // Writes a terminal PtNode position that is out of the trie in place of the first entry.
+    void breakTerminalPositionLookupTable(const char *const fileExtension, const int entryPos,
+            const int addressSize) const {
+        const std::string filePath = mDictDirPath + "/" + DICT_NAME + fileExtension;
+        FILE *const file = fopen(filePath.c_str(), "r+b");
+        ASSERT_NE(nullptr, file);
+        ASSERT_EQ(0, fseek(file, entryPos, SEEK_SET));
+        for (int i = 0; i < addressSize; ++i) {
+            fputc(0x7F, file);
+        }
+        fclose(file);
+    }
+
+    // Replaces the first occurrence of the bytes in the body file.
+    void replaceInBody(const char *const bytes, const char *const replacement) const {
+        const std::string bodyFilePath =
+                mDictDirPath + "/" + DICT_NAME + Ver4DictConstants::BODY_FILE_EXTENSION;
+        FILE *const file = fopen(bodyFilePath.c_str(), "r+b");
+        ASSERT_NE(nullptr, file);
+        std::vector<char> body(FileUtils::getFileSize(bodyFilePath.c_str()));
+        ASSERT_EQ(1u, fread(body.data(), body.size(), 1 /* count */, file));
+        const std::string bodyString(body.begin(), body.end());
+        const size_t pos = bodyString.find(bytes);
+        ASSERT_NE(std::string::npos, pos);
+        ASSERT_EQ(0, fseek(file, pos, SEEK_SET));
+        fputs(replacement, file);
+        fclose(file);
+    }
+
+    static std::string readHeaderValue(const DictionaryStructureWithBufferPolicy *const policy,
+            const char *const key) {
+        int value[32];
+        policy->getHeaderStructurePolicy()->readHeaderValueOrQuestionMark(key, value,
+                NELEMS(value));
+        std::string valueString;
+        for (int i = 0; value[i] != 0; ++i) {
+            valueString += static_cast<char>(value[i]);
+        }
+        return valueString;
+    }
+
+    static int readUint32(const std::string &filePath, const int pos) {
+        FILE *const file = fopen(filePath.c_str(), "rb");
+        if (!file || fseek(file, pos, SEEK_SET) != 0) {
+            return -1;
+        }
+        int value = 0;
+        for (int i = 0; i < 4; ++i) {
+            value = (value << 8) | fgetc(file);
+        }
+        fclose(file);
+        return value;
+    }
+
+    char mTmpDirPath[64];
+    std::string mDictDirPath;
+};
+
+TEST_F(Ver4DictBuffersTest, TestOpenDict) {
+    writeDict(FormatUtils::VERSION_4_DEV);
+    const DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy = openDict();
+    ASSERT_NE(nullptr, policy);
+    EXPECT_NE(NOT_A_DICT_POS, Ver4TestDictUtils::getTerminalPtNodePos(policy.get(), "apple"));
+    EXPECT_NE(NOT_A_DICT_POS, Ver4TestDictUtils::getTerminalPtNodePos(policy.get(), "cherry"));
+}
+
+TEST_F(Ver4DictBuffersTest, TestOpenTimings) {
+    writeDict(FormatUtils::VERSION_4_DEV);
+    const DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy = openDict();
+    ASSERT_NE(nullptr, policy);
+    const char *const query = "OPEN_TIMINGS";
+    char result[256];
+    policy->getProperty(query, strlen(query), result, NELEMS(result));
+    EXPECT_EQ(0, strncmp("body:", result, strlen("body:")));
+    EXPECT_NE(nullptr, strstr(result, " trie:"));
+    EXPECT_NE(nullptr, strstr(result, " bodyChecksum:"));
+}
+
+// The body of a flushed dictionary is verified with the checksum in the header, which catches
+// changes that are valid in structure.
+TEST_F(Ver4DictBuffersTest, TestOpenDictWithBrokenBodyChecksum) {
+    writeDict(FormatUtils::VERSION_4_DEV);
+    {
+        const DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy = openDict();
+        ASSERT_NE(nullptr, policy);
+        EXPECT_NE("?", readHeaderValue(policy.get(), "BODY_CHECKSUM"));
+    }
+    replaceInBody("herry", "herrz");
+    EXPECT_EQ(nullptr, openDict());
+}
+
+TEST_F(Ver4DictBuffersTest, TestBodyChecksumAfterGC) {
+    writeDict(FormatUtils::VERSION_4_DEV);
+    {
+        const DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy =
+                DictionaryStructureWithBufferPolicyFactory::newPolicyForExistingDictFile(
+                        mDictDirPath.c_str(), 0 /* bufOffset */, 0 /* size */,
+                        true /* isUpdatable */);
+        ASSERT_NE(nullptr, policy);
+        ASSERT_TRUE(Ver4TestDictUtils::addWord(policy.get(), "durian", 90));
+        ASSERT_TRUE(policy->flushWithGC(mDictDirPath.c_str()));
+    }
+    const DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy = openDict();
+    ASSERT_NE(nullptr, policy);
+    EXPECT_NE(NOT_A_DICT_POS, Ver4TestDictUtils::getTerminalPtNodePos(policy.get(), "durian"));
+    EXPECT_NE("?", readHeaderValue(policy.get(), "BODY_CHECKSUM"));
+    replaceInBody("urian", "urial");
+    EXPECT_EQ(nullptr, openDict());
+}
+
+TEST_F(Ver4DictBuffersTest, TestOpenDictWithBrokenTerminalPositionLookupTable) {
+    writeDict(FormatUtils::VERSION_4_DEV);
+    // The body file starts with the size of the trie followed by the trie, and then the size of
+    // the terminal position lookup table followed by the table.
+    const std::string bodyFilePath =
+            mDictDirPath + "/" + DICT_NAME + Ver4DictConstants::BODY_FILE_EXTENSION;
+    const int trieSize = readUint32(bodyFilePath, 0 /* pos */);
+    ASSERT_LT(0, trieSize);
+    breakTerminalPositionLookupTable(Ver4DictConstants::BODY_FILE_EXTENSION,
+            4 /* trie size */ + trieSize + 4 /* table size */,
+            Ver4DictConstants::TERMINAL_ADDRESS_TABLE_ADDRESS_SIZE);
+    EXPECT_EQ(nullptr, openDict());
+}
+
+TEST_F(Ver4DictBuffersTest, TestOpenDictWithTruncatedBody) {
+    writeDict(FormatUtils::VERSION_4_DEV);
+    const std::string bodyFilePath =
+            mDictDirPath + "/" + DICT_NAME + Ver4DictConstants::BODY_FILE_EXTENSION;
+    ASSERT_EQ(0, truncate(bodyFilePath.c_str(),
+            FileUtils::getFileSize(bodyFilePath.c_str()) - 1));
+    EXPECT_EQ(nullptr, openDict());
+}
+
+TEST_F(Ver4DictBuffersTest, TestOpenV402Dict) {
+    writeDict(FormatUtils::VERSION_4);
+    const DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy = openDict();
+    ASSERT_NE(nullptr, policy);
+    EXPECT_NE(NOT_A_DICT_POS, Ver4TestDictUtils::getTerminalPtNodePos(policy.get(), "apple"));
+    EXPECT_NE(NOT_A_DICT_POS, Ver4TestDictUtils::getTerminalPtNodePos(policy.get(), "cherry"));
+}
+
+TEST_F(Ver4DictBuffersTest, TestOpenV402DictWithBrokenTerminalPositionLookupTable) {
+    writeDict(FormatUtils::VERSION_4);
+    breakTerminalPositionLookupTable(
+            backward::v402::Ver4DictConstants::TERMINAL_ADDRESS_TABLE_FILE_EXTENSION,
+            0 /* entryPos */,
+            backward::v402::Ver4DictConstants::TERMINAL_ADDRESS_TABLE_ADDRESS_SIZE);
+    EXPECT_EQ(nullptr, openDict());
+}
+
+}  // namespace
+}  // namespace latinime
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/policyimpl/dictionary/structure/v4/ver4_patricia_trie_policy.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "suggest/core/dicnode/dic_node.h"
+#include "suggest/core/dicnode/dic_node_utils.h"
+#include "suggest/core/dicnode/dic_node_vector.h"
+#include "suggest/policyimpl/dictionary/structure/v4/ver4_test_dict_utils.h"
+#include "suggest/policyimpl/dictionary/utils/format_utils.h"
+
+namespace latinime {
+namespace {
+
+const int WORD_COUNT = 1000;
+
+typedef std::vector<std::pair<std::vector<int>, int>> WordsWithProbabilities;
+
+// Digits of the index in base 26, least significant first.
+std::string getWord(const int index) {
+    std::string word;
+    int remaining = index;
+    do {
+        word += static_cast<char>('a' + remaining % 26);
+        remaining /= 26;
+    } while (remaining > 0);
+    return word;
+}
+
+// Walks the trie with DicNodes as the search does and returns the terminals and their
+// probabilities. When isLazy is true, the children are created with
+// getAllChildDicNodesWithoutProbabilities(), which leaves the probabilities of terminals unread.
+WordsWithProbabilities getWordsWithDicNodes(
+        const DictionaryStructureWithBufferPolicy *const policy, const bool isLazy) {
+    WordsWithProbabilities words;
+    int prevWordsPtNodePos[MAX_PREV_WORD_COUNT_FOR_N_GRAM];
+    std::fill(prevWordsPtNodePos, prevWordsPtNodePos + NELEMS(prevWordsPtNodePos),
+            NOT_A_DICT_POS);
+    std::vector<DicNode> current(1 /* size */);
+    DicNodeUtils::initAsRoot(policy, prevWordsPtNodePos, &current.front());
+    while (!current.empty()) {
+        std::vector<DicNode> next;
+        for (const DicNode &dicNode : current) {
+            DicNodeVector childDicNodes;
+            if (isLazy) {
+                DicNodeUtils::getAllChildDicNodesWithoutProbabilities(&dicNode, policy,
+                        &childDicNodes);
+            } else {
+                DicNodeUtils::getAllChildDicNodes(&dicNode, policy, &childDicNodes);
+            }
+            const int childCount = childDicNodes.getSizeAndLock();
+            for (int i = 0; i < childCount; ++i) {
+                DicNode *const childDicNode = childDicNodes[i];
+                if (childDicNode->isTerminalDicNode()) {
+                    EXPECT_EQ(isLazy, childDicNode->needsToReadProbability());
+                    // The accessor reads an unread probability by itself.
+                    const int probability = childDicNode->getProbability(policy);
+                    DicNodeUtils::readProbabilityIfNeeded(policy, childDicNode);
+                    EXPECT_FALSE(childDicNode->needsToReadProbability());
+                    EXPECT_EQ(probability, childDicNode->getProbability(policy));
+                    const int *const codePoints = childDicNode->getOutputWordBuf();
+                    words.emplace_back(std::vector<int>(codePoints,
+                            codePoints + childDicNode->getNodeCodePointCount()),
+                            childDicNode->getProbability(policy));
+                }
+                next.push_back(*childDicNode);
+            }
+        }
+        current.swap(next);
+    }
+    std::sort(words.begin(), words.end());
+    return words;
+}
+
+class Ver4PatriciaTriePolicyTest : public ::testing::Test {
+ protected:
+    virtual void SetUp() {
+        mPolicy = Ver4TestDictUtils::newOnMemoryDict(FormatUtils::VERSION_4_DEV);
+        ASSERT_NE(nullptr, mPolicy);
+        // Longer words are added before their prefixes to split PtNodes.
+        for (int i = WORD_COUNT - 1; i >= 0; --i) {
+            ASSERT_TRUE(Ver4TestDictUtils::addWord(mPolicy.get(), getWord(i).c_str(),
+                    1 + (i * 37) % 250));
+        }
+        for (int i = 0; i < WORD_COUNT; i += 7) {
+            ASSERT_TRUE(Ver4TestDictUtils::removeWord(mPolicy.get(), getWord(i).c_str()));
+        }
+    }
+
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr mPolicy;
+};
+
+TEST_F(Ver4PatriciaTriePolicyTest, TestLazyProbabilityReadsMatchEagerReads) {
+    const WordsWithProbabilities words = getWordsWithDicNodes(mPolicy.get(),
+            false /* isLazy */);
+    EXPECT_EQ(static_cast<size_t>(WORD_COUNT - (WORD_COUNT + 6) / 7), words.size());
+    EXPECT_EQ(words, getWordsWithDicNodes(mPolicy.get(), true /* isLazy */));
+}
+
+} // namespace
+} // namespace latinime
@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/policyimpl/dictionary/structure/v4/ver4_patricia_trie_writing_helper.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <tuple>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+#include "suggest/core/dictionary/property/word_property.h"
+#include "suggest/policyimpl/dictionary/structure/dictionary_structure_with_buffer_policy_factory.h"
+#include "suggest/policyimpl/dictionary/structure/v4/ver4_test_dict_utils.h"
+#include "suggest/policyimpl/dictionary/utils/file_utils.h"
+#include "suggest/policyimpl/dictionary/utils/format_utils.h"
+
+namespace latinime {
+namespace {
+
+const char *const DICT_NAME = "test_dict";
+// Large enough for the trie to span several blocks of the blocked layout used by GC.
+const int WORD_COUNT = 2000;
+
+typedef std::vector<std::pair<std::vector<int>, int>> TargetsWithProbabilities;
+// Unigram probability, shortcuts and bigrams of a word.
+typedef std::tuple<int, TargetsWithProbabilities, TargetsWithProbabilities> WordContent;
+typedef std::map<std::vector<int>, WordContent> DictContent;
+
+// Digits of the index in base 26, least significant first. Consecutive indices have different
+// first letters, so children are added to PtNode arrays that have already been written, and
+// the arrays get forward linked.
+std::string getWord(const int index) {
+    std::string word;
+    int remaining = index;
+    do {
+        word += static_cast<char>('a' + remaining % 26);
+        remaining /= 26;
+    } while (remaining > 0);
+    return word;
+}
+
+// Removing unigrams is supported only by the latest format.
+bool isRemoved(const int formatVersion, const int index) {
+    return formatVersion == FormatUtils::VERSION_4_DEV && index % 7 == 3;
+}
+
+bool hasBigram(const int formatVersion, const int index) {
+    const int targetIndex = (index * 31) % WORD_COUNT;
+    return index % 10 == 0 && !isRemoved(formatVersion, index)
+            && !isRemoved(formatVersion, targetIndex);
+}
+
+DictContent getDictContent(DictionaryStructureWithBufferPolicy *const policy) {
+    DictContent content;
+    int codePoints[MAX_WORD_LENGTH];
+    int codePointCount = 0;
+    int token = 0;
+    do {
+        token = policy->getNextWordAndNextToken(token, codePoints, &codePointCount);
+        if (codePointCount <= 0) {
+            continue;
+        }
+        const WordProperty wordProperty = policy->getWordProperty(codePoints, codePointCount);
+        TargetsWithProbabilities shortcuts;
+        for (const auto &shortcut : wordProperty.getUnigramProperty()->getShortcuts()) {
+            shortcuts.emplace_back(*shortcut.getTargetCodePoints(), shortcut.getProbability());
+        }
+        std::sort(shortcuts.begin(), shortcuts.end());
+        TargetsWithProbabilities bigrams;
+        for (const auto &bigram : *wordProperty.getBigramProperties()) {
+            bigrams.emplace_back(*bigram.getTargetCodePoints(), bigram.getProbability());
+        }
+        std::sort(bigrams.begin(), bigrams.end());
+        content[std::vector<int>(codePoints, codePoints + codePointCount)] =
+                std::make_tuple(wordProperty.getUnigramProperty()->getProbability(), shortcuts,
+                        bigrams);
+    } while (token != 0);
+    return content;
+}
+
+int getAnonymousSize(DictionaryStructureWithBufferPolicy *const policy) {
+    const char *const query = "ANONYMOUS_SIZE";
+    char result[32];
+    policy->getProperty(query, strlen(query), result, NELEMS(result));
+    return atoi(result);
+}
+
+// The parameter is the format version of the dictionary.
+class Ver4PatriciaTrieWritingHelperTest : public ::testing::TestWithParam<int> {
+ protected:
+    virtual void SetUp() {
+        snprintf(mTmpDirPath, NELEMS(mTmpDirPath), "/tmp/ver4_writing_helper_test_XXXXXX");
+        ASSERT_NE(nullptr, mkdtemp(mTmpDirPath));
+        mDictDirPath = std::string(mTmpDirPath) + "/" + DICT_NAME;
+    }
+
+    virtual void TearDown() {
+        FileUtils::removeDirAndFiles(mTmpDirPath);
+    }
+
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr openDict() const {
+        return DictionaryStructureWithBufferPolicyFactory::newPolicyForExistingDictFile(
+                mDictDirPath.c_str(), 0 /* bufOffset */, 0 /* size */, true /* isUpdatable */);
+    }
+
+    char mTmpDirPath[64];
+    std::string mDictDirPath;
+};
+
+TEST_P(Ver4PatriciaTrieWritingHelperTest, TestGCKeepsDictContent) {
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy =
+            Ver4TestDictUtils::newOnMemoryDict(GetParam());
+    ASSERT_NE(nullptr, policy);
+    // Longer words are added before their prefixes to split PtNodes.
+    for (int i = WORD_COUNT - 1; i >= 0; --i) {
+        const std::string word = getWord(i);
+        if (i % 13 == 0) {
+            const std::string shortcutTarget = word + "z";
+            ASSERT_TRUE(Ver4TestDictUtils::addWord(policy.get(), word.c_str(),
+                    1 + (i * 37) % 250, shortcutTarget.c_str(), 1 + i % 14));
+        } else {
+            ASSERT_TRUE(Ver4TestDictUtils::addWord(policy.get(), word.c_str(),
+                    1 + (i * 37) % 250));
+        }
+    }
+    for (int i = 0; i < WORD_COUNT; ++i) {
+        if (hasBigram(GetParam(), i)) {
+            ASSERT_TRUE(Ver4TestDictUtils::addBigram(policy.get(), getWord(i).c_str(),
+                    getWord((i * 31) % WORD_COUNT).c_str(), 1 + i % 200));
+        }
+        if (i % 5 == 1) {
+            // Updates the probability.
+            ASSERT_TRUE(Ver4TestDictUtils::addWord(policy.get(), getWord(i).c_str(),
+                    1 + (i * 53) % 250));
+        }
+    }
+    for (int i = 0; i < WORD_COUNT; ++i) {
+        if (isRemoved(GetParam(), i)) {
+            ASSERT_TRUE(Ver4TestDictUtils::removeWord(policy.get(), getWord(i).c_str()));
+        }
+    }
+    const DictContent expectedContent = getDictContent(policy.get());
+    int removedWordCount = 0;
+    for (int i = 0; i < WORD_COUNT; ++i) {
+        const bool isInDict =
+                expectedContent.count(Ver4TestDictUtils::toCodePoints(getWord(i).c_str())) > 0;
+        EXPECT_EQ(!isRemoved(GetParam(), i), isInDict) << getWord(i);
+        if (isRemoved(GetParam(), i)) {
+            ++removedWordCount;
+        }
+    }
+    EXPECT_EQ(static_cast<size_t>(WORD_COUNT - removedWordCount), expectedContent.size());
+
+    ASSERT_TRUE(policy->flushWithGC(mDictDirPath.c_str()));
+    DictionaryStructureWithBufferPolicy::StructurePolicyPtr gcedPolicy = openDict();
+    ASSERT_NE(nullptr, gcedPolicy);
+    EXPECT_EQ(expectedContent, getDictContent(gcedPolicy.get()));
+    for (int i = 0; i < WORD_COUNT; ++i) {
+        if (isRemoved(GetParam(), i)) {
+            EXPECT_EQ(NOT_A_DICT_POS,
+                    Ver4TestDictUtils::getTerminalPtNodePos(gcedPolicy.get(), getWord(i).c_str()))
+                    << getWord(i);
+        }
+    }
+
+    // Running GC on the dictionary written by GC doesn't change the content either.
+    ASSERT_TRUE(gcedPolicy->flushWithGC(mDictDirPath.c_str()));
+    if (GetParam() == FormatUtils::VERSION_4_DEV) {
+        // GC writes the mapped files in place through the shadow file. Only the latest format
+        // reports the anonymous size.
+        EXPECT_EQ(0, getAnonymousSize(gcedPolicy.get()));
+    }
+    gcedPolicy = openDict();
+    ASSERT_NE(nullptr, gcedPolicy);
+    EXPECT_EQ(expectedContent, getDictContent(gcedPolicy.get()));
+}
+
+INSTANTIATE_TEST_CASE_P(Ver4PatriciaTrieWritingHelperTests, Ver4PatriciaTrieWritingHelperTest,
+        ::testing::Values(FormatUtils::VERSION_4, FormatUtils::VERSION_4_DEV));
+
+} // namespace
+} // namespace latinime
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATINIME_VER4_TEST_DICT_UTILS_H
+#define LATINIME_VER4_TEST_DICT_UTILS_H
+
+#include <vector>
+
+#include "defines.h"
+#include "suggest/core/dictionary/property/bigram_property.h"
+#include "suggest/core/dictionary/property/unigram_property.h"
+#include "suggest/core/policy/dictionary_header_structure_policy.h"
+#include "suggest/core/policy/dictionary_structure_with_buffer_policy.h"
+#include "suggest/core/session/prev_words_info.h"
+#include "suggest/policyimpl/dictionary/structure/dictionary_structure_with_buffer_policy_factory.h"
+
+namespace latinime {
+
+// Creates and fills on-memory version 4 dictionaries for tests, the way BinaryDictionary does
+// through JNI.
+class Ver4TestDictUtils {
+ public:
+    static DictionaryStructureWithBufferPolicy::StructurePolicyPtr newOnMemoryDict(
+            const int formatVersion) {
+        const std::vector<int> locale = toCodePoints("en");
+        const DictionaryHeaderStructurePolicy::AttributeMap attributeMap;
+        return DictionaryStructureWithBufferPolicyFactory::newPolicyForOnMemoryDict(
+                formatVersion, locale, &attributeMap);
+    }
+
+    static std::vector<int> toCodePoints(const char *const word) {
+        std::vector<int> codePoints;
+        for (const char *c = word; *c != '\0'; ++c) {
+            codePoints.push_back(static_cast<unsigned char>(*c));
+        }
+        return codePoints;
+    }
+
+    static bool addWord(DictionaryStructureWithBufferPolicy *const policy, const char *const word,
+            const int probability, const char *const shortcutTarget = nullptr,
+            const int shortcutProbability = NOT_A_PROBABILITY) {
+        std::vector<UnigramProperty::ShortcutProperty> shortcuts;
+        if (shortcutTarget) {
+            const std::vector<int> target = toCodePoints(shortcutTarget);
+            shortcuts.emplace_back(&target, shortcutProbability);
+        }
+        const UnigramProperty unigramProperty(false /* representsBeginningOfSentence */,
+                false /* isNotAWord */, false /* isBlacklisted */, probability,
+                NOT_A_TIMESTAMP, 0 /* level */, 0 /* count */, &shortcuts);
+        const std::vector<int> codePoints = toCodePoints(word);
+        return policy->addUnigramEntry(codePoints.data(), codePoints.size(), &unigramProperty);
+    }
+
+    static bool removeWord(DictionaryStructureWithBufferPolicy *const policy,
+            const char *const word) {
+        const std::vector<int> codePoints = toCodePoints(word);
+        return policy->removeUnigramEntry(codePoints.data(), codePoints.size());
+    }
+
+    static bool addBigram(DictionaryStructureWithBufferPolicy *const policy,
+            const char *const word0, const char *const word1, const int probability) {
+        const std::vector<int> prevWord = toCodePoints(word0);
+        const PrevWordsInfo prevWordsInfo(prevWord.data(), prevWord.size(),
+                false /* isBeginningOfSentence */);
+        const std::vector<int> target = toCodePoints(word1);
+        const BigramProperty bigramProperty(&target, probability, NOT_A_TIMESTAMP,
+                0 /* level */, 0 /* count */);
+        return policy->addNgramEntry(&prevWordsInfo, &bigramProperty);
+    }
+
+    static int getTerminalPtNodePos(const DictionaryStructureWithBufferPolicy *const policy,
+            const char *const word) {
+        const std::vector<int> codePoints = toCodePoints(word);
+        return policy->getTerminalPtNodePositionOfWord(codePoints.data(), codePoints.size(),
+                false /* forceLowerCaseSearch */);
+    }
+
+ private:
+    DISALLOW_IMPLICIT_CONSTRUCTORS(Ver4TestDictUtils);
+};
+} // namespace latinime
+#endif // LATINIME_VER4_TEST_DICT_UTILS_H
@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/policyimpl/dictionary/utils/checksum_utils.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+namespace latinime {
+namespace {
+
+TEST(ChecksumUtilsTest, TestAdler32) {
+    EXPECT_EQ(1u, ChecksumUtils::getAdler32(nullptr, 0 /* size */));
+    const char *const text = "Wikipedia";
+    EXPECT_EQ(0x11E60398u, ChecksumUtils::getAdler32(reinterpret_cast<const uint8_t *>(text),
+            strlen(text)));
+}
+
+// The sums are reduced in blocks, so the checksum of a buffer larger than a block has to match
+// java.util.zip.Adler32 too.
+TEST(ChecksumUtilsTest, TestAdler32OfLargeBuffer) {
+    std::vector<uint8_t> buffer;
+    for (int i = 0; i < 40; ++i) {
+        for (int j = 0; j < 256; ++j) {
+            buffer.push_back(static_cast<uint8_t>(j));
+        }
+    }
+    EXPECT_EQ(4101369118u, ChecksumUtils::getAdler32(buffer.data(), buffer.size()));
+}
+
+}  // namespace
+}  // namespace latinime
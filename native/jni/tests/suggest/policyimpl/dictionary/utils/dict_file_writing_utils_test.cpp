@@ -0,0 +1,262 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/policyimpl/dictionary/utils/dict_file_writing_utils.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+#include "suggest/core/dicnode/dic_node.h"
+#include "suggest/core/dicnode/dic_node_utils.h"
+#include "suggest/core/dicnode/dic_node_vector.h"
+#include "suggest/core/dictionary/property/word_property.h"
+#include "suggest/policyimpl/dictionary/structure/dictionary_structure_with_buffer_policy_factory.h"
+#include "suggest/policyimpl/dictionary/structure/v2/ver2_test_dict_builder.h"
+#include "suggest/policyimpl/dictionary/utils/file_utils.h"
+#include "suggest/policyimpl/dictionary/utils/format_utils.h"
+
+namespace latinime {
+namespace {
+
+const char *const WORDS[] = {
+    "a", "ab", "abandon", "abandoned", "abide", "about", "above", "abt", "b", "be", "because",
+    "bee", "thanks", "the", "then", "there", "thx", "zoo"
+};
+
+std::vector<std::vector<int>> getAllWords(DictionaryStructureWithBufferPolicy *const policy) {
+    std::vector<std::vector<int>> words;
+    int codePoints[MAX_WORD_LENGTH];
+    int codePointCount = 0;
+    int token = 0;
+    do {
+        token = policy->getNextWordAndNextToken(token, codePoints, &codePointCount);
+        words.emplace_back(codePoints, codePoints + codePointCount);
+    } while (token != 0);
+    std::sort(words.begin(), words.end());
+    return words;
+}
+
+// Walks the trie with DicNodes as the search does, and returns the words with their
+// probabilities.
+std::vector<std::pair<std::vector<int>, int>> getAllWordsWithDicNodes(
+        const DictionaryStructureWithBufferPolicy *const policy) {
+    std::vector<std::pair<std::vector<int>, int>> words;
+    int prevWordsPtNodePos[MAX_PREV_WORD_COUNT_FOR_N_GRAM];
+    std::fill(prevWordsPtNodePos, prevWordsPtNodePos + NELEMS(prevWordsPtNodePos),
+            NOT_A_DICT_POS);
+    std::vector<DicNode> current(1 /* size */);
+    DicNodeUtils::initAsRoot(policy, prevWordsPtNodePos, &current.front());
+    while (!current.empty()) {
+        std::vector<DicNode> next;
+        for (const DicNode &dicNode : current) {
+            DicNodeVector childDicNodes;
+            DicNodeUtils::getAllChildDicNodes(&dicNode, policy, &childDicNodes);
+            const int childCount = childDicNodes.getSizeAndLock();
+            for (int i = 0; i < childCount; ++i) {
+                DicNode *const childDicNode = childDicNodes[i];
+                DicNodeUtils::readProbabilityIfNeeded(policy, childDicNode);
+                if (childDicNode->isTerminalDicNode()) {
+                    const int *const codePoints = childDicNode->getOutputWordBuf();
+                    words.emplace_back(std::vector<int>(codePoints,
+                            codePoints + childDicNode->getNodeCodePointCount()),
+                            childDicNode->getProbability(policy));
+                }
+                next.push_back(*childDicNode);
+            }
+        }
+        current.swap(next);
+    }
+    std::sort(words.begin(), words.end());
+    return words;
+}
+
+std::vector<std::pair<std::vector<int>, int>> getShortcuts(const WordProperty &wordProperty) {
+    std::vector<std::pair<std::vector<int>, int>> shortcuts;
+    for (const auto &shortcut : wordProperty.getUnigramProperty()->getShortcuts()) {
+        shortcuts.emplace_back(*shortcut.getTargetCodePoints(), shortcut.getProbability());
+    }
+    std::sort(shortcuts.begin(), shortcuts.end());
+    return shortcuts;
+}
+
+std::vector<std::pair<std::vector<int>, int>> getBigrams(const WordProperty &wordProperty) {
+    std::vector<std::pair<std::vector<int>, int>> bigrams;
+    for (const auto &bigram : *wordProperty.getBigramProperties()) {
+        bigrams.emplace_back(*bigram.getTargetCodePoints(), bigram.getProbability());
+    }
+    std::sort(bigrams.begin(), bigrams.end());
+    return bigrams;
+}
+
+int getProbability(const DictionaryStructureWithBufferPolicy *const policy,
+        const std::vector<int> &prevWord, const std::vector<int> &word) {
+    int prevWordsPtNodePos[MAX_PREV_WORD_COUNT_FOR_N_GRAM];
+    std::fill(prevWordsPtNodePos, prevWordsPtNodePos + NELEMS(prevWordsPtNodePos),
+            NOT_A_DICT_POS);
+    if (!prevWord.empty()) {
+        prevWordsPtNodePos[0] = policy->getTerminalPtNodePositionOfWord(prevWord.data(),
+                prevWord.size(), false /* forceLowerCaseSearch */);
+    }
+    const int ptNodePos = policy->getTerminalPtNodePositionOfWord(word.data(), word.size(),
+            false /* forceLowerCaseSearch */);
+    return policy->getProbabilityOfPtNode(prevWordsPtNodePos, ptNodePos);
+}
+
+int getUnigramProbability(const DictionaryStructureWithBufferPolicy *const policy,
+        const std::vector<int> &word) {
+    return policy->getUnigramProbabilityOfPtNode(policy->getTerminalPtNodePositionOfWord(
+            word.data(), word.size(), false /* forceLowerCaseSearch */));
+}
+
+// The parameter is the version to convert to.
+class ConvertVer2DictFileTest : public ::testing::TestWithParam<int> {
+ protected:
+    virtual void SetUp() {
+        createTempFile(mVer2DictFilePath);
+        createTempFile(mDictFilePath);
+        Ver2TestDictBuilder builder;
+        for (size_t i = 0; i < NELEMS(WORDS); ++i) {
+            builder.addWord(WORDS[i], 255 - static_cast<int>(i) * 7);
+        }
+        // Code points outside of one byte and words that are not suggested.
+        builder.addWord(std::vector<int>({'c', 'a', 'f', 0xE9}), 150);
+        builder.addWord(std::vector<int>({0x3042, 0x3044}), 140);
+        builder.addWord(Ver2TestDictBuilder::toCodePoints("abcd"), 30, true /* isNotAWord */);
+        builder.addWord(Ver2TestDictBuilder::toCodePoints("thee"), 40, false /* isNotAWord */,
+                true /* isBlacklisted */);
+        builder.addShortcut("thx", "thanks", 14);
+        builder.addShortcut("thx", "thank you", 10);
+        builder.addShortcut("abt", "about", 12);
+        builder.addBigram("about", "the", 10);
+        builder.addBigram("about", "a", 3);
+        builder.addBigram("the", "zoo", 15);
+        builder.addBigram("zoo", "about", 1);
+        builder.addBigram("abandon", "abandoned", 7);
+        ASSERT_TRUE(builder.writeToFile(mVer2DictFilePath));
+    }
+
+    virtual void TearDown() {
+        unlink(mVer2DictFilePath);
+        unlink(mDictFilePath);
+    }
+
+    static void createTempFile(char *const outFilePath) {
+        snprintf(outFilePath, FILE_PATH_SIZE, "/tmp/convert_ver2_dict_file_test_XXXXXX");
+        const int fd = mkstemp(outFilePath);
+        ASSERT_LE(0, fd);
+        close(fd);
+    }
+
+    static DictionaryStructureWithBufferPolicy::StructurePolicyPtr openPolicy(
+            const char *const filePath) {
+        return DictionaryStructureWithBufferPolicyFactory::newPolicyForExistingDictFile(
+                filePath, 0 /* bufOffset */, FileUtils::getFileSize(filePath),
+                false /* isUpdatable */);
+    }
+
+    static const int FILE_PATH_SIZE = 64;
+
+    char mVer2DictFilePath[FILE_PATH_SIZE];
+    char mDictFilePath[FILE_PATH_SIZE];
+};
+
+TEST_P(ConvertVer2DictFileTest, TestConvertedDictHasSameContent) {
+    ASSERT_TRUE(DictFileWritingUtils::convertVer2DictFile(mVer2DictFilePath, mDictFilePath,
+            GetParam()));
+    const DictionaryStructureWithBufferPolicy::StructurePolicyPtr ver2Policy =
+            openPolicy(mVer2DictFilePath);
+    const DictionaryStructureWithBufferPolicy::StructurePolicyPtr policy =
+            openPolicy(mDictFilePath);
+    ASSERT_NE(nullptr, ver2Policy);
+    ASSERT_NE(nullptr, policy);
+    EXPECT_EQ(GetParam(), policy->getHeaderStructurePolicy()->getFormatVersionNumber());
+
+    const std::vector<std::vector<int>> words = getAllWords(ver2Policy.get());
+    ASSERT_EQ(NELEMS(WORDS) + 4, words.size());
+    EXPECT_EQ(words, getAllWords(policy.get()));
+    EXPECT_EQ(getAllWordsWithDicNodes(ver2Policy.get()), getAllWordsWithDicNodes(policy.get()));
+    EXPECT_EQ(words.size(), getAllWordsWithDicNodes(policy.get()).size());
+    const std::vector<int> noPrevWord;
+    for (const auto &word : words) {
+        SCOPED_TRACE(std::string(word.begin(), word.end()));
+        const WordProperty ver2WordProperty =
+                ver2Policy->getWordProperty(word.data(), word.size());
+        const WordProperty wordProperty = policy->getWordProperty(word.data(), word.size());
+        const UnigramProperty *const ver2UnigramProperty = ver2WordProperty.getUnigramProperty();
+        const UnigramProperty *const unigramProperty = wordProperty.getUnigramProperty();
+        EXPECT_EQ(ver2UnigramProperty->getProbability(), unigramProperty->getProbability());
+        EXPECT_EQ(ver2UnigramProperty->isNotAWord(), unigramProperty->isNotAWord());
+        EXPECT_EQ(ver2UnigramProperty->isBlacklisted(), unigramProperty->isBlacklisted());
+        EXPECT_EQ(getShortcuts(ver2WordProperty), getShortcuts(wordProperty));
+        EXPECT_EQ(getBigrams(ver2WordProperty), getBigrams(wordProperty));
+        EXPECT_EQ(getProbability(ver2Policy.get(), noPrevWord, word),
+                getProbability(policy.get(), noPrevWord, word));
+        EXPECT_EQ(getUnigramProbability(ver2Policy.get(), word),
+                getUnigramProbability(policy.get(), word));
+        for (const auto &bigram : getBigrams(ver2WordProperty)) {
+            EXPECT_EQ(getProbability(ver2Policy.get(), word, bigram.first),
+                    getProbability(policy.get(), word, bigram.first));
+        }
+    }
+    const std::vector<int> thx = Ver2TestDictBuilder::toCodePoints("thx");
+    EXPECT_EQ(2u, getShortcuts(policy->getWordProperty(thx.data(), thx.size())).size());
+    const std::vector<int> about = Ver2TestDictBuilder::toCodePoints("about");
+    EXPECT_EQ(2u, getBigrams(policy->getWordProperty(about.data(), about.size())).size());
+    // Prefixes of words and unknown words are not found.
+    const std::vector<int> abo = Ver2TestDictBuilder::toCodePoints("abo");
+    const std::vector<int> abc = Ver2TestDictBuilder::toCodePoints("abc");
+    const std::vector<int> zzz = Ver2TestDictBuilder::toCodePoints("zzz");
+    for (const std::vector<int> *const word : { &abo, &abc, &zzz }) {
+        EXPECT_EQ(NOT_A_DICT_POS, policy->getTerminalPtNodePositionOfWord(word->data(),
+                word->size(), false /* forceLowerCaseSearch */));
+    }
+}
+
+TEST_P(ConvertVer2DictFileTest, TestConvertOnlyVer2Dict) {
+    ASSERT_TRUE(DictFileWritingUtils::convertVer2DictFile(mVer2DictFilePath, mDictFilePath,
+            GetParam()));
+    EXPECT_FALSE(DictFileWritingUtils::convertVer2DictFile(mDictFilePath, mVer2DictFilePath,
+            GetParam()));
+}
+
+INSTANTIATE_TEST_CASE_P(ReadOnlyFormats, ConvertVer2DictFileTest,
+        ::testing::Values(FormatUtils::VERSION_2_LOUDS));
+
+TEST(DictFileWritingUtilsTest, TestConvertToUnsupportedVersion) {
+    char ver2DictFilePath[] = "/tmp/convert_ver2_dict_file_test_XXXXXX";
+    const int fd = mkstemp(ver2DictFilePath);
+    ASSERT_LE(0, fd);
+    close(fd);
+    Ver2TestDictBuilder builder;
+    builder.addWord("word", 100);
+    ASSERT_TRUE(builder.writeToFile(ver2DictFilePath));
+    const std::string filePath = std::string(ver2DictFilePath) + ".converted";
+    EXPECT_FALSE(DictFileWritingUtils::convertVer2DictFile(ver2DictFilePath, filePath.c_str(),
+            FormatUtils::VERSION_4));
+    EXPECT_FALSE(DictFileWritingUtils::convertVer2DictFile(ver2DictFilePath, filePath.c_str(),
+            FormatUtils::VERSION_2));
+    unlink(ver2DictFilePath);
+}
+
+}  // namespace
+}  // namespace latinime
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/policyimpl/dictionary/utils/mmapped_buffer.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+#include <vector>
+
+namespace latinime {
+namespace {
+
+// Not a multiple of the page size, so that the last page is partially mapped.
+const int TEST_FILE_SIZE = 256 * 1024 + 100;
+
+class MmappedBufferTest : public ::testing::Test {
+ protected:
+    virtual void SetUp() {
+        snprintf(mFilePath, NELEMS(mFilePath), "/tmp/mmapped_buffer_test_XXXXXX");
+        const int fd = mkstemp(mFilePath);
+        ASSERT_LE(0, fd);
+        const std::vector<uint8_t> content(TEST_FILE_SIZE, 1);
+        ASSERT_EQ(TEST_FILE_SIZE, write(fd, content.data(), content.size()));
+        close(fd);
+    }
+
+    virtual void TearDown() {
+        unlink(mFilePath);
+    }
+
+    int countBytesOfFile(const uint8_t value) const {
+        FILE *const file = fopen(mFilePath, "r");
+        int count = 0;
+        int c = 0;
+        while ((c = fgetc(file)) != EOF) {
+            if (c == value) {
+                count++;
+            }
+        }
+        fclose(file);
+        return count;
+    }
+
+    char mFilePath[64];
+};
+
+TEST_F(MmappedBufferTest, TestReadOnlyBuffer) {
+    const MmappedBuffer::MmappedBufferPtr buffer =
+            MmappedBuffer::openBuffer(mFilePath, false /* isUpdatable */);
+    ASSERT_NE(nullptr, buffer);
+    EXPECT_EQ(static_cast<size_t>(TEST_FILE_SIZE), buffer->getReadOnlyByteArrayView().size());
+    EXPECT_EQ(1, buffer->getReadOnlyByteArrayView().data()[TEST_FILE_SIZE - 1]);
+    // Only read-only dictionaries opened by the factory ask for paging hints.
+    EXPECT_FALSE(buffer->getLoadingPolicy()->adviseRandomAccess());
+    EXPECT_EQ(0, buffer->getLoadingPolicy()->getPrefetchedPrefixSize());
+    // Read-only buffers are never copied.
+    buffer->prepareForWriting();
+    EXPECT_EQ(0, buffer->getAnonymousSize());
+}
+
+TEST_F(MmappedBufferTest, TestWritingDoesNotModifyFile) {
+    const MmappedBuffer::MmappedBufferPtr buffer =
+            MmappedBuffer::openBuffer(mFilePath, true /* isUpdatable */);
+    ASSERT_NE(nullptr, buffer);
+    const ReadWriteByteArrayView view = buffer->getReadWriteByteArrayView();
+    const uint8_t *const data = view.data();
+    buffer->prepareForWriting();
+    // The buffer stays at the same address with the same contents.
+    EXPECT_EQ(data, buffer->getReadWriteByteArrayView().data());
+    EXPECT_EQ(1, view.data()[0]);
+    const int pagesize = sysconf(_SC_PAGESIZE);
+    for (int i = 0; i < TEST_FILE_SIZE; i += pagesize) {
+        view.data()[i] = 2;
+    }
+    // Written pages are backed by the shadow file, not by anonymous memory.
+    EXPECT_EQ(0, buffer->getAnonymousSize());
+    EXPECT_EQ(2, buffer->getReadOnlyByteArrayView().data()[pagesize]);
+    EXPECT_EQ(TEST_FILE_SIZE, countBytesOfFile(1));
+}
+
+TEST_F(MmappedBufferTest, TestWritesBeforePreparingAreKept) {
+    const MmappedBuffer::MmappedBufferPtr buffer =
+            MmappedBuffer::openBuffer(mFilePath, true /* isUpdatable */);
+    ASSERT_NE(nullptr, buffer);
+    buffer->getReadWriteByteArrayView().data()[10] = 3;
+    // The page has been copied into the private mapping.
+    EXPECT_LT(0, buffer->getAnonymousSize());
+    buffer->prepareForWriting();
+    EXPECT_EQ(3, buffer->getReadOnlyByteArrayView().data()[10]);
+    EXPECT_EQ(1, buffer->getReadOnlyByteArrayView().data()[11]);
+    EXPECT_EQ(TEST_FILE_SIZE, countBytesOfFile(1));
+}
+
+}  // namespace
+}  // namespace latinime
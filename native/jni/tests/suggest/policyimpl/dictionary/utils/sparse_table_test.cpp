@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/policyimpl/dictionary/utils/sparse_table.h"
+
+#include <gtest/gtest.h>
+
+#include "suggest/policyimpl/dictionary/utils/buffer_with_extendable_buffer.h"
+
+namespace latinime {
+namespace {
+
+const int BLOCK_SIZE = 4;
+const int DATA_SIZE = 4;
+const int VALUE_LIMIT = 1000;
+
+class SparseTableTest : public ::testing::Test {
+ protected:
+    SparseTableTest()
+            : mIndexTableBuffer(BufferWithExtendableBuffer::DEFAULT_MAX_ADDITIONAL_BUFFER_SIZE),
+              mContentTableBuffer(BufferWithExtendableBuffer::DEFAULT_MAX_ADDITIONAL_BUFFER_SIZE),
+              mSparseTable(&mIndexTableBuffer, &mContentTableBuffer, BLOCK_SIZE, DATA_SIZE) {}
+
+    virtual void SetUp() {
+        ASSERT_TRUE(mSparseTable.set(0, 10));
+        ASSERT_TRUE(mSparseTable.set(5, 20));
+        ASSERT_TRUE(mSparseTable.set(100, VALUE_LIMIT - 1));
+    }
+
+    BufferWithExtendableBuffer mIndexTableBuffer;
+    BufferWithExtendableBuffer mContentTableBuffer;
+    SparseTable mSparseTable;
+};
+
+TEST_F(SparseTableTest, TestVerifyStructure) {
+    EXPECT_EQ(10u, mSparseTable.get(0));
+    EXPECT_EQ(20u, mSparseTable.get(5));
+    EXPECT_TRUE(mSparseTable.verifyStructure(VALUE_LIMIT));
+}
+
+TEST_F(SparseTableTest, TestVerifyStructureWithValueOutOfLimit) {
+    EXPECT_FALSE(mSparseTable.verifyStructure(VALUE_LIMIT - 1));
+}
+
+TEST_F(SparseTableTest, TestVerifyStructureWithIndexOutOfContentTable) {
+    const int blockCount = mContentTableBuffer.getTailPosition() / (BLOCK_SIZE * DATA_SIZE);
+    ASSERT_TRUE(mIndexTableBuffer.writeUint(blockCount, 4 /* size */, 0 /* pos */));
+    EXPECT_FALSE(mSparseTable.verifyStructure(VALUE_LIMIT));
+}
+
+TEST_F(SparseTableTest, TestVerifyStructureWithTruncatedContentTable) {
+    ASSERT_TRUE(mContentTableBuffer.writeUint(0, 1 /* size */,
+            mContentTableBuffer.getTailPosition()));
+    EXPECT_FALSE(mSparseTable.verifyStructure(VALUE_LIMIT));
+}
+
+}  // namespace
+}  // namespace latinime
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "suggest/policyimpl/dictionary/utils/succinct_bit_vector.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace latinime {
+namespace {
+
+void checkBitVector(const std::vector<bool> &bits) {
+    std::vector<uint8_t> buffer;
+    buffer.push_back(0xAB);
+    SuccinctBitVector::appendToBuffer(bits, &buffer);
+    const SuccinctBitVector bitVector(buffer.data(), buffer.size(), 1 /* pos */);
+    ASSERT_TRUE(bitVector.isValid());
+    EXPECT_EQ(static_cast<int>(bits.size()), bitVector.getBitCount());
+    EXPECT_EQ(static_cast<int>(buffer.size()), bitVector.getEndPos());
+    const int bitCount = bits.size();
+    int oneCount = 0;
+    for (int i = 0; i < bitCount; ++i) {
+        EXPECT_EQ(bits[i], bitVector.get(i));
+        EXPECT_EQ(oneCount, bitVector.rank1(i));
+        if (bits[i]) {
+            EXPECT_EQ(i, bitVector.select1(oneCount));
+            ++oneCount;
+        } else {
+            EXPECT_EQ(i, bitVector.select0(i - oneCount));
+        }
+    }
+    EXPECT_EQ(oneCount, bitVector.getOneCount());
+    EXPECT_EQ(oneCount, bitVector.rank1(bitCount));
+    EXPECT_EQ(bitCount, bitVector.select1(oneCount));
+    EXPECT_EQ(bitCount, bitVector.select0(bitCount - oneCount));
+    int nextSetBitPos = bitCount;
+    int nextClearBitPos = bitCount;
+    for (int i = bitCount - 1; i >= 0; --i) {
+        if (bits[i]) {
+            nextSetBitPos = i;
+        } else {
+            nextClearBitPos = i;
+        }
+        EXPECT_EQ(nextSetBitPos, bitVector.getNextSetBitPos(i));
+        EXPECT_EQ(nextClearBitPos, bitVector.getNextClearBitPos(i));
+    }
+}
+
+TEST(SuccinctBitVectorTest, TestEmpty) {
+    checkBitVector(std::vector<bool>());
+}
+
+TEST(SuccinctBitVectorTest, TestUniform) {
+    checkBitVector(std::vector<bool>(1000, true));
+    checkBitVector(std::vector<bool>(1000, false));
+}
+
+TEST(SuccinctBitVectorTest, TestRandom) {
+    std::mt19937 randomEngine(1234);
+    // Sparse vectors have the select hints far apart.
+    for (const int percentage : { 1, 50, 99 }) {
+        std::vector<bool> bits;
+        for (int i = 0; i < 20000; ++i) {
+            bits.push_back(static_cast<int>(randomEngine() % 100) < percentage);
+        }
+        checkBitVector(bits);
+    }
+}
+
+TEST(SuccinctBitVectorTest, TestBrokenBuffer) {
+    std::vector<uint8_t> buffer;
+    SuccinctBitVector::appendToBuffer(std::vector<bool>(1000, true), &buffer);
+    const SuccinctBitVector bitVector(buffer.data(), buffer.size() - 1, 0 /* pos */);
+    EXPECT_FALSE(bitVector.isValid());
+    EXPECT_EQ(static_cast<int>(buffer.size()) - 1, bitVector.getEndPos());
+}
+
+}  // namespace
+}  // namespace latinime
@@ -19,11 +19,13 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <cstdio>
 #include <cstdlib>
 #include <functional>
 #include <map>
 #include <random>
 #include <unordered_map>
+#include <vector>
 
 namespace latinime {
 namespace {
@@ -220,5 +222,38 @@ TEST(TrieMapTest, TestIteration) {
     EXPECT_TRUE(testKeyValuePairs.empty());
 }
 
+TEST(TrieMapTest, TestVerifyStructure) {
+    static const int ELEMENT_COUNT = 10000;
+    TrieMap trieMap;
+    EXPECT_TRUE(trieMap.verifyStructure());
+    for (int i = 0; i < ELEMENT_COUNT; ++i) {
+        EXPECT_TRUE(trieMap.putRoot(i, i % 2 == 0 ? i : TrieMap::MAX_VALUE - i));
+    }
+    for (int i = 0; i < ELEMENT_COUNT; i += 10) {
+        const int nextLevel = trieMap.getNextLevelBitmapEntryIndex(i);
+        EXPECT_TRUE(trieMap.put(i + 1, i + 1, nextLevel));
+    }
+    EXPECT_TRUE(trieMap.verifyStructure());
+
+    FILE *const file = tmpfile();
+    ASSERT_TRUE(file != nullptr);
+    ASSERT_TRUE(trieMap.save(file));
+    // Skip the size field that precedes the saved buffer.
+    static const int SIZE_FIELD_SIZE = 4;
+    std::vector<uint8_t> buffer(ftell(file) - SIZE_FIELD_SIZE);
+    fseek(file, SIZE_FIELD_SIZE, SEEK_SET);
+    ASSERT_EQ(buffer.size(), fread(buffer.data(), 1, buffer.size(), file));
+    fclose(file);
+    EXPECT_TRUE(TrieMap(ReadWriteByteArrayView(buffer.data(), buffer.size())).verifyStructure());
+
+    // Make the root bitmap entry, which follows the 128 bytes of empty table links, link to a
+    // table outside the buffer.
+    static const int ROOT_TABLE_LINK_POS = 128 + 4 /* FIELD0_SIZE */;
+    buffer[ROOT_TABLE_LINK_POS] = 0x3F;
+    buffer[ROOT_TABLE_LINK_POS + 1] = 0xFF;
+    buffer[ROOT_TABLE_LINK_POS + 2] = 0xFF;
+    EXPECT_FALSE(TrieMap(ReadWriteByteArrayView(buffer.data(), buffer.size())).verifyStructure());
+}
+
 }  // namespace
 }  // namespace latinime
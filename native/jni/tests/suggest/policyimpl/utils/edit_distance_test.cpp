@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "suggest/policyimpl/utils/edit_distance.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "suggest/policyimpl/utils/damerau_levenshtein_edit_distance_policy.h"
+
+namespace latinime {
+namespace {
+
+// The same costs without reporting unit costs, so that EditDistance uses the costs.
+class PolicyCostsOnlyEditDistancePolicy : public DamerauLevenshteinEditDistancePolicy {
+ public:
+    PolicyCostsOnlyEditDistancePolicy(const std::vector<int> &string0,
+            const std::vector<int> &string1)
+            : DamerauLevenshteinEditDistancePolicy(string0.data(), string0.size(),
+                    string1.data(), string1.size()) {}
+
+    bool hasUnitCosts() const {
+        return false;
+    }
+};
+
+float getEditDistance(const std::vector<int> &string0, const std::vector<int> &string1) {
+    const DamerauLevenshteinEditDistancePolicy policy(string0.data(), string0.size(),
+            string1.data(), string1.size());
+    return EditDistance::getEditDistance(&policy);
+}
+
+TEST(EditDistanceTest, TestUnitCostEditDistance) {
+    const std::vector<std::vector<int>> words = {
+        {},
+        {'a'}, {'b'}, {'a', 'b'}, {'b', 'a'}, {'a', 'b', 'c'}, {'c', 'a'},
+        {'t', 'h', 'e', 'i', 'r'}, {'t', 'h', 'i', 'e', 'r'}, {'T', 'H', 0xCF, 'E', 'R'},
+        {'r', 'e', 'c', 'e', 'i', 'v', 'e'}, {'r', 'e', 'c', 'i', 'e', 'v', 'e'},
+    };
+    for (const auto &string0 : words) {
+        for (const auto &string1 : words) {
+            const PolicyCostsOnlyEditDistancePolicy policy(string0, string1);
+            EXPECT_EQ(EditDistance::getEditDistance(&policy), getEditDistance(string0, string1));
+        }
+    }
+    EXPECT_EQ(1.0f, getEditDistance({'t', 'h', 'e', 'i', 'r'}, {'t', 'h', 'i', 'e', 'r'}));
+    EXPECT_EQ(0.0f, getEditDistance({'t', 'h', 'i', 'e', 'r'}, {'T', 'H', 0xCF, 'E', 'R'}));
+    // Optimal string alignment doesn't edit a transposed pair again.
+    EXPECT_EQ(3.0f, getEditDistance({'c', 'a'}, {'a', 'b', 'c'}));
+}
+
+TEST(EditDistanceTest, TestLongStrings) {
+    std::vector<int> string0(MAX_WORD_LENGTH, 'a');
+    std::vector<int> string1(MAX_WORD_LENGTH, 'a');
+    string1[0] = 'b';
+    string1[MAX_WORD_LENGTH - 1] = 'b';
+    EXPECT_EQ(2.0f, getEditDistance(string0, string1));
+    string0.resize(100, 'a');
+    EXPECT_EQ(54.0f, getEditDistance(string0, string1));
+}
+
+TEST(EditDistanceTest, TestEditDistanceWithinThreshold) {
+    const std::vector<int> string0 = {'k', 'i', 't', 't', 'e', 'n'};
+    const std::vector<int> string1 = {'s', 'i', 't', 't', 'i', 'n', 'g'};
+    const DamerauLevenshteinEditDistancePolicy policy(string0.data(), string0.size(),
+            string1.data(), string1.size());
+    EXPECT_EQ(3.0f, EditDistance::getEditDistanceWithinThreshold(&policy, 3));
+    EXPECT_EQ(3.0f, EditDistance::getEditDistanceWithinThreshold(&policy, 5));
+    EXPECT_LT(2.0f, EditDistance::getEditDistanceWithinThreshold(&policy, 2));
+    EXPECT_LT(0.0f, EditDistance::getEditDistanceWithinThreshold(&policy, 0));
+}
+
+}  // namespace
+}  // namespace latinime
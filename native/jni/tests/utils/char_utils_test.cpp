@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/char_utils.h"
+
+#include <gtest/gtest.h>
+
+namespace latinime {
+namespace {
+
+TEST(CharUtilsTest, TestToLowerCase) {
+    EXPECT_EQ('a', CharUtils::toLowerCase('A'));
+    EXPECT_EQ('a', CharUtils::toLowerCase('a'));
+    EXPECT_EQ('@', CharUtils::toLowerCase('@'));
+    EXPECT_EQ(0x00E0, CharUtils::toLowerCase(0x00C0));
+    EXPECT_EQ(0x03C3, CharUtils::toLowerCase(0x03A3));
+    EXPECT_EQ(0x0430, CharUtils::toLowerCase(0x0410));
+    EXPECT_EQ(0xFF58, CharUtils::toLowerCase(0xFF38));
+    for (int c = 0x80; c <= 0xFFFF; ++c) {
+        EXPECT_EQ(CharUtils::latin_tolower(static_cast<unsigned short>(c)),
+                CharUtils::toLowerCase(c));
+    }
+}
+
+TEST(CharUtilsTest, TestToBaseCodePoint) {
+    EXPECT_EQ('A', CharUtils::toBaseCodePoint('A'));
+    EXPECT_EQ('A', CharUtils::toBaseCodePoint(0x00C0));
+    EXPECT_EQ('e', CharUtils::toBaseCodePoint(0x00E9));
+    EXPECT_EQ(0x0415, CharUtils::toBaseCodePoint(0x0400));
+    EXPECT_EQ(0x0500, CharUtils::toBaseCodePoint(0x0500));
+    EXPECT_EQ(0x1E00, CharUtils::toBaseCodePoint(0x1E00));
+}
+
+TEST(CharUtilsTest, TestToBaseLowerCase) {
+    for (int c = 0; c <= 0xFFFF; ++c) {
+        EXPECT_EQ(CharUtils::toLowerCase(CharUtils::toBaseCodePoint(c)),
+                CharUtils::toBaseLowerCase(c));
+    }
+    EXPECT_EQ('a', CharUtils::toBaseLowerCase(0x00C0));
+    EXPECT_EQ(0x0435, CharUtils::toBaseLowerCase(0x0400));
+}
+
+TEST(CharUtilsTest, TestCodePointsOutOfBmp) {
+    EXPECT_EQ(NOT_A_CODE_POINT, CharUtils::toLowerCase(NOT_A_CODE_POINT));
+    EXPECT_EQ(NOT_A_CODE_POINT, CharUtils::toBaseCodePoint(NOT_A_CODE_POINT));
+    EXPECT_EQ(NOT_A_CODE_POINT, CharUtils::toBaseLowerCase(NOT_A_CODE_POINT));
+    EXPECT_EQ(0x10400, CharUtils::toLowerCase(0x10400));
+    EXPECT_EQ(0x1F600, CharUtils::toBaseLowerCase(0x1F600));
+}
+
+}  // namespace
+}  // namespace latinime
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/suggestion_batch_buffer.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace latinime {
+namespace {
+
+// Creates the input record of a typing query that has one previous word.
+std::vector<int> createInputRecord(const std::vector<int> &prevWord, const int codePoint) {
+    std::vector<int> inputRecord = {1 /* inputSize */, 1 /* pointCount */,
+            1 /* inputCodePointCount */, 0 /* optionCount */, 1 /* prevWordCount */,
+            0 /* languageWeight */, 0 /* gesturePointsGeneration */,
+            0 /* isBeginningOfSentence */,
+            static_cast<int>(prevWord.size())};
+    inputRecord.insert(inputRecord.end(), prevWord.begin(), prevWord.end());
+    inputRecord.insert(inputRecord.end(), {codePoint, 0 /* x */, 0 /* y */, 0 /* time */,
+            0 /* pointerId */});
+    return inputRecord;
+}
+
+std::vector<int> createBatch(const std::vector<std::vector<int>> &inputRecords) {
+    std::vector<int> buffer(SuggestionBatchBuffer::HEADER_SIZE
+            + inputRecords.size() * SuggestionBuffer::OUTPUT_RECORD_SIZE, 0);
+    buffer[SuggestionBatchBuffer::QUERY_COUNT] = inputRecords.size();
+    for (const std::vector<int> &inputRecord : inputRecords) {
+        buffer.push_back(inputRecord.size());
+        buffer.insert(buffer.end(), inputRecord.begin(), inputRecord.end());
+    }
+    return buffer;
+}
+
+TEST(SuggestionBatchBufferTest, TestRecords) {
+    const std::vector<int> inputRecord0 = createInputRecord({'a'}, 'x');
+    const std::vector<int> inputRecord1 = createInputRecord({'b', 'c'}, 'y');
+    std::vector<int> buffer = createBatch({inputRecord0, inputRecord1});
+    const SuggestionBatchBuffer batchBuffer(buffer.data(), buffer.size());
+    ASSERT_TRUE(batchBuffer.isValid());
+    ASSERT_EQ(2, batchBuffer.getQueryCount());
+    EXPECT_EQ(&buffer[SuggestionBatchBuffer::HEADER_SIZE + SuggestionBuffer::OUTPUT_RECORD_SIZE],
+            batchBuffer.getOutputRecord(1));
+    EXPECT_EQ(static_cast<int>(inputRecord1.size()), batchBuffer.getInputRecordSize(1));
+    const SuggestionBuffer query(batchBuffer.getOutputRecord(1), batchBuffer.getInputRecord(1),
+            batchBuffer.getInputRecordSize(1));
+    ASSERT_TRUE(query.isValid());
+    EXPECT_EQ('y', query.getInputCodePoints()[0]);
+    EXPECT_EQ(2, query.getPrevWordsInfo().getNthPrevWordCodePointCount(1));
+
+    // Truncated batches are rejected.
+    for (size_t size = 0; size < buffer.size(); ++size) {
+        EXPECT_FALSE(SuggestionBatchBuffer(buffer.data(), size).isValid()) << size;
+    }
+}
+
+TEST(SuggestionBatchBufferTest, TestQueryGroupsByContext) {
+    std::vector<int> buffer = createBatch({createInputRecord({'a'}, 'w'),
+            createInputRecord({'b'}, 'x'), createInputRecord({'a'}, 'y'),
+            createInputRecord({'b'}, 'z'), createInputRecord({'a', 'b'}, 'x')});
+    const SuggestionBatchBuffer batchBuffer(buffer.data(), buffer.size());
+    ASSERT_TRUE(batchBuffer.isValid());
+    const std::vector<std::vector<int>> queryGroups = batchBuffer.getQueryGroupsByContext();
+    ASSERT_EQ(3u, queryGroups.size());
+    EXPECT_EQ(std::vector<int>({0, 2}), queryGroups[0]);
+    EXPECT_EQ(std::vector<int>({1, 3}), queryGroups[1]);
+    EXPECT_EQ(std::vector<int>({4}), queryGroups[2]);
+}
+
+}  // namespace
+}  // namespace latinime
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/suggestion_buffer.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+#include "suggest/core/result/suggestion_results.h"
+
+namespace latinime {
+namespace {
+
+std::vector<int> createBuffer(const std::vector<int> &inputRecord) {
+    std::vector<int> buffer(SuggestionBuffer::INPUT_RECORD, 0);
+    buffer.insert(buffer.end(), inputRecord.begin(), inputRecord.end());
+    return buffer;
+}
+
+int toInt(const float value) {
+    int intValue;
+    memcpy(&intValue, &value, sizeof(intValue));
+    return intValue;
+}
+
+TEST(SuggestionBufferTest, TestInputRecord) {
+    const std::vector<int> inputRecord = {
+        2 /* inputSize */, 2 /* pointCount */, 2 /* inputCodePointCount */, 3 /* optionCount */,
+        1 /* prevWordCount */, toInt(0.5f) /* languageWeight */, 7 /* gesturePointsGeneration */,
+        1, 0, 1 /* options */,
+        0 /* isBeginningOfSentence */, 3 /* codePointCount */, 'a', 'b', 'c',
+        'h', 'i' /* inputCodePoints */,
+        10, 20 /* xCoordinates */, 30, 40 /* yCoordinates */, 50, 60 /* times */,
+        0, 0 /* pointerIds */};
+    std::vector<int> buffer = createBuffer(inputRecord);
+    const SuggestionBuffer suggestionBuffer(buffer.data(), buffer.size());
+    ASSERT_TRUE(suggestionBuffer.isValid());
+    EXPECT_EQ(2, suggestionBuffer.getInputSize());
+    EXPECT_FLOAT_EQ(0.5f, suggestionBuffer.getInputLanguageWeight());
+    EXPECT_EQ(7, suggestionBuffer.getGesturePointsGeneration());
+    EXPECT_EQ(3, suggestionBuffer.getOptionCount());
+    EXPECT_EQ(1, suggestionBuffer.getOptions()[2]);
+    EXPECT_EQ('h', suggestionBuffer.getInputCodePoints()[0]);
+    EXPECT_EQ(20, suggestionBuffer.getXCoordinates()[1]);
+    EXPECT_EQ(30, suggestionBuffer.getYCoordinates()[0]);
+    EXPECT_EQ(60, suggestionBuffer.getTimes()[1]);
+    EXPECT_EQ(0, suggestionBuffer.getPointerIds()[1]);
+    const PrevWordsInfo prevWordsInfo = suggestionBuffer.getPrevWordsInfo();
+    ASSERT_TRUE(prevWordsInfo.isValid());
+    EXPECT_EQ(3, prevWordsInfo.getNthPrevWordCodePointCount(1));
+    EXPECT_EQ('c', prevWordsInfo.getNthPrevWordCodePoints(1)[2]);
+
+    // Truncated records are rejected.
+    for (size_t size = SuggestionBuffer::INPUT_RECORD; size < buffer.size(); ++size) {
+        EXPECT_FALSE(SuggestionBuffer(buffer.data(), size).isValid()) << size;
+    }
+}
+
+TEST(SuggestionBufferTest, TestOutputRecord) {
+    std::vector<int> buffer = createBuffer({0 /* inputSize */, 0 /* pointCount */,
+            0 /* inputCodePointCount */, 0 /* optionCount */, 0 /* prevWordCount */,
+            toInt(NOT_A_LANGUAGE_WEIGHT), 0 /* gesturePointsGeneration */});
+    SuggestionBuffer suggestionBuffer(buffer.data(), buffer.size());
+    ASSERT_TRUE(suggestionBuffer.isValid());
+    SuggestionResults suggestionResults(MAX_RESULTS);
+    const int word0[] = {'a', 'b'};
+    const int word1[] = {'x', 0x01 /* control code */, 'z'};
+    suggestionResults.addSuggestion(word0, NELEMS(word0), 100 /* score */, 1 /* type */,
+            NOT_AN_INDEX, 5 /* autoCommitFirstWordConfidence */);
+    suggestionResults.addSuggestion(word1, NELEMS(word1), 200 /* score */, 2 /* type */,
+            1 /* indexToPartialCommit */, 7 /* autoCommitFirstWordConfidence */);
+    suggestionResults.setLanguageWeight(0.25f);
+    suggestionResults.outputSuggestions(&suggestionBuffer);
+
+    EXPECT_EQ(2, buffer[SuggestionBuffer::SUGGESTION_COUNT]);
+    EXPECT_EQ(toInt(0.25f), buffer[SuggestionBuffer::OUTPUT_LANGUAGE_WEIGHT]);
+    // Suggestions are output in the same order as SuggestionResults outputs them to Java arrays.
+    EXPECT_EQ(100, buffer[SuggestionBuffer::SCORES]);
+    EXPECT_EQ(NOT_AN_INDEX, buffer[SuggestionBuffer::SPACE_INDICES]);
+    EXPECT_EQ(1, buffer[SuggestionBuffer::TYPES]);
+    EXPECT_EQ(200, buffer[SuggestionBuffer::SCORES + 1]);
+    EXPECT_EQ(7, buffer[SuggestionBuffer::AUTO_COMMIT_FIRST_WORD_CONFIDENCE]);
+    const int *const codePoints = &buffer[SuggestionBuffer::CODE_POINTS];
+    EXPECT_EQ('a', codePoints[0]);
+    EXPECT_EQ('b', codePoints[1]);
+    EXPECT_EQ(0, codePoints[2]);
+    EXPECT_EQ('x', codePoints[MAX_WORD_LENGTH]);
+    EXPECT_EQ(0xFFFD, codePoints[MAX_WORD_LENGTH + 1]);
+    EXPECT_EQ('z', codePoints[MAX_WORD_LENGTH + 2]);
+    EXPECT_EQ(0, codePoints[MAX_WORD_LENGTH + 3]);
+}
+
+}  // namespace
+}  // namespace latinime
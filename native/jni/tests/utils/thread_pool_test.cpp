@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/thread_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace latinime {
+namespace {
+
+TEST(ThreadPoolTest, TestRunTasks) {
+    ThreadPool *const threadPool = ThreadPool::getInstance();
+    EXPECT_LT(0, threadPool->getWorkerThreadCount());
+    std::vector<int> results(100, 0);
+    threadPool->runTasks(static_cast<int>(results.size()), [&results](const int taskIndex) {
+        results[taskIndex] += taskIndex * 2;
+    });
+    for (int i = 0; i < static_cast<int>(results.size()); ++i) {
+        EXPECT_EQ(i * 2, results[i]);
+    }
+    threadPool->runTasks(0 /* taskCount */, [](const int taskIndex) { FAIL(); });
+}
+
+// Tasks run on the worker threads while the calling thread runs tasks too.
+TEST(ThreadPoolTest, TestRunTasksOnSeveralThreads) {
+    ThreadPool *const threadPool = ThreadPool::getInstance();
+    const int taskCount = threadPool->getWorkerThreadCount() + 1;
+    std::atomic<int> startedTaskCount(0);
+    std::vector<std::thread::id> threadIds(taskCount);
+    threadPool->runTasks(taskCount, [&](const int taskIndex) {
+        threadIds[taskIndex] = std::this_thread::get_id();
+        ++startedTaskCount;
+        // Every task waits until all of them have started, so each one runs on its own thread.
+        while (startedTaskCount < taskCount) {
+            std::this_thread::yield();
+        }
+    });
+    for (int i = 0; i < taskCount; ++i) {
+        for (int j = i + 1; j < taskCount; ++j) {
+            EXPECT_NE(threadIds[i], threadIds[j]);
+        }
+    }
+}
+
+TEST(ThreadPoolTest, TestRunNestedTasks) {
+    ThreadPool *const threadPool = ThreadPool::getInstance();
+    std::atomic<int> count(0);
+    threadPool->runTasks(8 /* taskCount */, [&](const int outerTaskIndex) {
+        threadPool->runTasks(8 /* taskCount */, [&](const int innerTaskIndex) {
+            count += outerTaskIndex * 8 + innerTaskIndex;
+        });
+    });
+    EXPECT_EQ(63 * 64 / 2, count);
+}
+
+}  // namespace
+}  // namespace latinime